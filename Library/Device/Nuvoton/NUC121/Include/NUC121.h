@@ -132,6 +132,28 @@ typedef enum IRQn
     #pragma anon_unions
 #endif
 
+/**
+ * Place a function in SRAM
+ *
+ * @details  The function is copied to SRAM at boot together with the initialised data and runs there without flash
+ *           wait states. GCC needs gcc_arm.ld, Keil the ramfunc execution region of NUC121.sct, IAR its __ramfunc
+ *           keyword is enough. Without the scatter file Keil leaves the function in flash.
+ */
+#if defined ( __ICCARM__ )
+    #define __RAMFUNC       __ramfunc
+#else
+    #define __RAMFUNC       __attribute__((section("ramfunc"), noinline))
+#endif
+
+/**
+ * Place a hot driver function in SRAM when USE_RAMFUNC is defined, leave it in flash otherwise
+ */
+#ifdef USE_RAMFUNC
+    #define __RAMFUNC_HOT   __RAMFUNC
+#else
+    #define __RAMFUNC_HOT
+#endif
+
 /**
  * Initialize the system clock
  *
@@ -374,21 +396,42 @@ typedef volatile unsigned short vu16;
 /*                         Peripheral header files                            */
 /******************************************************************************/
 #include "adc.h"
+#include "blkdev.h"
 #include "bpwm.h"
 #include "clk.h"
+#include "dlog.h"
 #include "fmc.h"
 #include "gpio.h"
 #include "i2c.h"
+#include "i2c_xfer.h"
+#include "i2c_eeprom.h"
+#include "i2c_regmap.h"
+#include "nau8822.h"
 #include "pdma.h"
+#include "prof.h"
 #include "pwm.h"
+#include "pwm_seq.h"
+#include "sched.h"
+#include "semihost.h"
 #include "spi_i2s.h"
+#include "spi_nor.h"
+#include "i2s_stream.h"
+#include "irq_plan.h"
+#include "spi_slave.h"
+#include "stkmon.h"
 #include "sys.h"
 #include "timer.h"
+#include "swtimer.h"
+#include "timer_cap.h"
 #include "uart.h"
 #include "usbd.h"
 #include "usci_i2c.h"
+#include "usci_i2c_mon.h"
 #include "usci_spi.h"
 #include "usci_uart.h"
+#include "clk_gov.h"
+#include "crash.h"
+#include "lpm.h"
 #include "wdt.h"
 #include "wwdt.h"
 
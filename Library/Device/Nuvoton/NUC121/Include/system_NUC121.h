@@ -30,6 +30,29 @@ extern "C" {
  */
 //#define INIT_SYSCLK_AT_BOOTING
 
+/**
+ *
+ * @details    This is used to start the external crystal in SystemInit without waiting for it. The crystal
+ *             stabilises while the C runtime initialises RAM, so the HXT stable wait in SYS_Init is shorter.
+ *             PF.0 and PF.1 are switched to XT_OUT and XT_IN, do not enable it on boards using LXT there.
+ *
+ */
+//#define INIT_HXT_AT_BOOTING
+
+/**
+ *
+ * @details    This is used to let SysTick run free from SystemInit on, so SystemBootMark can stamp boot phases
+ *             in HCLK cycles since reset. The stamps are meaningless once the application reprograms SysTick.
+ *
+ */
+//#define INIT_BOOT_MARK_AT_BOOTING
+
+#define BOOT_MARK_RAM       0       /*!< .data and .bss initialised, stamped by the GCC __STARTUP_FAST_BOOT startup */
+#define BOOT_MARK_MAIN      1       /*!< First statement of main                                                    */
+#define BOOT_MARK_CLOCK     2       /*!< Clocks configured                                                          */
+#define BOOT_MARK_APP       3       /*!< Application ready                                                          */
+#define BOOT_MARK_NUM       4       /*!< Number of boot phase stamps                                                */
+
 /*----------------------------------------------------------------------------
   Define SYSCLK
  *----------------------------------------------------------------------------*/
@@ -48,6 +71,7 @@ extern "C" {
 extern uint32_t SystemCoreClock;    /*!< System Clock Frequency (Core Clock)  */
 extern uint32_t CyclesPerUs;        /*!< Cycles per micro second              */
 extern uint32_t PllClock;           /*!< PLL Output Clock Frequency           */
+extern uint32_t g_au32BootMark[BOOT_MARK_NUM];  /*!< Boot phase stamps in HCLK cycles since reset */
 
 #if USE_ASSERT
 /**
@@ -94,6 +118,19 @@ extern void SystemInit(void);
  */
 extern void SystemCoreClockUpdate(void);
 
+
+/**
+ * @brief    Stamp a Boot Phase
+ *
+ * @param[in]  u32Id  BOOT_MARK_RAM, BOOT_MARK_MAIN, BOOT_MARK_CLOCK or BOOT_MARK_APP
+ *
+ * @return   None
+ *
+ * @details  Stores the HCLK cycles since reset in g_au32BootMark, where a debugger or an emulator can read them.
+ *           Needs INIT_BOOT_MARK_AT_BOOTING, the stamp is 0 otherwise.
+ */
+extern void SystemBootMark(uint32_t u32Id);
+
 #ifdef __cplusplus
 }
 #endif
@@ -18,6 +18,7 @@ uint32_t SystemCoreClock  = __HSI;              /*!< System Clock Frequency (Cor
 uint32_t CyclesPerUs      = (__HSI / 1000000);  /*!< Cycles per micro second             */
 uint32_t PllClock         = __HSI;              /*!< PLL Output Clock Frequency          */
 const uint32_t gau32ClkSrcTbl[] = {__HXT, __LXT, __HSI, __LIRC, __HIRC, __HSI_DIV2, 0, __HIRC_DIV2};
+uint32_t g_au32BootMark[BOOT_MARK_NUM];          /*!< Boot phase stamps in HCLK cycles since reset */
 
 
 /**
@@ -80,7 +81,29 @@ void SystemInit(void)
     int32_t i32TimeoutCnt;
     uint32_t u32HclkSelect;
     int8_t i8IsPllEn;
+#endif
+
+#ifdef INIT_BOOT_MARK_AT_BOOTING
+    /* Free running down counter of HCLK cycles, SystemBootMark reads it */
+    SysTick->LOAD = SysTick_LOAD_RELOAD_Msk;
+    SysTick->VAL  = 0;
+    SysTick->CTRL = SysTick_CTRL_CLKSOURCE_Msk | SysTick_CTRL_ENABLE_Msk;
+#endif
+
+#ifdef INIT_HXT_AT_BOOTING
+    /* Set XT1_OUT(PF.0) and XT1_IN(PF.1) to input mode and disable their digital input path */
+    PF->MODE &= ~(GPIO_MODE_MODE0_Msk | GPIO_MODE_MODE1_Msk);
+    GPIO_DISABLE_DIGITAL_PATH(PF, BIT0 | BIT1);
+    SYS->GPF_MFPL = (SYS->GPF_MFPL & ~(SYS_GPF_MFPL_PF0MFP_Msk | SYS_GPF_MFPL_PF1MFP_Msk)) |
+                    SYS_GPF_MFPL_PF0MFP_XT_OUT | SYS_GPF_MFPL_PF1MFP_XT_IN;
+
+    /* Start HXT but do not wait for it, it stabilises while RAM is initialised */
+    SYS_UnlockReg();
+    CLK->PWRCTL = (CLK->PWRCTL & ~CLK_PWRCTL_XTLEN_Msk) | CLK_PWRCTL_HXTEN;
+    SYS_LockReg();
+#endif
 
+#ifdef INIT_SYSCLK_AT_BOOTING
     PllClock = 0;
     i8IsPllEn = 0;
     u32HclkSelect = CLK->CLKSEL0 & CLK_CLKSEL0_HCLKSEL_Msk;
@@ -107,7 +130,7 @@ void SystemInit(void)
         CLK->PLLCTL = CLK_PLLCTL_50MHz_HIRC_DIV2;
 
         /* Waiting for PLL ready */
-        i32TimeoutCnt = (__HIRC_DVI2 / 1000); /* Timeout is about 1ms */
+        i32TimeoutCnt = (__HIRC_DIV2 / 1000); /* Timeout is about 1ms */
 
         while ((CLK->STATUS & CLK_STATUS_PLLSTB_Msk) == 0)
         {
@@ -130,6 +153,28 @@ void SystemInit(void)
 }
 
 
+/**
+ * @brief    Stamp a Boot Phase
+ *
+ * @param[in]  u32Id  BOOT_MARK_RAM, BOOT_MARK_MAIN, BOOT_MARK_CLOCK or BOOT_MARK_APP
+ *
+ * @return   None
+ *
+ * @details  Stores the HCLK cycles since reset in g_au32BootMark. Stamps are taken against the HCLK of the moment,
+ *           a clock switch changes the rate they count at.
+ */
+void SystemBootMark(uint32_t u32Id)
+{
+    if (u32Id >= BOOT_MARK_NUM)
+        return;
+
+    if (SysTick->CTRL & SysTick_CTRL_ENABLE_Msk)
+        g_au32BootMark[u32Id] = SysTick_LOAD_RELOAD_Msk - SysTick->VAL;
+    else
+        g_au32BootMark[u32Id] = 0;
+}
+
+
 #if USE_ASSERT
 /**
  * @brief      Assert Error Message
@@ -0,0 +1,102 @@
+/**************************************************************************//**
+ * @file     blkdev.h
+ * @version  V1.00
+ * @brief    NUC121 series block device interface header file
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * @copyright (C) 2021 Nuvoton Technology Corp. All rights reserved.
+ *****************************************************************************/
+#ifndef __BLKDEV_H__
+#define __BLKDEV_H__
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+
+/** @addtogroup Standard_Driver Standard Driver
+  @{
+*/
+
+/** @addtogroup BLKDEV_Driver BLKDEV Driver
+  @{
+*/
+
+/** @addtogroup BLKDEV_EXPORTED_STRUCTS BLKDEV Exported Structs
+  @{
+*/
+typedef int32_t (*BLKDEV_READ_FUNC)(void *pvDev, uint32_t u32Block, uint8_t *pu8Buf, uint32_t u32Count);          /*!< Read blocks, return 0 on success  */
+typedef int32_t (*BLKDEV_WRITE_FUNC)(void *pvDev, uint32_t u32Block, const uint8_t *pu8Buf, uint32_t u32Count);   /*!< Write blocks, return 0 on success */
+typedef int32_t (*BLKDEV_SYNC_FUNC)(void *pvDev);                                                                 /*!< Wait until written data is stored */
+
+/* Storage seen as an array of equal blocks, filled in by the storage driver */
+typedef struct
+{
+    void *pvDev;                            /*!< Storage driver context passed to every function             */
+    uint32_t u32BlockSize;                  /*!< Block size in bytes                                         */
+    uint32_t u32BlockNum;                   /*!< Number of blocks                                            */
+    BLKDEV_READ_FUNC pfnRead;               /*!< Read blocks                                                 */
+    BLKDEV_WRITE_FUNC pfnWrite;             /*!< Write blocks                                                */
+    BLKDEV_SYNC_FUNC pfnSync;               /*!< Flush, could be NULL if writes complete before returning    */
+} S_BLKDEV_T;
+
+/*@}*/ /* end of group BLKDEV_EXPORTED_STRUCTS */
+
+
+/** @addtogroup BLKDEV_EXPORTED_FUNCTIONS BLKDEV Exported Functions
+  @{
+*/
+
+/**
+  * @brief      Read blocks from a block device
+  *
+  * @param[in]  psBlk       The pointer of the block device.
+  * @param[in]  u32Block    First block.
+  * @param[out] pu8Buf      Buffer of u32Count blocks.
+  * @param[in]  u32Count    Number of blocks.
+  *
+  * @retval     0           Success
+  * @retval     <0          Error code of the storage driver
+  * \hideinitializer
+  */
+#define BLKDEV_READ(psBlk, u32Block, pu8Buf, u32Count)  ((psBlk)->pfnRead((psBlk)->pvDev, (u32Block), (pu8Buf), (u32Count)))
+
+/**
+  * @brief      Write blocks to a block device
+  *
+  * @param[in]  psBlk       The pointer of the block device.
+  * @param[in]  u32Block    First block.
+  * @param[in]  pu8Buf      Data of u32Count blocks.
+  * @param[in]  u32Count    Number of blocks.
+  *
+  * @retval     0           Success
+  * @retval     <0          Error code of the storage driver
+  * \hideinitializer
+  */
+#define BLKDEV_WRITE(psBlk, u32Block, pu8Buf, u32Count) ((psBlk)->pfnWrite((psBlk)->pvDev, (u32Block), (pu8Buf), (u32Count)))
+
+/**
+  * @brief      Wait until every written block is stored
+  *
+  * @param[in]  psBlk       The pointer of the block device.
+  *
+  * @retval     0           Success
+  * @retval     <0          Error code of the storage driver
+  * \hideinitializer
+  */
+#define BLKDEV_SYNC(psBlk)      (((psBlk)->pfnSync != NULL) ? (psBlk)->pfnSync((psBlk)->pvDev) : 0)
+
+/*@}*/ /* end of group BLKDEV_EXPORTED_FUNCTIONS */
+
+/*@}*/ /* end of group BLKDEV_Driver */
+
+/*@}*/ /* end of group Standard_Driver */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //__BLKDEV_H__
+
+/*** (C) COPYRIGHT 2021 Nuvoton Technology Corp. ***/
@@ -0,0 +1,237 @@
+/**************************************************************************//**
+ * @file     clk_gov.h
+ * @version  V1.00
+ * @brief    NUC121 series clock scaling governor header file
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * @copyright (C) 2021 Nuvoton Technology Corp. All rights reserved.
+ *****************************************************************************/
+#ifndef __CLK_GOV_H__
+#define __CLK_GOV_H__
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+
+/** @addtogroup Standard_Driver Standard Driver
+  @{
+*/
+
+/** @addtogroup CLK_GOV_Driver CLK_GOV Driver
+  @{
+*/
+
+/** @addtogroup CLK_GOV_EXPORTED_CONSTANTS CLK_GOV Exported Constants
+  @{
+*/
+#define CLK_GOV_LEVEL_MAX           (8UL)   /*!< Maximum number of performance levels */
+
+#ifndef CLK_GOV_UP_THRESHOLD
+#define CLK_GOV_UP_THRESHOLD        (80UL)  /*!< Load in percent at or above which the highest level is selected */
+#endif
+
+#ifndef CLK_GOV_DOWN_THRESHOLD
+#define CLK_GOV_DOWN_THRESHOLD      (30UL)  /*!< Load in percent below which the level is lowered by one step    */
+#endif
+
+#define CLK_GOV_PRE_CHANGE          (0UL)   /*!< Notifier event before HCLK changes, peripheral should get idle  */
+#define CLK_GOV_POST_CHANGE         (1UL)   /*!< Notifier event after HCLK changed, peripheral recomputes clocks */
+
+/*@}*/ /* end of group CLK_GOV_EXPORTED_CONSTANTS */
+
+
+/** @addtogroup CLK_GOV_EXPORTED_STRUCTS CLK_GOV Exported Structs
+  @{
+*/
+typedef struct
+{
+    uint32_t u32ClkSrc;                     /*!< HCLK source, CLK_CLKSEL0_HCLKSEL_xxx                             */
+    uint32_t u32ClkDiv;                     /*!< HCLK divider, CLK_CLKDIV0_HCLK(x). Ignored for the PLL source    */
+    uint32_t u32Hclk;                       /*!< HCLK for the PLL source, set by \ref CLK_SetCoreClock, or 0      */
+} S_CLK_GOV_LEVEL_T;
+
+struct s_clk_gov_notifier;
+
+typedef void (*CLK_GOV_CB)(struct s_clk_gov_notifier *psNotifier, uint32_t u32Event); /*!< Clock change notifier */
+
+typedef struct s_clk_gov_notifier
+{
+    struct s_clk_gov_notifier *psNext;      /*!< Next registered notifier                                         */
+    CLK_GOV_CB pfnNotify;                   /*!< Called with \ref CLK_GOV_PRE_CHANGE and \ref CLK_GOV_POST_CHANGE */
+    void *pvPeriph;                         /*!< Peripheral of the notifier, for example UART0                    */
+    uint32_t u32Rate;                       /*!< Baud rate or bus clock to keep across changes                    */
+} S_CLK_GOV_NOTIFIER_T;
+
+typedef uint32_t (*CLK_GOV_TIME_FUNC)(void);    /*!< Micro second timebase not clocked from HCLK */
+
+typedef struct
+{
+    uint32_t u32Transitions;                /*!< Number of clock transitions                                      */
+    uint32_t u32LastTime;                   /*!< Duration of the last transition in micro seconds                 */
+    uint32_t u32MaxTime;                    /*!< Longest transition in micro seconds                              */
+    uint32_t au32Enter[CLK_GOV_LEVEL_MAX];  /*!< Number of transitions into each level                            */
+} S_CLK_GOV_STAT_T;
+
+/*@}*/ /* end of group CLK_GOV_EXPORTED_STRUCTS */
+
+
+/** @addtogroup CLK_GOV_EXPORTED_FUNCTIONS CLK_GOV Exported Functions
+  @{
+*/
+
+/**
+  * @brief      Clock change notifier of UART
+  *
+  * @param[in]  psNotifier  The pointer of the notifier, pvPeriph is UART0 and u32Rate is the baud rate.
+  * @param[in]  u32Event    \ref CLK_GOV_PRE_CHANGE or \ref CLK_GOV_POST_CHANGE.
+  *
+  * @return     None
+  *
+  * @details    Transmission is drained before the change. The baud rate only has to be recomputed if the UART is
+  *             clocked from PLL; with HXT or HIRC/2 the serial link is not affected by the governor at all.
+  */
+__STATIC_INLINE void CLK_GOV_NotifyUART(S_CLK_GOV_NOTIFIER_T *psNotifier, uint32_t u32Event)
+{
+    UART_T *uart = (UART_T *)psNotifier->pvPeriph;
+
+    if (u32Event == CLK_GOV_PRE_CHANGE)
+    {
+        UART_WAIT_TX_EMPTY(uart);
+    }
+    else
+    {
+        /* LINE is written back as is, only the divider depends on the clock */
+        UART_SetLine_Config(uart, psNotifier->u32Rate, uart->LINE, 0, 0);
+    }
+}
+
+/**
+  * @brief      Clock change notifier of USCI_UART
+  *
+  * @param[in]  psNotifier  The pointer of the notifier, pvPeriph is UUART0 and u32Rate is the baud rate.
+  * @param[in]  u32Event    \ref CLK_GOV_PRE_CHANGE or \ref CLK_GOV_POST_CHANGE.
+  *
+  * @return     None
+  *
+  * @details    USCI_UART is clocked from PCLK. The buffer is drained and the last character is given time to
+  *             leave the shift register before the change, then the baud rate is recomputed.
+  */
+__STATIC_INLINE void CLK_GOV_NotifyUUART(S_CLK_GOV_NOTIFIER_T *psNotifier, uint32_t u32Event)
+{
+    UUART_T *uuart = (UUART_T *)psNotifier->pvPeriph;
+    volatile uint32_t u32Loop;
+
+    if (u32Event == CLK_GOV_PRE_CHANGE)
+    {
+        UUART_WAIT_TX_EMPTY(uuart);
+
+        /* One character of up to 12 bits, without touching SysTick which may be owned by the application */
+        u32Loop = (((12000000UL / psNotifier->u32Rate) + 1UL) * CyclesPerUs) >> 2;
+
+        while (u32Loop-- != 0);
+    }
+    else
+    {
+        UUART_SetLine_Config(uuart, psNotifier->u32Rate, uuart->LINECTL & UUART_LINECTL_DWIDTH_Msk,
+                             uuart->PROTCTL & (UUART_PROTCTL_STICKEN_Msk | UUART_PROTCTL_EVENPARITY_Msk | UUART_PROTCTL_PARITYEN_Msk),
+                             uuart->PROTCTL & UUART_PROTCTL_STOPB_Msk);
+    }
+}
+
+/**
+  * @brief      Clock change notifier of I2C
+  *
+  * @param[in]  psNotifier  The pointer of the notifier, pvPeriph is I2C0 or I2C1 and u32Rate is the bus clock.
+  * @param[in]  u32Event    \ref CLK_GOV_PRE_CHANGE or \ref CLK_GOV_POST_CHANGE.
+  *
+  * @return     None
+  *
+  * @note       A transfer in progress cannot be paused, so hold the level by \ref CLK_GOV_Hold during transfers.
+  */
+__STATIC_INLINE void CLK_GOV_NotifyI2C(S_CLK_GOV_NOTIFIER_T *psNotifier, uint32_t u32Event)
+{
+    if (u32Event == CLK_GOV_POST_CHANGE)
+        I2C_SetBusClockFreq((I2C_T *)psNotifier->pvPeriph, psNotifier->u32Rate);
+}
+
+/**
+  * @brief      Clock change notifier of USCI_I2C
+  *
+  * @param[in]  psNotifier  The pointer of the notifier, pvPeriph is UI2C0 and u32Rate is the bus clock.
+  * @param[in]  u32Event    \ref CLK_GOV_PRE_CHANGE or \ref CLK_GOV_POST_CHANGE.
+  *
+  * @return     None
+  *
+  * @note       A transfer in progress cannot be paused, so hold the level by \ref CLK_GOV_Hold during transfers.
+  */
+__STATIC_INLINE void CLK_GOV_NotifyUI2C(S_CLK_GOV_NOTIFIER_T *psNotifier, uint32_t u32Event)
+{
+    if (u32Event == CLK_GOV_POST_CHANGE)
+        UI2C_SetBusClockFreq((UI2C_T *)psNotifier->pvPeriph, psNotifier->u32Rate);
+}
+
+/**
+  * @brief      Clock change notifier of SPI
+  *
+  * @param[in]  psNotifier  The pointer of the notifier, pvPeriph is SPI0 and u32Rate is the bus clock.
+  * @param[in]  u32Event    \ref CLK_GOV_PRE_CHANGE or \ref CLK_GOV_POST_CHANGE.
+  *
+  * @return     None
+  */
+__STATIC_INLINE void CLK_GOV_NotifySPI(S_CLK_GOV_NOTIFIER_T *psNotifier, uint32_t u32Event)
+{
+    SPI_T *spi = (SPI_T *)psNotifier->pvPeriph;
+
+    if (u32Event == CLK_GOV_PRE_CHANGE)
+    {
+        while (SPI_IS_BUSY(spi));
+    }
+    else
+        SPI_SetBusClock(spi, psNotifier->u32Rate);
+}
+
+/**
+  * @brief      Clock change notifier of USCI_SPI
+  *
+  * @param[in]  psNotifier  The pointer of the notifier, pvPeriph is USPI0 and u32Rate is the bus clock.
+  * @param[in]  u32Event    \ref CLK_GOV_PRE_CHANGE or \ref CLK_GOV_POST_CHANGE.
+  *
+  * @return     None
+  */
+__STATIC_INLINE void CLK_GOV_NotifyUSPI(S_CLK_GOV_NOTIFIER_T *psNotifier, uint32_t u32Event)
+{
+    USPI_T *uspi = (USPI_T *)psNotifier->pvPeriph;
+
+    if (u32Event == CLK_GOV_PRE_CHANGE)
+    {
+        while (USPI_IS_BUSY(uspi));
+    }
+    else
+        USPI_SetBusClock(uspi, psNotifier->u32Rate);
+}
+
+int32_t CLK_GOV_Init(const S_CLK_GOV_LEVEL_T *psLevels, uint32_t u32Num, CLK_GOV_TIME_FUNC pfnGetTime);
+void CLK_GOV_RegisterNotifier(S_CLK_GOV_NOTIFIER_T *psNotifier, CLK_GOV_CB pfnNotify, void *pvPeriph, uint32_t u32Rate);
+void CLK_GOV_UnregisterNotifier(S_CLK_GOV_NOTIFIER_T *psNotifier);
+int32_t CLK_GOV_SetLevel(uint32_t u32Level);
+uint32_t CLK_GOV_GetLevel(void);
+void CLK_GOV_SetLoad(uint32_t u32Load);
+void CLK_GOV_Hold(uint32_t u32Level);
+void CLK_GOV_Release(uint32_t u32Level);
+const S_CLK_GOV_STAT_T *CLK_GOV_GetStat(void);
+
+/*@}*/ /* end of group CLK_GOV_EXPORTED_FUNCTIONS */
+
+/*@}*/ /* end of group CLK_GOV_Driver */
+
+/*@}*/ /* end of group Standard_Driver */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //__CLK_GOV_H__
+
+/*** (C) COPYRIGHT 2021 Nuvoton Technology Corp. ***/
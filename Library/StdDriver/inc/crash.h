@@ -0,0 +1,95 @@
+/**************************************************************************//**
+ * @file     crash.h
+ * @version  V1.00
+ * @brief    NUC121 series crash dump and boot counter header file
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * @copyright (C) 2021 Nuvoton Technology Corp. All rights reserved.
+ *****************************************************************************/
+#ifndef __CRASH_H__
+#define __CRASH_H__
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+
+/** @addtogroup Standard_Driver Standard Driver
+  @{
+*/
+
+/** @addtogroup CRASH_Driver CRASH Driver
+  @{
+*/
+
+/** @addtogroup CRASH_EXPORTED_CONSTANTS CRASH Exported Constants
+  @{
+*/
+#ifndef CRASH_STACK_WORDS
+#define CRASH_STACK_WORDS           (32UL)  /*!< Stack words saved above the exception frame                 */
+#endif
+
+#define CRASH_STORE_SIZE            (FMC_FLASH_PAGE_SIZE * 2UL)     /*!< Flash reserved at the store base     */
+#define CRASH_MAGIC                 (0x43524153UL)  /*!< Valid crash record marker                           */
+
+#define CRASH_FRAME_R0              (0UL)   /*!< Index of R0 in the stacked frame                            */
+#define CRASH_FRAME_R1              (1UL)   /*!< Index of R1 in the stacked frame                            */
+#define CRASH_FRAME_R2              (2UL)   /*!< Index of R2 in the stacked frame                            */
+#define CRASH_FRAME_R3              (3UL)   /*!< Index of R3 in the stacked frame                            */
+#define CRASH_FRAME_R12             (4UL)   /*!< Index of R12 in the stacked frame                           */
+#define CRASH_FRAME_LR              (5UL)   /*!< Index of LR in the stacked frame                            */
+#define CRASH_FRAME_PC              (6UL)   /*!< Index of PC in the stacked frame                            */
+#define CRASH_FRAME_PSR             (7UL)   /*!< Index of xPSR in the stacked frame                          */
+
+#define CRASH_ERR_STORE             (-40L)  /*!< Store base is not page aligned or not in flash              */
+#define CRASH_ERR_FLASH             (-41L)  /*!< Flash erase or program failed                               */
+
+/*@}*/ /* end of group CRASH_EXPORTED_CONSTANTS */
+
+
+/** @addtogroup CRASH_EXPORTED_STRUCTS CRASH Exported Structs
+  @{
+*/
+typedef struct
+{
+    uint32_t u32Magic;                      /*!< \ref CRASH_MAGIC when the record is valid                   */
+    uint32_t u32Boot;                       /*!< Boot count of the run that crashed                          */
+    uint32_t u32ExcReturn;                  /*!< EXC_RETURN of the fault, bit 2 set if the frame is on PSP   */
+    uint32_t u32Sp;                         /*!< Address of the stacked frame                                */
+    uint32_t au32Frame[8];                  /*!< R0, R1, R2, R3, R12, LR, PC and xPSR pushed by the core     */
+    uint32_t u32Icsr;                       /*!< SCB->ICSR, pending and active exceptions                    */
+    uint32_t u32Control;                    /*!< CONTROL register                                            */
+    uint32_t u32RstSts;                     /*!< SYS->RSTSTS of the run that crashed                         */
+    uint32_t u32StackWords;                 /*!< Valid words in au32Stack, limited by the end of SRAM        */
+    uint32_t au32Stack[CRASH_STACK_WORDS];  /*!< Stack above the frame, return addresses of the callers      */
+    uint32_t u32Sum;                        /*!< Sum of all words above, the record is complete if it fits   */
+} S_CRASH_T;
+
+/*@}*/ /* end of group CRASH_EXPORTED_STRUCTS */
+
+
+/** @addtogroup CRASH_EXPORTED_FUNCTIONS CRASH Exported Functions
+  @{
+*/
+
+int32_t CRASH_Open(uint32_t u32Base);
+uint32_t CRASH_GetBootCount(void);
+uint32_t CRASH_Get(S_CRASH_T *psCrash);
+void CRASH_Clear(void);
+void CRASH_Print(const S_CRASH_T *psCrash);
+void CRASH_Capture(uint32_t *pu32Frame, uint32_t u32ExcReturn);
+
+/*@}*/ /* end of group CRASH_EXPORTED_FUNCTIONS */
+
+/*@}*/ /* end of group CRASH_Driver */
+
+/*@}*/ /* end of group Standard_Driver */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //__CRASH_H__
+
+/*** (C) COPYRIGHT 2021 Nuvoton Technology Corp. ***/
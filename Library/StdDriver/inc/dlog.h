@@ -0,0 +1,133 @@
+/**************************************************************************//**
+ * @file     dlog.h
+ * @version  V1.00
+ * @brief    NUC121 series deferred binary log header file
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * @copyright (C) 2021 Nuvoton Technology Corp. All rights reserved.
+ *****************************************************************************/
+#ifndef __DLOG_H__
+#define __DLOG_H__
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+
+/** @addtogroup Standard_Driver Standard Driver
+  @{
+*/
+
+/** @addtogroup DLOG_Driver DLOG Driver
+  @{
+*/
+
+/** @addtogroup DLOG_EXPORTED_CONSTANTS DLOG Exported Constants
+  @{
+*/
+#ifndef DLOG_BUF_WORDS
+#define DLOG_BUF_WORDS              (256UL)     /*!< Ring size in words, must be a power of 2                */
+#endif
+
+#define DLOG_ARG_MAX                (4UL)       /*!< Arguments of one record                                 */
+
+/*
+    Wire format, little endian words as they are in the ring:
+
+    word 0      bits 31..28 = 0xD, bits 27..24 = argument count, bits 23..0 = format string address
+    word 1..n   raw 32-bit arguments
+
+    The format string address is the record ID, a decoder reads the string at that address from the ELF file or
+    from the flash. A record with address 0 reports the number of records dropped because the ring was full.
+*/
+#define DLOG_SYNC                   (0xD0000000UL)  /*!< Upper nibble of each record header                  */
+#define DLOG_SYNC_MSK               (0xF0000000UL)  /*!< Mask of the sync nibble                             */
+#define DLOG_ARGS_POS               (24UL)          /*!< Argument count position in the header               */
+#define DLOG_ARGS_MSK               (0x0F000000UL)  /*!< Argument count mask in the header                   */
+#define DLOG_ID_MSK                 (0x00FFFFFFUL)  /*!< Format string address mask in the header            */
+#define DLOG_ID_DROPPED             (0UL)           /*!< ID of the dropped records report                    */
+
+/*@}*/ /* end of group DLOG_EXPORTED_CONSTANTS */
+
+
+/** @addtogroup DLOG_EXPORTED_FUNCTIONS DLOG Exported Functions
+  @{
+*/
+
+/**
+  * @brief      Log a record without arguments
+  *
+  * @param[in]  fmt     printf format string literal, only its address is recorded.
+  *
+  * @return     None
+  *
+  * @details    Safe in any context, including interrupts. Arguments are recorded as 32-bit words, so the format
+  *             may use %d, %u, %x, %c and %p, but not strings, 64-bit values or floating point.
+  * \hideinitializer
+  */
+#define DLOG0(fmt)                  DLOG_Write((uint32_t)(fmt), 0UL, 0UL, 0UL, 0UL, 0UL)
+
+/**
+  * @brief      Log a record with 1 argument
+  * @param[in]  fmt     printf format string literal.
+  * @param[in]  a       Argument converted to uint32_t.
+  * @return     None
+  * \hideinitializer
+  */
+#define DLOG1(fmt, a)               DLOG_Write((uint32_t)(fmt), 1UL, (uint32_t)(a), 0UL, 0UL, 0UL)
+
+/**
+  * @brief      Log a record with 2 arguments
+  * @param[in]  fmt     printf format string literal.
+  * @param[in]  a       Argument converted to uint32_t.
+  * @param[in]  b       Argument converted to uint32_t.
+  * @return     None
+  * \hideinitializer
+  */
+#define DLOG2(fmt, a, b)            DLOG_Write((uint32_t)(fmt), 2UL, (uint32_t)(a), (uint32_t)(b), 0UL, 0UL)
+
+/**
+  * @brief      Log a record with 3 arguments
+  * @param[in]  fmt     printf format string literal.
+  * @param[in]  a       Argument converted to uint32_t.
+  * @param[in]  b       Argument converted to uint32_t.
+  * @param[in]  c       Argument converted to uint32_t.
+  * @return     None
+  * \hideinitializer
+  */
+#define DLOG3(fmt, a, b, c)         DLOG_Write((uint32_t)(fmt), 3UL, (uint32_t)(a), (uint32_t)(b), (uint32_t)(c), 0UL)
+
+/**
+  * @brief      Log a record with 4 arguments
+  * @param[in]  fmt     printf format string literal.
+  * @param[in]  a       Argument converted to uint32_t.
+  * @param[in]  b       Argument converted to uint32_t.
+  * @param[in]  c       Argument converted to uint32_t.
+  * @param[in]  d       Argument converted to uint32_t.
+  * @return     None
+  * \hideinitializer
+  */
+#define DLOG4(fmt, a, b, c, d)      DLOG_Write((uint32_t)(fmt), 4UL, (uint32_t)(a), (uint32_t)(b), (uint32_t)(c), (uint32_t)(d))
+
+void DLOG_Open(uint32_t u32PdmaCh);
+void DLOG_Close(void);
+void DLOG_Write(uint32_t u32Fmt, uint32_t u32Args, uint32_t u32A, uint32_t u32B, uint32_t u32C, uint32_t u32D);
+uint32_t DLOG_Poll(void);
+void DLOG_Flush(void);
+void DLOG_Print(void);
+uint32_t DLOG_GetDropped(void);
+
+/*@}*/ /* end of group DLOG_EXPORTED_FUNCTIONS */
+
+/*@}*/ /* end of group DLOG_Driver */
+
+/*@}*/ /* end of group Standard_Driver */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //__DLOG_H__
+
+/*** (C) COPYRIGHT 2021 Nuvoton Technology Corp. ***/
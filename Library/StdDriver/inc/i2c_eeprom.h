@@ -0,0 +1,88 @@
+/**************************************************************************//**
+ * @file     i2c_eeprom.h
+ * @version  V1.00
+ * @brief    NUC121 series paged 24Cxx I2C EEPROM driver header file
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * @copyright (C) 2021 Nuvoton Technology Corp. All rights reserved.
+ *****************************************************************************/
+#ifndef __I2C_EEPROM_H__
+#define __I2C_EEPROM_H__
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+
+/** @addtogroup Standard_Driver Standard Driver
+  @{
+*/
+
+/** @addtogroup I2C_EEPROM_Driver I2C_EEPROM Driver
+  @{
+*/
+
+/** @addtogroup I2C_EEPROM_EXPORTED_CONSTANTS I2C_EEPROM Exported Constants
+  @{
+*/
+#ifndef I2C_EEPROM_CACHE_SIZE
+#define I2C_EEPROM_CACHE_SIZE       (32UL)  /*!< Read cache line in bytes, a power of 2 up to 256         */
+#endif
+
+#define I2C_EEPROM_POLL_MAX         (1000UL)    /*!< Default ACK polls before a write cycle is a time-out */
+
+#define I2C_EEPROM_ERR_RANGE        (-10L)  /*!< Access beyond the end of the device                     */
+#define I2C_EEPROM_ERR_BUSY         (-11L)  /*!< Write cycle did not end within the poll limit           */
+
+/*@}*/ /* end of group I2C_EEPROM_EXPORTED_CONSTANTS */
+
+
+/** @addtogroup I2C_EEPROM_EXPORTED_STRUCTS I2C_EEPROM Exported Structs
+  @{
+*/
+typedef struct
+{
+    S_I2C_XFER_BUS_T *psBus;                /*!< Queued master the device is connected to                    */
+    S_I2C_XFER_T sXfer;                     /*!< Transaction of the device                                   */
+    uint8_t u8SlaveAddr;                    /*!< 7-bit slave address with A2..A0                             */
+    uint8_t u8AddrLen;                      /*!< Word address length, 1 up to 2 KB, otherwise 2              */
+    uint8_t u8WriteBusy;                    /*!< Internal write cycle may be in progress                     */
+    uint32_t u32Size;                       /*!< Device size in bytes                                        */
+    uint32_t u32PageSize;                   /*!< Write page size in bytes                                    */
+    uint32_t u32PollMax;                    /*!< ACK polls before \ref I2C_EEPROM_ERR_BUSY                   */
+    uint32_t u32CacheAddr;                  /*!< Address of the cached line, 0xFFFFFFFF if empty             */
+    uint8_t au8Cache[I2C_EEPROM_CACHE_SIZE];    /*!< Read cache line                                         */
+    uint32_t u32PageWrites;                 /*!< Page write transactions                                     */
+    uint32_t u32Polls;                      /*!< ACK polls answered by NACK, each one about 10 bit times     */
+    uint32_t u32CacheHits;                  /*!< Reads served from the cache                                 */
+    uint32_t u32CacheMisses;                /*!< Cache line fills                                            */
+} S_I2C_EEPROM_T;
+
+/*@}*/ /* end of group I2C_EEPROM_EXPORTED_STRUCTS */
+
+
+/** @addtogroup I2C_EEPROM_EXPORTED_FUNCTIONS I2C_EEPROM Exported Functions
+  @{
+*/
+
+int32_t I2C_EEPROM_Open(S_I2C_EEPROM_T *psDev, S_I2C_XFER_BUS_T *psBus, uint8_t u8SlaveAddr, uint32_t u32Size, uint32_t u32PageSize);
+int32_t I2C_EEPROM_Read(S_I2C_EEPROM_T *psDev, uint32_t u32Addr, uint8_t *pu8Buf, uint32_t u32Len);
+int32_t I2C_EEPROM_Write(S_I2C_EEPROM_T *psDev, uint32_t u32Addr, const uint8_t *pu8Data, uint32_t u32Len);
+int32_t I2C_EEPROM_Sync(S_I2C_EEPROM_T *psDev);
+void I2C_EEPROM_Invalidate(S_I2C_EEPROM_T *psDev);
+void I2C_EEPROM_GetBlockDev(S_I2C_EEPROM_T *psDev, S_BLKDEV_T *psBlk);
+
+/*@}*/ /* end of group I2C_EEPROM_EXPORTED_FUNCTIONS */
+
+/*@}*/ /* end of group I2C_EEPROM_Driver */
+
+/*@}*/ /* end of group Standard_Driver */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //__I2C_EEPROM_H__
+
+/*** (C) COPYRIGHT 2021 Nuvoton Technology Corp. ***/
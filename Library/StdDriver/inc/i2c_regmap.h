@@ -0,0 +1,108 @@
+/**************************************************************************//**
+ * @file     i2c_regmap.h
+ * @version  V1.00
+ * @brief    NUC121 series I2C slave register map service header file
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * @copyright (C) 2021 Nuvoton Technology Corp. All rights reserved.
+ *****************************************************************************/
+#ifndef __I2C_REGMAP_H__
+#define __I2C_REGMAP_H__
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+
+/** @addtogroup Standard_Driver Standard Driver
+  @{
+*/
+
+/** @addtogroup I2C_REGMAP_Driver I2C_REGMAP Driver
+  @{
+*/
+
+/** @addtogroup I2C_REGMAP_EXPORTED_CONSTANTS I2C_REGMAP Exported Constants
+  @{
+*/
+#ifndef I2C_REGMAP_STAGE_SIZE
+#define I2C_REGMAP_STAGE_SIZE       (32UL)  /*!< Longest access with snapshot semantics, also the PDMA block size */
+#endif
+
+#define I2C_REGMAP_WIN_MAX          (4UL)   /*!< One window per slave address register                   */
+#define I2C_REGMAP_NO_PDMA          (0xFFFFFFFFUL)  /*!< PDMA channel not used                           */
+
+#define I2C_REGMAP_RW               (0UL)   /*!< Window could be written by the master                   */
+#define I2C_REGMAP_RO               (1UL)   /*!< Master writes to the window are acknowledged and dropped */
+
+/*@}*/ /* end of group I2C_REGMAP_EXPORTED_CONSTANTS */
+
+
+/** @addtogroup I2C_REGMAP_EXPORTED_STRUCTS I2C_REGMAP Exported Structs
+  @{
+*/
+struct s_i2c_regmap;
+
+typedef void (*I2C_REGMAP_CB)(struct s_i2c_regmap *psMap, uint32_t u32Win, uint32_t u32Reg, uint32_t u32Len); /*!< Master write committed, interrupt context */
+
+typedef struct
+{
+    uint8_t *pu8Map;                        /*!< Register file                                               */
+    uint32_t u32Size;                       /*!< Register file size, register addresses wrap at the end      */
+    uint8_t u8SlaveAddr;                    /*!< 7-bit slave address                                         */
+    uint8_t u8Mask;                         /*!< Address bits ignored when matching                          */
+    uint8_t u8ReadOnly;                     /*!< \ref I2C_REGMAP_RW or \ref I2C_REGMAP_RO                    */
+} S_I2C_REGMAP_WIN_T;
+
+typedef struct s_i2c_regmap
+{
+    I2C_T *i2c;                             /*!< Controller in slave mode                                    */
+    S_I2C_REGMAP_WIN_T asWin[I2C_REGMAP_WIN_MAX];   /*!< Windows, one per slave address                      */
+    uint32_t u32WinNum;                     /*!< Windows in use                                              */
+    uint32_t u32RegLen;                     /*!< Register address length, 1 or 2 bytes                       */
+    uint32_t u32PdmaTxCh;                   /*!< PDMA channel for transmit or \ref I2C_REGMAP_NO_PDMA        */
+    uint32_t u32PdmaRxCh;                   /*!< PDMA channel for receive or \ref I2C_REGMAP_NO_PDMA         */
+    I2C_REGMAP_CB pfnWrite;                 /*!< Write notification, could be NULL                           */
+    uint32_t u32Win;                        /*!< Addressed window                                            */
+    uint32_t u32Reg;                        /*!< Register address of the access                              */
+    uint32_t u32AddrCnt;                    /*!< Register address bytes received                             */
+    uint32_t u32Count;                      /*!< Bytes staged or sent                                        */
+    uint32_t u32Stage;                      /*!< Bytes valid in au8Stage for a read, or PDMA receive length  */
+    uint32_t u32Commit;                     /*!< Register address of the next write commit                   */
+    uint8_t au8Stage[I2C_REGMAP_STAGE_SIZE];    /*!< Snapshot for reads, staging for writes                  */
+    uint32_t u32Writes;                     /*!< Committed master writes                                     */
+    uint32_t u32Reads;                      /*!< Master reads                                                */
+    uint32_t u32Dropped;                    /*!< Bytes written to read-only windows                          */
+} S_I2C_REGMAP_T;
+
+/*@}*/ /* end of group I2C_REGMAP_EXPORTED_STRUCTS */
+
+
+/** @addtogroup I2C_REGMAP_EXPORTED_FUNCTIONS I2C_REGMAP Exported Functions
+  @{
+*/
+
+uint32_t I2C_REGMAP_Open(S_I2C_REGMAP_T *psMap, I2C_T *i2c, uint32_t u32BusClock, uint32_t u32RegLen);
+void I2C_REGMAP_Close(S_I2C_REGMAP_T *psMap);
+int32_t I2C_REGMAP_AddWindow(S_I2C_REGMAP_T *psMap, uint8_t u8SlaveAddr, uint8_t u8Mask, uint8_t *pu8Map,
+                             uint32_t u32Size, uint32_t u32ReadOnly);
+int32_t I2C_REGMAP_EnablePDMA(S_I2C_REGMAP_T *psMap, uint32_t u32TxCh, uint32_t u32RxCh);
+void I2C_REGMAP_SetWriteCallback(S_I2C_REGMAP_T *psMap, I2C_REGMAP_CB pfnWrite);
+void I2C_REGMAP_Update(S_I2C_REGMAP_T *psMap, uint32_t u32Win, uint32_t u32Reg, const uint8_t *pu8Data, uint32_t u32Len);
+void I2C_REGMAP_Snapshot(S_I2C_REGMAP_T *psMap, uint32_t u32Win, uint32_t u32Reg, uint8_t *pu8Buf, uint32_t u32Len);
+void I2C_REGMAP_IRQHandler(S_I2C_REGMAP_T *psMap);
+
+/*@}*/ /* end of group I2C_REGMAP_EXPORTED_FUNCTIONS */
+
+/*@}*/ /* end of group I2C_REGMAP_Driver */
+
+/*@}*/ /* end of group Standard_Driver */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //__I2C_REGMAP_H__
+
+/*** (C) COPYRIGHT 2021 Nuvoton Technology Corp. ***/
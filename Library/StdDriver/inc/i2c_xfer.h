@@ -0,0 +1,155 @@
+/**************************************************************************//**
+ * @file     i2c_xfer.h
+ * @version  V1.00
+ * @brief    NUC121 series interrupt driven I2C and USCI_I2C master transaction queue header file
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * @copyright (C) 2021 Nuvoton Technology Corp. All rights reserved.
+ *****************************************************************************/
+#ifndef __I2C_XFER_H__
+#define __I2C_XFER_H__
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+
+/** @addtogroup Standard_Driver Standard Driver
+  @{
+*/
+
+/** @addtogroup I2C_XFER_Driver I2C_XFER Driver
+  @{
+*/
+
+/** @addtogroup I2C_XFER_EXPORTED_CONSTANTS I2C_XFER Exported Constants
+  @{
+*/
+#define I2C_XFER_OK                 (0L)    /*!< Transaction completed                                   */
+#define I2C_XFER_QUEUED             (1L)    /*!< Transaction waits in the queue                          */
+#define I2C_XFER_ACTIVE             (2L)    /*!< Transaction is on the bus                               */
+#define I2C_XFER_ERR_NACK           (-1L)   /*!< Address or data was not acknowledged                    */
+#define I2C_XFER_ERR_ARB            (-2L)   /*!< Arbitration lost to another master                      */
+#define I2C_XFER_ERR_BUS            (-3L)   /*!< Illegal START or STOP on the bus                        */
+#define I2C_XFER_ERR_TIMEOUT        (-4L)   /*!< Bus stalled, the controller has been recovered          */
+
+#define I2C_XFER_NO_PDMA            (0xFFFFFFFFUL)  /*!< PDMA channel not used                           */
+
+#define I2C_XFER_EV_NONE            (0UL)   /*!< Back-end event: nothing to do                           */
+#define I2C_XFER_EV_START           (1UL)   /*!< Back-end event: START or repeated START transmitted     */
+#define I2C_XFER_EV_ACK             (2UL)   /*!< Back-end event: byte transferred with ACK               */
+#define I2C_XFER_EV_NACK            (3UL)   /*!< Back-end event: byte transferred with NACK              */
+#define I2C_XFER_EV_ARB             (4UL)   /*!< Back-end event: arbitration lost                        */
+#define I2C_XFER_EV_BUS             (5UL)   /*!< Back-end event: bus error                               */
+#define I2C_XFER_EV_TIMEOUT         (6UL)   /*!< Back-end event: bus time-out                            */
+
+#define I2C_XFER_CTL_ACK            (0x1UL) /*!< Back-end control: acknowledge the event, SI or PTRG     */
+#define I2C_XFER_CTL_STA            (0x2UL) /*!< Back-end control: send START                            */
+#define I2C_XFER_CTL_STO            (0x4UL) /*!< Back-end control: send STOP, before START if both set   */
+#define I2C_XFER_CTL_AA             (0x8UL) /*!< Back-end control: ACK the next received byte            */
+
+/*@}*/ /* end of group I2C_XFER_EXPORTED_CONSTANTS */
+
+
+/** @addtogroup I2C_XFER_EXPORTED_STRUCTS I2C_XFER Exported Structs
+  @{
+*/
+struct s_i2c_xfer;
+struct s_i2c_xfer_bus;
+
+typedef void (*I2C_XFER_CB)(struct s_i2c_xfer *psXfer);     /*!< Completion callback, called in interrupt context */
+typedef void (*I2C_XFER_RECOVER_FUNC)(void *pvBus);         /*!< Board specific bus clear, for example 9 SCL pulses by GPIO */
+
+typedef struct s_i2c_xfer
+{
+    struct s_i2c_xfer *psNext;              /*!< Next queued transaction                                     */
+    uint8_t u8SlaveAddr;                    /*!< 7-bit slave address                                         */
+    uint8_t u8RegLen;                       /*!< Register address length, 0, 1 or 2 bytes, sent MSB first   */
+    uint16_t u16Reg;                        /*!< Register address                                            */
+    const uint8_t *pu8Tx;                   /*!< Data written after the register address                     */
+    uint32_t u32TxLen;                      /*!< Number of bytes to write                                    */
+    uint8_t *pu8Rx;                         /*!< Data read after a repeated START                            */
+    uint32_t u32RxLen;                      /*!< Number of bytes to read                                     */
+    I2C_XFER_CB pfnDone;                    /*!< Completion callback, could be NULL                          */
+    void *pvArg;                            /*!< Argument for the callback                                   */
+    volatile int32_t i32Status;             /*!< I2C_XFER_xxx status                                         */
+    uint32_t u32Count;                      /*!< Bytes transferred in the current direction                  */
+} S_I2C_XFER_T;
+
+/* Controller back-end, one per controller type. Every function gets the bus context. */
+typedef struct
+{
+    uint32_t (*pfnOpen)(struct s_i2c_xfer_bus *psBus);                  /*!< Enable at u32BusClock with interrupts, return actual clock */
+    void (*pfnClose)(struct s_i2c_xfer_bus *psBus);                     /*!< Reset and disable the controller                           */
+    uint32_t (*pfnEvent)(struct s_i2c_xfer_bus *psBus);                 /*!< Read and clear the next event, I2C_XFER_EV_xxx            */
+    void (*pfnCtrl)(struct s_i2c_xfer_bus *psBus, uint32_t u32Ctrl);    /*!< Apply I2C_XFER_CTL_xxx bits                                */
+    void (*pfnWrite)(struct s_i2c_xfer_bus *psBus, uint8_t u8Data);     /*!< Load the byte to transmit                                  */
+    uint8_t (*pfnRead)(struct s_i2c_xfer_bus *psBus);                   /*!< Get the received byte                                      */
+    void (*pfnTimeout)(struct s_i2c_xfer_bus *psBus, uint32_t u32En);   /*!< Enable or disable the bus time-out                         */
+    int32_t (*pfnPdma)(struct s_i2c_xfer_bus *psBus, uint32_t u32Rx, uint8_t *pu8Buf, uint32_t u32Len); /*!< Start PDMA, could be NULL */
+} S_I2C_XFER_OPS_T;
+
+typedef struct s_i2c_xfer_bus
+{
+    void *pvPort;                           /*!< Controller, I2C0, I2C1 or UI2C0                             */
+    const S_I2C_XFER_OPS_T *psOps;          /*!< Controller back-end                                         */
+    S_I2C_XFER_T *psCur;                    /*!< Transaction on the bus                                      */
+    S_I2C_XFER_T *psTail;                   /*!< Last queued transaction                                     */
+    uint32_t u32Phase;                      /*!< Position in the current transaction                         */
+    uint32_t u32BusClock;                   /*!< Bus clock restored after recovery                           */
+    uint32_t u32PdmaTxCh;                   /*!< PDMA channel for transmit or \ref I2C_XFER_NO_PDMA          */
+    uint32_t u32PdmaRxCh;                   /*!< PDMA channel for receive or \ref I2C_XFER_NO_PDMA           */
+    uint32_t u32PdmaMin;                    /*!< Shortest payload moved by PDMA                              */
+    I2C_XFER_RECOVER_FUNC pfnRecover;       /*!< Bus clear function, could be NULL                           */
+    void *pvRecoverArg;                     /*!< Argument for the bus clear function                         */
+    uint32_t u32Done;                       /*!< Completed transactions                                      */
+    uint32_t u32Nack;                       /*!< Transactions ended by NACK                                  */
+    uint32_t u32Error;                      /*!< Transactions ended by arbitration loss or bus error         */
+    uint32_t u32Timeout;                    /*!< Bus time-outs, each followed by a recovery                  */
+} S_I2C_XFER_BUS_T;
+
+/*@}*/ /* end of group I2C_XFER_EXPORTED_STRUCTS */
+
+
+/** @addtogroup I2C_XFER_EXPORTED_FUNCTIONS I2C_XFER Exported Functions
+  @{
+*/
+
+/**
+  * @brief      Check if a transaction has finished
+  *
+  * @param[in]  psXfer  The pointer of the transaction.
+  *
+  * @retval     0       Transaction is queued or on the bus
+  * @retval     1       Transaction has finished, i32Status holds the result
+  * \hideinitializer
+  */
+#define I2C_XFER_IS_DONE(psXfer)    (((psXfer)->i32Status <= I2C_XFER_OK) ? 1 : 0)
+
+uint32_t I2C_XFER_Open(S_I2C_XFER_BUS_T *psBus, I2C_T *i2c, uint32_t u32BusClock);
+uint32_t UI2C_XFER_Open(S_I2C_XFER_BUS_T *psBus, UI2C_T *ui2c, uint32_t u32BusClock);
+uint32_t I2C_XFER_OpenBackend(S_I2C_XFER_BUS_T *psBus, void *pvPort, const S_I2C_XFER_OPS_T *psOps, uint32_t u32BusClock);
+void I2C_XFER_Close(S_I2C_XFER_BUS_T *psBus);
+int32_t I2C_XFER_EnablePDMA(S_I2C_XFER_BUS_T *psBus, uint32_t u32TxCh, uint32_t u32RxCh, uint32_t u32MinLen);
+void I2C_XFER_SetRecover(S_I2C_XFER_BUS_T *psBus, I2C_XFER_RECOVER_FUNC pfnRecover, void *pvArg);
+void I2C_XFER_Setup(S_I2C_XFER_T *psXfer, uint8_t u8SlaveAddr, uint16_t u16Reg, uint8_t u8RegLen,
+                    const uint8_t *pu8Tx, uint32_t u32TxLen, uint8_t *pu8Rx, uint32_t u32RxLen);
+int32_t I2C_XFER_Submit(S_I2C_XFER_BUS_T *psBus, S_I2C_XFER_T *psXfer, I2C_XFER_CB pfnDone, void *pvArg);
+int32_t I2C_XFER_Wait(S_I2C_XFER_T *psXfer);
+int32_t I2C_XFER_Transfer(S_I2C_XFER_BUS_T *psBus, S_I2C_XFER_T *psXfer);
+void I2C_XFER_IRQHandler(S_I2C_XFER_BUS_T *psBus);
+
+/*@}*/ /* end of group I2C_XFER_EXPORTED_FUNCTIONS */
+
+/*@}*/ /* end of group I2C_XFER_Driver */
+
+/*@}*/ /* end of group Standard_Driver */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //__I2C_XFER_H__
+
+/*** (C) COPYRIGHT 2021 Nuvoton Technology Corp. ***/
@@ -0,0 +1,102 @@
+/**************************************************************************//**
+ * @file     i2s_stream.h
+ * @version  V1.00
+ * @brief    NUC121 series I2S PDMA streaming header file
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * @copyright (C) 2021 Nuvoton Technology Corp. All rights reserved.
+ *****************************************************************************/
+#ifndef __I2S_STREAM_H__
+#define __I2S_STREAM_H__
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+
+/** @addtogroup Standard_Driver Standard Driver
+  @{
+*/
+
+/** @addtogroup I2S_STREAM_Driver I2S_STREAM Driver
+  @{
+*/
+
+/** @addtogroup I2S_STREAM_EXPORTED_CONSTANTS I2S_STREAM Exported Constants
+  @{
+*/
+#ifndef I2S_STREAM_PERIOD_MAX
+#define I2S_STREAM_PERIOD_MAX       (8UL)   /*!< Descriptors in the PDMA ring                            */
+#endif
+
+#define I2S_STREAM_TX               (0UL)   /*!< Play, memory to I2S                                     */
+#define I2S_STREAM_RX               (1UL)   /*!< Record, I2S to memory                                   */
+
+#define I2S_STREAM_PCM16            (2UL)   /*!< Application samples are int16_t                         */
+#define I2S_STREAM_PCM24            (3UL)   /*!< Application samples are packed 3-byte little endian     */
+#define I2S_STREAM_PCM32            (4UL)   /*!< Application samples are int32_t                         */
+
+/*@}*/ /* end of group I2S_STREAM_EXPORTED_CONSTANTS */
+
+
+/** @addtogroup I2S_STREAM_EXPORTED_STRUCTS I2S_STREAM Exported Structs
+  @{
+*/
+struct s_i2s_stream;
+
+typedef void (*I2S_STREAM_CB)(struct s_i2s_stream *psStream, uint32_t u32Period);   /*!< Period done, interrupt context */
+
+typedef struct s_i2s_stream
+{
+    SPI_T *i2s;                             /*!< I2S opened by \ref I2S_Open                                 */
+    uint32_t u32Dir;                        /*!< \ref I2S_STREAM_TX or \ref I2S_STREAM_RX                    */
+    uint32_t u32PdmaCh;                     /*!< PDMA channel of the ring                                    */
+    uint32_t *pu32Ring;                     /*!< Ring in I2S FIFO word format                                */
+    uint32_t u32PeriodWords;                /*!< Words of one period, one descriptor                         */
+    uint32_t u32PeriodNum;                  /*!< Periods in the ring                                         */
+    uint32_t u32RingWords;                  /*!< u32PeriodWords * u32PeriodNum                               */
+    uint32_t u32SampleBytes;                /*!< I2S word width, 2, 3 or 4 bytes                             */
+    uint32_t u32Channels;                   /*!< 1 for mono, 2 for stereo                                    */
+    uint32_t u32DescCtl;                    /*!< Descriptor control word, restored after each period         */
+    uint32_t u32Period;                     /*!< Period moved by the PDMA now                                */
+    uint32_t u32Off;                        /*!< Next word written by play or read by record                 */
+    volatile uint32_t u32Level;             /*!< Words ahead of the PDMA for play, behind it for record      */
+    volatile uint32_t u32Periods;           /*!< Periods done since start                                    */
+    volatile uint32_t u32Xruns;             /*!< Play underruns or record overruns                           */
+    I2S_STREAM_CB pfnPeriod;                /*!< Period done callback, could be NULL                         */
+    void *pvArg;                            /*!< Argument for the callback                                   */
+    PDMA_DSCT_T asDesc[I2S_STREAM_PERIOD_MAX];  /*!< Scatter-gather ring, one descriptor per period          */
+} S_I2S_STREAM_T;
+
+/*@}*/ /* end of group I2S_STREAM_EXPORTED_STRUCTS */
+
+
+/** @addtogroup I2S_STREAM_EXPORTED_FUNCTIONS I2S_STREAM Exported Functions
+  @{
+*/
+
+int32_t I2S_STREAM_Open(S_I2S_STREAM_T *psStream, SPI_T *i2s, uint32_t u32Dir, uint32_t u32PdmaCh,
+                        uint32_t *pu32Ring, uint32_t u32PeriodWords, uint32_t u32PeriodNum,
+                        I2S_STREAM_CB pfnPeriod, void *pvArg);
+void I2S_STREAM_Start(S_I2S_STREAM_T *psStream);
+void I2S_STREAM_Stop(S_I2S_STREAM_T *psStream);
+uint32_t I2S_STREAM_Write(S_I2S_STREAM_T *psStream, const void *pvPcm, uint32_t u32Frames, uint32_t u32PcmBytes, uint32_t u32PcmCh);
+uint32_t I2S_STREAM_Read(S_I2S_STREAM_T *psStream, void *pvPcm, uint32_t u32Frames, uint32_t u32PcmBytes, uint32_t u32PcmCh);
+uint32_t I2S_STREAM_GetFrames(S_I2S_STREAM_T *psStream);
+uint32_t I2S_STREAM_GetFree(S_I2S_STREAM_T *psStream);
+void I2S_STREAM_IRQHandler(S_I2S_STREAM_T *psStream);
+
+/*@}*/ /* end of group I2S_STREAM_EXPORTED_FUNCTIONS */
+
+/*@}*/ /* end of group I2S_STREAM_Driver */
+
+/*@}*/ /* end of group Standard_Driver */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //__I2S_STREAM_H__
+
+/*** (C) COPYRIGHT 2021 Nuvoton Technology Corp. ***/
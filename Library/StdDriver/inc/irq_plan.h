@@ -0,0 +1,104 @@
+/**************************************************************************//**
+ * @file     irq_plan.h
+ * @version  V1.00
+ * @brief    NUC121 series deadline based interrupt priority planner and latency monitor header file
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * @copyright (C) 2021 Nuvoton Technology Corp. All rights reserved.
+ *****************************************************************************/
+#ifndef __IRQ_PLAN_H__
+#define __IRQ_PLAN_H__
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+
+/** @addtogroup Standard_Driver Standard Driver
+  @{
+*/
+
+/** @addtogroup IRQ_PLAN_Driver IRQ_PLAN Driver
+  @{
+*/
+
+/** @addtogroup IRQ_PLAN_EXPORTED_CONSTANTS IRQ_PLAN Exported Constants
+  @{
+*/
+#define IRQ_PLAN_LEVELS             (1UL << __NVIC_PRIO_BITS)   /*!< NVIC priority levels, 0 is the most urgent */
+
+/*@}*/ /* end of group IRQ_PLAN_EXPORTED_CONSTANTS */
+
+
+/** @addtogroup IRQ_PLAN_EXPORTED_STRUCTS IRQ_PLAN Exported Structs
+  @{
+*/
+typedef struct
+{
+    IRQn_Type eIrq;                         /*!< Interrupt of the entry                                      */
+    const char *pcName;                     /*!< Name in the report                                          */
+    uint32_t u32DeadlineUs;                 /*!< Longest allowed time from the event to the end of the ISR   */
+    uint32_t u32CostUs;                     /*!< Longest run time of the ISR, see \ref IRQ_PLAN_Learn        */
+    uint32_t u32Priority;                   /*!< NVIC priority set by \ref IRQ_PLAN_Apply                    */
+    uint32_t u32BoundUs;                    /*!< Worst response time predicted by \ref IRQ_PLAN_Apply        */
+    uint32_t u32Entry;                      /*!< Timestamp of the last \ref IRQ_PLAN_ENTER                   */
+    uint32_t u32Count;                      /*!< Monitored ISR runs                                          */
+    uint32_t u32MaxTicks;                   /*!< Longest ISR run, nesting included, in ticks of PROF_Open    */
+    uint32_t u32MaxLatencyUs;               /*!< Longest event to entry time, measured by probes only        */
+    uint32_t u32UsScale;                    /*!< Probe ticks to us in 16.16, 0 if the entry is not a probe   */
+} S_IRQ_PLAN_T;
+
+/*@}*/ /* end of group IRQ_PLAN_EXPORTED_STRUCTS */
+
+
+/** @addtogroup IRQ_PLAN_EXPORTED_FUNCTIONS IRQ_PLAN Exported Functions
+  @{
+*/
+
+/**
+  * @brief      Mark the entry of a monitored ISR
+  *
+  * @param[in]  psPlan      The pointer of the plan entry of the ISR.
+  *
+  * @return     None
+  *
+  * @details    First statement of the ISR, timestamps come from PROF_Now of the profiler.
+  * \hideinitializer
+  */
+#define IRQ_PLAN_ENTER(psPlan)      ((psPlan)->u32Entry = PROF_Now())
+
+/**
+  * @brief      Mark the exit of a monitored ISR
+  *
+  * @param[in]  psPlan      The pointer of the plan entry of the ISR.
+  *
+  * @return     None
+  *
+  * @details    Last statement of the ISR.
+  * \hideinitializer
+  */
+#define IRQ_PLAN_EXIT(psPlan)       IRQ_PLAN_Exit((psPlan), PROF_Now())
+
+int32_t IRQ_PLAN_Apply(S_IRQ_PLAN_T *psPlan, uint32_t u32Num);
+void IRQ_PLAN_Exit(S_IRQ_PLAN_T *psPlan, uint32_t u32Now);
+void IRQ_PLAN_Reset(S_IRQ_PLAN_T *psPlan, uint32_t u32Num);
+void IRQ_PLAN_Learn(S_IRQ_PLAN_T *psPlan, uint32_t u32Num, uint32_t u32TickFreq);
+uint32_t IRQ_PLAN_ProbeStart(S_IRQ_PLAN_T *psPlan, TIMER_T *timer, uint32_t u32Freq);
+void IRQ_PLAN_ProbeStop(S_IRQ_PLAN_T *psPlan, TIMER_T *timer);
+void IRQ_PLAN_ProbeEntry(S_IRQ_PLAN_T *psPlan, TIMER_T *timer);
+void IRQ_PLAN_Report(S_IRQ_PLAN_T *psPlan, uint32_t u32Num, uint32_t u32TickFreq);
+
+/*@}*/ /* end of group IRQ_PLAN_EXPORTED_FUNCTIONS */
+
+/*@}*/ /* end of group IRQ_PLAN_Driver */
+
+/*@}*/ /* end of group Standard_Driver */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //__IRQ_PLAN_H__
+
+/*** (C) COPYRIGHT 2021 Nuvoton Technology Corp. ***/
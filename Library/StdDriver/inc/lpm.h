@@ -0,0 +1,87 @@
+/**************************************************************************//**
+ * @file     lpm.h
+ * @version  V1.00
+ * @brief    NUC121 series low power manager header file
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * @copyright (C) 2021 Nuvoton Technology Corp. All rights reserved.
+ *****************************************************************************/
+#ifndef __LPM_H__
+#define __LPM_H__
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+
+/** @addtogroup Standard_Driver Standard Driver
+  @{
+*/
+
+/** @addtogroup LPM_Driver LPM Driver
+  @{
+*/
+
+/** @addtogroup LPM_EXPORTED_CONSTANTS LPM Exported Constants
+  @{
+*/
+#define LPM_MODE_RUN                (0UL)   /*!< Do not sleep, work is pending                      */
+#define LPM_MODE_IDLE               (1UL)   /*!< CPU clock stopped, peripherals keep running        */
+#define LPM_MODE_PD                 (2UL)   /*!< Power-down, only LXT/LIRC clocked logic keeps running */
+
+/*@}*/ /* end of group LPM_EXPORTED_CONSTANTS */
+
+
+/** @addtogroup LPM_EXPORTED_STRUCTS LPM Exported Structs
+  @{
+*/
+typedef uint32_t (*LPM_MODE_FUNC)(void *pvArg);     /*!< Return the deepest mode a device allows right now */
+typedef void (*LPM_CB)(void *pvArg);                /*!< Device suspend or resume function                 */
+
+typedef struct s_lpm_dev
+{
+    struct s_lpm_dev *psNext;               /*!< Next registered device                                      */
+    LPM_MODE_FUNC pfnMode;                  /*!< Busy state, called with interrupts disabled. Could be NULL  */
+    LPM_CB pfnSuspend;                      /*!< Arm wake-up source before power-down. Could be NULL         */
+    LPM_CB pfnResume;                       /*!< Undo pfnSuspend after wake-up. Could be NULL                */
+    void *pvArg;                            /*!< Argument of the device functions                            */
+} S_LPM_DEV_T;
+
+typedef struct
+{
+    uint32_t u32IdleCount;                  /*!< Number of Idle mode entries                                 */
+    uint32_t u32PDCount;                    /*!< Number of Power-down mode entries                           */
+    uint32_t u32TimerWakeCount;             /*!< Power-down exits caused by the timebase                     */
+    uint32_t u32SleepTime;                  /*!< Timebase counts spent in Idle and Power-down mode           */
+    uint32_t u32LastWakeLatency;            /*!< Timebase counts from the deadline to resume, last timer wake */
+    uint32_t u32MaxWakeLatency;             /*!< Longest wake-up latency in timebase counts                  */
+} S_LPM_STAT_T;
+
+/*@}*/ /* end of group LPM_EXPORTED_STRUCTS */
+
+
+/** @addtogroup LPM_EXPORTED_FUNCTIONS LPM Exported Functions
+  @{
+*/
+
+void LPM_Init(TIMER_T *timer, uint32_t u32MinPDTime);
+void LPM_RegisterDevice(S_LPM_DEV_T *psDev, LPM_MODE_FUNC pfnMode, LPM_CB pfnSuspend, LPM_CB pfnResume, void *pvArg);
+void LPM_UnregisterDevice(S_LPM_DEV_T *psDev);
+uint32_t LPM_GetMode(void);
+uint32_t LPM_Sleep(void);
+const S_LPM_STAT_T *LPM_GetStat(void);
+
+/*@}*/ /* end of group LPM_EXPORTED_FUNCTIONS */
+
+/*@}*/ /* end of group LPM_Driver */
+
+/*@}*/ /* end of group Standard_Driver */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //__LPM_H__
+
+/*** (C) COPYRIGHT 2021 Nuvoton Technology Corp. ***/
@@ -0,0 +1,133 @@
+/**************************************************************************//**
+ * @file     nau8822.h
+ * @version  V1.00
+ * @brief    NUC121 series NAU8822 audio codec driver header file
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * @copyright (C) 2021 Nuvoton Technology Corp. All rights reserved.
+ *****************************************************************************/
+#ifndef __NAU8822_H__
+#define __NAU8822_H__
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+
+/** @addtogroup Standard_Driver Standard Driver
+  @{
+*/
+
+/** @addtogroup NAU8822_Driver NAU8822 Driver
+  @{
+*/
+
+/** @addtogroup NAU8822_EXPORTED_CONSTANTS NAU8822 Exported Constants
+  @{
+*/
+#define NAU8822_SLAVE_ADDR          (0x1AUL)    /*!< 7-bit I2C address                                       */
+#define NAU8822_REG_NUM             (80UL)      /*!< Registers R0 up to R79                                  */
+#define NAU8822_MCLK                (12000000UL)    /*!< MCLK input the PLL tables are computed for          */
+
+#define NAU8822_R_RESET             (0UL)   /*!< Software reset                                              */
+#define NAU8822_R_POWER1            (1UL)   /*!< Power management 1                                          */
+#define NAU8822_R_POWER2            (2UL)   /*!< Power management 2                                          */
+#define NAU8822_R_POWER3            (3UL)   /*!< Power management 3                                          */
+#define NAU8822_R_AUDIO_IF          (4UL)   /*!< Audio interface, word length and format                     */
+#define NAU8822_R_COMPAND           (5UL)   /*!< Companding and loop back                                    */
+#define NAU8822_R_CLOCK1            (6UL)   /*!< Clock source, MCLK and BCLK dividers, master mode           */
+#define NAU8822_R_CLOCK2            (7UL)   /*!< Filter sample rate                                          */
+#define NAU8822_R_DAC_CTL           (10UL)  /*!< DAC control                                                 */
+#define NAU8822_R_DAC_VOL_L         (11UL)  /*!< Left DAC volume                                             */
+#define NAU8822_R_DAC_VOL_R         (12UL)  /*!< Right DAC volume                                            */
+#define NAU8822_R_ADC_CTL           (14UL)  /*!< ADC control                                                 */
+#define NAU8822_R_ADC_VOL_L         (15UL)  /*!< Left ADC volume                                             */
+#define NAU8822_R_ADC_VOL_R         (16UL)  /*!< Right ADC volume                                            */
+#define NAU8822_R_PLL_N             (36UL)  /*!< PLL integer part and MCLK divide by 2                       */
+#define NAU8822_R_PLL_K1            (37UL)  /*!< PLL fraction bits 23..18                                    */
+#define NAU8822_R_PLL_K2            (38UL)  /*!< PLL fraction bits 17..9                                     */
+#define NAU8822_R_PLL_K3            (39UL)  /*!< PLL fraction bits 8..0                                      */
+#define NAU8822_R_PGA_L             (45UL)  /*!< Left input PGA gain                                         */
+#define NAU8822_R_PGA_R             (46UL)  /*!< Right input PGA gain                                        */
+#define NAU8822_R_BOOST_L           (47UL)  /*!< Left ADC boost                                              */
+#define NAU8822_R_BOOST_R           (48UL)  /*!< Right ADC boost                                             */
+#define NAU8822_R_OUT_CTL           (49UL)  /*!< Output control                                              */
+#define NAU8822_R_MIX_L             (50UL)  /*!< Left main mixer                                             */
+#define NAU8822_R_MIX_R             (51UL)  /*!< Right main mixer                                            */
+#define NAU8822_R_HP_VOL_L          (52UL)  /*!< Left headphone volume                                       */
+#define NAU8822_R_HP_VOL_R          (53UL)  /*!< Right headphone volume                                      */
+#define NAU8822_R_SPK_VOL_L         (54UL)  /*!< Left speaker volume                                         */
+#define NAU8822_R_SPK_VOL_R         (55UL)  /*!< Right speaker volume                                        */
+
+#define NAU8822_VU                  (0x100UL)   /*!< Volume update bit of the right register of a pair      */
+#define NAU8822_MUTE                (0x040UL)   /*!< Mute bit of the headphone and speaker volumes          */
+
+#define NAU8822_TRIM_NONE           (0L)    /*!< Nominal PLL                                                 */
+#define NAU8822_TRIM_UP             (1L)    /*!< PLL 0.5 % faster                                            */
+#define NAU8822_TRIM_DOWN           (-1L)   /*!< PLL 0.5 % slower                                            */
+
+#define NAU8822_ERR_RATE            (-30L)  /*!< Sample rate or word length not supported                    */
+
+/*@}*/ /* end of group NAU8822_EXPORTED_CONSTANTS */
+
+
+/** @addtogroup NAU8822_EXPORTED_STRUCTS NAU8822 Exported Structs
+  @{
+*/
+typedef struct
+{
+    S_I2C_XFER_BUS_T *psBus;                /*!< Queued master the codec is connected to                     */
+    S_I2C_XFER_T sXfer;                     /*!< Register write on the bus                                   */
+    uint8_t u8Data;                         /*!< Data bits 7..0, the register number and bit 8 go first      */
+    uint8_t u8Reg;                          /*!< Register of the write on the bus                            */
+    volatile uint8_t u8Busy;                /*!< A register write is on the bus                              */
+    uint16_t au16Shadow[NAU8822_REG_NUM];   /*!< Last value written to each register                         */
+    uint32_t au32Known[(NAU8822_REG_NUM + 31UL) / 32UL];    /*!< Shadow value matches the codec              */
+    volatile uint32_t au32Dirty[(NAU8822_REG_NUM + 31UL) / 32UL];   /*!< Shadow value waits for the bus      */
+    uint32_t u32PllFamily;                  /*!< PLL table row of the sample rate                            */
+    uint32_t u32Writes;                     /*!< Register writes sent                                        */
+    uint32_t u32Skips;                      /*!< Register writes dropped because nothing changed             */
+    uint32_t u32Errors;                     /*!< Register writes that failed on the bus                      */
+} S_NAU8822_T;
+
+/*@}*/ /* end of group NAU8822_EXPORTED_STRUCTS */
+
+
+/** @addtogroup NAU8822_EXPORTED_FUNCTIONS NAU8822 Exported Functions
+  @{
+*/
+
+/**
+  * @brief      Check if all register writes have reached the codec
+  *
+  * @param[in]  psCodec The pointer of the codec context.
+  *
+  * @retval     0       Writes are queued or on the bus
+  * @retval     1       Codec registers match the shadow
+  * \hideinitializer
+  */
+#define NAU8822_IS_IDLE(psCodec)    ((psCodec)->u8Busy ? 0 : 1)
+
+int32_t NAU8822_Open(S_NAU8822_T *psCodec, S_I2C_XFER_BUS_T *psBus);
+void NAU8822_WriteReg(S_NAU8822_T *psCodec, uint32_t u32Reg, uint32_t u32Value);
+void NAU8822_UpdateBits(S_NAU8822_T *psCodec, uint32_t u32Reg, uint32_t u32Mask, uint32_t u32Value);
+uint32_t NAU8822_ReadReg(S_NAU8822_T *psCodec, uint32_t u32Reg);
+void NAU8822_WritePair(S_NAU8822_T *psCodec, uint32_t u32RegL, uint32_t u32Left, uint32_t u32Right);
+int32_t NAU8822_SetFormat(S_NAU8822_T *psCodec, uint32_t u32SampleRate, uint32_t u32WordWidth);
+void NAU8822_TrimPll(S_NAU8822_T *psCodec, int32_t i32Trim);
+void NAU8822_Sync(S_NAU8822_T *psCodec);
+
+/*@}*/ /* end of group NAU8822_EXPORTED_FUNCTIONS */
+
+/*@}*/ /* end of group NAU8822_Driver */
+
+/*@}*/ /* end of group Standard_Driver */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //__NAU8822_H__
+
+/*** (C) COPYRIGHT 2021 Nuvoton Technology Corp. ***/
@@ -0,0 +1,127 @@
+/**************************************************************************//**
+ * @file     prof.h
+ * @version  V1.00
+ * @brief    NUC121 series timing probe and PC sampling profiler header file
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * @copyright (C) 2021 Nuvoton Technology Corp. All rights reserved.
+ *****************************************************************************/
+#ifndef __PROF_H__
+#define __PROF_H__
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+
+/** @addtogroup Standard_Driver Standard Driver
+  @{
+*/
+
+/** @addtogroup PROF_Driver PROF Driver
+  @{
+*/
+
+/** @addtogroup PROF_EXPORTED_CONSTANTS PROF Exported Constants
+  @{
+*/
+/*
+    Define PROF_USE_SAMPLER for the whole project to build the PC sampler. This driver then owns the IRQ handler
+    of TIMER PROF_SAMPLE_TIMER_NUM, without it the vector stays with the application.
+*/
+#ifndef PROF_SAMPLE_TIMER_NUM
+#define PROF_SAMPLE_TIMER_NUM       3       /*!< TIMER of the PC sampler, its IRQ handler is part of this driver */
+#endif
+
+#define PROF_CNT_MSK                (0x00FFFFFFUL)  /*!< Timestamps are 24-bit and wrap                      */
+
+/*@}*/ /* end of group PROF_EXPORTED_CONSTANTS */
+
+
+/** @addtogroup PROF_EXPORTED_STRUCTS PROF Exported Structs
+  @{
+*/
+typedef struct s_prof_probe
+{
+    struct s_prof_probe *psNext;            /*!< Next probe of the report                                    */
+    const char *pcName;                     /*!< Name in the report                                          */
+    uint32_t u32Start;                      /*!< Timestamp of the last \ref PROF_ENTER                       */
+    uint32_t u32Count;                      /*!< Measured scopes                                             */
+    uint32_t u32Min;                        /*!< Shortest scope in ticks                                     */
+    uint32_t u32Max;                        /*!< Longest scope in ticks                                      */
+    uint64_t u64Sum;                        /*!< Sum of all scopes in ticks                                  */
+} S_PROF_PROBE_T;
+
+/*@}*/ /* end of group PROF_EXPORTED_STRUCTS */
+
+
+/** @addtogroup PROF_EXPORTED_FUNCTIONS PROF Exported Functions
+  @{
+*/
+
+/// @cond HIDDEN_SYMBOLS
+extern volatile uint32_t *g_pu32ProfCnt;
+extern uint32_t g_u32ProfXor;
+/// @endcond HIDDEN_SYMBOLS
+
+/**
+  * @brief      Read the profiling timestamp
+  *
+  * @return     24-bit up counting timestamp in ticks of \ref PROF_Open
+  *
+  * @details    SysTick counts down, it is inverted so both sources count up.
+  */
+__STATIC_INLINE uint32_t PROF_Now(void)
+{
+    return ((*g_pu32ProfCnt ^ g_u32ProfXor) & PROF_CNT_MSK);
+}
+
+/**
+  * @brief      Start a measured scope
+  *
+  * @param[in]  psProbe     The pointer of the probe.
+  *
+  * @return     None
+  *
+  * @details    A probe measures one scope at a time, use one probe per interrupt level.
+  * \hideinitializer
+  */
+#define PROF_ENTER(psProbe)         ((psProbe)->u32Start = PROF_Now())
+
+/**
+  * @brief      End a measured scope
+  *
+  * @param[in]  psProbe     The pointer of the probe.
+  *
+  * @return     None
+  *
+  * @details    Scopes must be shorter than 2^24 ticks.
+  * \hideinitializer
+  */
+#define PROF_EXIT(psProbe)          PROF_Exit((psProbe), PROF_Now())
+
+uint32_t PROF_Open(TIMER_T *timer);
+void PROF_AddProbe(S_PROF_PROBE_T *psProbe, const char *pcName);
+void PROF_Exit(S_PROF_PROBE_T *psProbe, uint32_t u32Now);
+void PROF_ResetProbes(void);
+#ifdef PROF_USE_SAMPLER
+uint32_t PROF_SampleStart(uint32_t u32Freq, uint16_t *pu16Hist, uint32_t u32Buckets, uint32_t u32Shift);
+void PROF_SampleStop(void);
+#endif
+void PROF_SamplePC(uint32_t u32PC);
+void PROF_Report(void);
+
+/*@}*/ /* end of group PROF_EXPORTED_FUNCTIONS */
+
+/*@}*/ /* end of group PROF_Driver */
+
+/*@}*/ /* end of group Standard_Driver */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //__PROF_H__
+
+/*** (C) COPYRIGHT 2021 Nuvoton Technology Corp. ***/
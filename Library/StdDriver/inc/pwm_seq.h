@@ -0,0 +1,112 @@
+/**************************************************************************//**
+ * @file     pwm_seq.h
+ * @version  V1.00
+ * @brief    NUC121 series PWM/BPWM waveform sequencer header file
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * @copyright (C) 2021 Nuvoton Technology Corp. All rights reserved.
+ *****************************************************************************/
+#ifndef __PWM_SEQ_H__
+#define __PWM_SEQ_H__
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+
+/** @addtogroup Standard_Driver Standard Driver
+  @{
+*/
+
+/** @addtogroup PWM_SEQ_Driver PWM Waveform Sequencer Driver
+  @{
+*/
+
+/** @addtogroup PWM_SEQ_EXPORTED_CONSTANTS PWM Waveform Sequencer Exported Constants
+  @{
+*/
+#define PWM_SEQ_ONESHOT             (0UL)       /*!< Stop after the last step of the table is loaded */
+#define PWM_SEQ_REPEAT              (1UL)       /*!< Restart from the first step after the last one  */
+
+#define PWM_SEQ_DUTY_FULL           (1000UL)    /*!< Duty value of 100%, duty is given in 0.1% units */
+
+#define PWM_SEQ_MAX_PRESCALE        (0x1000UL)  /*!< Largest clock divider supported by CLKPSC       */
+#define PWM_SEQ_MAX_PERIOD          (0x10000UL) /*!< Largest counter length supported by PERIOD      */
+
+/*@}*/ /* end of group PWM_SEQ_EXPORTED_CONSTANTS */
+
+
+/** @addtogroup PWM_SEQ_EXPORTED_STRUCTS PWM Waveform Sequencer Exported Structs
+  @{
+*/
+typedef void (*PWM_SEQ_CB)(void);           /*!< Functional pointer type declaration for sequence end callback */
+
+typedef struct s_pwm_seq_table
+{
+    const uint16_t *pu16Period;             /*!< PERIOD register value of each step. NULL for fixed period */
+    const uint16_t *pu16Cmp;                /*!< CMPDAT register value of each step                        */
+    uint16_t u16Prescale;                   /*!< CLKPSC register value shared by all steps                 */
+    uint16_t u16Period;                     /*!< PERIOD register value used when pu16Period is NULL        */
+    uint32_t u32Steps;                      /*!< Number of steps in the table                              */
+} S_PWM_SEQ_TABLE_T;
+
+typedef struct s_pwm_seq
+{
+    __IO uint32_t *pu32Period;              /*!< PERIOD register of the sequenced channel                  */
+    __IO uint32_t *pu32Cmp;                 /*!< CMPDAT register of the sequenced channel                  */
+    __IO uint32_t *pu32Prescale;            /*!< CLKPSC register of the sequenced channel                  */
+    __IO uint32_t *pu32Ctl0;                /*!< CTL0 register of the PWM/BPWM module                      */
+    __IO uint32_t *pu32IntEn;               /*!< INTEN0/INTEN register of the PWM/BPWM module              */
+    __IO uint32_t *pu32IntSts;              /*!< INTSTS0 register of the PWM/BPWM module                   */
+    uint32_t u32PeriodIntMsk;               /*!< Period interrupt enable/flag bit of the channel           */
+    uint32_t u32LoadModeMsk;                /*!< Immediate and center load mode bits of the channel        */
+    const S_PWM_SEQ_TABLE_T *psTable;       /*!< Table being played                                        */
+    uint32_t u32Mode;                       /*!< \ref PWM_SEQ_ONESHOT or \ref PWM_SEQ_REPEAT                */
+    volatile uint32_t u32Index;             /*!< Index of the next step to be loaded                       */
+    volatile uint32_t u32Busy;              /*!< 1 while the sequence is playing                           */
+    PWM_SEQ_CB pfnDone;                     /*!< Called from IRQ when a one-shot sequence completes        */
+} S_PWM_SEQ_T;
+
+/*@}*/ /* end of group PWM_SEQ_EXPORTED_STRUCTS */
+
+
+/** @addtogroup PWM_SEQ_EXPORTED_FUNCTIONS PWM Waveform Sequencer Exported Functions
+  @{
+*/
+
+/**
+  * @brief      Check if a sequence is still playing
+  *
+  * @param[in]  psSeq       The pointer of the sequencer control block.
+  *
+  * @retval     0   Sequence is stopped or has completed
+  * @retval     1   Sequence is playing
+  *
+  * \hideinitializer
+  */
+#define PWM_SEQ_IS_BUSY(psSeq)      ((psSeq)->u32Busy)
+
+int32_t PWM_SEQ_BuildTable(uint32_t u32ClkFreq, const uint32_t au32Freq[], const uint16_t au16Duty[], uint32_t u32Steps,
+                           uint16_t au16Period[], uint16_t au16Cmp[], S_PWM_SEQ_TABLE_T *psTable);
+int32_t PWM_SEQ_ValidateTable(const S_PWM_SEQ_TABLE_T *psTable);
+void PWM_SEQ_InitPWM(S_PWM_SEQ_T *psSeq, PWM_T *pwm, uint32_t u32ChannelNum);
+void PWM_SEQ_InitBPWM(S_PWM_SEQ_T *psSeq, BPWM_T *bpwm, uint32_t u32ChannelNum);
+void PWM_SEQ_Start(S_PWM_SEQ_T *psSeq, const S_PWM_SEQ_TABLE_T *psTable, uint32_t u32Mode, PWM_SEQ_CB pfnDone);
+void PWM_SEQ_Stop(S_PWM_SEQ_T *psSeq);
+void PWM_SEQ_IRQHandler(S_PWM_SEQ_T *psSeq);
+int32_t PWM_SEQ_StartPDMA(S_PWM_SEQ_T *psSeq, const S_PWM_SEQ_TABLE_T *psTable, uint32_t u32Ch, TIMER_T *timer, uint32_t u32ClkFreq);
+
+/*@}*/ /* end of group PWM_SEQ_EXPORTED_FUNCTIONS */
+
+/*@}*/ /* end of group PWM_SEQ_Driver */
+
+/*@}*/ /* end of group Standard_Driver */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //__PWM_SEQ_H__
+
+/*** (C) COPYRIGHT 2021 Nuvoton Technology Corp. ***/
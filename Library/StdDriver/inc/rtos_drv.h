@@ -0,0 +1,111 @@
+/**************************************************************************//**
+ * @file     rtos_drv.h
+ * @version  V1.00
+ * @brief    NUC121 series CMSIS-RTOS2 RTX driver wrappers and tickless idle header file
+ *
+ * @note     Not part of NuMicro.h, include it after NuMicro.h in projects that build CMSIS-RTOS2 RTX.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * @copyright (C) 2021 Nuvoton Technology Corp. All rights reserved.
+ *****************************************************************************/
+#ifndef __RTOS_DRV_H__
+#define __RTOS_DRV_H__
+
+#include "cmsis_os2.h"
+#include "rtx_os.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+
+/** @addtogroup Standard_Driver Standard Driver
+  @{
+*/
+
+/** @addtogroup RTOS_DRV_Driver RTOS_DRV Driver
+  @{
+*/
+
+/** @addtogroup RTOS_DRV_EXPORTED_CONSTANTS RTOS_DRV Exported Constants
+  @{
+*/
+#define RTOS_THREAD_FLAG_I2C        (0x40000000UL)  /*!< Thread flag \ref RTOS_I2C_Transfer waits for, keep it free   */
+
+#define RTOS_ERR_TIMEOUT            (-70L)          /*!< Nothing was transferred before the time-out                 */
+#define RTOS_ERR_OS                 (-71L)          /*!< A kernel object could not be created or used                */
+
+/*@}*/ /* end of group RTOS_DRV_EXPORTED_CONSTANTS */
+
+
+/** @addtogroup RTOS_DRV_EXPORTED_STRUCTS RTOS_DRV Exported Structs
+  @{
+*/
+typedef struct
+{
+    UART_T *uart;                           /*!< UART of the wrapper                                         */
+    osMutexId_t sTxLock;                    /*!< Serialises writers                                          */
+    osMutexId_t sRxLock;                    /*!< Serialises readers                                          */
+    osEventFlagsId_t sFlags;                /*!< Completion flags set by \ref RTOS_UART_IRQHandler           */
+    const uint8_t *pu8Tx;                   /*!< Next byte to send                                           */
+    volatile uint32_t u32TxLeft;            /*!< Bytes still to load into the FIFO                           */
+    uint8_t *pu8Rx;                         /*!< Next byte to receive                                        */
+    volatile uint32_t u32RxLeft;            /*!< Bytes still to receive                                      */
+    uint32_t au32TxLockCb[(osRtxMutexCbSize + 3) / 4];     /*!< Control block of sTxLock                     */
+    uint32_t au32RxLockCb[(osRtxMutexCbSize + 3) / 4];     /*!< Control block of sRxLock                     */
+    uint32_t au32FlagsCb[(osRtxEventFlagsCbSize + 3) / 4]; /*!< Control block of sFlags                      */
+} S_RTOS_UART_T;
+
+typedef struct
+{
+    SPI_T *spi;                             /*!< SPI of the wrapper                                          */
+    osMutexId_t sLock;                      /*!< Recursive bus lock, held across a chip select if needed     */
+    osEventFlagsId_t sFlags;                /*!< Completion flag set by \ref RTOS_SPI_IRQHandler             */
+    const uint8_t *pu8Tx;                   /*!< Next byte to send, NULL sends 0xFF                          */
+    uint8_t *pu8Rx;                         /*!< Next byte to receive, NULL drops it                         */
+    volatile uint32_t u32Left;              /*!< Frames still to transfer                                    */
+    uint32_t au32LockCb[(osRtxMutexCbSize + 3) / 4];       /*!< Control block of sLock                       */
+    uint32_t au32FlagsCb[(osRtxEventFlagsCbSize + 3) / 4]; /*!< Control block of sFlags                      */
+} S_RTOS_SPI_T;
+
+typedef struct
+{
+    uint32_t u32IdleCount;                  /*!< Idle mode entries of the idle thread                        */
+    uint32_t u32PDCount;                    /*!< Power-down mode entries of the idle thread                  */
+    uint32_t u32SleptTicks;                 /*!< Kernel ticks spent asleep without SysTick                   */
+} S_RTOS_IDLE_STAT_T;
+
+/*@}*/ /* end of group RTOS_DRV_EXPORTED_STRUCTS */
+
+
+/** @addtogroup RTOS_DRV_EXPORTED_FUNCTIONS RTOS_DRV Exported Functions
+  @{
+*/
+
+int32_t RTOS_UART_Open(S_RTOS_UART_T *psUart, UART_T *uart, uint32_t u32Baudrate);
+int32_t RTOS_UART_Write(S_RTOS_UART_T *psUart, const void *pvBuf, uint32_t u32Len, uint32_t u32Timeout);
+int32_t RTOS_UART_Read(S_RTOS_UART_T *psUart, void *pvBuf, uint32_t u32Len, uint32_t u32Timeout);
+void RTOS_UART_IRQHandler(S_RTOS_UART_T *psUart);
+int32_t RTOS_SPI_Open(S_RTOS_SPI_T *psSpi, SPI_T *spi, uint32_t u32SPIMode, uint32_t u32BusClock);
+int32_t RTOS_SPI_Acquire(S_RTOS_SPI_T *psSpi, uint32_t u32Timeout);
+void RTOS_SPI_Release(S_RTOS_SPI_T *psSpi);
+int32_t RTOS_SPI_Transfer(S_RTOS_SPI_T *psSpi, const void *pvTx, void *pvRx, uint32_t u32Len, uint32_t u32Timeout);
+void RTOS_SPI_IRQHandler(S_RTOS_SPI_T *psSpi);
+int32_t RTOS_I2C_Transfer(S_I2C_XFER_BUS_T *psBus, S_I2C_XFER_T *psXfer);
+void RTOS_TicklessInit(TIMER_T *timer, uint32_t u32MinPDTicks);
+const S_RTOS_IDLE_STAT_T *RTOS_GetIdleStat(void);
+
+/*@}*/ /* end of group RTOS_DRV_EXPORTED_FUNCTIONS */
+
+/*@}*/ /* end of group RTOS_DRV_Driver */
+
+/*@}*/ /* end of group Standard_Driver */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //__RTOS_DRV_H__
+
+/*** (C) COPYRIGHT 2021 Nuvoton Technology Corp. ***/
@@ -0,0 +1,90 @@
+/**************************************************************************//**
+ * @file     sched.h
+ * @version  V1.00
+ * @brief    NUC121 series cooperative run-to-completion event scheduler header file
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * @copyright (C) 2021 Nuvoton Technology Corp. All rights reserved.
+ *****************************************************************************/
+#ifndef __SCHED_H__
+#define __SCHED_H__
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+
+/** @addtogroup Standard_Driver Standard Driver
+  @{
+*/
+
+/** @addtogroup SCHED_Driver SCHED Driver
+  @{
+*/
+
+/** @addtogroup SCHED_EXPORTED_CONSTANTS SCHED Exported Constants
+  @{
+*/
+#ifndef SCHED_PRIO_NUM
+#define SCHED_PRIO_NUM              (4UL)           /*!< Event priorities, 0 is handled first               */
+#endif
+
+#define SCHED_FLAG_POST             (0x00000001UL)  /*!< Flag of a plain post                               */
+#define SCHED_FLAG_TIMER            (0x80000000UL)  /*!< Flag posted by \ref SCHED_PostFromTimer            */
+
+/*@}*/ /* end of group SCHED_EXPORTED_CONSTANTS */
+
+
+/** @addtogroup SCHED_EXPORTED_STRUCTS SCHED Exported Structs
+  @{
+*/
+typedef void (*SCHED_FUNC)(void *pvArg, uint32_t u32Flags); /*!< Event handler, gets the flags posted since its last run */
+typedef void (*SCHED_IDLE_FUNC)(void);                      /*!< Idle hook, called with PRIMASK set                      */
+
+typedef struct s_sched_event
+{
+    struct s_sched_event *psNext;           /*!< Next queued event of the same priority                      */
+    SCHED_FUNC pfnHandler;                  /*!< Run by the scheduler, never from interrupt context          */
+    void *pvArg;                            /*!< Argument passed to pfnHandler                               */
+    uint32_t u32Prio;                       /*!< Queue of the event, below \ref SCHED_PRIO_NUM               */
+    volatile uint32_t u32Flags;             /*!< Flags posted and not handled yet, not 0 while queued        */
+} S_SCHED_EVENT_T;
+
+typedef struct
+{
+    uint32_t u32Posted;                     /*!< Posts that queued an event                                  */
+    uint32_t u32Merged;                     /*!< Posts merged into an event already queued                   */
+    uint32_t u32Handled;                    /*!< Handler runs                                                */
+    uint32_t u32IdleCount;                  /*!< Idle hook calls                                             */
+} S_SCHED_STAT_T;
+
+/*@}*/ /* end of group SCHED_EXPORTED_STRUCTS */
+
+
+/** @addtogroup SCHED_EXPORTED_FUNCTIONS SCHED Exported Functions
+  @{
+*/
+
+void SCHED_InitEvent(S_SCHED_EVENT_T *psEvent, SCHED_FUNC pfnHandler, void *pvArg, uint32_t u32Prio);
+void SCHED_Post(S_SCHED_EVENT_T *psEvent, uint32_t u32Flags);
+void SCHED_PostFromTimer(void *pvArg);
+void SCHED_Cancel(S_SCHED_EVENT_T *psEvent);
+uint32_t SCHED_RunOnce(void);
+void SCHED_Run(void);
+void SCHED_SetIdleHook(SCHED_IDLE_FUNC pfnIdle);
+const S_SCHED_STAT_T *SCHED_GetStat(void);
+
+/*@}*/ /* end of group SCHED_EXPORTED_FUNCTIONS */
+
+/*@}*/ /* end of group SCHED_Driver */
+
+/*@}*/ /* end of group Standard_Driver */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //__SCHED_H__
+
+/*** (C) COPYRIGHT 2021 Nuvoton Technology Corp. ***/
@@ -0,0 +1,74 @@
+/**************************************************************************//**
+ * @file     semihost.h
+ * @version  V1.00
+ * @brief    NUC121 series buffered semihost file I/O header file
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * @copyright (C) 2021 Nuvoton Technology Corp. All rights reserved.
+ *****************************************************************************/
+#ifndef __SEMIHOST_H__
+#define __SEMIHOST_H__
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+
+/** @addtogroup Standard_Driver Standard Driver
+  @{
+*/
+
+/** @addtogroup SEMIHOST_Driver SEMIHOST Driver
+  @{
+*/
+
+/** @addtogroup SEMIHOST_EXPORTED_CONSTANTS SEMIHOST Exported Constants
+  @{
+*/
+#ifndef SEMIHOST_BUF_SIZE
+#define SEMIHOST_BUF_SIZE           (256UL) /*!< Bytes collected by \ref SEMIHOST_StreamWrite per SYS_WRITE     */
+#endif
+
+#define SEMIHOST_MODE_READ          (1UL)   /*!< Open a file for reading, "rb"                                   */
+#define SEMIHOST_MODE_WRITE         (5UL)   /*!< Create or truncate a file for writing, "wb"                     */
+#define SEMIHOST_MODE_APPEND        (9UL)   /*!< Open or create a file for appending, "ab"                       */
+
+#define SEMIHOST_CONSOLE            ":tt"   /*!< File name of the debugger console                               */
+
+#define SEMIHOST_ERR_NO_HOST        (-60L)  /*!< No debugger attached or DEBUG_ENABLE_SEMIHOST not defined       */
+#define SEMIHOST_ERR_IO             (-61L)  /*!< The host refused the operation                                  */
+
+/*@}*/ /* end of group SEMIHOST_EXPORTED_CONSTANTS */
+
+
+/** @addtogroup SEMIHOST_EXPORTED_FUNCTIONS SEMIHOST Exported Functions
+  @{
+*/
+
+int32_t SEMIHOST_Open(void);
+int32_t SEMIHOST_IsAttached(void);
+uint32_t SEMIHOST_GetTrapCount(void);
+int32_t SEMIHOST_FileOpen(const char *pcName, uint32_t u32Mode);
+int32_t SEMIHOST_FileClose(int32_t i32Handle);
+int32_t SEMIHOST_FileRead(int32_t i32Handle, void *pvBuf, uint32_t u32Len);
+int32_t SEMIHOST_FileWrite(int32_t i32Handle, const void *pvBuf, uint32_t u32Len);
+int32_t SEMIHOST_FileLength(int32_t i32Handle);
+int32_t SEMIHOST_StreamOpen(const char *pcName);
+void SEMIHOST_StreamWrite(const void *pvBuf, uint32_t u32Len);
+void SEMIHOST_StreamFlush(void);
+void SEMIHOST_StreamClose(void);
+
+/*@}*/ /* end of group SEMIHOST_EXPORTED_FUNCTIONS */
+
+/*@}*/ /* end of group SEMIHOST_Driver */
+
+/*@}*/ /* end of group Standard_Driver */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //__SEMIHOST_H__
+
+/*** (C) COPYRIGHT 2021 Nuvoton Technology Corp. ***/
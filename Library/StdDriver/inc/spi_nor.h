@@ -0,0 +1,117 @@
+/**************************************************************************//**
+ * @file     spi_nor.h
+ * @version  V1.00
+ * @brief    NUC121 series SPI NOR flash driver header file
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * @copyright (C) 2021 Nuvoton Technology Corp. All rights reserved.
+ *****************************************************************************/
+#ifndef __SPI_NOR_H__
+#define __SPI_NOR_H__
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+
+/** @addtogroup Standard_Driver Standard Driver
+  @{
+*/
+
+/** @addtogroup SPI_NOR_Driver SPI_NOR Driver
+  @{
+*/
+
+/** @addtogroup SPI_NOR_EXPORTED_CONSTANTS SPI_NOR Exported Constants
+  @{
+*/
+#define SPI_NOR_PAGE_SIZE           (256UL)     /*!< Page program size                                       */
+#define SPI_NOR_SECTOR_SIZE         (4096UL)    /*!< Smallest erase unit                                     */
+#define SPI_NOR_BLOCK64_SIZE        (65536UL)   /*!< Large erase unit                                        */
+#define SPI_NOR_BLOCK_SIZE          (512UL)     /*!< Block of the block device interface                     */
+#define SPI_NOR_SIZE_MAX            (0x1000000UL)   /*!< 3-byte addressing limit                             */
+
+#ifndef SPI_NOR_DESC_NUM
+#define SPI_NOR_DESC_NUM            (4UL)   /*!< Scatter-gather descriptors loaded into the PDMA at once     */
+#endif
+
+#define SPI_NOR_PDMA_MIN            (16UL)  /*!< Shorter transfers are moved by the CPU                      */
+#define SPI_NOR_PDMA_MAX            (0x4000UL)  /*!< Frames of one PDMA transfer                             */
+#define SPI_NOR_NO_PDMA             (0xFFFFFFFFUL)  /*!< No PDMA channel                                     */
+#define SPI_NOR_POLL_MAX            (2000000UL) /*!< Default status reads before a time-out                  */
+
+#define SPI_NOR_ERR_ID              (-20L)  /*!< No JEDEC device or unsupported capacity                     */
+#define SPI_NOR_ERR_RANGE           (-21L)  /*!< Access beyond the end of the device                         */
+#define SPI_NOR_ERR_BUSY            (-22L)  /*!< Program or erase did not end within the poll limit          */
+#define SPI_NOR_ERR_ALIGN           (-23L)  /*!< Erase range is not sector aligned                           */
+
+/*@}*/ /* end of group SPI_NOR_EXPORTED_CONSTANTS */
+
+
+/** @addtogroup SPI_NOR_EXPORTED_STRUCTS SPI_NOR Exported Structs
+  @{
+*/
+typedef struct
+{
+    uint8_t *pu8Buf;                        /*!< Destination, NULL skips the bytes                           */
+    uint32_t u32Len;                        /*!< Number of bytes                                             */
+} S_SPI_NOR_SG_T;
+
+typedef struct
+{
+    SPI_T *spi;                             /*!< SPI master the device is connected to                       */
+    uint32_t u32TxCh;                       /*!< PDMA channel for SPI TX, \ref SPI_NOR_NO_PDMA for none      */
+    uint32_t u32RxCh;                       /*!< PDMA channel for SPI RX                                     */
+    uint8_t au8Id[3];                       /*!< JEDEC manufacturer, memory type and capacity                */
+    uint8_t u8Busy;                         /*!< Program or erase may be in progress                         */
+    uint32_t u32Size;                       /*!< Device size in bytes                                        */
+    uint32_t u32PollMax;                    /*!< Status reads before \ref SPI_NOR_ERR_BUSY                   */
+    uint32_t u32EraseNext;                  /*!< Next sector of the erase-ahead queue                        */
+    uint32_t u32EraseEnd;                   /*!< End of the erase-ahead queue                                */
+    uint32_t u32BlankStart;                 /*!< Start of the range known to be erased                       */
+    uint32_t u32BlankEnd;                   /*!< End of the range known to be erased                         */
+    uint8_t *pu8Cache;                      /*!< Write-behind sector of the block device                     */
+    uint32_t u32CacheAddr;                  /*!< Address of the cached sector, 0xFFFFFFFF if empty           */
+    uint8_t u8CacheValid;                   /*!< Blocks of the cached sector holding data                    */
+    uint8_t u8CacheDirty;                   /*!< Blocks of the cached sector not written yet                 */
+    uint32_t u32DummyTx;                    /*!< Sent while reading                                          */
+    uint32_t u32DummyRx;                    /*!< Received while writing                                      */
+    PDMA_DSCT_T asDesc[SPI_NOR_DESC_NUM];   /*!< Scatter-gather table of the RX channel                      */
+    uint32_t u32PagePrograms;               /*!< Page program commands                                       */
+    uint32_t u32Erases;                     /*!< Erase commands                                              */
+    uint32_t u32AheadErases;                /*!< Erase commands issued by the erase-ahead queue              */
+    uint32_t u32Polls;                      /*!< Status reads while the device was busy                      */
+    uint32_t u32Flushes;                    /*!< Sectors written by the block device                         */
+} S_SPI_NOR_T;
+
+/*@}*/ /* end of group SPI_NOR_EXPORTED_STRUCTS */
+
+
+/** @addtogroup SPI_NOR_EXPORTED_FUNCTIONS SPI_NOR Exported Functions
+  @{
+*/
+
+int32_t SPI_NOR_Open(S_SPI_NOR_T *psDev, SPI_T *spi, uint32_t u32TxCh, uint32_t u32RxCh);
+int32_t SPI_NOR_Read(S_SPI_NOR_T *psDev, uint32_t u32Addr, uint8_t *pu8Buf, uint32_t u32Len);
+int32_t SPI_NOR_ReadSG(S_SPI_NOR_T *psDev, uint32_t u32Addr, const S_SPI_NOR_SG_T *psSg, uint32_t u32Num);
+int32_t SPI_NOR_Write(S_SPI_NOR_T *psDev, uint32_t u32Addr, const uint8_t *pu8Data, uint32_t u32Len);
+int32_t SPI_NOR_Erase(S_SPI_NOR_T *psDev, uint32_t u32Addr, uint32_t u32Len);
+int32_t SPI_NOR_EraseAhead(S_SPI_NOR_T *psDev, uint32_t u32Addr, uint32_t u32Len);
+uint32_t SPI_NOR_Poll(S_SPI_NOR_T *psDev);
+int32_t SPI_NOR_Sync(S_SPI_NOR_T *psDev);
+void SPI_NOR_GetBlockDev(S_SPI_NOR_T *psDev, S_BLKDEV_T *psBlk, uint8_t *pu8SectorBuf);
+
+/*@}*/ /* end of group SPI_NOR_EXPORTED_FUNCTIONS */
+
+/*@}*/ /* end of group SPI_NOR_Driver */
+
+/*@}*/ /* end of group Standard_Driver */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //__SPI_NOR_H__
+
+/*** (C) COPYRIGHT 2021 Nuvoton Technology Corp. ***/
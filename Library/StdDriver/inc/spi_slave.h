@@ -0,0 +1,111 @@
+/**************************************************************************//**
+ * @file     spi_slave.h
+ * @version  V1.00
+ * @brief    NUC121 series SPI slave stream header file
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * @copyright (C) 2021 Nuvoton Technology Corp. All rights reserved.
+ *****************************************************************************/
+#ifndef __SPI_SLAVE_H__
+#define __SPI_SLAVE_H__
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+
+/** @addtogroup Standard_Driver Standard Driver
+  @{
+*/
+
+/** @addtogroup SPI_SLAVE_Driver SPI_SLAVE Driver
+  @{
+*/
+
+/** @addtogroup SPI_SLAVE_EXPORTED_CONSTANTS SPI_SLAVE Exported Constants
+  @{
+*/
+#ifndef SPI_SLAVE_SEG_MAX
+#define SPI_SLAVE_SEG_MAX           (4UL)   /*!< Descriptors in each PDMA ring                               */
+#endif
+
+#ifndef SPI_SLAVE_IDLE_BYTE
+#define SPI_SLAVE_IDLE_BYTE         (0xFFU) /*!< Sent when the master clocks more than was written           */
+#endif
+
+#define SPI_SLAVE_TX_MARGIN         (4UL)   /*!< Frames the TX PDMA may fetch while a write catches up       */
+
+/*@}*/ /* end of group SPI_SLAVE_EXPORTED_CONSTANTS */
+
+
+/** @addtogroup SPI_SLAVE_EXPORTED_STRUCTS SPI_SLAVE Exported Structs
+  @{
+*/
+struct s_spi_slave;
+
+typedef void (*SPI_SLAVE_CB)(struct s_spi_slave *psSlave);  /*!< Slave select went inactive, interrupt context */
+
+typedef struct
+{
+    uint8_t *pu8Ring;                       /*!< Ring of u32SegFrames * u32SegNum frames                     */
+    uint32_t u32PdmaCh;                     /*!< PDMA channel of the ring                                    */
+    uint32_t u32DescCtl;                    /*!< Descriptor control word, restored after each segment        */
+    uint32_t u32Seg;                        /*!< Segment moved by the PDMA now                               */
+    uint32_t u32Off;                        /*!< Ring frame the application accesses next                    */
+    volatile uint32_t u32HwFrames;          /*!< Frames of the finished segments since start                 */
+    volatile uint32_t u32AppFrames;         /*!< Frames written or read by the application since start       */
+    PDMA_DSCT_T asDesc[SPI_SLAVE_SEG_MAX];  /*!< Scatter-gather ring, one descriptor per segment             */
+} S_SPI_SLAVE_RING_T;
+
+typedef struct s_spi_slave
+{
+    SPI_T *spi;                             /*!< SPI opened as slave by \ref SPI_Open                        */
+    uint32_t u32FrameShift;                 /*!< Bytes per frame as a shift, 0, 1 or 2                       */
+    uint32_t u32SegFrames;                  /*!< Frames of one segment, one descriptor                       */
+    uint32_t u32SegNum;                     /*!< Segments in each ring                                       */
+    uint32_t u32RingFrames;                 /*!< u32SegFrames * u32SegNum                                    */
+    uint8_t u8Running;                      /*!< PDMA rings are started                                      */
+    S_SPI_SLAVE_RING_T sTx;                 /*!< Frames for the master, read by the TX PDMA                  */
+    S_SPI_SLAVE_RING_T sRx;                 /*!< Frames from the master, written by the RX PDMA              */
+    SPI_SLAVE_CB pfnInactive;               /*!< Slave select inactive callback, could be NULL               */
+    void *pvArg;                            /*!< Argument for the callback                                   */
+    volatile uint32_t u32Bursts;            /*!< Slave select inactive events                                */
+    volatile uint32_t u32TxUnderruns;       /*!< Master clocked frames never written, idle was sent          */
+    volatile uint32_t u32RxOverruns;        /*!< Segments dropped because the application read too late     */
+    volatile uint32_t u32FifoUnderruns;     /*!< TX FIFO empty at a transfer start, the PDMA fell behind     */
+    volatile uint32_t u32FifoOverruns;      /*!< RX FIFO overrun, the PDMA fell behind                       */
+} S_SPI_SLAVE_T;
+
+/*@}*/ /* end of group SPI_SLAVE_EXPORTED_STRUCTS */
+
+
+/** @addtogroup SPI_SLAVE_EXPORTED_FUNCTIONS SPI_SLAVE Exported Functions
+  @{
+*/
+
+int32_t SPI_SLAVE_Open(S_SPI_SLAVE_T *psSlave, SPI_T *spi, uint32_t u32TxCh, uint32_t u32RxCh,
+                       void *pvTxRing, void *pvRxRing, uint32_t u32SegFrames, uint32_t u32SegNum);
+void SPI_SLAVE_SetCallback(S_SPI_SLAVE_T *psSlave, SPI_SLAVE_CB pfnInactive, void *pvArg);
+void SPI_SLAVE_Start(S_SPI_SLAVE_T *psSlave);
+void SPI_SLAVE_Stop(S_SPI_SLAVE_T *psSlave);
+uint32_t SPI_SLAVE_Write(S_SPI_SLAVE_T *psSlave, const void *pvData, uint32_t u32Frames);
+uint32_t SPI_SLAVE_Read(S_SPI_SLAVE_T *psSlave, void *pvData, uint32_t u32Frames);
+uint32_t SPI_SLAVE_GetTxFree(S_SPI_SLAVE_T *psSlave);
+uint32_t SPI_SLAVE_GetRxCount(S_SPI_SLAVE_T *psSlave);
+void SPI_SLAVE_PDMAHandler(S_SPI_SLAVE_T *psSlave);
+void SPI_SLAVE_IRQHandler(S_SPI_SLAVE_T *psSlave);
+
+/*@}*/ /* end of group SPI_SLAVE_EXPORTED_FUNCTIONS */
+
+/*@}*/ /* end of group SPI_SLAVE_Driver */
+
+/*@}*/ /* end of group Standard_Driver */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //__SPI_SLAVE_H__
+
+/*** (C) COPYRIGHT 2021 Nuvoton Technology Corp. ***/
@@ -0,0 +1,100 @@
+/**************************************************************************//**
+ * @file     stkmon.h
+ * @version  V1.00
+ * @brief    NUC121 series stack and heap usage monitor header file
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * @copyright (C) 2021 Nuvoton Technology Corp. All rights reserved.
+ *****************************************************************************/
+#ifndef __STKMON_H__
+#define __STKMON_H__
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+
+/** @addtogroup Standard_Driver Standard Driver
+  @{
+*/
+
+/** @addtogroup STKMON_Driver STKMON Driver
+  @{
+*/
+
+/** @addtogroup STKMON_EXPORTED_CONSTANTS STKMON Exported Constants
+  @{
+*/
+#define STKMON_PATTERN              (0xA5C3F00FUL)  /*!< Paint of unused stack and heap words                */
+
+#ifndef STKMON_GUARD_WORDS
+#define STKMON_GUARD_WORDS          (4UL)   /*!< Words at the stack limit checked by \ref STKMON_Check       */
+#endif
+
+#ifndef STKMON_ISR_MAX
+#define STKMON_ISR_MAX              (8UL)   /*!< Interrupt handlers measured by \ref STKMON_ISR_ENTER        */
+#endif
+
+#ifndef STKMON_ISR_WINDOW
+#define STKMON_ISR_WINDOW           (64UL)  /*!< Words painted below the stack pointer at an ISR entry       */
+#endif
+
+#define STKMON_MARGIN               (16UL)  /*!< Words below the caller kept unpainted by \ref STKMON_Paint  */
+
+#define STKMON_ERR_OVERFLOW         (-50L)  /*!< Guard words at the stack limit were overwritten             */
+
+/*@}*/ /* end of group STKMON_EXPORTED_CONSTANTS */
+
+
+/** @addtogroup STKMON_EXPORTED_FUNCTIONS STKMON Exported Functions
+  @{
+*/
+
+/**
+  * @brief      Start measuring the stack depth of an interrupt handler
+  *
+  * @param[in]  u32Id   Handler number, 0 to \ref STKMON_ISR_MAX - 1.
+  *
+  * @return     None
+  *
+  * @details    First statement of the handler. Paints \ref STKMON_ISR_WINDOW words below the stack pointer, so
+  *             it is meant for tuning builds. A nested handler is part of the depth of the one it interrupted.
+  * \hideinitializer
+  */
+#define STKMON_ISR_ENTER(u32Id)     uint32_t u32StkMonSp = STKMON_IsrEnter()
+
+/**
+  * @brief      End measuring the stack depth of an interrupt handler
+  *
+  * @param[in]  u32Id   Handler number given to \ref STKMON_ISR_ENTER.
+  *
+  * @return     None
+  * \hideinitializer
+  */
+#define STKMON_ISR_EXIT(u32Id)      STKMON_IsrExit((u32Id), u32StkMonSp)
+
+void STKMON_Paint(void);
+uint32_t STKMON_GetStackSize(void);
+uint32_t STKMON_GetStackPeak(void);
+uint32_t STKMON_GetHeapSize(void);
+uint32_t STKMON_GetHeapPeak(void);
+int32_t STKMON_Check(void);
+uint32_t STKMON_IsrEnter(void);
+void STKMON_IsrExit(uint32_t u32Id, uint32_t u32Sp);
+uint32_t STKMON_GetIsrPeak(uint32_t u32Id);
+void STKMON_Report(void);
+
+/*@}*/ /* end of group STKMON_EXPORTED_FUNCTIONS */
+
+/*@}*/ /* end of group STKMON_Driver */
+
+/*@}*/ /* end of group Standard_Driver */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //__STKMON_H__
+
+/*** (C) COPYRIGHT 2021 Nuvoton Technology Corp. ***/
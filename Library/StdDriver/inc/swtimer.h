@@ -0,0 +1,127 @@
+/**************************************************************************//**
+ * @file     swtimer.h
+ * @version  V1.00
+ * @brief    NUC121 series timebase and software timer driver header file
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * @copyright (C) 2021 Nuvoton Technology Corp. All rights reserved.
+ *****************************************************************************/
+#ifndef __SWTIMER_H__
+#define __SWTIMER_H__
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+
+/** @addtogroup Standard_Driver Standard Driver
+  @{
+*/
+
+/** @addtogroup SWTIMER_Driver SWTIMER Driver
+  @{
+*/
+
+/** @addtogroup SWTIMER_EXPORTED_CONSTANTS SWTIMER Exported Constants
+  @{
+*/
+#ifndef SWTIMER_TIMEBASE_FREQ
+#define SWTIMER_TIMEBASE_FREQ       (1000000UL)     /*!< Target timebase frequency, 1 count per micro second */
+#endif
+
+#ifndef SWTIMER_TICK_SHIFT
+#define SWTIMER_TICK_SHIFT          (10UL)          /*!< Wheel tick is (1 << SWTIMER_TICK_SHIFT) timebase counts, 1.024 ms by default */
+#endif
+
+#define SWTIMER_WHEEL_BITS          (4UL)           /*!< Each wheel level has (1 << SWTIMER_WHEEL_BITS) slots */
+#define SWTIMER_WHEEL_LEVELS        (4UL)           /*!< Number of wheel levels. Timeouts up to 2^16 ticks avoid re-cascading */
+
+#define SWTIMER_ONESHOT             (0UL)           /*!< Period value of a one-shot software timer */
+
+/*@}*/ /* end of group SWTIMER_EXPORTED_CONSTANTS */
+
+
+/** @addtogroup SWTIMER_EXPORTED_STRUCTS SWTIMER Exported Structs
+  @{
+*/
+typedef void (*SWTIMER_CB)(void *pvArg);    /*!< Functional pointer type declaration for software timer callback */
+
+typedef struct s_swtimer
+{
+    struct s_swtimer *psNext;               /*!< Next timer in the same wheel slot                        */
+    struct s_swtimer **ppsPrev;             /*!< Link pointing to this timer, NULL if timer is not active */
+    uint32_t u32Expire;                     /*!< Expire time in wheel ticks                               */
+    uint32_t u32Period;                     /*!< Reload period in wheel ticks, 0 for one-shot             */
+    uint16_t u16Frac;                       /*!< Sub-tick remainder of the deadline in counts             */
+    uint16_t u16PeriodFrac;                 /*!< Sub-tick remainder of the period in counts               */
+    SWTIMER_CB pfnCallback;                 /*!< Function called from timer IRQ on expiry                 */
+    void *pvArg;                            /*!< Argument passed to pfnCallback                           */
+} S_SWTIMER_T;
+
+/*@}*/ /* end of group SWTIMER_EXPORTED_STRUCTS */
+
+
+/** @addtogroup SWTIMER_EXPORTED_FUNCTIONS SWTIMER Exported Functions
+  @{
+*/
+
+/**
+  * @brief      Check if a software timer is active
+  *
+  * @param[in]  psTimer     The pointer of the software timer.
+  *
+  * @retval     0   Software timer is stopped or has expired
+  * @retval     1   Software timer is pending
+  *
+  * \hideinitializer
+  */
+#define SWTIMER_IS_ACTIVE(psTimer)      (((psTimer)->ppsPrev != NULL) ? 1 : 0)
+
+/**
+  * @brief      Convert micro seconds to timebase counts
+  *
+  * @param[in]  u32Usec     Time in micro seconds.
+  *
+  * @return     Timebase counts
+  *
+  * @details    Only valid if the timebase runs at \ref SWTIMER_TIMEBASE_FREQ, which is the case when the timer clock is
+  *             a multiple of 1 MHz.
+  *
+  * \hideinitializer
+  */
+#define SWTIMER_US_TO_COUNT(u32Usec)    (u32Usec)
+
+/**
+  * @brief      Convert milli seconds to timebase counts
+  *
+  * @param[in]  u32Msec     Time in milli seconds.
+  *
+  * @return     Timebase counts
+  *
+  * \hideinitializer
+  */
+#define SWTIMER_MS_TO_COUNT(u32Msec)    ((u32Msec) * (SWTIMER_TIMEBASE_FREQ / 1000UL))
+
+uint32_t SWTIMER_Open(TIMER_T *timer);
+void SWTIMER_Close(void);
+uint32_t SWTIMER_GetTime(void);
+uint32_t SWTIMER_GetTicks(void);
+void SWTIMER_Start(S_SWTIMER_T *psTimer, uint32_t u32Timeout, uint32_t u32Period, SWTIMER_CB pfnCallback, void *pvArg);
+void SWTIMER_Stop(S_SWTIMER_T *psTimer);
+uint32_t SWTIMER_GetNextTimeout(void);
+void SWTIMER_IRQHandler(void);
+
+/*@}*/ /* end of group SWTIMER_EXPORTED_FUNCTIONS */
+
+/*@}*/ /* end of group SWTIMER_Driver */
+
+/*@}*/ /* end of group Standard_Driver */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //__SWTIMER_H__
+
+/*** (C) COPYRIGHT 2021 Nuvoton Technology Corp. ***/
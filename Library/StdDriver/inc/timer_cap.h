@@ -0,0 +1,105 @@
+/**************************************************************************//**
+ * @file     timer_cap.h
+ * @version  V1.00
+ * @brief    NUC121 series timer capture timestamp driver header file
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * @copyright (C) 2021 Nuvoton Technology Corp. All rights reserved.
+ *****************************************************************************/
+#ifndef __TIMER_CAP_H__
+#define __TIMER_CAP_H__
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+
+/** @addtogroup Standard_Driver Standard Driver
+  @{
+*/
+
+/** @addtogroup TIMER_CAP_Driver TIMER_CAP Driver
+  @{
+*/
+
+/** @addtogroup TIMER_CAP_EXPORTED_CONSTANTS TIMER_CAP Exported Constants
+  @{
+*/
+#define TIMER_CAP_DEBOUNCE          (TIMER_EXTCTL_CAPDBEN_Msk)  /*!< Enable capture pin de-bounce, OR with the edge setting */
+#define TIMER_CAP_NO_PDMA           (0xFFFFFFFFUL)              /*!< Timestamps are queued by \ref TIMER_CAP_IRQHandler    */
+
+/*@}*/ /* end of group TIMER_CAP_EXPORTED_CONSTANTS */
+
+
+/** @addtogroup TIMER_CAP_EXPORTED_STRUCTS TIMER_CAP Exported Structs
+  @{
+*/
+typedef struct s_timer_cap
+{
+    TIMER_T *timer;                         /*!< Timer module of this capture channel                         */
+    uint32_t *pu32Buf;                      /*!< Timestamp queue, number of entries is a power of 2           */
+    uint32_t u32Mask;                       /*!< Number of queue entries - 1                                  */
+    volatile uint32_t u32Head;              /*!< Free-running write index, only advanced by the producer      */
+    volatile uint32_t u32Tail;              /*!< Free-running read index, only advanced by the consumer       */
+    volatile uint32_t u32Dropped;           /*!< Edges dropped because the queue was full                     */
+    volatile uint32_t u32Wraps;             /*!< 24-bit counter wrap-arounds counted by the IRQ handler       */
+    uint32_t u32PdmaCh;                     /*!< PDMA channel or \ref TIMER_CAP_NO_PDMA                       */
+    uint32_t u32PdmaWraps;                  /*!< Wrap-arounds reconstructed from the PDMA queue               */
+    uint32_t u32PdmaLast;                   /*!< Last 24-bit value read from the PDMA queue                   */
+    PDMA_DSCT_T sDesc;                      /*!< Self-linked scatter-gather descriptor of the PDMA queue      */
+    uint32_t u32Freq;                       /*!< Counting frequency in Hz                                     */
+    uint32_t u32LastStamp;                  /*!< Last timestamp passed to the period statistics               */
+    uint32_t u32Stamps;                     /*!< Number of timestamps passed to the period statistics         */
+    uint32_t u32PeriodLast;                 /*!< Last period in counts                                        */
+    uint32_t u32PeriodMin;                  /*!< Minimum period in counts                                     */
+    uint32_t u32PeriodMax;                  /*!< Maximum period in counts                                     */
+    uint32_t u32Periods;                    /*!< Number of periods accumulated in u64PeriodSum                */
+    uint64_t u64PeriodSum;                  /*!< Sum of all periods in counts                                 */
+} S_TIMER_CAP_T;
+
+/*@}*/ /* end of group TIMER_CAP_EXPORTED_STRUCTS */
+
+
+/** @addtogroup TIMER_CAP_EXPORTED_FUNCTIONS TIMER_CAP Exported Functions
+  @{
+*/
+
+/**
+  * @brief      Convert timer counts to micro seconds
+  *
+  * @param[in]  psCap       The pointer of the capture channel.
+  * @param[in]  u32Count    Counts of the capture timer, for example a period.
+  *
+  * @return     Time in micro seconds, 0 if the channel was not opened by \ref TIMER_CAP_Open
+  *
+  * \hideinitializer
+  */
+#define TIMER_CAP_COUNT_TO_US(psCap, u32Count)  ((uint32_t)(((psCap)->u32Freq == 0) ? 0ULL : \
+        (((uint64_t)(u32Count) * 1000000UL) / (psCap)->u32Freq)))
+
+uint32_t TIMER_CAP_Open(S_TIMER_CAP_T *psCap, TIMER_T *timer, uint32_t u32Freq, uint32_t u32Edge, uint32_t *pu32Buf, uint32_t u32Size);
+int32_t TIMER_CAP_EnablePDMA(S_TIMER_CAP_T *psCap, uint32_t u32Ch);
+void TIMER_CAP_Start(S_TIMER_CAP_T *psCap);
+void TIMER_CAP_Stop(S_TIMER_CAP_T *psCap);
+void TIMER_CAP_IRQHandler(S_TIMER_CAP_T *psCap);
+uint32_t TIMER_CAP_GetCount(S_TIMER_CAP_T *psCap);
+uint32_t TIMER_CAP_Read(S_TIMER_CAP_T *psCap, uint32_t *pu32Stamp, uint32_t u32Max);
+void TIMER_CAP_ResetStat(S_TIMER_CAP_T *psCap);
+uint32_t TIMER_CAP_GetAvgPeriod(S_TIMER_CAP_T *psCap);
+uint32_t TIMER_CAP_GetFreq(S_TIMER_CAP_T *psCap);
+uint32_t TIMER_CAP_GetRPM(S_TIMER_CAP_T *psCap, uint32_t u32PulsePerRev);
+
+/*@}*/ /* end of group TIMER_CAP_EXPORTED_FUNCTIONS */
+
+/*@}*/ /* end of group TIMER_CAP_Driver */
+
+/*@}*/ /* end of group Standard_Driver */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //__TIMER_CAP_H__
+
+/*** (C) COPYRIGHT 2021 Nuvoton Technology Corp. ***/
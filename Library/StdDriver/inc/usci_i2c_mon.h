@@ -0,0 +1,136 @@
+/**************************************************************************//**
+ * @file     usci_i2c_mon.h
+ * @version  V1.00
+ * @brief    NUC121 series USCI_I2C passive bus monitor header file
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * @copyright (C) 2021 Nuvoton Technology Corp. All rights reserved.
+ *****************************************************************************/
+#ifndef __USCI_I2C_MON_H__
+#define __USCI_I2C_MON_H__
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+
+/** @addtogroup Standard_Driver Standard Driver
+  @{
+*/
+
+/** @addtogroup UI2C_MON_Driver UI2C_MON Driver
+  @{
+*/
+
+/** @addtogroup UI2C_MON_EXPORTED_CONSTANTS UI2C_MON Exported Constants
+  @{
+*/
+
+/*---------------------------------------------------------------------------------------------------------*/
+/*  Event record                                                                                           */
+/*                                                                                                         */
+/*  Each bus event is one 32-bit little endian word:                                                       */
+/*    [31:29] type, one of UI2C_MON_REC_xxx                                                                */
+/*    [28]    1 if the byte was not acknowledged                                                           */
+/*    [27:20] address byte with R/W bit, or data byte                                                      */
+/*    [19:0]  bits 19..0 of the SWTIMER timebase in micro seconds                                          */
+/*  A TIME record carries bits 31..20 of the timebase in [11:0] and comes before the first event of every  */
+/*  new 1.048576 s period. A LOST record carries the number of dropped events in [27:0].                   */
+/*---------------------------------------------------------------------------------------------------------*/
+#define UI2C_MON_REC_TIME           (0UL)   /*!< Upper timebase bits                                     */
+#define UI2C_MON_REC_START          (1UL)   /*!< START on an idle bus                                    */
+#define UI2C_MON_REC_RESTART        (2UL)   /*!< Repeated START                                          */
+#define UI2C_MON_REC_STOP           (3UL)   /*!< STOP                                                    */
+#define UI2C_MON_REC_ADDR           (4UL)   /*!< Address byte and its acknowledge                        */
+#define UI2C_MON_REC_DATA           (5UL)   /*!< Data byte and its acknowledge                           */
+#define UI2C_MON_REC_LOST           (6UL)   /*!< Events dropped because the ring was full                */
+
+#define UI2C_MON_REC_TYPE(u32Rec)   ((u32Rec) >> 29)                /*!< Record type \hideinitializer        */
+#define UI2C_MON_REC_NACK(u32Rec)   (((u32Rec) >> 28) & 0x1UL)      /*!< Not acknowledged \hideinitializer   */
+#define UI2C_MON_REC_BYTE(u32Rec)   (((u32Rec) >> 20) & 0xFFUL)     /*!< Address or data byte \hideinitializer */
+#define UI2C_MON_REC_TIMEL(u32Rec)  ((u32Rec) & 0xFFFFFUL)          /*!< Time bits 19..0 \hideinitializer    */
+#define UI2C_MON_REC_COUNT(u32Rec)  ((u32Rec) & 0x0FFFFFFFUL)       /*!< TIME or LOST payload \hideinitializer */
+
+#define UI2C_MON_PASSIVE            (0UL)   /*!< Never drive the bus, drop events when the ring is full  */
+#define UI2C_MON_STRETCH            (1UL)   /*!< Hold SCL low until the monitor has read the byte        */
+
+#ifndef UI2C_MON_STAT_NUM
+#define UI2C_MON_STAT_NUM           (8UL)   /*!< Slave addresses with their own statistics               */
+#endif
+
+/*@}*/ /* end of group UI2C_MON_EXPORTED_CONSTANTS */
+
+
+/** @addtogroup UI2C_MON_EXPORTED_STRUCTS UI2C_MON Exported Structs
+  @{
+*/
+typedef struct
+{
+    UI2C_T *ui2c;                           /*!< USCI in I2C monitor mode                                    */
+    uint32_t *pu32Ring;                     /*!< Record ring                                                 */
+    uint32_t u32Mask;                       /*!< Ring size - 1, the size is a power of 2                     */
+    volatile uint32_t u32Head;              /*!< Next record written by the interrupt                        */
+    volatile uint32_t u32Tail;              /*!< Next record read by the application                         */
+    uint32_t u32State;                      /*!< Bus idle, address expected or data expected                 */
+    uint32_t u32High;                       /*!< Timebase bits 31..20 of the last TIME record                */
+    uint32_t u32Lost;                       /*!< Events dropped since the last LOST record                   */
+    uint32_t u32Events;                     /*!< Events recorded                                             */
+    uint32_t u32Dropped;                    /*!< Events dropped in total                                     */
+} S_UI2C_MON_T;
+
+typedef struct
+{
+    uint8_t u8Addr;                         /*!< 7-bit slave address                                         */
+    uint32_t u32Xfers;                      /*!< Transactions addressed to the slave                         */
+    uint32_t u32Bytes;                      /*!< Data bytes                                                  */
+    uint32_t u32Nacks;                      /*!< Address bytes not acknowledged                              */
+    uint32_t u32TotalTime;                  /*!< Sum of START to STOP times in micro seconds                 */
+    uint32_t u32MaxTime;                    /*!< Longest START to STOP time in micro seconds                 */
+} S_UI2C_MON_ADDR_STAT_T;
+
+typedef struct
+{
+    S_UI2C_MON_ADDR_STAT_T asAddr[UI2C_MON_STAT_NUM];   /*!< Per slave address, in order of appearance     */
+    uint32_t u32AddrNum;                    /*!< Entries of asAddr in use                                    */
+    uint32_t u32OtherXfers;                 /*!< Transactions to slaves without an entry                     */
+    uint32_t u32High;                       /*!< Timebase bits 31..20                                        */
+    uint32_t u32First;                      /*!< Time of the first event                                     */
+    uint32_t u32Last;                       /*!< Time of the last event                                      */
+    uint32_t u32Start;                      /*!< Time of the START of the open transaction                   */
+    uint32_t u32Busy;                       /*!< Sum of START to STOP times                                  */
+    uint32_t u32Cur;                        /*!< Entry of the open transaction, UI2C_MON_STAT_NUM for none   */
+    uint32_t u32Open;                       /*!< A transaction is open                                       */
+    uint32_t u32Lost;                       /*!< Events dropped by the monitor                               */
+    uint32_t u32Events;                     /*!< Events decoded                                              */
+} S_UI2C_MON_STAT_T;
+
+/*@}*/ /* end of group UI2C_MON_EXPORTED_STRUCTS */
+
+
+/** @addtogroup UI2C_MON_EXPORTED_FUNCTIONS UI2C_MON Exported Functions
+  @{
+*/
+
+int32_t UI2C_MON_Open(S_UI2C_MON_T *psMon, UI2C_T *ui2c, uint32_t *pu32Ring, uint32_t u32Size, uint32_t u32Mode);
+void UI2C_MON_Close(S_UI2C_MON_T *psMon);
+uint32_t UI2C_MON_GetCount(S_UI2C_MON_T *psMon);
+uint32_t UI2C_MON_Read(S_UI2C_MON_T *psMon, uint32_t *pu32Buf, uint32_t u32Max);
+void UI2C_MON_IRQHandler(S_UI2C_MON_T *psMon);
+void UI2C_MON_StatInit(S_UI2C_MON_STAT_T *psStat);
+void UI2C_MON_StatFeed(S_UI2C_MON_STAT_T *psStat, const uint32_t *pu32Rec, uint32_t u32Num);
+uint32_t UI2C_MON_StatUtilization(S_UI2C_MON_STAT_T *psStat);
+
+/*@}*/ /* end of group UI2C_MON_EXPORTED_FUNCTIONS */
+
+/*@}*/ /* end of group UI2C_MON_Driver */
+
+/*@}*/ /* end of group Standard_Driver */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //__USCI_I2C_MON_H__
+
+/*** (C) COPYRIGHT 2021 Nuvoton Technology Corp. ***/
@@ -60,9 +60,47 @@ extern "C"
 #define USPI_TX_FULL_MASK            (0x10)                          /*!< TX full status mask */
 #define USPI_SSLINE_STS_MASK         (0x20)                          /*!< USCI_SPI_SS line status mask */
 
+/* USCI_SPI transfer API */
+#define USPI_XFER_CS_HOLD            (0x01UL)                        /*!< Keep USCI_SPI_SS active for the next transfer */
+#define USPI_XFER_NO_PDMA            (0xFFFFFFFFUL)                  /*!< PDMA channel not used */
+#define USPI_XFER_PDMA_MAX           (0x4000UL)                      /*!< Frames per PDMA block, longer transfers are split */
+#define USPI_XFER_DUMMY              (0xFFFFUL)                      /*!< Frame sent when there is no transmit buffer */
+
 /*@}*/ /* end of group USPI_EXPORTED_CONSTANTS */
 
 
+/** @addtogroup USPI_EXPORTED_STRUCTS USPI Exported Structs
+  @{
+*/
+struct s_uspi_xfer;
+
+typedef void (*USPI_XFER_CB)(struct s_uspi_xfer *psXfer);   /*!< Transfer done, interrupt context */
+
+typedef struct s_uspi_xfer
+{
+    USPI_T *uspi;                           /*!< USCI_SPI master */
+    const void *pvTx;                       /*!< Transmit frames, NULL sends \ref USPI_XFER_DUMMY */
+    void *pvRx;                             /*!< Receive frames, NULL discards them */
+    uint32_t u32Len;                        /*!< Frames, 8-bit for data width up to 8, otherwise 16-bit */
+    uint32_t u32TxCnt;                      /*!< Frames written to the transmit buffer */
+    uint32_t u32RxCnt;                      /*!< Frames read from the receive buffer */
+    uint32_t u32Flags;                      /*!< \ref USPI_XFER_CS_HOLD */
+    uint32_t u32Wide;                       /*!< Frames are 16-bit */
+    uint32_t u32CsActive;                   /*!< USCI_SPI_SS is driven active */
+    uint32_t u32PdmaTxCh;                   /*!< PDMA channel for transmit or \ref USPI_XFER_NO_PDMA */
+    uint32_t u32PdmaRxCh;                   /*!< PDMA channel for receive or \ref USPI_XFER_NO_PDMA */
+    uint32_t u32PdmaMin;                    /*!< Shortest transfer moved by PDMA */
+    uint32_t u32PdmaLen;                    /*!< Frames of the running PDMA block */
+    uint32_t u32DummyTx;                    /*!< PDMA source without transmit buffer */
+    uint32_t u32DummyRx;                    /*!< PDMA destination without receive buffer */
+    USPI_XFER_CB pfnDone;                   /*!< Completion callback, could be NULL */
+    void *pvArg;                            /*!< Callback argument */
+    volatile uint32_t u32Busy;              /*!< Transfer in progress */
+} S_USPI_XFER_T;
+
+/*@}*/ /* end of group USPI_EXPORTED_STRUCTS */
+
+
 /** @addtogroup USPI_EXPORTED_FUNCTIONS USPI Exported Functions
   @{
 */
@@ -346,6 +384,14 @@ extern "C"
 #define USPI_DISABLE_PDMA(uspi) ((uspi)->PDMACTL &= ~(USPI_PDMACTL_TXPDMAEN_Msk | USPI_PDMACTL_RXPDMAEN_Msk | USPI_PDMACTL_PDMAEN_Msk))
 
 
+/**
+  * @brief  Check if a transfer started by \ref USPI_TransferAsync is running.
+  * @param[in]  psXfer The pointer of the transfer context.
+  * @return 1 if the transfer is running, 0 if it is done.
+  * \hideinitializer
+  */
+#define USPI_XFER_IS_BUSY(psXfer) ((psXfer)->u32Busy)
+
 /**
   * @brief  Set the data width of a USCI_SPI transaction.
   * @param[in]  uspi The pointer of the specified USCI_SPI module.
@@ -376,6 +422,13 @@ void USPI_ClearIntFlag(USPI_T *uspi, uint32_t u32Mask);
 uint32_t USPI_GetStatus(USPI_T *uspi, uint32_t u32Mask);
 void USPI_EnableWakeup(USPI_T *uspi);
 void USPI_DisableWakeup(USPI_T *uspi);
+void USPI_XferInit(S_USPI_XFER_T *psXfer, USPI_T *uspi);
+int32_t USPI_XferEnablePDMA(S_USPI_XFER_T *psXfer, uint32_t u32TxCh, uint32_t u32RxCh, uint32_t u32MinLen);
+int32_t USPI_Transfer(S_USPI_XFER_T *psXfer, const void *pvTx, void *pvRx, uint32_t u32Len, uint32_t u32Flags);
+int32_t USPI_TransferAsync(S_USPI_XFER_T *psXfer, const void *pvTx, void *pvRx, uint32_t u32Len, uint32_t u32Flags,
+                           USPI_XFER_CB pfnDone, void *pvArg);
+void USPI_XferIRQHandler(S_USPI_XFER_T *psXfer);
+void USPI_XferPDMAHandler(S_USPI_XFER_T *psXfer);
 
 
 /*@}*/ /* end of group USPI_EXPORTED_FUNCTIONS */
@@ -0,0 +1,342 @@
+/**************************************************************************//**
+ * @file     clk_gov.c
+ * @version  V1.00
+ * @brief    NUC121 series clock scaling governor source file
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * @copyright (C) 2021 Nuvoton Technology Corp. All rights reserved.
+*****************************************************************************/
+#include "NuMicro.h"
+
+/** @addtogroup Standard_Driver Standard Driver
+  @{
+*/
+
+/** @addtogroup CLK_GOV_Driver CLK_GOV Driver
+  @{
+*/
+
+/// @cond HIDDEN_SYMBOLS
+
+#define CLK_GOV_FOM24_HCLK      (24000000UL)
+#define CLK_GOV_NO_LEVEL        (0xFFFFFFFFUL)
+
+static const S_CLK_GOV_LEVEL_T *s_psLevels = NULL;
+static uint32_t s_u32LevelNum = 0;
+static uint32_t s_u32Level = CLK_GOV_NO_LEVEL;
+static uint32_t s_u32LoadLevel = 0;
+static uint16_t s_au16Hold[CLK_GOV_LEVEL_MAX];
+static S_CLK_GOV_NOTIFIER_T *s_psNotifierList = NULL;
+static CLK_GOV_TIME_FUNC s_pfnGetTime = NULL;
+static S_CLK_GOV_STAT_T s_sStat;
+
+/* PLL can only be powered down if no enabled module is clocked from it */
+static uint32_t CLK_GOV_IsPLLUsed(void)
+{
+    uint32_t u32Sel1 = CLK->CLKSEL1, u32En = CLK->APBCLK0;
+
+    if ((CLK->CLKSEL0 & CLK_CLKSEL0_HCLKSEL_Msk) == CLK_CLKSEL0_HCLKSEL_PLL)
+        return 1;
+
+    if ((u32En & CLK_APBCLK0_UART0CKEN_Msk) && ((u32Sel1 & CLK_CLKSEL1_UARTSEL_Msk) == CLK_CLKSEL1_UARTSEL_PLL))
+        return 1;
+
+    if ((u32En & CLK_APBCLK0_ADCCKEN_Msk) && ((u32Sel1 & CLK_CLKSEL1_ADCSEL_Msk) == CLK_CLKSEL1_ADCSEL_PLL))
+        return 1;
+
+    if ((u32En & CLK_APBCLK0_PWM0CKEN_Msk) && ((u32Sel1 & CLK_CLKSEL1_PWM0SEL_Msk) == CLK_CLKSEL1_PWM0SEL_PLL))
+        return 1;
+
+    if ((u32En & CLK_APBCLK0_PWM1CKEN_Msk) && ((u32Sel1 & CLK_CLKSEL1_PWM1SEL_Msk) == CLK_CLKSEL1_PWM1SEL_PLL))
+        return 1;
+
+    if ((u32En & CLK_APBCLK0_BPWM0CKEN_Msk) && ((u32Sel1 & CLK_CLKSEL1_BPWM0SEL_Msk) == CLK_CLKSEL1_BPWM0SEL_PLL))
+        return 1;
+
+    if ((u32En & CLK_APBCLK0_BPWM1CKEN_Msk) && ((u32Sel1 & CLK_CLKSEL1_BPWM1SEL_Msk) == CLK_CLKSEL1_BPWM1SEL_PLL))
+        return 1;
+
+    if ((u32En & CLK_APBCLK0_SPI0CKEN_Msk) && ((CLK->CLKSEL2 & CLK_CLKSEL2_SPI0SEL_Msk) == CLK_CLKSEL2_SPI0SEL_PLL))
+        return 1;
+
+    if ((u32En & CLK_APBCLK0_USBDCKEN_Msk) && ((CLK->CLKSEL3 & CLK_CLKSEL3_USBDSEL_Msk) == CLK_CLKSEL3_USBDSEL_PLL))
+        return 1;
+
+    return 0;
+}
+
+static void CLK_GOV_Notify(uint32_t u32Event)
+{
+    S_CLK_GOV_NOTIFIER_T *psNotifier;
+
+    for (psNotifier = s_psNotifierList; psNotifier != NULL; psNotifier = psNotifier->psNext)
+        psNotifier->pfnNotify(psNotifier, u32Event);
+}
+
+static void CLK_GOV_Apply(uint32_t u32Level)
+{
+    const S_CLK_GOV_LEVEL_T *psLevel = &s_psLevels[u32Level];
+    uint32_t u32Start = 0, u32Time, u32Locked;
+
+    if (s_pfnGetTime != NULL)
+        u32Start = s_pfnGetTime();
+
+    CLK_GOV_Notify(CLK_GOV_PRE_CHANGE);
+
+    u32Locked = SYS_IsRegLocked();
+
+    if (u32Locked)
+        SYS_UnlockReg();
+
+    /* CLK_SetHCLK and CLK_SetCoreClock pass through undivided HIRC, so use 50 MHz flash timing meanwhile */
+    FMC_EnableFreqOptimizeMode(FMC_FTCTL_OPTIMIZE_50MHZ);
+
+    if (psLevel->u32ClkSrc == CLK_CLKSEL0_HCLKSEL_PLL)
+        CLK_SetCoreClock(psLevel->u32Hclk);
+    else
+    {
+        CLK_SetHCLK(psLevel->u32ClkSrc, psLevel->u32ClkDiv);
+
+        if (CLK_GOV_IsPLLUsed() == 0)
+            CLK_DisablePLL();
+    }
+
+    if (SystemCoreClock <= CLK_GOV_FOM24_HCLK)
+        FMC_EnableFreqOptimizeMode(FMC_FTCTL_OPTIMIZE_24MHZ);
+
+    if (u32Locked)
+        SYS_LockReg();
+
+    CLK_GOV_Notify(CLK_GOV_POST_CHANGE);
+
+    s_u32Level = u32Level;
+
+    s_sStat.u32Transitions++;
+    s_sStat.au32Enter[u32Level]++;
+
+    if (s_pfnGetTime != NULL)
+    {
+        u32Time = s_pfnGetTime() - u32Start;
+        s_sStat.u32LastTime = u32Time;
+
+        if (u32Time > s_sStat.u32MaxTime)
+            s_sStat.u32MaxTime = u32Time;
+    }
+}
+
+/* Highest level requested by load or by a hold */
+static void CLK_GOV_Update(void)
+{
+    uint32_t u32Target = s_u32LoadLevel, u32Level;
+
+    for (u32Level = s_u32LevelNum; u32Level > (u32Target + 1UL); u32Level--)
+    {
+        if (s_au16Hold[u32Level - 1UL] != 0)
+        {
+            u32Target = u32Level - 1UL;
+            break;
+        }
+    }
+
+    if (u32Target != s_u32Level)
+        CLK_GOV_Apply(u32Target);
+}
+
+/// @endcond HIDDEN_SYMBOLS
+
+/** @addtogroup CLK_GOV_EXPORTED_FUNCTIONS CLK_GOV Exported Functions
+  @{
+*/
+
+/**
+  * @brief      Initialize the clock governor
+  *
+  * @param[in]  psLevels    Performance levels, sorted from the lowest to the highest HCLK.
+  * @param[in]  u32Num      Number of levels, up to \ref CLK_GOV_LEVEL_MAX.
+  * @param[in]  pfnGetTime  Micro second timebase used to measure transitions, for example \ref SWTIMER_GetTime.
+  *                         It must not be clocked from HCLK. It could be NULL if no measurement is needed.
+  *
+  * @retval     0           Success
+  * @retval     -1          Invalid number of levels
+  *
+  * @details    The highest level is applied. Registered notifiers are kept.
+  */
+int32_t CLK_GOV_Init(const S_CLK_GOV_LEVEL_T *psLevels, uint32_t u32Num, CLK_GOV_TIME_FUNC pfnGetTime)
+{
+    uint32_t i;
+
+    if ((u32Num == 0) || (u32Num > CLK_GOV_LEVEL_MAX))
+        return -1;
+
+    s_psLevels = psLevels;
+    s_u32LevelNum = u32Num;
+    s_pfnGetTime = pfnGetTime;
+    s_u32Level = CLK_GOV_NO_LEVEL;
+    s_u32LoadLevel = u32Num - 1UL;
+
+    for (i = 0; i < CLK_GOV_LEVEL_MAX; i++)
+    {
+        s_au16Hold[i] = 0;
+        s_sStat.au32Enter[i] = 0;
+    }
+
+    s_sStat.u32Transitions = 0;
+    s_sStat.u32LastTime = 0;
+    s_sStat.u32MaxTime = 0;
+
+    CLK_GOV_Update();
+
+    return 0;
+}
+
+/**
+  * @brief      Register a clock change notifier
+  *
+  * @param[in]  psNotifier  The pointer of the notifier, owned by the caller.
+  * @param[in]  pfnNotify   Notifier function, for example \ref CLK_GOV_NotifyUART.
+  * @param[in]  pvPeriph    Peripheral handled by the notifier.
+  * @param[in]  u32Rate     Baud rate or bus clock to restore after each change.
+  *
+  * @return     None
+  *
+  * @details    Every notifier is called with \ref CLK_GOV_PRE_CHANGE before and with \ref CLK_GOV_POST_CHANGE after
+  *             HCLK changes, after SystemCoreClock and CyclesPerUs are updated.
+  */
+void CLK_GOV_RegisterNotifier(S_CLK_GOV_NOTIFIER_T *psNotifier, CLK_GOV_CB pfnNotify, void *pvPeriph, uint32_t u32Rate)
+{
+    psNotifier->pfnNotify = pfnNotify;
+    psNotifier->pvPeriph = pvPeriph;
+    psNotifier->u32Rate = u32Rate;
+    psNotifier->psNext = s_psNotifierList;
+    s_psNotifierList = psNotifier;
+}
+
+/**
+  * @brief      Unregister a clock change notifier
+  *
+  * @param[in]  psNotifier  The pointer of the notifier.
+  *
+  * @return     None
+  */
+void CLK_GOV_UnregisterNotifier(S_CLK_GOV_NOTIFIER_T *psNotifier)
+{
+    S_CLK_GOV_NOTIFIER_T **ppsLink;
+
+    for (ppsLink = &s_psNotifierList; *ppsLink != NULL; ppsLink = &(*ppsLink)->psNext)
+    {
+        if (*ppsLink == psNotifier)
+        {
+            *ppsLink = psNotifier->psNext;
+            break;
+        }
+    }
+}
+
+/**
+  * @brief      Select a performance level directly
+  *
+  * @param[in]  u32Level    Level index.
+  *
+  * @retval     0           Success
+  * @retval     -1          Invalid level
+  *
+  * @details    The level replaces the one chosen by \ref CLK_GOV_SetLoad until the next load update.
+  *             Levels held by \ref CLK_GOV_Hold are still respected.
+  */
+int32_t CLK_GOV_SetLevel(uint32_t u32Level)
+{
+    if (u32Level >= s_u32LevelNum)
+        return -1;
+
+    s_u32LoadLevel = u32Level;
+    CLK_GOV_Update();
+
+    return 0;
+}
+
+/**
+  * @brief      Get the current performance level
+  *
+  * @param      None
+  *
+  * @return     Level index
+  */
+uint32_t CLK_GOV_GetLevel(void)
+{
+    return s_u32Level;
+}
+
+/**
+  * @brief      Give a load hint to the governor
+  *
+  * @param[in]  u32Load     CPU load in percent over the last measurement window.
+  *
+  * @return     None
+  *
+  * @details    At or above \ref CLK_GOV_UP_THRESHOLD the highest level is selected at once, so bursts are served
+  *             without delay. Below \ref CLK_GOV_DOWN_THRESHOLD the level is lowered by one step per hint.
+  *             It must be called from thread context since notifiers may wait for peripherals.
+  */
+void CLK_GOV_SetLoad(uint32_t u32Load)
+{
+    if (u32Load >= CLK_GOV_UP_THRESHOLD)
+        s_u32LoadLevel = s_u32LevelNum - 1UL;
+    else if ((u32Load < CLK_GOV_DOWN_THRESHOLD) && (s_u32LoadLevel > 0))
+        s_u32LoadLevel--;
+
+    CLK_GOV_Update();
+}
+
+/**
+  * @brief      Hold a minimum performance level
+  *
+  * @param[in]  u32Level    Minimum level needed, for example during a fast SPI session.
+  *
+  * @return     None
+  *
+  * @details    Holds are counted, every call must be paired with \ref CLK_GOV_Release.
+  */
+void CLK_GOV_Hold(uint32_t u32Level)
+{
+    if (u32Level < s_u32LevelNum)
+    {
+        s_au16Hold[u32Level]++;
+        CLK_GOV_Update();
+    }
+}
+
+/**
+  * @brief      Release a minimum performance level
+  *
+  * @param[in]  u32Level    Level given to \ref CLK_GOV_Hold.
+  *
+  * @return     None
+  */
+void CLK_GOV_Release(uint32_t u32Level)
+{
+    if ((u32Level < s_u32LevelNum) && (s_au16Hold[u32Level] != 0))
+    {
+        s_au16Hold[u32Level]--;
+        CLK_GOV_Update();
+    }
+}
+
+/**
+  * @brief      Get the transition statistics
+  *
+  * @param      None
+  *
+  * @return     The pointer of the statistics
+  */
+const S_CLK_GOV_STAT_T *CLK_GOV_GetStat(void)
+{
+    return &s_sStat;
+}
+
+/*@}*/ /* end of group CLK_GOV_EXPORTED_FUNCTIONS */
+
+/*@}*/ /* end of group CLK_GOV_Driver */
+
+/*@}*/ /* end of group Standard_Driver */
+
+/*** (C) COPYRIGHT 2021 Nuvoton Technology Corp. ***/
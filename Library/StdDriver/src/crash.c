@@ -0,0 +1,304 @@
+/**************************************************************************//**
+ * @file     crash.c
+ * @version  V1.00
+ * @brief    NUC121 series crash dump and boot counter source file
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * @copyright (C) 2021 Nuvoton Technology Corp. All rights reserved.
+*****************************************************************************/
+#include <stdio.h>
+#include <string.h>
+#include "NuMicro.h"
+
+/** @addtogroup Standard_Driver Standard Driver
+  @{
+*/
+
+/** @addtogroup CRASH_Driver CRASH Driver
+  @{
+*/
+
+/// @cond HIDDEN_SYMBOLS
+
+#define CRASH_FLASH_END         (FLASH_BASE + 0x8000UL)
+#define CRASH_SRAM_END          (SRAM_BASE + 0x2000UL)
+#define CRASH_PAGE_WORDS        (FMC_FLASH_PAGE_SIZE / 4UL)
+#define CRASH_RECORD_WORDS      (sizeof(S_CRASH_T) / 4UL)
+#define CRASH_ERASED            (0xFFFFFFFFUL)
+
+static uint32_t s_u32CrashBase = CRASH_ERASED;
+static uint32_t s_u32CrashBaseInv = CRASH_ERASED;   /* ~base, a corrupted base is not trusted by the fault path */
+static uint32_t s_u32CrashBoot;
+static uint32_t s_u32CrashRstSts;
+static S_CRASH_T s_sCrash;          /* Built outside of the stack, which may be what failed */
+
+static uint32_t CRASH_Sum(const uint32_t *pu32Word)
+{
+    uint32_t i, u32Sum = 0;
+
+    for (i = 0; i < (CRASH_RECORD_WORDS - 1UL); i++)
+        u32Sum += pu32Word[i];
+
+    return u32Sum;
+}
+
+/* Enable ISP programming of APROM and data flash. Registers must be unlocked. */
+static uint32_t CRASH_IspOn(void)
+{
+    uint32_t u32IspCtl = FMC->ISPCTL;
+
+    CLK->AHBCLK |= CLK_AHBCLK_ISPCKEN_Msk;
+    FMC->ISPCTL = u32IspCtl | FMC_ISPCTL_ISPEN_Msk | FMC_ISPCTL_APUEN_Msk | FMC_ISPCTL_ISPFF_Msk;
+
+    return u32IspCtl;
+}
+
+/* Count this boot: one more word of the tally page is programmed, the page is erased once per 127 boots */
+static uint32_t CRASH_CountBoot(uint32_t u32Page)
+{
+    uint32_t i, u32Base = M32(u32Page);
+
+    if (u32Base == CRASH_ERASED)
+    {
+        u32Base = 0;
+        FMC_Write(u32Page, u32Base);
+    }
+
+    for (i = 1; i < CRASH_PAGE_WORDS; i++)
+    {
+        if (M32(u32Page + (i << 2)) == CRASH_ERASED)
+            break;
+    }
+
+    if (i == CRASH_PAGE_WORDS)
+    {
+        u32Base += CRASH_PAGE_WORDS - 1UL;
+
+        if (FMC_Erase(u32Page) != 0)
+            return 0;
+
+        FMC_Write(u32Page, u32Base);
+        i = 1;
+    }
+
+    FMC_Write(u32Page + (i << 2), 0);
+
+    return (u32Base + i);
+}
+
+/// @endcond HIDDEN_SYMBOLS
+
+
+/** @addtogroup CRASH_EXPORTED_FUNCTIONS CRASH Exported Functions
+  @{
+*/
+
+/**
+  * @brief      Set up the crash store and count the boot
+  *
+  * @param[in]  u32Base     Flash address of \ref CRASH_STORE_SIZE bytes reserved for the store, page aligned.
+  *
+  * @retval     0                   Success
+  * @retval     CRASH_ERR_STORE     Store base is not page aligned or not in flash
+  * @retval     CRASH_ERR_FLASH     Boot counter could not be programmed
+  *
+  * @details    Call once at boot with registers unlocked, before anything could fault. The first page holds the
+  *             last crash record, the second one the boot counter. Both may be in data flash or at the end of
+  *             APROM outside of the code. A boot costs one word program.
+  */
+int32_t CRASH_Open(uint32_t u32Base)
+{
+    uint32_t u32IspCtl;
+
+    if ((u32Base & (FMC_FLASH_PAGE_SIZE - 1UL)) || ((u32Base + CRASH_STORE_SIZE) > CRASH_FLASH_END))
+        return CRASH_ERR_STORE;
+
+    s_u32CrashBase = u32Base;
+    s_u32CrashBaseInv = ~u32Base;
+    s_u32CrashRstSts = SYS->RSTSTS;
+
+    u32IspCtl = CRASH_IspOn();
+    s_u32CrashBoot = CRASH_CountBoot(u32Base + FMC_FLASH_PAGE_SIZE);
+    FMC->ISPCTL = u32IspCtl;
+
+    return ((s_u32CrashBoot != 0) ? 0 : CRASH_ERR_FLASH);
+}
+
+/**
+  * @brief      Get the boot count
+  *
+  * @return     Boots since the store was first erased, 1 for the first boot
+  */
+uint32_t CRASH_GetBootCount(void)
+{
+    return s_u32CrashBoot;
+}
+
+/**
+  * @brief      Get the crash record of an earlier run
+  *
+  * @param[out] psCrash     Copy of the record.
+  *
+  * @retval     1   A complete record was found
+  * @retval     0   No crash since the last \ref CRASH_Clear
+  */
+uint32_t CRASH_Get(S_CRASH_T *psCrash)
+{
+    const S_CRASH_T *psStore;
+
+    if (s_u32CrashBase != ~s_u32CrashBaseInv)
+        return 0;
+
+    psStore = (const S_CRASH_T *)s_u32CrashBase;
+
+    if ((psStore->u32Magic != CRASH_MAGIC) || (CRASH_Sum((const uint32_t *)psStore) != psStore->u32Sum))
+        return 0;
+
+    memcpy(psCrash, psStore, sizeof(S_CRASH_T));
+
+    return 1;
+}
+
+/**
+  * @brief      Erase the crash record
+  *
+  * @return     None
+  *
+  * @details    Call with registers unlocked once the record is reported.
+  */
+void CRASH_Clear(void)
+{
+    uint32_t u32IspCtl;
+
+    if (s_u32CrashBase != ~s_u32CrashBaseInv)
+        return;
+
+    u32IspCtl = CRASH_IspOn();
+    FMC_Erase(s_u32CrashBase);
+    FMC->ISPCTL = u32IspCtl;
+}
+
+/**
+  * @brief      Print a crash record
+  *
+  * @param[in]  psCrash     Record from \ref CRASH_Get.
+  *
+  * @return     None
+  *
+  * @details    Cortex-M0 code has no frame pointers, so the backtrace lists the stack words that are Thumb code
+  *             addresses, the return addresses of the callers among them. Resolve PC, LR and the list against
+  *             the ELF file of the build, for example with arm-none-eabi-addr2line -f -e app.elf.
+  */
+void CRASH_Print(const S_CRASH_T *psCrash)
+{
+    uint32_t i, u32Word;
+
+    printf("Crash in boot %u, reset status 0x%08x\n", (unsigned int)psCrash->u32Boot, (unsigned int)psCrash->u32RstSts);
+    printf("PC   0x%08x  LR   0x%08x  xPSR 0x%08x\n", (unsigned int)psCrash->au32Frame[CRASH_FRAME_PC],
+           (unsigned int)psCrash->au32Frame[CRASH_FRAME_LR], (unsigned int)psCrash->au32Frame[CRASH_FRAME_PSR]);
+    printf("R0   0x%08x  R1   0x%08x  R2   0x%08x  R3   0x%08x  R12  0x%08x\n",
+           (unsigned int)psCrash->au32Frame[CRASH_FRAME_R0], (unsigned int)psCrash->au32Frame[CRASH_FRAME_R1],
+           (unsigned int)psCrash->au32Frame[CRASH_FRAME_R2], (unsigned int)psCrash->au32Frame[CRASH_FRAME_R3],
+           (unsigned int)psCrash->au32Frame[CRASH_FRAME_R12]);
+    printf("SP   0x%08x  EXC_RETURN 0x%08x  ICSR 0x%08x  CONTROL 0x%08x\n", (unsigned int)psCrash->u32Sp,
+           (unsigned int)psCrash->u32ExcReturn, (unsigned int)psCrash->u32Icsr, (unsigned int)psCrash->u32Control);
+    printf("Backtrace:\n    0x%08x\n    0x%08x\n", (unsigned int)psCrash->au32Frame[CRASH_FRAME_PC],
+           (unsigned int)(psCrash->au32Frame[CRASH_FRAME_LR] & ~1UL));
+
+    for (i = 0; i < psCrash->u32StackWords; i++)
+    {
+        u32Word = psCrash->au32Stack[i];
+
+        if ((u32Word & 1UL) && (u32Word < CRASH_FLASH_END))
+            printf("    0x%08x  sp+%u\n", (unsigned int)(u32Word & ~1UL), (unsigned int)((i + 8UL) << 2));
+    }
+}
+
+/**
+  * @brief      Save a crash record and reset the chip
+  *
+  * @param[in]  pu32Frame       Exception frame stacked by the core.
+  * @param[in]  u32ExcReturn    LR value at the exception entry.
+  *
+  * @return     None, does not return
+  *
+  * @details    Called by the hard fault handler through ProcessHardFault, may be called by an application check
+  *             too. Uses neither the heap nor interrupts, only one page erase and the word programs of the
+  *             record. Without a valid store the chip only resets.
+  */
+void CRASH_Capture(uint32_t *pu32Frame, uint32_t u32ExcReturn)
+{
+    uint32_t i, u32Addr = (uint32_t)pu32Frame, u32Top;
+    uint32_t *pu32Record = (uint32_t *)&s_sCrash;
+
+    __set_PRIMASK(1);
+
+    if (s_u32CrashBase == ~s_u32CrashBaseInv)
+    {
+        memset(&s_sCrash, 0, sizeof(s_sCrash));
+        s_sCrash.u32Magic = CRASH_MAGIC;
+        s_sCrash.u32Boot = s_u32CrashBoot;
+        s_sCrash.u32ExcReturn = u32ExcReturn;
+        s_sCrash.u32Sp = u32Addr;
+        s_sCrash.u32Icsr = SCB->ICSR;
+        s_sCrash.u32Control = __get_CONTROL();
+        s_sCrash.u32RstSts = s_u32CrashRstSts;
+
+        /* A frame pointer out of SRAM would fault again and lock the core up */
+        if ((u32Addr >= SRAM_BASE) && ((u32Addr + 32UL) <= CRASH_SRAM_END) && ((u32Addr & 3UL) == 0))
+        {
+            for (i = 0; i < 8UL; i++)
+                s_sCrash.au32Frame[i] = pu32Frame[i];
+
+            u32Top = (CRASH_SRAM_END - (u32Addr + 32UL)) >> 2;
+            s_sCrash.u32StackWords = (u32Top < CRASH_STACK_WORDS) ? u32Top : CRASH_STACK_WORDS;
+
+            for (i = 0; i < s_sCrash.u32StackWords; i++)
+                s_sCrash.au32Stack[i] = pu32Frame[8UL + i];
+        }
+
+        s_sCrash.u32Sum = CRASH_Sum(pu32Record);
+
+        SYS_UnlockReg();
+        CLK->PWRCTL |= CLK_PWRCTL_HIRCEN_Msk;
+
+        while ((CLK->STATUS & CLK_STATUS_HIRCSTB_Msk) == 0);
+
+        CRASH_IspOn();
+
+        if (FMC_Erase(s_u32CrashBase) == 0)
+        {
+            for (i = 0; i < CRASH_RECORD_WORDS; i++)
+                FMC_Write(s_u32CrashBase + (i << 2), pu32Record[i]);
+        }
+    }
+
+    NVIC_SystemReset();
+}
+
+/**
+  * @brief      Hard fault hook of retarget.c
+  *
+  * @param[in]  lr      LR value at the exception entry.
+  * @param[in]  msp     Main stack pointer at the exception entry.
+  * @param[in]  psp     Process stack pointer at the exception entry.
+  *
+  * @return     None, does not return
+  *
+  * @details    Overrides the weak ProcessHardFault of retarget.c, so linking this driver turns every hard fault
+  *             into a crash record and a reset.
+  */
+uint32_t ProcessHardFault(uint32_t lr, uint32_t msp, uint32_t psp)
+{
+    CRASH_Capture((uint32_t *)((lr & 4UL) ? psp : msp), lr);
+
+    return lr;
+}
+
+/*@}*/ /* end of group CRASH_EXPORTED_FUNCTIONS */
+
+/*@}*/ /* end of group CRASH_Driver */
+
+/*@}*/ /* end of group Standard_Driver */
+
+/*** (C) COPYRIGHT 2021 Nuvoton Technology Corp. ***/
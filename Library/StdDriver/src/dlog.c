@@ -0,0 +1,305 @@
+/**************************************************************************//**
+ * @file     dlog.c
+ * @version  V1.00
+ * @brief    NUC121 series deferred binary log source file
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * @copyright (C) 2021 Nuvoton Technology Corp. All rights reserved.
+*****************************************************************************/
+#include <stdio.h>
+#include "NuMicro.h"
+
+/** @addtogroup Standard_Driver Standard Driver
+  @{
+*/
+
+/** @addtogroup DLOG_Driver DLOG Driver
+  @{
+*/
+
+/// @cond HIDDEN_SYMBOLS
+
+#define DLOG_BUF_MASK           (DLOG_BUF_WORDS - 1UL)
+#define DLOG_CH_NONE            (0xFFFFFFFFUL)
+/* Largest chunk of one basic PDMA transfer, in words */
+#define DLOG_CHUNK_MAX          (((PDMA_DSCT_CTL_TXCNT_Msk >> PDMA_DSCT_CTL_TXCNT_Pos) + 1UL) / 4UL)
+
+static uint32_t s_au32DlogBuf[DLOG_BUF_WORDS];
+static volatile uint32_t s_u32DlogHead;     /* Words written since open, moved by writers with interrupts masked */
+static volatile uint32_t s_u32DlogTail;     /* Words sent since open, moved by the drain only */
+static uint32_t s_u32DlogSending;           /* Words of the PDMA transfer in progress */
+static volatile uint32_t s_u32DlogDropped;  /* Records dropped since the last report */
+static volatile uint32_t s_u32DlogDroppedTotal;
+static uint32_t s_u32DlogCh = DLOG_CH_NONE;
+
+/* Store one record. Must be called with interrupts disabled. */
+static __INLINE uint32_t DLOG_Put(uint32_t u32Fmt, uint32_t u32Args, uint32_t u32A, uint32_t u32B, uint32_t u32C, uint32_t u32D)
+{
+    uint32_t u32Head = s_u32DlogHead;
+
+    if ((u32Head - s_u32DlogTail) >= (DLOG_BUF_WORDS - u32Args))
+        return 0;
+
+    switch (u32Args)
+    {
+        case 4:
+            s_au32DlogBuf[(u32Head + 4UL) & DLOG_BUF_MASK] = u32D;
+
+        /* fall through */
+        case 3:
+            s_au32DlogBuf[(u32Head + 3UL) & DLOG_BUF_MASK] = u32C;
+
+        /* fall through */
+        case 2:
+            s_au32DlogBuf[(u32Head + 2UL) & DLOG_BUF_MASK] = u32B;
+
+        /* fall through */
+        case 1:
+            s_au32DlogBuf[(u32Head + 1UL) & DLOG_BUF_MASK] = u32A;
+
+        /* fall through */
+        default:
+            s_au32DlogBuf[u32Head & DLOG_BUF_MASK] = DLOG_SYNC | (u32Args << DLOG_ARGS_POS) | (u32Fmt & DLOG_ID_MSK);
+    }
+
+    s_u32DlogHead = u32Head + 1UL + u32Args;
+
+    return 1;
+}
+
+/* Report the records lost since the last report as soon as the ring has room for it */
+static void DLOG_ReportDropped(void)
+{
+    uint32_t u32PriMask;
+
+    if (s_u32DlogDropped == 0)
+        return;
+
+    u32PriMask = __get_PRIMASK();
+    __set_PRIMASK(1);
+
+    if (DLOG_Put(DLOG_ID_DROPPED, 1UL, s_u32DlogDropped, 0UL, 0UL, 0UL))
+        s_u32DlogDropped = 0;
+
+    __set_PRIMASK(u32PriMask);
+}
+
+/* Retire the PDMA transfer in progress, return 0 if it is still running */
+static uint32_t DLOG_Retire(void)
+{
+    if (s_u32DlogSending == 0)
+        return 1;
+
+    if ((PDMA->DSCT[s_u32DlogCh].CTL & PDMA_DSCT_CTL_OPMODE_Msk) != PDMA_OP_IDLE)
+        return 0;
+
+    PDMA_CLR_TD_FLAG(1UL << s_u32DlogCh);
+    s_u32DlogTail += s_u32DlogSending;
+    s_u32DlogSending = 0;
+
+    return 1;
+}
+
+/// @endcond HIDDEN_SYMBOLS
+
+
+/** @addtogroup DLOG_EXPORTED_FUNCTIONS DLOG Exported Functions
+  @{
+*/
+
+/**
+  * @brief      Drain the log ring to the debug port by PDMA
+  *
+  * @param[in]  u32PdmaCh   PDMA channel for the debug port TX.
+  *
+  * @return     None
+  *
+  * @details    The debug port must be opened by \ref UART_Open first. Records logged before the call stay in the
+  *             ring and go out with the first \ref DLOG_Poll. Characters from printf and records interleave on the
+  *             port, call \ref DLOG_Flush before printing text.
+  */
+void DLOG_Open(uint32_t u32PdmaCh)
+{
+    s_u32DlogCh = u32PdmaCh;
+    s_u32DlogSending = 0;
+
+    PDMA_Open(1UL << u32PdmaCh);
+    PDMA_SetTransferMode(u32PdmaCh, PDMA_UART0_TX, FALSE, 0);
+    PDMA->DSCT[u32PdmaCh].CTL = PDMA_OP_IDLE;
+    PDMA->DSCT[u32PdmaCh].DA = (uint32_t)&DEBUG_PORT->DAT;
+
+    UART_PDMA_ENABLE(DEBUG_PORT, UART_INTEN_TXPDMAEN_Msk);
+}
+
+/**
+  * @brief      Stop draining the log ring
+  *
+  * @return     None
+  *
+  * @details    Waits for the PDMA transfer in progress. Records not sent yet stay in the ring.
+  */
+void DLOG_Close(void)
+{
+    if (s_u32DlogCh == DLOG_CH_NONE)
+        return;
+
+    while (DLOG_Retire() == 0);
+
+    UART_PDMA_DISABLE(DEBUG_PORT, UART_INTEN_TXPDMAEN_Msk);
+    PDMA->CHCTL &= ~(1UL << s_u32DlogCh);
+    s_u32DlogCh = DLOG_CH_NONE;
+}
+
+/**
+  * @brief      Store a record in the log ring
+  *
+  * @param[in]  u32Fmt      Address of the format string, the record ID.
+  * @param[in]  u32Args     Number of arguments, 0 to \ref DLOG_ARG_MAX.
+  * @param[in]  u32A        First argument.
+  * @param[in]  u32B        Second argument.
+  * @param[in]  u32C        Third argument.
+  * @param[in]  u32D        Fourth argument.
+  *
+  * @return     None
+  *
+  * @details    Use the DLOG0 to DLOG4 macros instead of calling this directly. Nothing is formatted and nothing
+  *             waits for the port, the record is a few word stores with interrupts masked. Cortex-M0 has no
+  *             exclusive access instructions, so the short masked section is what keeps writers from different
+  *             interrupt levels apart. A record that does not fit is dropped and counted.
+  */
+void DLOG_Write(uint32_t u32Fmt, uint32_t u32Args, uint32_t u32A, uint32_t u32B, uint32_t u32C, uint32_t u32D)
+{
+    uint32_t u32PriMask = __get_PRIMASK();
+
+    __set_PRIMASK(1);
+
+    if (DLOG_Put(u32Fmt, u32Args, u32A, u32B, u32C, u32D) == 0)
+    {
+        s_u32DlogDropped++;
+        s_u32DlogDroppedTotal++;
+    }
+
+    __set_PRIMASK(u32PriMask);
+}
+
+/**
+  * @brief      Move logged records to the debug port
+  *
+  * @return     Words in the ring not yet sent, 0 if the log is idle
+  *
+  * @details    Call from the main loop or idle time. Starts a PDMA transfer of the longest contiguous run of
+  *             records once the previous one is done, so the port is fed without the CPU. Only one context may
+  *             call it. Does nothing before \ref DLOG_Open.
+  */
+uint32_t DLOG_Poll(void)
+{
+    uint32_t u32Idx, u32Words;
+
+    if (s_u32DlogCh == DLOG_CH_NONE)
+        return 0;
+
+    if (DLOG_Retire() == 0)
+        return (s_u32DlogHead - s_u32DlogTail);
+
+    DLOG_ReportDropped();
+
+    u32Words = s_u32DlogHead - s_u32DlogTail;
+
+    if (u32Words == 0)
+        return 0;
+
+    u32Idx = s_u32DlogTail & DLOG_BUF_MASK;
+
+    if (u32Words > (DLOG_BUF_WORDS - u32Idx))
+        u32Words = DLOG_BUF_WORDS - u32Idx;
+
+    if (u32Words > DLOG_CHUNK_MAX)
+        u32Words = DLOG_CHUNK_MAX;
+
+    s_u32DlogSending = u32Words;
+
+    PDMA->DSCT[s_u32DlogCh].SA = (uint32_t)&s_au32DlogBuf[u32Idx];
+    PDMA->DSCT[s_u32DlogCh].CTL = (((u32Words << 2) - 1UL) << PDMA_DSCT_CTL_TXCNT_Pos) | PDMA_WIDTH_8 |
+                                  PDMA_SAR_INC | PDMA_DAR_FIX | PDMA_REQ_SINGLE | PDMA_OP_BASIC;
+
+    return (s_u32DlogHead - s_u32DlogTail);
+}
+
+/**
+  * @brief      Send all logged records
+  *
+  * @return     None
+  *
+  * @details    Blocks until the ring is empty and the debug port has shifted out the last byte, for example
+  *             before printf or a reset. Does nothing before \ref DLOG_Open.
+  */
+void DLOG_Flush(void)
+{
+    if (s_u32DlogCh == DLOG_CH_NONE)
+        return;
+
+    while (DLOG_Poll() != 0);
+
+    UART_WAIT_TX_EMPTY(DEBUG_PORT);
+}
+
+/**
+  * @brief      Print logged records as text
+  *
+  * @return     None
+  *
+  * @details    On-chip decoder for a terminal without the host decoder. Each record is formatted by printf from
+  *             its format string in flash, so this costs what printf costs and belongs in the main loop only.
+  *             Records are taken from the ring and are not sent in binary form.
+  */
+void DLOG_Print(void)
+{
+    uint32_t u32Hdr, u32Args, u32Tail, au32Arg[DLOG_ARG_MAX], i;
+
+    if (s_u32DlogCh != DLOG_CH_NONE)
+    {
+        while (DLOG_Retire() == 0);
+    }
+
+    DLOG_ReportDropped();
+
+    while ((u32Tail = s_u32DlogTail) != s_u32DlogHead)
+    {
+        u32Hdr = s_au32DlogBuf[u32Tail & DLOG_BUF_MASK];
+        u32Args = (u32Hdr & DLOG_ARGS_MSK) >> DLOG_ARGS_POS;
+
+        if (((u32Hdr & DLOG_SYNC_MSK) != DLOG_SYNC) || (u32Args > DLOG_ARG_MAX))
+        {
+            s_u32DlogTail = u32Tail + 1UL;
+            continue;
+        }
+
+        for (i = 0; i < DLOG_ARG_MAX; i++)
+            au32Arg[i] = (i < u32Args) ? s_au32DlogBuf[(u32Tail + 1UL + i) & DLOG_BUF_MASK] : 0UL;
+
+        s_u32DlogTail = u32Tail + 1UL + u32Args;
+
+        if ((u32Hdr & DLOG_ID_MSK) == DLOG_ID_DROPPED)
+            printf("[dlog] %u records dropped\n", (unsigned int)au32Arg[0]);
+        else
+            printf((const char *)(u32Hdr & DLOG_ID_MSK), au32Arg[0], au32Arg[1], au32Arg[2], au32Arg[3]);
+    }
+}
+
+/**
+  * @brief      Get the number of records dropped because the ring was full
+  *
+  * @return     Dropped records since reset
+  */
+uint32_t DLOG_GetDropped(void)
+{
+    return s_u32DlogDroppedTotal;
+}
+
+/*@}*/ /* end of group DLOG_EXPORTED_FUNCTIONS */
+
+/*@}*/ /* end of group DLOG_Driver */
+
+/*@}*/ /* end of group Standard_Driver */
+
+/*** (C) COPYRIGHT 2021 Nuvoton Technology Corp. ***/
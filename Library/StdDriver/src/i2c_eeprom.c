@@ -0,0 +1,345 @@
+/**************************************************************************//**
+ * @file     i2c_eeprom.c
+ * @version  V1.00
+ * @brief    NUC121 series paged 24Cxx I2C EEPROM driver source file
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * @copyright (C) 2021 Nuvoton Technology Corp. All rights reserved.
+*****************************************************************************/
+#include <string.h>
+#include "NuMicro.h"
+
+/** @addtogroup Standard_Driver Standard Driver
+  @{
+*/
+
+/** @addtogroup I2C_EEPROM_Driver I2C_EEPROM Driver
+  @{
+*/
+
+/// @cond HIDDEN_SYMBOLS
+
+#define I2C_EEPROM_NO_LINE      (0xFFFFFFFFUL)
+#define I2C_EEPROM_1BYTE_MAX    (2048UL)    /* 24C01 to 24C16 take address bits 10..8 in the slave address */
+#define I2C_EEPROM_2BYTE_MAX    (65536UL)
+
+/* One transaction at a memory address, one-byte devices take the upper address bits in the slave address */
+static int32_t I2C_EEPROM_Xfer(S_I2C_EEPROM_T *psDev, uint32_t u32Addr, const uint8_t *pu8Tx, uint32_t u32TxLen,
+                               uint8_t *pu8Rx, uint32_t u32RxLen)
+{
+    uint8_t u8Slave = psDev->u8SlaveAddr;
+
+    if (psDev->u8AddrLen == 1)
+        u8Slave |= (uint8_t)((u32Addr >> 8) & 0x07UL);
+
+    I2C_XFER_Setup(&psDev->sXfer, u8Slave, (uint16_t)u32Addr, psDev->u8AddrLen, pu8Tx, u32TxLen, pu8Rx, u32RxLen);
+
+    return I2C_XFER_Transfer(psDev->psBus, &psDev->sXfer);
+}
+
+/* The device ignores its address until the internal write cycle ends, so poll instead of a worst case delay */
+static int32_t I2C_EEPROM_Poll(S_I2C_EEPROM_T *psDev)
+{
+    uint32_t i;
+    int32_t i32Ret;
+
+    if (psDev->u8WriteBusy == 0)
+        return 0;
+
+    for (i = 0; i < psDev->u32PollMax; i++)
+    {
+        I2C_XFER_Setup(&psDev->sXfer, psDev->u8SlaveAddr, 0, 0, NULL, 0, NULL, 0);
+        i32Ret = I2C_XFER_Transfer(psDev->psBus, &psDev->sXfer);
+
+        if (i32Ret == I2C_XFER_OK)
+        {
+            psDev->u8WriteBusy = 0;
+            return 0;
+        }
+
+        if (i32Ret != I2C_XFER_ERR_NACK)
+            return i32Ret;
+
+        psDev->u32Polls++;
+    }
+
+    return I2C_EEPROM_ERR_BUSY;
+}
+
+/* Sequential read, one-byte devices cannot cross a 256 bytes block */
+static int32_t I2C_EEPROM_ReadRaw(S_I2C_EEPROM_T *psDev, uint32_t u32Addr, uint8_t *pu8Buf, uint32_t u32Len)
+{
+    uint32_t u32Len1;
+    int32_t i32Ret;
+
+    while (u32Len != 0)
+    {
+        u32Len1 = u32Len;
+
+        if ((psDev->u8AddrLen == 1) && (u32Len1 > (256UL - (u32Addr & 0xFFUL))))
+            u32Len1 = 256UL - (u32Addr & 0xFFUL);
+
+        i32Ret = I2C_EEPROM_Xfer(psDev, u32Addr, NULL, 0, pu8Buf, u32Len1);
+
+        if (i32Ret != I2C_XFER_OK)
+            return i32Ret;
+
+        u32Addr += u32Len1;
+        pu8Buf += u32Len1;
+        u32Len -= u32Len1;
+    }
+
+    return 0;
+}
+
+static int32_t I2C_EEPROM_BlkRead(void *pvDev, uint32_t u32Block, uint8_t *pu8Buf, uint32_t u32Count)
+{
+    S_I2C_EEPROM_T *psDev = (S_I2C_EEPROM_T *)pvDev;
+
+    return I2C_EEPROM_Read(psDev, u32Block * psDev->u32PageSize, pu8Buf, u32Count * psDev->u32PageSize);
+}
+
+static int32_t I2C_EEPROM_BlkWrite(void *pvDev, uint32_t u32Block, const uint8_t *pu8Buf, uint32_t u32Count)
+{
+    S_I2C_EEPROM_T *psDev = (S_I2C_EEPROM_T *)pvDev;
+
+    return I2C_EEPROM_Write(psDev, u32Block * psDev->u32PageSize, pu8Buf, u32Count * psDev->u32PageSize);
+}
+
+static int32_t I2C_EEPROM_BlkSync(void *pvDev)
+{
+    return I2C_EEPROM_Sync((S_I2C_EEPROM_T *)pvDev);
+}
+
+/// @endcond HIDDEN_SYMBOLS
+
+/** @addtogroup I2C_EEPROM_EXPORTED_FUNCTIONS I2C_EEPROM Exported Functions
+  @{
+*/
+
+/**
+  * @brief      Attach a 24Cxx EEPROM
+  *
+  * @param[in]  psDev       The pointer of the device context.
+  * @param[in]  psBus       Queued master opened by \ref I2C_XFER_Open or \ref UI2C_XFER_Open.
+  * @param[in]  u8SlaveAddr 7-bit slave address, 0x50 with A2..A0 pins.
+  * @param[in]  u32Size     Device size in bytes, for example 8192 for 24C64.
+  * @param[in]  u32PageSize Write page size in bytes from the data sheet, for example 32 for 24C64.
+  *
+  * @retval     0           Success
+  * @retval     -1          Unsupported size or page size
+  *
+  * @details    Devices up to 2 KB use one word address byte and the slave address bits for the block.
+  *             Larger devices up to 64 KB use two word address bytes. Page size and cache line are
+  *             powers of 2, and the cache line must not be larger than the device.
+  */
+int32_t I2C_EEPROM_Open(S_I2C_EEPROM_T *psDev, S_I2C_XFER_BUS_T *psBus, uint8_t u8SlaveAddr, uint32_t u32Size, uint32_t u32PageSize)
+{
+    if ((u32PageSize == 0) || (u32PageSize > 256UL) || ((u32PageSize & (u32PageSize - 1UL)) != 0) ||
+            (u32Size < u32PageSize) || (u32Size < I2C_EEPROM_CACHE_SIZE) || (u32Size > I2C_EEPROM_2BYTE_MAX))
+        return -1;
+
+    psDev->psBus = psBus;
+    psDev->u8SlaveAddr = u8SlaveAddr;
+    psDev->u8AddrLen = (u32Size <= I2C_EEPROM_1BYTE_MAX) ? 1 : 2;
+    psDev->u8WriteBusy = 0;
+    psDev->u32Size = u32Size;
+    psDev->u32PageSize = u32PageSize;
+    psDev->u32PollMax = I2C_EEPROM_POLL_MAX;
+    psDev->u32CacheAddr = I2C_EEPROM_NO_LINE;
+    psDev->u32PageWrites = 0;
+    psDev->u32Polls = 0;
+    psDev->u32CacheHits = 0;
+    psDev->u32CacheMisses = 0;
+    psDev->sXfer.i32Status = I2C_XFER_OK;
+
+    return 0;
+}
+
+/**
+  * @brief      Read from the EEPROM
+  *
+  * @param[in]  psDev       The pointer of the device context.
+  * @param[in]  u32Addr     Memory address.
+  * @param[out] pu8Buf      Buffer for the data.
+  * @param[in]  u32Len      Number of bytes.
+  *
+  * @retval     0                       Success
+  * @retval     I2C_EEPROM_ERR_RANGE    Access beyond the end of the device
+  * @retval     I2C_EEPROM_ERR_BUSY     Previous write cycle did not end
+  * @retval     <0                      I2C_XFER_ERR_xxx of the bus
+  *
+  * @details    Reads shorter than a cache line are served from one cached line, so consecutive reads of small
+  *             parameters cost one bus transaction. Longer reads go to the device in one sequential read.
+  *             The bus must not be used from interrupt context by this API.
+  */
+int32_t I2C_EEPROM_Read(S_I2C_EEPROM_T *psDev, uint32_t u32Addr, uint8_t *pu8Buf, uint32_t u32Len)
+{
+    uint32_t u32Line, u32Off, u32Len1;
+    int32_t i32Ret;
+
+    if ((u32Addr > psDev->u32Size) || (u32Len > (psDev->u32Size - u32Addr)))
+        return I2C_EEPROM_ERR_RANGE;
+
+    i32Ret = I2C_EEPROM_Poll(psDev);
+
+    if (i32Ret != 0)
+        return i32Ret;
+
+    while (u32Len != 0)
+    {
+        u32Line = u32Addr & ~(I2C_EEPROM_CACHE_SIZE - 1UL);
+        u32Off = u32Addr - u32Line;
+        u32Len1 = I2C_EEPROM_CACHE_SIZE - u32Off;
+
+        if (u32Len1 > u32Len)
+            u32Len1 = u32Len;
+
+        if (u32Line == psDev->u32CacheAddr)
+            psDev->u32CacheHits++;
+        else if (u32Len >= I2C_EEPROM_CACHE_SIZE)
+            return I2C_EEPROM_ReadRaw(psDev, u32Addr, pu8Buf, u32Len);
+        else
+        {
+            psDev->u32CacheMisses++;
+            psDev->u32CacheAddr = I2C_EEPROM_NO_LINE;
+            i32Ret = I2C_EEPROM_ReadRaw(psDev, u32Line, psDev->au8Cache, I2C_EEPROM_CACHE_SIZE);
+
+            if (i32Ret != 0)
+                return i32Ret;
+
+            psDev->u32CacheAddr = u32Line;
+        }
+
+        memcpy(pu8Buf, &psDev->au8Cache[u32Off], u32Len1);
+        u32Addr += u32Len1;
+        pu8Buf += u32Len1;
+        u32Len -= u32Len1;
+    }
+
+    return 0;
+}
+
+/**
+  * @brief      Write to the EEPROM
+  *
+  * @param[in]  psDev       The pointer of the device context.
+  * @param[in]  u32Addr     Memory address.
+  * @param[in]  pu8Data     Data to write.
+  * @param[in]  u32Len      Number of bytes.
+  *
+  * @retval     0                       Success
+  * @retval     I2C_EEPROM_ERR_RANGE    Access beyond the end of the device
+  * @retval     I2C_EEPROM_ERR_BUSY     A write cycle did not end
+  * @retval     <0                      I2C_XFER_ERR_xxx of the bus
+  *
+  * @details    Data is split on page boundaries so each page is written by one transaction and one internal
+  *             write cycle, instead of one cycle per byte. The end of each cycle is detected by ACK polling.
+  *             This API returns while the last cycle is still running, the next access or
+  *             \ref I2C_EEPROM_Sync waits for it. The read cache is kept up to date.
+  */
+int32_t I2C_EEPROM_Write(S_I2C_EEPROM_T *psDev, uint32_t u32Addr, const uint8_t *pu8Data, uint32_t u32Len)
+{
+    uint32_t u32Len1, u32Start, u32End;
+    int32_t i32Ret;
+
+    if ((u32Addr > psDev->u32Size) || (u32Len > (psDev->u32Size - u32Addr)))
+        return I2C_EEPROM_ERR_RANGE;
+
+    while (u32Len != 0)
+    {
+        /* A page write wraps inside the page, so never cross a page boundary */
+        u32Len1 = psDev->u32PageSize - (u32Addr & (psDev->u32PageSize - 1UL));
+
+        if (u32Len1 > u32Len)
+            u32Len1 = u32Len;
+
+        i32Ret = I2C_EEPROM_Poll(psDev);
+
+        if (i32Ret == 0)
+            i32Ret = I2C_EEPROM_Xfer(psDev, u32Addr, pu8Data, u32Len1, NULL, 0);
+
+        if (i32Ret != 0)
+        {
+            /* The content of the page is unknown now */
+            psDev->u32CacheAddr = I2C_EEPROM_NO_LINE;
+            return i32Ret;
+        }
+
+        psDev->u8WriteBusy = 1;
+        psDev->u32PageWrites++;
+
+        /* Write through the cached line */
+        if (psDev->u32CacheAddr != I2C_EEPROM_NO_LINE)
+        {
+            u32Start = (u32Addr > psDev->u32CacheAddr) ? u32Addr : psDev->u32CacheAddr;
+            u32End = ((u32Addr + u32Len1) < (psDev->u32CacheAddr + I2C_EEPROM_CACHE_SIZE)) ?
+                     (u32Addr + u32Len1) : (psDev->u32CacheAddr + I2C_EEPROM_CACHE_SIZE);
+
+            if (u32Start < u32End)
+                memcpy(&psDev->au8Cache[u32Start - psDev->u32CacheAddr], &pu8Data[u32Start - u32Addr], u32End - u32Start);
+        }
+
+        u32Addr += u32Len1;
+        pu8Data += u32Len1;
+        u32Len -= u32Len1;
+    }
+
+    return 0;
+}
+
+/**
+  * @brief      Wait for the last write cycle
+  *
+  * @param[in]  psDev       The pointer of the device context.
+  *
+  * @retval     0                       Data is stored
+  * @retval     I2C_EEPROM_ERR_BUSY     The write cycle did not end
+  * @retval     <0                      I2C_XFER_ERR_xxx of the bus
+  *
+  * @details    Call it before power is removed or before another master accesses the device.
+  */
+int32_t I2C_EEPROM_Sync(S_I2C_EEPROM_T *psDev)
+{
+    return I2C_EEPROM_Poll(psDev);
+}
+
+/**
+  * @brief      Drop the read cache
+  *
+  * @param[in]  psDev       The pointer of the device context.
+  *
+  * @return     None
+  *
+  * @details    Needed only if the device is written by another master.
+  */
+void I2C_EEPROM_Invalidate(S_I2C_EEPROM_T *psDev)
+{
+    psDev->u32CacheAddr = I2C_EEPROM_NO_LINE;
+}
+
+/**
+  * @brief      Get the block device interface of the EEPROM
+  *
+  * @param[in]  psDev       The pointer of the device context.
+  * @param[out] psBlk       Block device, one block per write page.
+  *
+  * @return     None
+  */
+void I2C_EEPROM_GetBlockDev(S_I2C_EEPROM_T *psDev, S_BLKDEV_T *psBlk)
+{
+    psBlk->pvDev = psDev;
+    psBlk->u32BlockSize = psDev->u32PageSize;
+    psBlk->u32BlockNum = psDev->u32Size / psDev->u32PageSize;
+    psBlk->pfnRead = I2C_EEPROM_BlkRead;
+    psBlk->pfnWrite = I2C_EEPROM_BlkWrite;
+    psBlk->pfnSync = I2C_EEPROM_BlkSync;
+}
+
+/*@}*/ /* end of group I2C_EEPROM_EXPORTED_FUNCTIONS */
+
+/*@}*/ /* end of group I2C_EEPROM_Driver */
+
+/*@}*/ /* end of group Standard_Driver */
+
+/*** (C) COPYRIGHT 2021 Nuvoton Technology Corp. ***/
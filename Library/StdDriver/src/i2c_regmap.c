@@ -0,0 +1,474 @@
+/**************************************************************************//**
+ * @file     i2c_regmap.c
+ * @version  V1.00
+ * @brief    NUC121 series I2C slave register map service source file
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * @copyright (C) 2021 Nuvoton Technology Corp. All rights reserved.
+*****************************************************************************/
+#include "NuMicro.h"
+
+/** @addtogroup Standard_Driver Standard Driver
+  @{
+*/
+
+/** @addtogroup I2C_REGMAP_Driver I2C_REGMAP Driver
+  @{
+*/
+
+/// @cond HIDDEN_SYMBOLS
+
+static void I2C_REGMAP_CopyFrom(S_I2C_REGMAP_WIN_T *psWin, uint32_t u32Reg, uint8_t *pu8Buf, uint32_t u32Len)
+{
+    while (u32Len--)
+    {
+        *pu8Buf++ = psWin->pu8Map[u32Reg];
+
+        if (++u32Reg >= psWin->u32Size)
+            u32Reg = 0;
+    }
+}
+
+static void I2C_REGMAP_CopyTo(S_I2C_REGMAP_WIN_T *psWin, uint32_t u32Reg, const uint8_t *pu8Data, uint32_t u32Len)
+{
+    while (u32Len--)
+    {
+        psWin->pu8Map[u32Reg] = *pu8Data++;
+
+        if (++u32Reg >= psWin->u32Size)
+            u32Reg = 0;
+    }
+}
+
+static void I2C_REGMAP_StartPDMA(uint32_t u32Ch, uint32_t u32Periph, uint32_t u32Src, uint32_t u32SrcCtrl,
+                                 uint32_t u32Dst, uint32_t u32DstCtrl, uint32_t u32Len)
+{
+    PDMA->TDSTS = (1UL << u32Ch);
+    PDMA_SetTransferCnt(u32Ch, PDMA_WIDTH_8, u32Len);
+    PDMA_SetTransferAddr(u32Ch, u32Src, u32SrcCtrl, u32Dst, u32DstCtrl);
+    PDMA_SetBurstType(u32Ch, PDMA_REQ_SINGLE, 0);
+    PDMA_SetTransferMode(u32Ch, u32Periph, 0, 0);
+}
+
+/* Let PDMA answer the data ACK requests until the staging buffer is full */
+static void I2C_REGMAP_StartRx(S_I2C_REGMAP_T *psMap)
+{
+    I2C_T *i2c = psMap->i2c;
+
+    if ((psMap->u32PdmaRxCh == I2C_REGMAP_NO_PDMA) || (psMap->u32Count >= I2C_REGMAP_STAGE_SIZE))
+        return;
+
+    I2C_REGMAP_StartPDMA(psMap->u32PdmaRxCh, (i2c == I2C0) ? PDMA_I2C0_RX : PDMA_I2C1_RX,
+                         (uint32_t)&i2c->DAT, PDMA_SAR_FIX, (uint32_t)&psMap->au8Stage[psMap->u32Count], PDMA_DAR_INC,
+                         I2C_REGMAP_STAGE_SIZE - psMap->u32Count);
+    psMap->u32Stage = I2C_REGMAP_STAGE_SIZE;
+    i2c->CTL1 |= I2C_CTL1_RXPDMAEN_Msk;
+}
+
+/* Count what PDMA has received, TXCNT counts down and an idle channel has moved every byte */
+static void I2C_REGMAP_StopRx(S_I2C_REGMAP_T *psMap)
+{
+    uint32_t u32Ctl;
+
+    if ((psMap->i2c->CTL1 & I2C_CTL1_RXPDMAEN_Msk) == 0)
+        return;
+
+    psMap->i2c->CTL1 &= ~I2C_CTL1_RXPDMAEN_Msk;
+    u32Ctl = PDMA->DSCT[psMap->u32PdmaRxCh].CTL;
+
+    if (u32Ctl & PDMA_DSCT_CTL_OPMODE_Msk)
+    {
+        PDMA->DSCT[psMap->u32PdmaRxCh].CTL = u32Ctl & ~PDMA_DSCT_CTL_OPMODE_Msk;
+        psMap->u32Count = psMap->u32Stage - (((u32Ctl & PDMA_DSCT_CTL_TXCNT_Msk) >> PDMA_DSCT_CTL_TXCNT_Pos) + 1UL);
+    }
+    else
+        psMap->u32Count = psMap->u32Stage;
+}
+
+/* PDMA sent the snapshot, or the master stopped reading early */
+static void I2C_REGMAP_StopTx(S_I2C_REGMAP_T *psMap)
+{
+    if ((psMap->i2c->CTL1 & I2C_CTL1_TXPDMAEN_Msk) == 0)
+        return;
+
+    psMap->i2c->CTL1 &= ~I2C_CTL1_TXPDMAEN_Msk;
+    PDMA->DSCT[psMap->u32PdmaTxCh].CTL &= ~PDMA_DSCT_CTL_OPMODE_Msk;
+    psMap->u32Count = psMap->u32Stage;
+}
+
+/* Move staged bytes to the register file in one step */
+static void I2C_REGMAP_Commit(S_I2C_REGMAP_T *psMap)
+{
+    S_I2C_REGMAP_WIN_T *psWin = &psMap->asWin[psMap->u32Win];
+    uint32_t u32Reg = psMap->u32Commit, u32Len = psMap->u32Count;
+
+    if (u32Len == 0)
+        return;
+
+    psMap->u32Count = 0;
+    psMap->u32Commit = (u32Reg + u32Len) % psWin->u32Size;
+
+    if (psWin->u8ReadOnly)
+    {
+        psMap->u32Dropped += u32Len;
+        return;
+    }
+
+    I2C_REGMAP_CopyTo(psWin, u32Reg, psMap->au8Stage, u32Len);
+    psMap->u32Writes++;
+
+    if (psMap->pfnWrite != NULL)
+        psMap->pfnWrite(psMap, psMap->u32Win, u32Reg, u32Len);
+}
+
+/* The data register holds the received address byte, match it like the controller did */
+static void I2C_REGMAP_Select(S_I2C_REGMAP_T *psMap)
+{
+    uint32_t i, u32Addr = (I2C_GET_DATA(psMap->i2c) >> 1) & 0x7FUL;
+
+    for (i = 0; i < psMap->u32WinNum; i++)
+    {
+        if (((u32Addr ^ psMap->asWin[i].u8SlaveAddr) & ~(uint32_t)psMap->asWin[i].u8Mask & 0x7FUL) == 0)
+        {
+            psMap->u32Win = i;
+            return;
+        }
+    }
+
+    psMap->u32Win = 0;
+}
+
+/* Own SLA+R, take the snapshot and send it */
+static void I2C_REGMAP_ReadStart(S_I2C_REGMAP_T *psMap)
+{
+    I2C_T *i2c = psMap->i2c;
+    S_I2C_REGMAP_WIN_T *psWin = &psMap->asWin[psMap->u32Win];
+    uint32_t u32Len = (psWin->u32Size < I2C_REGMAP_STAGE_SIZE) ? psWin->u32Size : I2C_REGMAP_STAGE_SIZE;
+
+    psMap->u32Reg %= psWin->u32Size;
+    I2C_REGMAP_CopyFrom(psWin, psMap->u32Reg, psMap->au8Stage, u32Len);
+    psMap->u32Stage = u32Len;
+    psMap->u32Reads++;
+
+    I2C_SET_DATA(i2c, psMap->au8Stage[0]);
+    psMap->u32Count = 1;
+
+    if ((psMap->u32PdmaTxCh != I2C_REGMAP_NO_PDMA) && (u32Len > 1))
+    {
+        I2C_REGMAP_StartPDMA(psMap->u32PdmaTxCh, (i2c == I2C0) ? PDMA_I2C0_TX : PDMA_I2C1_TX,
+                             (uint32_t)&psMap->au8Stage[1], PDMA_SAR_INC, (uint32_t)&i2c->DAT, PDMA_DAR_FIX, u32Len - 1UL);
+        i2c->CTL1 |= I2C_CTL1_TXPDMAEN_Msk;
+    }
+}
+
+/// @endcond HIDDEN_SYMBOLS
+
+/** @addtogroup I2C_REGMAP_EXPORTED_FUNCTIONS I2C_REGMAP Exported Functions
+  @{
+*/
+
+/**
+  * @brief      Open an I2C controller as a register map slave
+  *
+  * @param[in]  psMap       The pointer of the register map context.
+  * @param[in]  i2c         I2C controller, I2C0 or I2C1.
+  * @param[in]  u32BusClock Bus clock in Hz, up to 1 MHz.
+  * @param[in]  u32RegLen   Register address length sent by the master, 1 or 2 bytes.
+  *
+  * @return     Actual bus clock in Hz
+  *
+  * @details    The controller does not answer until the first window is added. Enable the NVIC interrupt and
+  *             call \ref I2C_REGMAP_IRQHandler from I2Cn_IRQHandler.
+  */
+uint32_t I2C_REGMAP_Open(S_I2C_REGMAP_T *psMap, I2C_T *i2c, uint32_t u32BusClock, uint32_t u32RegLen)
+{
+    uint32_t u32Clk;
+
+    psMap->i2c = i2c;
+    psMap->u32WinNum = 0;
+    psMap->u32RegLen = (u32RegLen == 2) ? 2 : 1;
+    psMap->u32PdmaTxCh = I2C_REGMAP_NO_PDMA;
+    psMap->u32PdmaRxCh = I2C_REGMAP_NO_PDMA;
+    psMap->pfnWrite = NULL;
+    psMap->u32Win = 0;
+    psMap->u32Reg = 0;
+    psMap->u32AddrCnt = 0;
+    psMap->u32Count = 0;
+    psMap->u32Stage = 0;
+    psMap->u32Commit = 0;
+    psMap->u32Writes = 0;
+    psMap->u32Reads = 0;
+    psMap->u32Dropped = 0;
+
+    u32Clk = I2C_Open(i2c, u32BusClock);
+    I2C_EnableInt(i2c);
+
+    return u32Clk;
+}
+
+/**
+  * @brief      Close a register map slave
+  *
+  * @param[in]  psMap       The pointer of the register map context.
+  *
+  * @return     None
+  */
+void I2C_REGMAP_Close(S_I2C_REGMAP_T *psMap)
+{
+    if (psMap->u32PdmaTxCh != I2C_REGMAP_NO_PDMA)
+        PDMA->DSCT[psMap->u32PdmaTxCh].CTL &= ~PDMA_DSCT_CTL_OPMODE_Msk;
+
+    if (psMap->u32PdmaRxCh != I2C_REGMAP_NO_PDMA)
+        PDMA->DSCT[psMap->u32PdmaRxCh].CTL &= ~PDMA_DSCT_CTL_OPMODE_Msk;
+
+    I2C_DisableInt(psMap->i2c);
+    I2C_Close(psMap->i2c);
+    psMap->u32WinNum = 0;
+}
+
+/**
+  * @brief      Serve a register file at a slave address
+  *
+  * @param[in]  psMap       The pointer of the register map context.
+  * @param[in]  u8SlaveAddr 7-bit slave address.
+  * @param[in]  u8Mask      Address bits ignored when matching, 0 for a single address.
+  * @param[in]  pu8Map      Register file, owned by the caller.
+  * @param[in]  u32Size     Register file size in bytes.
+  * @param[in]  u32ReadOnly \ref I2C_REGMAP_RW or \ref I2C_REGMAP_RO.
+  *
+  * @return     Window number, or -1 if every slave address register is used
+  *
+  * @details    Each window takes one of the four slave address registers with its address mask.
+  *             Update the register file with \ref I2C_REGMAP_Update while the slave is running.
+  */
+int32_t I2C_REGMAP_AddWindow(S_I2C_REGMAP_T *psMap, uint8_t u8SlaveAddr, uint8_t u8Mask, uint8_t *pu8Map,
+                             uint32_t u32Size, uint32_t u32ReadOnly)
+{
+    uint32_t u32Win = psMap->u32WinNum;
+
+    if ((u32Win >= I2C_REGMAP_WIN_MAX) || (u32Size == 0))
+        return -1;
+
+    psMap->asWin[u32Win].pu8Map = pu8Map;
+    psMap->asWin[u32Win].u32Size = u32Size;
+    psMap->asWin[u32Win].u8SlaveAddr = u8SlaveAddr;
+    psMap->asWin[u32Win].u8Mask = u8Mask;
+    psMap->asWin[u32Win].u8ReadOnly = (uint8_t)u32ReadOnly;
+    psMap->u32WinNum = u32Win + 1UL;
+
+    I2C_SetSlaveAddr(psMap->i2c, (uint8_t)u32Win, u8SlaveAddr, 0);
+    I2C_SetSlaveAddrMask(psMap->i2c, (uint8_t)u32Win, u8Mask);
+
+    /* Unused address registers repeat the first window, so they never answer another address */
+    for (u32Win = psMap->u32WinNum; u32Win < I2C_REGMAP_WIN_MAX; u32Win++)
+    {
+        I2C_SetSlaveAddr(psMap->i2c, (uint8_t)u32Win, psMap->asWin[0].u8SlaveAddr, 0);
+        I2C_SetSlaveAddrMask(psMap->i2c, (uint8_t)u32Win, psMap->asWin[0].u8Mask);
+    }
+
+    if (psMap->u32WinNum == 1)
+        I2C_SET_CONTROL_REG(psMap->i2c, I2C_CTL_AA);
+
+    return (int32_t)(psMap->u32WinNum - 1UL);
+}
+
+/**
+  * @brief      Move register data by PDMA
+  *
+  * @param[in]  psMap       The pointer of the register map context.
+  * @param[in]  u32TxCh     PDMA channel for master reads, or \ref I2C_REGMAP_NO_PDMA.
+  * @param[in]  u32RxCh     PDMA channel for master writes, or \ref I2C_REGMAP_NO_PDMA.
+  *
+  * @retval     0           Success
+  * @retval     -1          Invalid channel
+  *
+  * @details    Up to \ref I2C_REGMAP_STAGE_SIZE bytes per access are moved by PDMA, so the data phase raises no
+  *             interrupt and SCL is only stretched at the address phase and the end of the access.
+  */
+int32_t I2C_REGMAP_EnablePDMA(S_I2C_REGMAP_T *psMap, uint32_t u32TxCh, uint32_t u32RxCh)
+{
+    if (((u32TxCh != I2C_REGMAP_NO_PDMA) && (u32TxCh >= PDMA_CH_MAX)) ||
+            ((u32RxCh != I2C_REGMAP_NO_PDMA) && (u32RxCh >= PDMA_CH_MAX)))
+        return -1;
+
+    psMap->u32PdmaTxCh = u32TxCh;
+    psMap->u32PdmaRxCh = u32RxCh;
+
+    if (u32TxCh != I2C_REGMAP_NO_PDMA)
+        PDMA_Open(1UL << u32TxCh);
+
+    if (u32RxCh != I2C_REGMAP_NO_PDMA)
+        PDMA_Open(1UL << u32RxCh);
+
+    return 0;
+}
+
+/**
+  * @brief      Set the write notification
+  *
+  * @param[in]  psMap       The pointer of the register map context.
+  * @param[in]  pfnWrite    Called from the interrupt after master data is in the register file, could be NULL.
+  *
+  * @return     None
+  */
+void I2C_REGMAP_SetWriteCallback(S_I2C_REGMAP_T *psMap, I2C_REGMAP_CB pfnWrite)
+{
+    psMap->pfnWrite = pfnWrite;
+}
+
+/**
+  * @brief      Update registers from the application
+  *
+  * @param[in]  psMap       The pointer of the register map context.
+  * @param[in]  u32Win      Window number.
+  * @param[in]  u32Reg      First register.
+  * @param[in]  pu8Data     New register values.
+  * @param[in]  u32Len      Number of bytes.
+  *
+  * @return     None
+  *
+  * @details    A master read started before or after the update sees either all old or all new values,
+  *             for reads up to \ref I2C_REGMAP_STAGE_SIZE bytes.
+  */
+void I2C_REGMAP_Update(S_I2C_REGMAP_T *psMap, uint32_t u32Win, uint32_t u32Reg, const uint8_t *pu8Data, uint32_t u32Len)
+{
+    uint32_t u32PriMask = __get_PRIMASK();
+
+    __set_PRIMASK(1);
+    I2C_REGMAP_CopyTo(&psMap->asWin[u32Win], u32Reg % psMap->asWin[u32Win].u32Size, pu8Data, u32Len);
+    __set_PRIMASK(u32PriMask);
+}
+
+/**
+  * @brief      Read registers from the application
+  *
+  * @param[in]  psMap       The pointer of the register map context.
+  * @param[in]  u32Win      Window number.
+  * @param[in]  u32Reg      First register.
+  * @param[out] pu8Buf      Register values.
+  * @param[in]  u32Len      Number of bytes.
+  *
+  * @return     None
+  *
+  * @details    Master writes up to \ref I2C_REGMAP_STAGE_SIZE bytes are committed at once, so the values are
+  *             never a mix of two writes.
+  */
+void I2C_REGMAP_Snapshot(S_I2C_REGMAP_T *psMap, uint32_t u32Win, uint32_t u32Reg, uint8_t *pu8Buf, uint32_t u32Len)
+{
+    uint32_t u32PriMask = __get_PRIMASK();
+
+    __set_PRIMASK(1);
+    I2C_REGMAP_CopyFrom(&psMap->asWin[u32Win], u32Reg % psMap->asWin[u32Win].u32Size, pu8Buf, u32Len);
+    __set_PRIMASK(u32PriMask);
+}
+
+/**
+  * @brief      I2C register map slave interrupt service
+  *
+  * @param[in]  psMap       The pointer of the register map context.
+  *
+  * @return     None
+  *
+  * @details    Call this API from I2Cn_IRQHandler. A write access is the register address followed by data. A read
+  *             access is a register address write, a repeated START and the read. A read without register address
+  *             starts at the register address of the previous access. Register addresses wrap at the window end.
+  */
+void I2C_REGMAP_IRQHandler(S_I2C_REGMAP_T *psMap)
+{
+    I2C_T *i2c = psMap->i2c;
+    S_I2C_REGMAP_WIN_T *psWin;
+    uint32_t u32Status, u32Data;
+
+    if (I2C_GET_TIMEOUT_FLAG(i2c))
+    {
+        I2C_ClearTimeoutFlag(i2c);
+        return;
+    }
+
+    if ((i2c->CTL & I2C_CTL_SI_Msk) == 0)
+        return;
+
+    u32Status = I2C_GET_STATUS(i2c);
+
+    /* PDMA has moved its part, continue byte by byte */
+    I2C_REGMAP_StopRx(psMap);
+    I2C_REGMAP_StopTx(psMap);
+
+    psWin = &psMap->asWin[psMap->u32Win];
+
+    switch (u32Status)
+    {
+        case 0x60:                                      /* Own SLA+W has been received and ACK returned */
+        case 0x68:                                      /* Arbitration lost, own SLA+W received */
+            I2C_REGMAP_Select(psMap);
+            psMap->u32AddrCnt = 0;
+            psMap->u32Count = 0;
+            break;
+
+        case 0x80:                                      /* Data has been received and ACK returned */
+            u32Data = I2C_GET_DATA(i2c);
+
+            if (psMap->u32AddrCnt < psMap->u32RegLen)
+            {
+                psMap->u32Reg = (psMap->u32AddrCnt == 0) ? u32Data : ((psMap->u32Reg << 8) | u32Data);
+
+                if (++psMap->u32AddrCnt == psMap->u32RegLen)
+                {
+                    psMap->u32Reg %= psWin->u32Size;
+                    psMap->u32Commit = psMap->u32Reg;
+                    psMap->u32Count = 0;
+                    I2C_REGMAP_StartRx(psMap);
+                }
+            }
+            else
+            {
+                /* Longer writes are committed in staging buffer pieces */
+                if (psMap->u32Count >= I2C_REGMAP_STAGE_SIZE)
+                    I2C_REGMAP_Commit(psMap);
+
+                psMap->au8Stage[psMap->u32Count++] = (uint8_t)u32Data;
+                I2C_REGMAP_StartRx(psMap);
+            }
+
+            break;
+
+        case 0xA0:                                      /* STOP or repeated START while addressed as receiver */
+            I2C_REGMAP_Commit(psMap);
+            break;
+
+        case 0xA8:                                      /* Own SLA+R has been received and ACK returned */
+        case 0xB0:                                      /* Arbitration lost, own SLA+R received */
+            I2C_REGMAP_Select(psMap);
+            I2C_REGMAP_ReadStart(psMap);
+            break;
+
+        case 0xB8:                                      /* Data has been transmitted and ACK received */
+            if (psMap->u32Count < psMap->u32Stage)
+                I2C_SET_DATA(i2c, psMap->au8Stage[psMap->u32Count]);
+            else
+                I2C_SET_DATA(i2c, psWin->pu8Map[(psMap->u32Reg + psMap->u32Count) % psWin->u32Size]);
+
+            psMap->u32Count++;
+            break;
+
+        case 0x88:                                      /* Data has been received and NACK returned */
+        case 0xC0:                                      /* Data has been transmitted and NACK received */
+        case 0xC8:                                      /* Last data has been transmitted and ACK received */
+            break;
+
+        default:                                        /* Bus error, release the bus */
+            psMap->u32Count = 0;
+            I2C_SET_CONTROL_REG(i2c, I2C_CTL_STO_SI_AA);
+            return;
+    }
+
+    I2C_SET_CONTROL_REG(i2c, I2C_CTL_SI_AA);
+}
+
+/*@}*/ /* end of group I2C_REGMAP_EXPORTED_FUNCTIONS */
+
+/*@}*/ /* end of group I2C_REGMAP_Driver */
+
+/*@}*/ /* end of group Standard_Driver */
+
+/*** (C) COPYRIGHT 2021 Nuvoton Technology Corp. ***/
@@ -0,0 +1,637 @@
+/**************************************************************************//**
+ * @file     i2c_xfer.c
+ * @version  V1.00
+ * @brief    NUC121 series interrupt driven I2C and USCI_I2C master transaction queue source file
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * @copyright (C) 2021 Nuvoton Technology Corp. All rights reserved.
+*****************************************************************************/
+#include "NuMicro.h"
+
+/** @addtogroup Standard_Driver Standard Driver
+  @{
+*/
+
+/** @addtogroup I2C_XFER_Driver I2C_XFER Driver
+  @{
+*/
+
+/// @cond HIDDEN_SYMBOLS
+
+#define I2C_XFER_PDMA_MIN       (3UL)   /* Receive by PDMA leaves the last two bytes to the interrupt */
+
+/* Position in the current transaction, decides what an event means */
+#define I2C_XFER_PH_START       (0UL)   /* START requested */
+#define I2C_XFER_PH_WRITE       (1UL)   /* SLA+W or a data byte sent */
+#define I2C_XFER_PH_RESTART     (2UL)   /* Repeated START requested */
+#define I2C_XFER_PH_ADDR_R      (3UL)   /* SLA+R sent */
+#define I2C_XFER_PH_READ        (4UL)   /* Receiving data */
+
+static uint8_t I2C_XFER_TxByte(S_I2C_XFER_T *psXfer, uint32_t u32Idx)
+{
+    if (u32Idx < psXfer->u8RegLen)
+        return (uint8_t)(psXfer->u16Reg >> ((psXfer->u8RegLen - 1UL - u32Idx) << 3));
+
+    return psXfer->pu8Tx[u32Idx - psXfer->u8RegLen];
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* I2C_T back-end                                                                                          */
+/*---------------------------------------------------------------------------------------------------------*/
+static uint32_t I2C_XFER_HwOpen(S_I2C_XFER_BUS_T *psBus)
+{
+    uint32_t u32Clk = I2C_Open((I2C_T *)psBus->pvPort, psBus->u32BusClock);
+
+    I2C_EnableInt((I2C_T *)psBus->pvPort);
+
+    return u32Clk;
+}
+
+static void I2C_XFER_HwClose(S_I2C_XFER_BUS_T *psBus)
+{
+    I2C_DisableInt((I2C_T *)psBus->pvPort);
+    I2C_DisableTimeout((I2C_T *)psBus->pvPort);
+    I2C_Close((I2C_T *)psBus->pvPort);
+}
+
+static uint32_t I2C_XFER_HwEvent(S_I2C_XFER_BUS_T *psBus)
+{
+    I2C_T *i2c = (I2C_T *)psBus->pvPort;
+
+    if (I2C_GET_TIMEOUT_FLAG(i2c))
+    {
+        I2C_ClearTimeoutFlag(i2c);
+        return I2C_XFER_EV_TIMEOUT;
+    }
+
+    if ((i2c->CTL & I2C_CTL_SI_Msk) == 0)
+        return I2C_XFER_EV_NONE;
+
+    /* PDMA has moved its part, continue byte by byte */
+    if (i2c->CTL1 & (I2C_CTL1_TXPDMAEN_Msk | I2C_CTL1_RXPDMAEN_Msk))
+        i2c->CTL1 &= ~(I2C_CTL1_TXPDMAEN_Msk | I2C_CTL1_RXPDMAEN_Msk);
+
+    switch (I2C_GET_STATUS(i2c))
+    {
+        case 0x08:                                      /* START has been transmitted */
+        case 0x10:                                      /* Repeated START has been transmitted */
+            return I2C_XFER_EV_START;
+
+        case 0x18:                                      /* SLA+W has been transmitted and ACK received */
+        case 0x28:                                      /* Data has been transmitted and ACK received */
+        case 0x40:                                      /* SLA+R has been transmitted and ACK received */
+        case 0x50:                                      /* Data has been received and ACK returned */
+            return I2C_XFER_EV_ACK;
+
+        case 0x20:                                      /* SLA+W has been transmitted and NACK received */
+        case 0x30:                                      /* Data has been transmitted and NACK received */
+        case 0x48:                                      /* SLA+R has been transmitted and NACK received */
+        case 0x58:                                      /* Last data has been received and NACK returned */
+            return I2C_XFER_EV_NACK;
+
+        case 0x38:                                      /* Arbitration lost, the bus belongs to another master */
+            return I2C_XFER_EV_ARB;
+
+        default:                                        /* Bus error */
+            return I2C_XFER_EV_BUS;
+    }
+}
+
+static void I2C_XFER_HwCtrl(S_I2C_XFER_BUS_T *psBus, uint32_t u32Ctrl)
+{
+    uint32_t u32Reg = 0;
+
+    if (u32Ctrl & I2C_XFER_CTL_ACK)
+        u32Reg |= I2C_CTL_SI;
+
+    if (u32Ctrl & I2C_XFER_CTL_STA)
+        u32Reg |= I2C_CTL_STA;
+
+    if (u32Ctrl & I2C_XFER_CTL_STO)
+        u32Reg |= I2C_CTL_STO;
+
+    if (u32Ctrl & I2C_XFER_CTL_AA)
+        u32Reg |= I2C_CTL_AA;
+
+    I2C_SET_CONTROL_REG((I2C_T *)psBus->pvPort, u32Reg);
+}
+
+static void I2C_XFER_HwWrite(S_I2C_XFER_BUS_T *psBus, uint8_t u8Data)
+{
+    I2C_SET_DATA((I2C_T *)psBus->pvPort, u8Data);
+}
+
+static uint8_t I2C_XFER_HwRead(S_I2C_XFER_BUS_T *psBus)
+{
+    return (uint8_t)I2C_GET_DATA((I2C_T *)psBus->pvPort);
+}
+
+static void I2C_XFER_HwTimeout(S_I2C_XFER_BUS_T *psBus, uint32_t u32En)
+{
+    if (u32En)
+        I2C_EnableTimeout((I2C_T *)psBus->pvPort, 1);
+    else
+        I2C_DisableTimeout((I2C_T *)psBus->pvPort);
+}
+
+/* PDMA answers the data requests of the controller until the count is reached */
+static int32_t I2C_XFER_HwPdma(S_I2C_XFER_BUS_T *psBus, uint32_t u32Rx, uint8_t *pu8Buf, uint32_t u32Len)
+{
+    I2C_T *i2c = (I2C_T *)psBus->pvPort;
+    uint32_t u32Ch = u32Rx ? psBus->u32PdmaRxCh : psBus->u32PdmaTxCh;
+
+    if (u32Ch == I2C_XFER_NO_PDMA)
+        return -1;
+
+    PDMA->TDSTS = (1UL << u32Ch);
+    PDMA_SetTransferCnt(u32Ch, PDMA_WIDTH_8, u32Len);
+
+    if (u32Rx)
+    {
+        PDMA_SetTransferAddr(u32Ch, (uint32_t)&i2c->DAT, PDMA_SAR_FIX, (uint32_t)pu8Buf, PDMA_DAR_INC);
+        PDMA_SetBurstType(u32Ch, PDMA_REQ_SINGLE, 0);
+        PDMA_SetTransferMode(u32Ch, (i2c == I2C0) ? PDMA_I2C0_RX : PDMA_I2C1_RX, 0, 0);
+        i2c->CTL1 |= I2C_CTL1_RXPDMAEN_Msk;
+    }
+    else
+    {
+        PDMA_SetTransferAddr(u32Ch, (uint32_t)pu8Buf, PDMA_SAR_INC, (uint32_t)&i2c->DAT, PDMA_DAR_FIX);
+        PDMA_SetBurstType(u32Ch, PDMA_REQ_SINGLE, 0);
+        PDMA_SetTransferMode(u32Ch, (i2c == I2C0) ? PDMA_I2C0_TX : PDMA_I2C1_TX, 0, 0);
+        i2c->CTL1 |= I2C_CTL1_TXPDMAEN_Msk;
+    }
+
+    return 0;
+}
+
+static const S_I2C_XFER_OPS_T s_sI2CXferOps =
+{
+    I2C_XFER_HwOpen,
+    I2C_XFER_HwClose,
+    I2C_XFER_HwEvent,
+    I2C_XFER_HwCtrl,
+    I2C_XFER_HwWrite,
+    I2C_XFER_HwRead,
+    I2C_XFER_HwTimeout,
+    I2C_XFER_HwPdma
+};
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Controller independent engine                                                                           */
+/*---------------------------------------------------------------------------------------------------------*/
+
+/* Reset the controller after a stalled bus and restore its setting */
+static void I2C_XFER_Recover(S_I2C_XFER_BUS_T *psBus)
+{
+    if (psBus->u32PdmaTxCh != I2C_XFER_NO_PDMA)
+        PDMA->DSCT[psBus->u32PdmaTxCh].CTL &= ~PDMA_DSCT_CTL_OPMODE_Msk;
+
+    if (psBus->u32PdmaRxCh != I2C_XFER_NO_PDMA)
+        PDMA->DSCT[psBus->u32PdmaRxCh].CTL &= ~PDMA_DSCT_CTL_OPMODE_Msk;
+
+    psBus->psOps->pfnClose(psBus);
+
+    /* A slave holding SDA low is released by clocking it out, which needs the pins as GPIO */
+    if (psBus->pfnRecover != NULL)
+        psBus->pfnRecover(psBus->pvRecoverArg);
+
+    psBus->psOps->pfnOpen(psBus);
+}
+
+/* Complete the current transaction, start the next one in the same control write */
+static void I2C_XFER_Finish(S_I2C_XFER_BUS_T *psBus, int32_t i32Status, uint32_t u32Ctrl)
+{
+    S_I2C_XFER_T *psXfer = psBus->psCur, *psNext = psXfer->psNext;
+
+    if (i32Status == I2C_XFER_OK)
+        psBus->u32Done++;
+    else if (i32Status == I2C_XFER_ERR_NACK)
+        psBus->u32Nack++;
+    else if (i32Status != I2C_XFER_ERR_TIMEOUT)
+        psBus->u32Error++;
+
+    psBus->psCur = psNext;
+    psBus->u32Phase = I2C_XFER_PH_START;
+
+    if (psNext != NULL)
+    {
+        psNext->u32Count = 0;
+        psNext->i32Status = I2C_XFER_ACTIVE;
+        u32Ctrl |= I2C_XFER_CTL_STA;
+    }
+    else
+    {
+        psBus->psTail = NULL;
+        psBus->psOps->pfnTimeout(psBus, 0);
+    }
+
+    if (u32Ctrl != 0)
+        psBus->psOps->pfnCtrl(psBus, u32Ctrl);
+
+    psXfer->i32Status = i32Status;
+
+    if (psXfer->pfnDone != NULL)
+        psXfer->pfnDone(psXfer);
+}
+
+/* START sent, address the slave for writing unless the transaction only reads */
+static void I2C_XFER_Address(S_I2C_XFER_BUS_T *psBus, S_I2C_XFER_T *psXfer)
+{
+    if ((psBus->u32Phase == I2C_XFER_PH_START) &&
+            (((psXfer->u8RegLen + psXfer->u32TxLen) != 0) || (psXfer->u32RxLen == 0)))
+    {
+        psBus->psOps->pfnWrite(psBus, (uint8_t)(psXfer->u8SlaveAddr << 1));
+        psBus->u32Phase = I2C_XFER_PH_WRITE;
+    }
+    else
+    {
+        psBus->psOps->pfnWrite(psBus, (uint8_t)((psXfer->u8SlaveAddr << 1) | 0x01));
+        psBus->u32Phase = I2C_XFER_PH_ADDR_R;
+    }
+
+    psBus->psOps->pfnCtrl(psBus, I2C_XFER_CTL_ACK);
+}
+
+/* Next step after SLA+W or a data byte has been acknowledged */
+static void I2C_XFER_Write(S_I2C_XFER_BUS_T *psBus, S_I2C_XFER_T *psXfer)
+{
+    const S_I2C_XFER_OPS_T *psOps = psBus->psOps;
+    uint32_t u32Total = psXfer->u8RegLen + psXfer->u32TxLen, u32Idx = psXfer->u32Count, u32Left;
+
+    if (u32Idx < u32Total)
+    {
+        u32Left = u32Total - u32Idx;
+        psOps->pfnWrite(psBus, I2C_XFER_TxByte(psXfer, u32Idx));
+
+        /* The first payload byte is written here, PDMA answers the following data ACK requests */
+        if ((psOps->pfnPdma != NULL) && (u32Idx >= psXfer->u8RegLen) && (u32Left >= psBus->u32PdmaMin) &&
+                (psOps->pfnPdma(psBus, 0, (uint8_t *)&psXfer->pu8Tx[u32Idx - psXfer->u8RegLen + 1UL], u32Left - 1UL) == 0))
+            psXfer->u32Count = u32Total;
+        else
+            psXfer->u32Count++;
+
+        psOps->pfnCtrl(psBus, I2C_XFER_CTL_ACK);
+    }
+    else if (psXfer->u32RxLen != 0)
+    {
+        psXfer->u32Count = 0;
+        psBus->u32Phase = I2C_XFER_PH_RESTART;
+        psOps->pfnCtrl(psBus, I2C_XFER_CTL_ACK | I2C_XFER_CTL_STA);
+    }
+    else
+        I2C_XFER_Finish(psBus, I2C_XFER_OK, I2C_XFER_CTL_ACK | I2C_XFER_CTL_STO);
+}
+
+/* Next step after SLA+R has been acknowledged */
+static void I2C_XFER_ReadStart(S_I2C_XFER_BUS_T *psBus, S_I2C_XFER_T *psXfer)
+{
+    const S_I2C_XFER_OPS_T *psOps = psBus->psOps;
+
+    /* PDMA takes all but the last two bytes, the interrupt then NACKs the last one */
+    if ((psOps->pfnPdma != NULL) && (psXfer->u32RxLen >= psBus->u32PdmaMin) &&
+            (psOps->pfnPdma(psBus, 1, psXfer->pu8Rx, psXfer->u32RxLen - 2UL) == 0))
+        psXfer->u32Count = psXfer->u32RxLen - 2UL;
+
+    psBus->u32Phase = I2C_XFER_PH_READ;
+    psOps->pfnCtrl(psBus, (psXfer->u32RxLen > 1) ? (I2C_XFER_CTL_ACK | I2C_XFER_CTL_AA) : I2C_XFER_CTL_ACK);
+}
+
+/// @endcond HIDDEN_SYMBOLS
+
+/** @addtogroup I2C_XFER_EXPORTED_FUNCTIONS I2C_XFER Exported Functions
+  @{
+*/
+
+/**
+  * @brief      Open a controller through its back-end as a queued master
+  *
+  * @param[in]  psBus       The pointer of the bus context.
+  * @param[in]  pvPort      Controller passed to the back-end.
+  * @param[in]  psOps       Controller back-end.
+  * @param[in]  u32BusClock Target bus clock in Hz.
+  *
+  * @return     Actual bus clock in Hz
+  *
+  * @details    The transaction queue and the master state machine are shared by every back-end. The back-end
+  *             translates controller status into I2C_XFER_EV_xxx events and I2C_XFER_CTL_xxx bits into
+  *             control register writes. PDMA is available if the back-end implements pfnPdma.
+  */
+uint32_t I2C_XFER_OpenBackend(S_I2C_XFER_BUS_T *psBus, void *pvPort, const S_I2C_XFER_OPS_T *psOps, uint32_t u32BusClock)
+{
+    psBus->pvPort = pvPort;
+    psBus->psOps = psOps;
+    psBus->psCur = NULL;
+    psBus->psTail = NULL;
+    psBus->u32Phase = I2C_XFER_PH_START;
+    psBus->u32BusClock = u32BusClock;
+    psBus->u32PdmaTxCh = I2C_XFER_NO_PDMA;
+    psBus->u32PdmaRxCh = I2C_XFER_NO_PDMA;
+    psBus->u32PdmaMin = 0xFFFFFFFFUL;
+    psBus->pfnRecover = NULL;
+    psBus->pvRecoverArg = NULL;
+    psBus->u32Done = 0;
+    psBus->u32Nack = 0;
+    psBus->u32Error = 0;
+    psBus->u32Timeout = 0;
+
+    return psOps->pfnOpen(psBus);
+}
+
+/**
+  * @brief      Open an I2C controller as a queued master
+  *
+  * @param[in]  psBus       The pointer of the bus context.
+  * @param[in]  i2c         I2C controller, I2C0 or I2C1.
+  * @param[in]  u32BusClock Target bus clock in Hz.
+  *
+  * @return     Actual bus clock in Hz
+  *
+  * @details    The controller interrupt is enabled. Enable the NVIC interrupt and call \ref I2C_XFER_IRQHandler
+  *             from I2Cn_IRQHandler. The time-out counter is enabled while transactions are on the bus.
+  */
+uint32_t I2C_XFER_Open(S_I2C_XFER_BUS_T *psBus, I2C_T *i2c, uint32_t u32BusClock)
+{
+    return I2C_XFER_OpenBackend(psBus, i2c, &s_sI2CXferOps, u32BusClock);
+}
+
+/**
+  * @brief      Close a queued I2C master
+  *
+  * @param[in]  psBus       The pointer of the bus context.
+  *
+  * @return     None
+  *
+  * @details    Queued transactions are dropped without callback. Wait for them before closing.
+  */
+void I2C_XFER_Close(S_I2C_XFER_BUS_T *psBus)
+{
+    psBus->psOps->pfnClose(psBus);
+    psBus->psCur = NULL;
+    psBus->psTail = NULL;
+}
+
+/**
+  * @brief      Move long payloads by PDMA
+  *
+  * @param[in]  psBus       The pointer of the bus context.
+  * @param[in]  u32TxCh     PDMA channel for transmit, or \ref I2C_XFER_NO_PDMA.
+  * @param[in]  u32RxCh     PDMA channel for receive, or \ref I2C_XFER_NO_PDMA.
+  * @param[in]  u32MinLen   Shortest payload worth a PDMA setup, at least 3 bytes.
+  *
+  * @retval     0           Success
+  * @retval     -1          Invalid channel or the back-end has no PDMA support
+  *
+  * @details    PDMA answers the data requests of the controller, as in the I2C_PDMA_TRX sample, so only the
+  *             address phase and the end of a transaction raise interrupts. PDMA interrupts are not used.
+  */
+int32_t I2C_XFER_EnablePDMA(S_I2C_XFER_BUS_T *psBus, uint32_t u32TxCh, uint32_t u32RxCh, uint32_t u32MinLen)
+{
+    if ((psBus->psOps->pfnPdma == NULL) ||
+            ((u32TxCh != I2C_XFER_NO_PDMA) && (u32TxCh >= PDMA_CH_MAX)) ||
+            ((u32RxCh != I2C_XFER_NO_PDMA) && (u32RxCh >= PDMA_CH_MAX)))
+        return -1;
+
+    psBus->u32PdmaTxCh = u32TxCh;
+    psBus->u32PdmaRxCh = u32RxCh;
+    psBus->u32PdmaMin = (u32MinLen < I2C_XFER_PDMA_MIN) ? I2C_XFER_PDMA_MIN : u32MinLen;
+
+    if (u32TxCh != I2C_XFER_NO_PDMA)
+        PDMA_Open(1UL << u32TxCh);
+
+    if (u32RxCh != I2C_XFER_NO_PDMA)
+        PDMA_Open(1UL << u32RxCh);
+
+    return 0;
+}
+
+/**
+  * @brief      Set the bus clear function
+  *
+  * @param[in]  psBus       The pointer of the bus context.
+  * @param[in]  pfnRecover  Called after a time-out while the controller is in reset, could be NULL.
+  * @param[in]  pvArg       Argument for pfnRecover.
+  *
+  * @return     None
+  *
+  * @details    A slave stuck in the middle of a byte keeps SDA low forever. The function should switch SCL to
+  *             GPIO, pulse it up to 9 times until SDA is released and switch the pins back to I2C.
+  */
+void I2C_XFER_SetRecover(S_I2C_XFER_BUS_T *psBus, I2C_XFER_RECOVER_FUNC pfnRecover, void *pvArg)
+{
+    psBus->pfnRecover = pfnRecover;
+    psBus->pvRecoverArg = pvArg;
+}
+
+/**
+  * @brief      Describe a transaction
+  *
+  * @param[in]  psXfer      The pointer of the transaction, owned by the caller until it is done.
+  * @param[in]  u8SlaveAddr 7-bit slave address.
+  * @param[in]  u16Reg      Register address sent first.
+  * @param[in]  u8RegLen    Register address length, 0, 1 or 2 bytes.
+  * @param[in]  pu8Tx       Data written after the register address, could be NULL if u32TxLen is 0.
+  * @param[in]  u32TxLen    Number of bytes to write.
+  * @param[in]  pu8Rx       Buffer for data read after a repeated START, could be NULL if u32RxLen is 0.
+  * @param[in]  u32RxLen    Number of bytes to read.
+  *
+  * @return     None
+  *
+  * @details    Every blocking I2C_WriteXxx and I2C_ReadXxx function maps to one transaction, for example
+  *             I2C_ReadMultiBytesTwoRegs is u8RegLen 2, u32TxLen 0 and u32RxLen n. With nothing to write or
+  *             read, the transaction only addresses the slave, which checks that it is present.
+  */
+void I2C_XFER_Setup(S_I2C_XFER_T *psXfer, uint8_t u8SlaveAddr, uint16_t u16Reg, uint8_t u8RegLen,
+                    const uint8_t *pu8Tx, uint32_t u32TxLen, uint8_t *pu8Rx, uint32_t u32RxLen)
+{
+    psXfer->psNext = NULL;
+    psXfer->u8SlaveAddr = u8SlaveAddr;
+    psXfer->u16Reg = u16Reg;
+    psXfer->u8RegLen = u8RegLen;
+    psXfer->pu8Tx = pu8Tx;
+    psXfer->u32TxLen = u32TxLen;
+    psXfer->pu8Rx = pu8Rx;
+    psXfer->u32RxLen = u32RxLen;
+    psXfer->pfnDone = NULL;
+    psXfer->pvArg = NULL;
+    psXfer->i32Status = I2C_XFER_OK;
+    psXfer->u32Count = 0;
+}
+
+/**
+  * @brief      Queue a transaction
+  *
+  * @param[in]  psBus       The pointer of the bus context.
+  * @param[in]  psXfer      The pointer of a transaction prepared by \ref I2C_XFER_Setup.
+  * @param[in]  pfnDone     Called from the interrupt when the transaction has finished, could be NULL.
+  * @param[in]  pvArg       Argument stored in the transaction for the callback.
+  *
+  * @retval     0           Success
+  * @retval     -1          The transaction is still queued
+  *
+  * @details    The transaction starts at once if the bus is idle. It could be called from a callback to chain
+  *             transactions.
+  */
+int32_t I2C_XFER_Submit(S_I2C_XFER_BUS_T *psBus, S_I2C_XFER_T *psXfer, I2C_XFER_CB pfnDone, void *pvArg)
+{
+    uint32_t u32PriMask = __get_PRIMASK();
+
+    if (!I2C_XFER_IS_DONE(psXfer))
+        return -1;
+
+    psXfer->pfnDone = pfnDone;
+    psXfer->pvArg = pvArg;
+    psXfer->psNext = NULL;
+    psXfer->u32Count = 0;
+
+    __set_PRIMASK(1);
+
+    if (psBus->psCur == NULL)
+    {
+        psBus->psCur = psXfer;
+        psBus->psTail = psXfer;
+        psXfer->i32Status = I2C_XFER_ACTIVE;
+        psBus->u32Phase = I2C_XFER_PH_START;
+        psBus->psOps->pfnTimeout(psBus, 1);
+        psBus->psOps->pfnCtrl(psBus, I2C_XFER_CTL_STA);
+    }
+    else
+    {
+        psXfer->i32Status = I2C_XFER_QUEUED;
+        psBus->psTail->psNext = psXfer;
+        psBus->psTail = psXfer;
+    }
+
+    __set_PRIMASK(u32PriMask);
+
+    return 0;
+}
+
+/**
+  * @brief      Wait for a transaction
+  *
+  * @param[in]  psXfer      The pointer of the transaction.
+  *
+  * @return     Result, \ref I2C_XFER_OK or I2C_XFER_ERR_xxx
+  *
+  * @details    The bus time-out guarantees that the wait ends.
+  */
+int32_t I2C_XFER_Wait(S_I2C_XFER_T *psXfer)
+{
+    while (!I2C_XFER_IS_DONE(psXfer));
+
+    return psXfer->i32Status;
+}
+
+/**
+  * @brief      Run a transaction and wait for it
+  *
+  * @param[in]  psBus       The pointer of the bus context.
+  * @param[in]  psXfer      The pointer of a transaction prepared by \ref I2C_XFER_Setup.
+  *
+  * @return     Result, \ref I2C_XFER_OK or I2C_XFER_ERR_xxx
+  *
+  * @details    Blocking replacement of the I2C_WriteXxx and I2C_ReadXxx functions that still shares the bus
+  *             with queued transactions. It must not be called from interrupt context.
+  */
+int32_t I2C_XFER_Transfer(S_I2C_XFER_BUS_T *psBus, S_I2C_XFER_T *psXfer)
+{
+    I2C_XFER_Submit(psBus, psXfer, NULL, NULL);
+
+    return I2C_XFER_Wait(psXfer);
+}
+
+/**
+  * @brief      I2C master interrupt service
+  *
+  * @param[in]  psBus       The pointer of the bus context.
+  *
+  * @return     None
+  *
+  * @details    Call this API from I2Cn_IRQHandler or USCI_IRQHandler. It takes one event from the back-end per
+  *             call, runs the master state machine of the blocking functions one step and completes
+  *             transactions with their callbacks.
+  */
+void I2C_XFER_IRQHandler(S_I2C_XFER_BUS_T *psBus)
+{
+    const S_I2C_XFER_OPS_T *psOps = psBus->psOps;
+    S_I2C_XFER_T *psXfer = psBus->psCur;
+    uint32_t u32Event = psOps->pfnEvent(psBus);
+
+    if (u32Event == I2C_XFER_EV_NONE)
+        return;
+
+    if (u32Event == I2C_XFER_EV_TIMEOUT)
+    {
+        psBus->u32Timeout++;
+        I2C_XFER_Recover(psBus);
+
+        if (psXfer != NULL)
+        {
+            psOps->pfnTimeout(psBus, 1);
+            I2C_XFER_Finish(psBus, I2C_XFER_ERR_TIMEOUT, 0);
+        }
+
+        return;
+    }
+
+    if (psXfer == NULL)
+    {
+        psOps->pfnCtrl(psBus, I2C_XFER_CTL_ACK | I2C_XFER_CTL_STO);
+        return;
+    }
+
+    switch (u32Event)
+    {
+        case I2C_XFER_EV_START:
+            if ((psBus->u32Phase == I2C_XFER_PH_START) || (psBus->u32Phase == I2C_XFER_PH_RESTART))
+                I2C_XFER_Address(psBus, psXfer);
+            else
+                I2C_XFER_Finish(psBus, I2C_XFER_ERR_BUS, I2C_XFER_CTL_ACK | I2C_XFER_CTL_STO);
+
+            break;
+
+        case I2C_XFER_EV_ACK:
+            if (psBus->u32Phase == I2C_XFER_PH_WRITE)
+                I2C_XFER_Write(psBus, psXfer);
+            else if (psBus->u32Phase == I2C_XFER_PH_ADDR_R)
+                I2C_XFER_ReadStart(psBus, psXfer);
+            else if (psBus->u32Phase == I2C_XFER_PH_READ)
+            {
+                psXfer->pu8Rx[psXfer->u32Count++] = psOps->pfnRead(psBus);
+                psOps->pfnCtrl(psBus, ((psXfer->u32Count + 1UL) < psXfer->u32RxLen) ?
+                               (I2C_XFER_CTL_ACK | I2C_XFER_CTL_AA) : I2C_XFER_CTL_ACK);
+            }
+            else
+                I2C_XFER_Finish(psBus, I2C_XFER_ERR_BUS, I2C_XFER_CTL_ACK | I2C_XFER_CTL_STO);
+
+            break;
+
+        case I2C_XFER_EV_NACK:
+            /* The master NACKs the last byte it reads, anything else is refused by the slave */
+            if (psBus->u32Phase == I2C_XFER_PH_READ)
+            {
+                psXfer->pu8Rx[psXfer->u32Count++] = psOps->pfnRead(psBus);
+                I2C_XFER_Finish(psBus, I2C_XFER_OK, I2C_XFER_CTL_ACK | I2C_XFER_CTL_STO);
+            }
+            else
+                I2C_XFER_Finish(psBus, I2C_XFER_ERR_NACK, I2C_XFER_CTL_ACK | I2C_XFER_CTL_STO);
+
+            break;
+
+        case I2C_XFER_EV_ARB:                           /* The bus belongs to another master */
+            I2C_XFER_Finish(psBus, I2C_XFER_ERR_ARB, I2C_XFER_CTL_ACK);
+            break;
+
+        default:                                        /* Bus error, STOP releases the bus */
+            I2C_XFER_Finish(psBus, I2C_XFER_ERR_BUS, I2C_XFER_CTL_ACK | I2C_XFER_CTL_STO);
+            break;
+    }
+}
+
+/*@}*/ /* end of group I2C_XFER_EXPORTED_FUNCTIONS */
+
+/*@}*/ /* end of group I2C_XFER_Driver */
+
+/*@}*/ /* end of group Standard_Driver */
+
+/*** (C) COPYRIGHT 2021 Nuvoton Technology Corp. ***/
@@ -0,0 +1,495 @@
+/**************************************************************************//**
+ * @file     i2s_stream.c
+ * @version  V1.00
+ * @brief    NUC121 series I2S PDMA streaming source file
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * @copyright (C) 2021 Nuvoton Technology Corp. All rights reserved.
+*****************************************************************************/
+#include <string.h>
+#include "NuMicro.h"
+
+/** @addtogroup Standard_Driver Standard Driver
+  @{
+*/
+
+/** @addtogroup I2S_STREAM_Driver I2S_STREAM Driver
+  @{
+*/
+
+/// @cond HIDDEN_SYMBOLS
+
+/* 16-bit samples are packed two per FIFO word, the first one in bits 15..0 */
+static uint32_t I2S_STREAM_FramesToWords(S_I2S_STREAM_T *psStream, uint32_t u32Frames)
+{
+    uint32_t u32Samples = u32Frames << (psStream->u32Channels - 1UL);
+
+    return (psStream->u32SampleBytes == 2) ? (u32Samples >> 1) : u32Samples;
+}
+
+static uint32_t I2S_STREAM_WordsToFrames(S_I2S_STREAM_T *psStream, uint32_t u32Words)
+{
+    uint32_t u32Samples = (psStream->u32SampleBytes == 2) ? (u32Words << 1) : u32Words;
+
+    return u32Samples >> (psStream->u32Channels - 1UL);
+}
+
+/* Little endian PCM sample to a left justified 32-bit sample, byte access for any alignment */
+static int32_t I2S_STREAM_Load(const uint8_t *pu8Pcm, uint32_t u32Bytes)
+{
+    uint32_t u32Sample = ((uint32_t)pu8Pcm[u32Bytes - 1UL] << 24) | ((uint32_t)pu8Pcm[u32Bytes - 2UL] << 16);
+
+    if (u32Bytes >= 3)
+        u32Sample |= (uint32_t)pu8Pcm[u32Bytes - 3UL] << 8;
+
+    if (u32Bytes == 4)
+        u32Sample |= pu8Pcm[0];
+
+    return (int32_t)u32Sample;
+}
+
+static void I2S_STREAM_Store(uint8_t *pu8Pcm, uint32_t u32Bytes, int32_t i32Sample)
+{
+    uint32_t i, u32Sample = (uint32_t)i32Sample >> ((4UL - u32Bytes) * 8UL);
+
+    for (i = 0; i < u32Bytes; i++)
+    {
+        pu8Pcm[i] = (uint8_t)u32Sample;
+        u32Sample >>= 8;
+    }
+}
+
+/* Stream sample u32Idx taken from interleaved PCM, mono is copied to both channels and stereo is mixed to mono */
+static int32_t I2S_STREAM_GetSample(S_I2S_STREAM_T *psStream, const uint8_t *pu8Pcm, uint32_t u32Idx,
+                                    uint32_t u32PcmBytes, uint32_t u32PcmCh)
+{
+    uint32_t u32Frame = u32Idx >> (psStream->u32Channels - 1UL);
+
+    if (u32PcmCh == 1)
+        return I2S_STREAM_Load(&pu8Pcm[u32Frame * u32PcmBytes], u32PcmBytes);
+
+    if (psStream->u32Channels == 1)
+        return (I2S_STREAM_Load(&pu8Pcm[u32Frame * 2UL * u32PcmBytes], u32PcmBytes) >> 1) +
+               (I2S_STREAM_Load(&pu8Pcm[(u32Frame * 2UL + 1UL) * u32PcmBytes], u32PcmBytes) >> 1);
+
+    return I2S_STREAM_Load(&pu8Pcm[u32Idx * u32PcmBytes], u32PcmBytes);
+}
+
+static void I2S_STREAM_PutSample(S_I2S_STREAM_T *psStream, uint8_t *pu8Pcm, uint32_t u32Idx, uint32_t u32PcmBytes,
+                                 uint32_t u32PcmCh, int32_t i32Sample, int32_t *pi32Left)
+{
+    uint32_t u32Frame = u32Idx >> (psStream->u32Channels - 1UL);
+
+    if (psStream->u32Channels == 1)
+    {
+        I2S_STREAM_Store(&pu8Pcm[u32Frame * u32PcmCh * u32PcmBytes], u32PcmBytes, i32Sample);
+
+        if (u32PcmCh == 2)
+            I2S_STREAM_Store(&pu8Pcm[(u32Frame * 2UL + 1UL) * u32PcmBytes], u32PcmBytes, i32Sample);
+    }
+    else if (u32PcmCh == 2)
+        I2S_STREAM_Store(&pu8Pcm[u32Idx * u32PcmBytes], u32PcmBytes, i32Sample);
+    else if ((u32Idx & 1UL) == 0)
+        *pi32Left = i32Sample;
+    else
+        I2S_STREAM_Store(&pu8Pcm[u32Frame * u32PcmBytes], u32PcmBytes, (*pi32Left >> 1) + (i32Sample >> 1));
+}
+
+/* Same layout as the FIFO, 16-bit stereo from USB audio for example */
+static uint32_t I2S_STREAM_IsRaw(S_I2S_STREAM_T *psStream, uint32_t u32PcmBytes, uint32_t u32PcmCh)
+{
+    return ((u32PcmBytes == psStream->u32SampleBytes) && (u32PcmCh == psStream->u32Channels) && (u32PcmBytes != 3)) ? 1 : 0;
+}
+
+/* Play: the period just sent is silenced where no new data is written, the next period must be complete */
+static void I2S_STREAM_TxPeriod(S_I2S_STREAM_T *psStream)
+{
+    uint32_t u32PW = psStream->u32PeriodWords;
+    uint32_t u32Last = (psStream->u32PeriodNum - 1UL) * u32PW;
+    uint32_t u32Level = (psStream->u32Level > u32PW) ? (psStream->u32Level - u32PW) : 0;
+    uint32_t u32Start = psStream->u32Period * u32PW;
+    uint32_t u32From = (u32Level > u32Last) ? u32Level : u32Last;
+    uint32_t u32Done = (u32Start + u32Last) % psStream->u32RingWords;
+
+    if (u32From < psStream->u32RingWords)
+        memset(&psStream->pu32Ring[u32Done + (u32From - u32Last)], 0, (psStream->u32RingWords - u32From) * 4UL);
+
+    if (u32Level < u32PW)
+    {
+        /* Restart the writer behind the period on the bus */
+        psStream->u32Xruns++;
+        u32Level = u32PW;
+        psStream->u32Off = (u32Start + u32PW) % psStream->u32RingWords;
+    }
+
+    psStream->u32Level = u32Level;
+}
+
+/* Record: drop the oldest period if the PDMA starts to fill it again */
+static void I2S_STREAM_RxPeriod(S_I2S_STREAM_T *psStream)
+{
+    uint32_t u32PW = psStream->u32PeriodWords;
+
+    psStream->u32Level += u32PW;
+
+    if (psStream->u32Level > (psStream->u32RingWords - u32PW))
+    {
+        psStream->u32Xruns++;
+        psStream->u32Level -= u32PW;
+        psStream->u32Off = (psStream->u32Off + u32PW) % psStream->u32RingWords;
+    }
+}
+
+/// @endcond HIDDEN_SYMBOLS
+
+/** @addtogroup I2S_STREAM_EXPORTED_FUNCTIONS I2S_STREAM Exported Functions
+  @{
+*/
+
+/**
+  * @brief      Set up a play or record stream on a ring of PDMA descriptors
+  *
+  * @param[in]  psStream        The pointer of the stream context.
+  * @param[in]  i2s             SPI0 opened by \ref I2S_Open with 16, 24 or 32-bit words.
+  * @param[in]  u32Dir          \ref I2S_STREAM_TX or \ref I2S_STREAM_RX.
+  * @param[in]  u32PdmaCh       PDMA channel of the stream.
+  * @param[in]  pu32Ring        Ring of u32PeriodWords * u32PeriodNum words.
+  * @param[in]  u32PeriodWords  FIFO words of one period, up to 16384. 16-bit words take two samples per FIFO word.
+  * @param[in]  u32PeriodNum    Periods in the ring, 2 up to \ref I2S_STREAM_PERIOD_MAX.
+  * @param[in]  pfnPeriod       Called in interrupt context after each period, could be NULL.
+  * @param[in]  pvArg           Argument kept for the callback.
+  *
+  * @retval     0               Success
+  * @retval     -1              Invalid argument or 8-bit I2S words
+  *
+  * @details    Each period is one scatter-gather descriptor and the last one links back to the first, so the
+  *             PDMA runs without CPU help. Two periods give the classic ping-pong half buffers, more periods
+  *             give a deeper buffer for a source with jitter such as USB audio. A play ring starts with silence.
+  */
+int32_t I2S_STREAM_Open(S_I2S_STREAM_T *psStream, SPI_T *i2s, uint32_t u32Dir, uint32_t u32PdmaCh,
+                        uint32_t *pu32Ring, uint32_t u32PeriodWords, uint32_t u32PeriodNum,
+                        I2S_STREAM_CB pfnPeriod, void *pvArg)
+{
+    uint32_t i, u32Width = (i2s->I2SCTL & SPI_I2SCTL_WDWIDTH_Msk) >> SPI_I2SCTL_WDWIDTH_Pos;
+
+    if ((u32PdmaCh >= PDMA_CH_MAX) || (u32PeriodNum < 2) || (u32PeriodNum > I2S_STREAM_PERIOD_MAX) ||
+            (u32PeriodWords == 0) || (u32PeriodWords > 0x4000UL) || (u32Width == 0))
+        return -1;
+
+    psStream->i2s = i2s;
+    psStream->u32Dir = u32Dir;
+    psStream->u32PdmaCh = u32PdmaCh;
+    psStream->pu32Ring = pu32Ring;
+    psStream->u32PeriodWords = u32PeriodWords;
+    psStream->u32PeriodNum = u32PeriodNum;
+    psStream->u32RingWords = u32PeriodWords * u32PeriodNum;
+    psStream->u32SampleBytes = u32Width + 1UL;
+    psStream->u32Channels = (i2s->I2SCTL & SPI_I2SCTL_MONO_Msk) ? 1UL : 2UL;
+    psStream->pfnPeriod = pfnPeriod;
+    psStream->pvArg = pvArg;
+    psStream->u32Period = 0;
+    psStream->u32Periods = 0;
+    psStream->u32Xruns = 0;
+
+    psStream->u32DescCtl = ((u32PeriodWords - 1UL) << PDMA_DSCT_CTL_TXCNT_Pos) | PDMA_WIDTH_32 | PDMA_REQ_SINGLE |
+                           PDMA_OP_SCATTER | ((u32Dir == I2S_STREAM_TX) ? (PDMA_SAR_INC | PDMA_DAR_FIX) : (PDMA_SAR_FIX | PDMA_DAR_INC));
+
+    for (i = 0; i < u32PeriodNum; i++)
+    {
+        psStream->asDesc[i].CTL = psStream->u32DescCtl;
+        psStream->asDesc[i].SA = (u32Dir == I2S_STREAM_TX) ? (uint32_t)&pu32Ring[i * u32PeriodWords] : (uint32_t)&i2s->RX;
+        psStream->asDesc[i].DA = (u32Dir == I2S_STREAM_TX) ? (uint32_t)&i2s->TX : (uint32_t)&pu32Ring[i * u32PeriodWords];
+        psStream->asDesc[i].FIRST = (uint32_t)&psStream->asDesc[(i + 1UL) % u32PeriodNum] - PDMA->SCATBA;
+    }
+
+    if (u32Dir == I2S_STREAM_TX)
+    {
+        /* The first period goes out as silence, the writer starts behind it */
+        memset(pu32Ring, 0, psStream->u32RingWords * 4UL);
+        psStream->u32Level = u32PeriodWords;
+        psStream->u32Off = u32PeriodWords;
+    }
+    else
+    {
+        psStream->u32Level = 0;
+        psStream->u32Off = 0;
+    }
+
+    PDMA_Open(1UL << u32PdmaCh);
+
+    return 0;
+}
+
+/**
+  * @brief      Start the PDMA ring and the I2S direction of the stream
+  *
+  * @param[in]  psStream    The pointer of the stream context.
+  *
+  * @return     None
+  *
+  * @details    Data written by \ref I2S_STREAM_Write before the start follows the first silent period.
+  *             PDMA_IRQn must be enabled and call \ref I2S_STREAM_IRQHandler.
+  */
+void I2S_STREAM_Start(S_I2S_STREAM_T *psStream)
+{
+    SPI_T *i2s = psStream->i2s;
+
+    PDMA_SetTransferMode(psStream->u32PdmaCh, (psStream->u32Dir == I2S_STREAM_TX) ? PDMA_SPI0_TX : PDMA_SPI0_RX,
+                         TRUE, (uint32_t)&psStream->asDesc[0]);
+    PDMA_EnableInt(psStream->u32PdmaCh, PDMA_INT_TRANS_DONE);
+
+    if (psStream->u32Dir == I2S_STREAM_TX)
+    {
+        I2S_CLR_TX_FIFO(i2s);
+        I2S_ENABLE_TXDMA(i2s);
+        I2S_ENABLE_TX(i2s);
+    }
+    else
+    {
+        I2S_CLR_RX_FIFO(i2s);
+        I2S_ENABLE_RXDMA(i2s);
+        I2S_ENABLE_RX(i2s);
+    }
+}
+
+/**
+  * @brief      Stop the stream
+  *
+  * @param[in]  psStream    The pointer of the stream context.
+  *
+  * @return     None
+  *
+  * @details    Call \ref I2S_STREAM_Open again before the next start.
+  */
+void I2S_STREAM_Stop(S_I2S_STREAM_T *psStream)
+{
+    SPI_T *i2s = psStream->i2s;
+
+    if (psStream->u32Dir == I2S_STREAM_TX)
+    {
+        I2S_DISABLE_TX(i2s);
+        I2S_DISABLE_TXDMA(i2s);
+        I2S_CLR_TX_FIFO(i2s);
+    }
+    else
+    {
+        I2S_DISABLE_RX(i2s);
+        I2S_DISABLE_RXDMA(i2s);
+        I2S_CLR_RX_FIFO(i2s);
+    }
+
+    PDMA_DisableInt(psStream->u32PdmaCh, PDMA_INT_TRANS_DONE);
+    PDMA->DSCT[psStream->u32PdmaCh].CTL = PDMA_OP_IDLE;
+    PDMA_CLR_TD_FLAG(1UL << psStream->u32PdmaCh);
+}
+
+/**
+  * @brief      Queue PCM frames for play
+  *
+  * @param[in]  psStream    The pointer of the stream context.
+  * @param[in]  pvPcm       Interleaved little endian PCM frames.
+  * @param[in]  u32Frames   Number of frames.
+  * @param[in]  u32PcmBytes \ref I2S_STREAM_PCM16, \ref I2S_STREAM_PCM24 or \ref I2S_STREAM_PCM32.
+  * @param[in]  u32PcmCh    1 for mono, 2 for stereo.
+  *
+  * @return     Frames taken, less than u32Frames if the ring is full
+  *
+  * @details    Samples are scaled to the I2S word width. Mono PCM is copied to both channels of a stereo
+  *             stream and stereo PCM is mixed for a mono stream. PCM with the FIFO layout is copied as is.
+  *             A 16-bit mono stream takes frames in pairs. Interrupts are masked while the ring is updated.
+  */
+uint32_t I2S_STREAM_Write(S_I2S_STREAM_T *psStream, const void *pvPcm, uint32_t u32Frames, uint32_t u32PcmBytes, uint32_t u32PcmCh)
+{
+    const uint8_t *pu8Pcm = (const uint8_t *)pvPcm;
+    uint32_t i, u32Words, u32Free, u32Len, u32Idx = 0, u32Word;
+    uint32_t u32PriMask = __get_PRIMASK();
+
+    __set_PRIMASK(1);
+
+    u32Free = psStream->u32RingWords - psStream->u32Level;
+    u32Words = I2S_STREAM_FramesToWords(psStream, u32Frames);
+
+    if (u32Words > u32Free)
+        u32Words = u32Free;
+
+    u32Frames = I2S_STREAM_WordsToFrames(psStream, u32Words);
+
+    if (I2S_STREAM_IsRaw(psStream, u32PcmBytes, u32PcmCh))
+    {
+        for (i = 0; i < u32Words; i += u32Len)
+        {
+            u32Len = psStream->u32RingWords - psStream->u32Off;
+
+            if (u32Len > (u32Words - i))
+                u32Len = u32Words - i;
+
+            memcpy(&psStream->pu32Ring[psStream->u32Off], &pu8Pcm[i * 4UL], u32Len * 4UL);
+            psStream->u32Off = (psStream->u32Off + u32Len) % psStream->u32RingWords;
+        }
+    }
+    else
+    {
+        for (i = 0; i < u32Words; i++)
+        {
+            if (psStream->u32SampleBytes == 2)
+            {
+                u32Word = (uint32_t)I2S_STREAM_GetSample(psStream, pu8Pcm, u32Idx++, u32PcmBytes, u32PcmCh) >> 16;
+                u32Word |= (uint32_t)I2S_STREAM_GetSample(psStream, pu8Pcm, u32Idx++, u32PcmBytes, u32PcmCh) & 0xFFFF0000UL;
+            }
+            else if (psStream->u32SampleBytes == 3)
+                u32Word = ((uint32_t)I2S_STREAM_GetSample(psStream, pu8Pcm, u32Idx++, u32PcmBytes, u32PcmCh) >> 8) & 0xFFFFFFUL;
+            else
+                u32Word = (uint32_t)I2S_STREAM_GetSample(psStream, pu8Pcm, u32Idx++, u32PcmBytes, u32PcmCh);
+
+            psStream->pu32Ring[psStream->u32Off] = u32Word;
+
+            if (++psStream->u32Off == psStream->u32RingWords)
+                psStream->u32Off = 0;
+        }
+    }
+
+    psStream->u32Level += u32Words;
+
+    __set_PRIMASK(u32PriMask);
+
+    return u32Frames;
+}
+
+/**
+  * @brief      Take recorded PCM frames
+  *
+  * @param[in]  psStream    The pointer of the stream context.
+  * @param[out] pvPcm       Buffer for interleaved little endian PCM frames.
+  * @param[in]  u32Frames   Number of frames wanted.
+  * @param[in]  u32PcmBytes \ref I2S_STREAM_PCM16, \ref I2S_STREAM_PCM24 or \ref I2S_STREAM_PCM32.
+  * @param[in]  u32PcmCh    1 for mono, 2 for stereo.
+  *
+  * @return     Frames stored, less than u32Frames if fewer are recorded
+  *
+  * @details    The conversions of \ref I2S_STREAM_Write are done the other way round.
+  */
+uint32_t I2S_STREAM_Read(S_I2S_STREAM_T *psStream, void *pvPcm, uint32_t u32Frames, uint32_t u32PcmBytes, uint32_t u32PcmCh)
+{
+    uint8_t *pu8Pcm = (uint8_t *)pvPcm;
+    uint32_t i, u32Words, u32Len, u32Idx = 0, u32Word;
+    int32_t i32Left = 0;
+    uint32_t u32PriMask = __get_PRIMASK();
+
+    __set_PRIMASK(1);
+
+    u32Words = I2S_STREAM_FramesToWords(psStream, u32Frames);
+
+    if (u32Words > psStream->u32Level)
+        u32Words = psStream->u32Level;
+
+    u32Frames = I2S_STREAM_WordsToFrames(psStream, u32Words);
+
+    if (I2S_STREAM_IsRaw(psStream, u32PcmBytes, u32PcmCh))
+    {
+        for (i = 0; i < u32Words; i += u32Len)
+        {
+            u32Len = psStream->u32RingWords - psStream->u32Off;
+
+            if (u32Len > (u32Words - i))
+                u32Len = u32Words - i;
+
+            memcpy(&pu8Pcm[i * 4UL], &psStream->pu32Ring[psStream->u32Off], u32Len * 4UL);
+            psStream->u32Off = (psStream->u32Off + u32Len) % psStream->u32RingWords;
+        }
+    }
+    else
+    {
+        for (i = 0; i < u32Words; i++)
+        {
+            u32Word = psStream->pu32Ring[psStream->u32Off];
+
+            if (++psStream->u32Off == psStream->u32RingWords)
+                psStream->u32Off = 0;
+
+            if (psStream->u32SampleBytes == 2)
+            {
+                I2S_STREAM_PutSample(psStream, pu8Pcm, u32Idx++, u32PcmBytes, u32PcmCh, (int32_t)(u32Word << 16), &i32Left);
+                I2S_STREAM_PutSample(psStream, pu8Pcm, u32Idx++, u32PcmBytes, u32PcmCh, (int32_t)(u32Word & 0xFFFF0000UL), &i32Left);
+            }
+            else if (psStream->u32SampleBytes == 3)
+                I2S_STREAM_PutSample(psStream, pu8Pcm, u32Idx++, u32PcmBytes, u32PcmCh, (int32_t)(u32Word << 8), &i32Left);
+            else
+                I2S_STREAM_PutSample(psStream, pu8Pcm, u32Idx++, u32PcmBytes, u32PcmCh, (int32_t)u32Word, &i32Left);
+        }
+    }
+
+    psStream->u32Level -= u32Words;
+
+    __set_PRIMASK(u32PriMask);
+
+    return u32Frames;
+}
+
+/**
+  * @brief      Frames queued for play or recorded and not read yet
+  *
+  * @param[in]  psStream    The pointer of the stream context.
+  *
+  * @return     Number of frames
+  *
+  * @details    For play the count includes the period on the bus. A USB audio device could use it
+  *             for its feedback endpoint.
+  */
+uint32_t I2S_STREAM_GetFrames(S_I2S_STREAM_T *psStream)
+{
+    return I2S_STREAM_WordsToFrames(psStream, psStream->u32Level);
+}
+
+/**
+  * @brief      Frames \ref I2S_STREAM_Write could take now
+  *
+  * @param[in]  psStream    The pointer of the stream context.
+  *
+  * @return     Number of frames
+  */
+uint32_t I2S_STREAM_GetFree(S_I2S_STREAM_T *psStream)
+{
+    return I2S_STREAM_WordsToFrames(psStream, psStream->u32RingWords - psStream->u32Level);
+}
+
+/**
+  * @brief      PDMA interrupt service of a stream
+  *
+  * @param[in]  psStream    The pointer of the stream context.
+  *
+  * @return     None
+  *
+  * @details    Call it from PDMA_IRQHandler for every open stream, it returns at once if the channel of
+  *             the stream is not done. The finished descriptor is rearmed for the next lap of the ring and
+  *             the period callback is called with the index of the finished period.
+  */
+void I2S_STREAM_IRQHandler(S_I2S_STREAM_T *psStream)
+{
+    uint32_t u32Period = psStream->u32Period;
+
+    if ((PDMA_GET_TD_STS() & (1UL << psStream->u32PdmaCh)) == 0)
+        return;
+
+    PDMA_CLR_TD_FLAG(1UL << psStream->u32PdmaCh);
+
+    /* The PDMA writes back the descriptor it finished */
+    psStream->asDesc[u32Period].CTL = psStream->u32DescCtl;
+    psStream->u32Period = (u32Period + 1UL == psStream->u32PeriodNum) ? 0 : (u32Period + 1UL);
+    psStream->u32Periods++;
+
+    if (psStream->u32Dir == I2S_STREAM_TX)
+        I2S_STREAM_TxPeriod(psStream);
+    else
+        I2S_STREAM_RxPeriod(psStream);
+
+    if (psStream->pfnPeriod != NULL)
+        psStream->pfnPeriod(psStream, u32Period);
+}
+
+/*@}*/ /* end of group I2S_STREAM_EXPORTED_FUNCTIONS */
+
+/*@}*/ /* end of group I2S_STREAM_Driver */
+
+/*@}*/ /* end of group Standard_Driver */
+
+/*** (C) COPYRIGHT 2021 Nuvoton Technology Corp. ***/
@@ -0,0 +1,301 @@
+/**************************************************************************//**
+ * @file     irq_plan.c
+ * @version  V1.00
+ * @brief    NUC121 series deadline based interrupt priority planner and latency monitor source file
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * @copyright (C) 2021 Nuvoton Technology Corp. All rights reserved.
+*****************************************************************************/
+#include <stdio.h>
+#include "NuMicro.h"
+
+/** @addtogroup Standard_Driver Standard Driver
+  @{
+*/
+
+/** @addtogroup IRQ_PLAN_Driver IRQ_PLAN Driver
+  @{
+*/
+
+/// @cond HIDDEN_SYMBOLS
+
+/* Distinct deadlines shorter than u32DeadlineUs */
+static uint32_t IRQ_PLAN_Rank(S_IRQ_PLAN_T *psPlan, uint32_t u32Num, uint32_t u32DeadlineUs)
+{
+    uint32_t i, j, u32Rank = 0;
+
+    for (i = 0; i < u32Num; i++)
+    {
+        if (psPlan[i].u32DeadlineUs >= u32DeadlineUs)
+            continue;
+
+        for (j = 0; j < i; j++)
+        {
+            if (psPlan[j].u32DeadlineUs == psPlan[i].u32DeadlineUs)
+                break;
+        }
+
+        if (j == i)
+            u32Rank++;
+    }
+
+    return u32Rank;
+}
+
+static uint32_t IRQ_PLAN_TicksToUs(uint32_t u32Ticks, uint32_t u32TickFreq)
+{
+    return (uint32_t)(((uint64_t)u32Ticks * 1000000UL + u32TickFreq - 1UL) / u32TickFreq);
+}
+
+/// @endcond HIDDEN_SYMBOLS
+
+
+/** @addtogroup IRQ_PLAN_EXPORTED_FUNCTIONS IRQ_PLAN Exported Functions
+  @{
+*/
+
+/**
+  * @brief      Set the NVIC priorities of a plan from its deadlines
+  *
+  * @param[in]  psPlan      Plan entries with eIrq, u32DeadlineUs and u32CostUs filled in.
+  * @param[in]  u32Num      Number of entries.
+  *
+  * @return     Number of entries whose predicted worst response exceeds their deadline
+  *
+  * @details    Deadline monotonic: the shorter the deadline, the more urgent the level. Up to
+  *             \ref IRQ_PLAN_LEVELS distinct deadlines get a level each, more are spread evenly over the levels.
+  *             The bound of an entry is its own cost, plus the cost of every other entry on its level, which it
+  *             can not preempt, plus the cost of every more urgent entry. Each interrupt is assumed to fire at
+  *             most once per deadline and code running with PRIMASK set is not accounted, keep it shorter
+  *             than the smallest slack.
+  */
+int32_t IRQ_PLAN_Apply(S_IRQ_PLAN_T *psPlan, uint32_t u32Num)
+{
+    uint32_t i, j, u32Distinct = 0, u32Bound;
+    int32_t i32Miss = 0;
+
+    for (i = 0; i < u32Num; i++)
+    {
+        psPlan[i].u32Priority = IRQ_PLAN_Rank(psPlan, u32Num, psPlan[i].u32DeadlineUs);
+
+        if (psPlan[i].u32Priority >= u32Distinct)
+            u32Distinct = psPlan[i].u32Priority + 1UL;
+    }
+
+    for (i = 0; i < u32Num; i++)
+    {
+        if (u32Distinct > IRQ_PLAN_LEVELS)
+            psPlan[i].u32Priority = psPlan[i].u32Priority * IRQ_PLAN_LEVELS / u32Distinct;
+
+        NVIC_SetPriority(psPlan[i].eIrq, psPlan[i].u32Priority);
+    }
+
+    for (i = 0; i < u32Num; i++)
+    {
+        u32Bound = psPlan[i].u32CostUs;
+
+        for (j = 0; j < u32Num; j++)
+        {
+            if ((j != i) && (psPlan[j].u32Priority <= psPlan[i].u32Priority))
+                u32Bound += psPlan[j].u32CostUs;
+        }
+
+        psPlan[i].u32BoundUs = u32Bound;
+
+        if (u32Bound > psPlan[i].u32DeadlineUs)
+            i32Miss++;
+    }
+
+    return i32Miss;
+}
+
+/**
+  * @brief      Account a monitored ISR run
+  *
+  * @param[in]  psPlan      The pointer of the plan entry of the ISR.
+  * @param[in]  u32Now      Timestamp at the end of the ISR.
+  *
+  * @return     None
+  *
+  * @details    Use \ref IRQ_PLAN_EXIT, which reads the timestamp before the call.
+  */
+void IRQ_PLAN_Exit(S_IRQ_PLAN_T *psPlan, uint32_t u32Now)
+{
+    uint32_t u32Ticks = (u32Now - psPlan->u32Entry) & PROF_CNT_MSK;
+
+    if (u32Ticks > psPlan->u32MaxTicks)
+        psPlan->u32MaxTicks = u32Ticks;
+
+    psPlan->u32Count++;
+}
+
+/**
+  * @brief      Clear the measurements of a plan
+  *
+  * @param[in]  psPlan      Plan entries.
+  * @param[in]  u32Num      Number of entries.
+  *
+  * @return     None
+  */
+void IRQ_PLAN_Reset(S_IRQ_PLAN_T *psPlan, uint32_t u32Num)
+{
+    uint32_t u32PriMask = __get_PRIMASK();
+
+    __set_PRIMASK(1);
+
+    while (u32Num--)
+    {
+        psPlan->u32Count = 0;
+        psPlan->u32MaxTicks = 0;
+        psPlan->u32MaxLatencyUs = 0;
+        psPlan++;
+    }
+
+    __set_PRIMASK(u32PriMask);
+}
+
+/**
+  * @brief      Raise the declared costs to the measured ones
+  *
+  * @param[in]  psPlan      Plan entries.
+  * @param[in]  u32Num      Number of entries.
+  * @param[in]  u32TickFreq Tick frequency returned by PROF_Open.
+  *
+  * @return     None
+  *
+  * @details    Run the application under load with the monitor in place, then learn and apply again. Measured
+  *             runs include the time spent in nested ISRs, so the learned costs are on the safe side.
+  */
+void IRQ_PLAN_Learn(S_IRQ_PLAN_T *psPlan, uint32_t u32Num, uint32_t u32TickFreq)
+{
+    uint32_t u32Us;
+
+    while (u32Num--)
+    {
+        u32Us = IRQ_PLAN_TicksToUs(psPlan->u32MaxTicks, u32TickFreq);
+
+        if (u32Us > psPlan->u32CostUs)
+            psPlan->u32CostUs = u32Us;
+
+        psPlan++;
+    }
+}
+
+/**
+  * @brief      Start a periodic TIMER as latency probe
+  *
+  * @param[in]  psPlan      Plan entry of the TIMER interrupt, applied already.
+  * @param[in]  timer       The pointer of the TIMER, it must be clocked.
+  * @param[in]  u32Freq     Events per second.
+  *
+  * @return     Event frequency actually set
+  *
+  * @details    The TIMER counts on from 0 after every event, so its counter read at entry of the handler is the
+  *             time the event waited. A probe on the level of a real interrupt, audio for example, shows the
+  *             latency that interrupt sees. Latencies longer than the period are not detected.
+  */
+uint32_t IRQ_PLAN_ProbeStart(S_IRQ_PLAN_T *psPlan, TIMER_T *timer, uint32_t u32Freq)
+{
+    uint32_t u32Ret, u32Clk;
+
+    u32Ret = TIMER_Open(timer, TIMER_PERIODIC_MODE, u32Freq);
+    u32Clk = TIMER_GetModuleClock(timer) / (((timer->CTL & TIMER_CTL_PSC_Msk) >> TIMER_CTL_PSC_Pos) + 1UL);
+    psPlan->u32UsScale = (uint32_t)((1000000ULL << 16) / u32Clk);
+
+    TIMER_EnableInt(timer);
+    NVIC_EnableIRQ(psPlan->eIrq);
+    TIMER_Start(timer);
+
+    return u32Ret;
+}
+
+/**
+  * @brief      Stop a latency probe
+  *
+  * @param[in]  psPlan      Plan entry of the TIMER interrupt.
+  * @param[in]  timer       The pointer of the TIMER.
+  *
+  * @return     None
+  */
+void IRQ_PLAN_ProbeStop(S_IRQ_PLAN_T *psPlan, TIMER_T *timer)
+{
+    TIMER_Stop(timer);
+    NVIC_DisableIRQ(psPlan->eIrq);
+    TIMER_DisableInt(timer);
+    TIMER_ClearIntFlag(timer);
+}
+
+/**
+  * @brief      Measure the latency at entry of the probe handler
+  *
+  * @param[in]  psPlan      Plan entry of the TIMER interrupt.
+  * @param[in]  timer       The pointer of the TIMER.
+  *
+  * @return     None
+  *
+  * @details    First statement of the TIMER handler, it clears the TIMER flag and does \ref IRQ_PLAN_ENTER too.
+  */
+void IRQ_PLAN_ProbeEntry(S_IRQ_PLAN_T *psPlan, TIMER_T *timer)
+{
+    uint32_t u32Us = (uint32_t)(((uint64_t)TIMER_GetCounter(timer) * psPlan->u32UsScale) >> 16);
+
+    IRQ_PLAN_ENTER(psPlan);
+    TIMER_ClearIntFlag(timer);
+
+    if (u32Us > psPlan->u32MaxLatencyUs)
+        psPlan->u32MaxLatencyUs = u32Us;
+}
+
+/**
+  * @brief      Print a plan with its measurements
+  *
+  * @param[in]  psPlan      Plan entries.
+  * @param[in]  u32Num      Number of entries.
+  * @param[in]  u32TickFreq Tick frequency returned by PROF_Open.
+  *
+  * @return     None
+  *
+  * @details    An entry is flagged when its measured run or latency proves the deadline was missed, or when
+  *             \ref IRQ_PLAN_Apply predicted it might be. Only probes started by \ref IRQ_PLAN_ProbeStart
+  *             measure latency, other entries show "-" and are checked on their run time alone.
+  */
+void IRQ_PLAN_Report(S_IRQ_PLAN_T *psPlan, uint32_t u32Num, uint32_t u32TickFreq)
+{
+    uint32_t u32RunUs, u32LatencyUs;
+    char acLatency[12];
+
+    printf("IRQ  Name             Level Deadline  Bound    Runs     MaxRun  Latency (us)\n");
+
+    while (u32Num--)
+    {
+        u32RunUs = IRQ_PLAN_TicksToUs(psPlan->u32MaxTicks, u32TickFreq);
+
+        /* Only a probe knows when its event happened */
+        if (psPlan->u32UsScale != 0)
+        {
+            u32LatencyUs = psPlan->u32MaxLatencyUs;
+            sprintf(acLatency, "%u", (unsigned int)u32LatencyUs);
+        }
+        else
+        {
+            u32LatencyUs = 0;
+            sprintf(acLatency, "-");
+        }
+
+        printf("%-4d %-16s %-5u %-9u %-8u %-8u %-7u %-7s %s\n", (int)psPlan->eIrq, psPlan->pcName,
+               (unsigned int)psPlan->u32Priority, (unsigned int)psPlan->u32DeadlineUs,
+               (unsigned int)psPlan->u32BoundUs, (unsigned int)psPlan->u32Count, (unsigned int)u32RunUs,
+               acLatency,
+               ((psPlan->u32BoundUs > psPlan->u32DeadlineUs) ||
+                (u32RunUs + u32LatencyUs > psPlan->u32DeadlineUs)) ? "MISS" : "");
+        psPlan++;
+    }
+}
+
+/*@}*/ /* end of group IRQ_PLAN_EXPORTED_FUNCTIONS */
+
+/*@}*/ /* end of group IRQ_PLAN_Driver */
+
+/*@}*/ /* end of group Standard_Driver */
+
+/*** (C) COPYRIGHT 2021 Nuvoton Technology Corp. ***/
@@ -0,0 +1,331 @@
+/**************************************************************************//**
+ * @file     lpm.c
+ * @version  V1.00
+ * @brief    NUC121 series low power manager source file
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * @copyright (C) 2021 Nuvoton Technology Corp. All rights reserved.
+*****************************************************************************/
+#include "NuMicro.h"
+
+/** @addtogroup Standard_Driver Standard Driver
+  @{
+*/
+
+/** @addtogroup LPM_Driver LPM Driver
+  @{
+*/
+
+/// @cond HIDDEN_SYMBOLS
+
+#define LPM_NO_TIMEOUT          (0xFFFFFFFFUL)
+
+static TIMER_T *s_psTimebase = NULL;
+static uint32_t s_u32TimebaseInPD = 0;
+static uint32_t s_u32MinPDTime = 0;
+static S_LPM_DEV_T *s_psDevList = NULL;
+static S_LPM_STAT_T s_sStat;
+
+/* Only timers clocked from LXT or LIRC keep counting in power-down mode */
+static uint32_t LPM_IsTimerInPD(TIMER_T *timer)
+{
+    uint32_t u32Sel;
+
+    if (timer == TIMER0)
+        u32Sel = (CLK->CLKSEL1 & CLK_CLKSEL1_TMR0SEL_Msk) >> CLK_CLKSEL1_TMR0SEL_Pos;
+    else if (timer == TIMER1)
+        u32Sel = (CLK->CLKSEL1 & CLK_CLKSEL1_TMR1SEL_Msk) >> CLK_CLKSEL1_TMR1SEL_Pos;
+    else if (timer == TIMER2)
+        u32Sel = (CLK->CLKSEL1 & CLK_CLKSEL1_TMR2SEL_Msk) >> CLK_CLKSEL1_TMR2SEL_Pos;
+    else
+        u32Sel = (CLK->CLKSEL1 & CLK_CLKSEL1_TMR3SEL_Msk) >> CLK_CLKSEL1_TMR3SEL_Pos;
+
+    u32Sel <<= CLK_CLKSEL1_TMR0SEL_Pos;
+
+    return ((u32Sel == CLK_CLKSEL1_TMR0SEL_LXT) || (u32Sel == CLK_CLKSEL1_TMR0SEL_LIRC)) ? 1UL : 0UL;
+}
+
+/* Deepest mode allowed by every registered device and by the next software timer deadline */
+static uint32_t LPM_Decide(uint32_t *pu32Next)
+{
+    S_LPM_DEV_T *psDev;
+    uint32_t u32Mode = LPM_MODE_PD, u32DevMode;
+
+    *pu32Next = LPM_NO_TIMEOUT;
+
+    for (psDev = s_psDevList; psDev != NULL; psDev = psDev->psNext)
+    {
+        if (psDev->pfnMode != NULL)
+        {
+            u32DevMode = psDev->pfnMode(psDev->pvArg);
+
+            if (u32DevMode < u32Mode)
+                u32Mode = u32DevMode;
+
+            if (u32Mode == LPM_MODE_RUN)
+                return LPM_MODE_RUN;
+        }
+    }
+
+    if (s_psTimebase != NULL)
+    {
+        *pu32Next = SWTIMER_GetNextTimeout();
+
+        if (*pu32Next == 0)
+            return LPM_MODE_RUN;
+
+        /* A deadline the timebase cannot see in power-down, or one too close to pay for the wake-up, stays in idle */
+        if ((u32Mode == LPM_MODE_PD) && (*pu32Next != LPM_NO_TIMEOUT) &&
+                ((s_u32TimebaseInPD == 0) || (*pu32Next < s_u32MinPDTime)))
+            u32Mode = LPM_MODE_IDLE;
+    }
+
+    return u32Mode;
+}
+
+/* Wait for every clock source enabled before power-down, HCLK may run from HXT or PLL */
+static void LPM_RestoreClock(uint32_t u32PwrCtl)
+{
+    uint32_t u32Stable = 0;
+
+    if ((u32PwrCtl & CLK_PWRCTL_XTLEN_Msk) == CLK_PWRCTL_HXTEN)
+        u32Stable |= CLK_STATUS_HXTSTB_Msk;
+
+    if (u32PwrCtl & CLK_PWRCTL_HIRCEN_Msk)
+        u32Stable |= CLK_STATUS_HIRCSTB_Msk;
+
+    if ((CLK->PLLCTL & CLK_PLLCTL_PD_Msk) == 0)
+        u32Stable |= CLK_STATUS_PLLSTB_Msk;
+
+    if (u32Stable != 0)
+        CLK_WaitClockReady(u32Stable);
+}
+
+/// @endcond HIDDEN_SYMBOLS
+
+/** @addtogroup LPM_EXPORTED_FUNCTIONS LPM Exported Functions
+  @{
+*/
+
+/**
+  * @brief      Initialize the low power manager
+  *
+  * @param[in]  timer           The timer passed to \ref SWTIMER_Open, or NULL if software timers are not used.
+  * @param[in]  u32MinPDTime    Minimum time to the next deadline, in timebase counts, worth a power-down entry.
+  *
+  * @return     None
+  *
+  * @details    If the timebase is clocked from LXT or LIRC, its wake-up function is enabled and the compare match
+  *             of the next software timer wakes the chip from power-down. Otherwise the timebase stops in
+  *             power-down mode, so only idle mode is used while a software timer is active.
+  *             Registered devices are kept. Set the timer clock before calling this function.
+  */
+void LPM_Init(TIMER_T *timer, uint32_t u32MinPDTime)
+{
+    s_psTimebase = timer;
+    s_u32MinPDTime = u32MinPDTime;
+    s_u32TimebaseInPD = 0;
+
+    if (timer != NULL)
+    {
+        s_u32TimebaseInPD = LPM_IsTimerInPD(timer);
+
+        if (s_u32TimebaseInPD)
+            TIMER_EnableWakeup(timer);
+    }
+
+    s_sStat.u32IdleCount = 0;
+    s_sStat.u32PDCount = 0;
+    s_sStat.u32TimerWakeCount = 0;
+    s_sStat.u32SleepTime = 0;
+    s_sStat.u32LastWakeLatency = 0;
+    s_sStat.u32MaxWakeLatency = 0;
+}
+
+/**
+  * @brief      Register a device to the low power manager
+  *
+  * @param[in]  psDev       The pointer of the device, owned by the caller.
+  * @param[in]  pfnMode     Returns the deepest mode the device allows, \ref LPM_MODE_RUN, \ref LPM_MODE_IDLE or
+  *                         \ref LPM_MODE_PD. For example a UART returns \ref LPM_MODE_IDLE until its TX FIFO is empty.
+  * @param[in]  pfnSuspend  Called before power-down to arm the wake-up source of the device.
+  * @param[in]  pfnResume   Called after wake-up from power-down.
+  * @param[in]  pvArg       Argument of the device functions.
+  *
+  * @return     None
+  *
+  * @details    Every function runs with interrupts disabled and must not wait for an interrupt.
+  *             Devices are resumed in the reverse order of suspension.
+  */
+void LPM_RegisterDevice(S_LPM_DEV_T *psDev, LPM_MODE_FUNC pfnMode, LPM_CB pfnSuspend, LPM_CB pfnResume, void *pvArg)
+{
+    uint32_t u32PriMask = __get_PRIMASK();
+
+    psDev->pfnMode = pfnMode;
+    psDev->pfnSuspend = pfnSuspend;
+    psDev->pfnResume = pfnResume;
+    psDev->pvArg = pvArg;
+
+    __set_PRIMASK(1);
+    psDev->psNext = s_psDevList;
+    s_psDevList = psDev;
+    __set_PRIMASK(u32PriMask);
+}
+
+/**
+  * @brief      Unregister a device from the low power manager
+  *
+  * @param[in]  psDev       The pointer of the device.
+  *
+  * @return     None
+  */
+void LPM_UnregisterDevice(S_LPM_DEV_T *psDev)
+{
+    S_LPM_DEV_T **ppsLink;
+    uint32_t u32PriMask = __get_PRIMASK();
+
+    __set_PRIMASK(1);
+
+    for (ppsLink = &s_psDevList; *ppsLink != NULL; ppsLink = &(*ppsLink)->psNext)
+    {
+        if (*ppsLink == psDev)
+        {
+            *ppsLink = psDev->psNext;
+            break;
+        }
+    }
+
+    __set_PRIMASK(u32PriMask);
+}
+
+/**
+  * @brief      Get the deepest mode allowed now
+  *
+  * @param      None
+  *
+  * @return     \ref LPM_MODE_RUN, \ref LPM_MODE_IDLE or \ref LPM_MODE_PD
+  */
+uint32_t LPM_GetMode(void)
+{
+    uint32_t u32PriMask = __get_PRIMASK(), u32Next, u32Mode;
+
+    __set_PRIMASK(1);
+    u32Mode = LPM_Decide(&u32Next);
+    __set_PRIMASK(u32PriMask);
+
+    return u32Mode;
+}
+
+/**
+  * @brief      Enter the deepest allowed low power mode
+  *
+  * @param      None
+  *
+  * @return     The mode that was used, \ref LPM_MODE_RUN if the system did not sleep
+  *
+  * @details    Call this API from the idle loop after all pending work is done. Interrupts are disabled while the
+  *             mode is decided and the chip sleeps, so an event raised in between only shortens the sleep, and
+  *             the interrupt handlers run after clocks are stable and devices are resumed.
+  *             Protected registers are unlocked and locked again for the power-down entry if they were locked.
+  */
+uint32_t LPM_Sleep(void)
+{
+    S_LPM_DEV_T *psDev, *psDone = NULL;
+    uint32_t u32PriMask = __get_PRIMASK(), u32Mode, u32Next, u32Start = 0, u32Now, u32PwrCtl, u32Locked;
+
+    __set_PRIMASK(1);
+
+    u32Mode = LPM_Decide(&u32Next);
+
+    if (s_psTimebase != NULL)
+        u32Start = SWTIMER_GetTime();
+
+    if (u32Mode == LPM_MODE_IDLE)
+    {
+        s_sStat.u32IdleCount++;
+        CLK_Idle();
+    }
+    else if (u32Mode == LPM_MODE_PD)
+    {
+        s_sStat.u32PDCount++;
+
+        for (psDev = s_psDevList; psDev != NULL; psDev = psDev->psNext)
+        {
+            if (psDev->pfnSuspend != NULL)
+                psDev->pfnSuspend(psDev->pvArg);
+        }
+
+        if (s_u32TimebaseInPD && TIMER_GetWakeupFlag(s_psTimebase))
+            TIMER_ClearWakeupFlag(s_psTimebase);
+
+        u32PwrCtl = CLK->PWRCTL;
+        u32Locked = SYS_IsRegLocked();
+
+        if (u32Locked)
+            SYS_UnlockReg();
+
+        CLK_PowerDown();
+
+        if (u32Locked)
+            SYS_LockReg();
+
+        LPM_RestoreClock(u32PwrCtl);
+
+        if (s_u32TimebaseInPD && TIMER_GetWakeupFlag(s_psTimebase))
+        {
+            TIMER_ClearWakeupFlag(s_psTimebase);
+            s_sStat.u32TimerWakeCount++;
+
+            if (u32Next != LPM_NO_TIMEOUT)
+            {
+                u32Now = SWTIMER_GetTime() - (u32Start + u32Next);
+
+                if ((int32_t)u32Now < 0)
+                    u32Now = 0;
+
+                s_sStat.u32LastWakeLatency = u32Now;
+
+                if (u32Now > s_sStat.u32MaxWakeLatency)
+                    s_sStat.u32MaxWakeLatency = u32Now;
+            }
+        }
+
+        /* Resume in the reverse order of suspension */
+        while (psDone != s_psDevList)
+        {
+            for (psDev = s_psDevList; psDev->psNext != psDone; psDev = psDev->psNext);
+
+            if (psDev->pfnResume != NULL)
+                psDev->pfnResume(psDev->pvArg);
+
+            psDone = psDev;
+        }
+    }
+
+    if ((u32Mode != LPM_MODE_RUN) && (s_psTimebase != NULL))
+        s_sStat.u32SleepTime += SWTIMER_GetTime() - u32Start;
+
+    __set_PRIMASK(u32PriMask);
+
+    return u32Mode;
+}
+
+/**
+  * @brief      Get the low power statistics
+  *
+  * @param      None
+  *
+  * @return     The pointer of the statistics
+  */
+const S_LPM_STAT_T *LPM_GetStat(void)
+{
+    return &s_sStat;
+}
+
+/*@}*/ /* end of group LPM_EXPORTED_FUNCTIONS */
+
+/*@}*/ /* end of group LPM_Driver */
+
+/*@}*/ /* end of group Standard_Driver */
+
+/*** (C) COPYRIGHT 2021 Nuvoton Technology Corp. ***/
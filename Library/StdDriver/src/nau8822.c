@@ -0,0 +1,375 @@
+/**************************************************************************//**
+ * @file     nau8822.c
+ * @version  V1.00
+ * @brief    NUC121 series NAU8822 audio codec driver source file
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * @copyright (C) 2021 Nuvoton Technology Corp. All rights reserved.
+*****************************************************************************/
+#include <string.h>
+#include "NuMicro.h"
+
+/** @addtogroup Standard_Driver Standard Driver
+  @{
+*/
+
+/** @addtogroup NAU8822_Driver NAU8822 Driver
+  @{
+*/
+
+/// @cond HIDDEN_SYMBOLS
+
+#define NAU8822_DEFAULT_NUM     (58UL)  /* R0 to R57 have documented reset values */
+#define NAU8822_NO_REG          (0xFFFFFFFFUL)
+
+typedef struct
+{
+    uint32_t u32Rate;
+    uint8_t u8Family;                   /* Row of s_au16Nau8822Pll */
+    uint8_t u8MclkSel;                  /* R6 MCLKSEL, PLL / 4 divided down to 256 fs */
+    uint8_t u8Smplr;                    /* R7 SMPLR, filter coefficients */
+} S_NAU8822_RATE_T;
+
+static const uint16_t s_au16Nau8822Default[NAU8822_DEFAULT_NUM] =
+{
+    0x000, 0x000, 0x000, 0x000, 0x050, 0x000, 0x140, 0x000, 0x000, 0x000,
+    0x000, 0x0FF, 0x0FF, 0x000, 0x100, 0x0FF, 0x0FF, 0x000, 0x12C, 0x02C,
+    0x02C, 0x02C, 0x02C, 0x000, 0x032, 0x000, 0x000, 0x000, 0x000, 0x000,
+    0x000, 0x000, 0x038, 0x00B, 0x032, 0x000, 0x008, 0x00C, 0x093, 0x0E9,
+    0x000, 0x000, 0x000, 0x000, 0x033, 0x010, 0x010, 0x100, 0x100, 0x002,
+    0x001, 0x001, 0x039, 0x039, 0x039, 0x039, 0x001, 0x001
+};
+
+/* PLL N, K1, K2 and K3 for a 12 MHz MCLK: nominal, 0.5 % up and 0.5 % down.
+   98.304 MHz serves 48 kHz and its divisions, 90.3168 MHz serves 44.1 kHz. */
+static const uint16_t s_au16Nau8822Pll[2][3][4] =
+{
+    {{0x008, 0x00C, 0x093, 0x0E9}, {0x008, 0x00E, 0x1D1, 0x144}, {0x008, 0x009, 0x155, 0x08F}},
+    {{0x007, 0x021, 0x161, 0x027}, {0x007, 0x024, 0x032, 0x067}, {0x007, 0x01F, 0x08F, 0x1E6}}
+};
+
+static const S_NAU8822_RATE_T s_asNau8822Rate[] =
+{
+    {48000, 0, 2, 0}, {32000, 0, 3, 1}, {24000, 0, 4, 2}, {16000, 0, 5, 3}, {12000, 0, 6, 4}, {8000, 0, 7, 5},
+    {44100, 1, 2, 0}, {22050, 1, 4, 2}, {11025, 1, 6, 4}
+};
+
+static void NAU8822_Next(S_NAU8822_T *psCodec);
+
+static uint32_t NAU8822_IsKnown(S_NAU8822_T *psCodec, uint32_t u32Reg)
+{
+    return (psCodec->au32Known[u32Reg >> 5] >> (u32Reg & 31UL)) & 1UL;
+}
+
+static void NAU8822_SetDirty(S_NAU8822_T *psCodec, uint32_t u32Reg)
+{
+    psCodec->au32Dirty[u32Reg >> 5] |= 1UL << (u32Reg & 31UL);
+}
+
+/* Completion in interrupt context, a failed register is sent again by its next write */
+static void NAU8822_XferDone(S_I2C_XFER_T *psXfer)
+{
+    S_NAU8822_T *psCodec = (S_NAU8822_T *)psXfer->pvArg;
+
+    if (psXfer->i32Status != I2C_XFER_OK)
+    {
+        psCodec->u32Errors++;
+        psCodec->au32Known[psCodec->u8Reg >> 5] &= ~(1UL << (psCodec->u8Reg & 31UL));
+    }
+
+    NAU8822_Next(psCodec);
+}
+
+/* Send the lowest dirty register, so left volumes go before the right ones that carry the update bit.
+   Called with interrupts masked or from the completion. */
+static void NAU8822_Next(S_NAU8822_T *psCodec)
+{
+    uint32_t i, u32Reg = NAU8822_NO_REG, u32Value;
+
+    for (i = 0; i < ((NAU8822_REG_NUM + 31UL) / 32UL); i++)
+    {
+        if (psCodec->au32Dirty[i] != 0)
+        {
+            u32Reg = i * 32UL;
+
+            while (((psCodec->au32Dirty[i] >> (u32Reg & 31UL)) & 1UL) == 0)
+                u32Reg++;
+
+            break;
+        }
+    }
+
+    if (u32Reg == NAU8822_NO_REG)
+    {
+        psCodec->u8Busy = 0;
+        return;
+    }
+
+    psCodec->au32Dirty[u32Reg >> 5] &= ~(1UL << (u32Reg & 31UL));
+    psCodec->au32Known[u32Reg >> 5] |= 1UL << (u32Reg & 31UL);
+
+    /* 7-bit register number and data bit 8 take the place of a register address */
+    u32Value = psCodec->au16Shadow[u32Reg];
+    psCodec->u8Reg = (uint8_t)u32Reg;
+    psCodec->u8Data = (uint8_t)u32Value;
+    psCodec->u8Busy = 1;
+    psCodec->u32Writes++;
+
+    I2C_XFER_Setup(&psCodec->sXfer, NAU8822_SLAVE_ADDR, (uint16_t)((u32Reg << 1) | (u32Value >> 8)), 1,
+                   &psCodec->u8Data, 1, NULL, 0);
+    I2C_XFER_Submit(psCodec->psBus, &psCodec->sXfer, NAU8822_XferDone, psCodec);
+}
+
+/// @endcond HIDDEN_SYMBOLS
+
+/** @addtogroup NAU8822_EXPORTED_FUNCTIONS NAU8822 Exported Functions
+  @{
+*/
+
+/**
+  * @brief      Reset the codec and load the register shadow
+  *
+  * @param[in]  psCodec     The pointer of the codec context.
+  * @param[in]  psBus       Queued I2C master opened by \ref I2C_XFER_Open or \ref UI2C_XFER_Open.
+  *
+  * @return     Result of the reset write, \ref I2C_XFER_OK or I2C_XFER_ERR_xxx
+  *
+  * @details    The reset is the only blocking write. The shadow then holds the reset values of R0 to R57,
+  *             so writes that do not change a register are dropped. Registers above R57 are sent at their
+  *             first write.
+  */
+int32_t NAU8822_Open(S_NAU8822_T *psCodec, S_I2C_XFER_BUS_T *psBus)
+{
+    int32_t i32Ret;
+
+    memset(psCodec, 0, sizeof(S_NAU8822_T));
+    psCodec->psBus = psBus;
+    memcpy(psCodec->au16Shadow, s_au16Nau8822Default, sizeof(s_au16Nau8822Default));
+    psCodec->au32Known[0] = 0xFFFFFFFFUL;
+    psCodec->au32Known[1] = (1UL << (NAU8822_DEFAULT_NUM - 32UL)) - 1UL;
+
+    psCodec->u8Data = 0;
+    I2C_XFER_Setup(&psCodec->sXfer, NAU8822_SLAVE_ADDR, NAU8822_R_RESET << 1, 1, &psCodec->u8Data, 1, NULL, 0);
+    i32Ret = I2C_XFER_Transfer(psBus, &psCodec->sXfer);
+
+    if (i32Ret == I2C_XFER_OK)
+        CLK_SysTickDelay(10000);
+
+    return i32Ret;
+}
+
+/**
+  * @brief      Write a codec register in the background
+  *
+  * @param[in]  psCodec     The pointer of the codec context.
+  * @param[in]  u32Reg      Register number, 1 up to 79.
+  * @param[in]  u32Value    9-bit register value.
+  *
+  * @return     None
+  *
+  * @details    The shadow is updated at once and the register is queued if it changed. Several writes to a
+  *             register still queued go out as one. It never waits for the bus and could be called from
+  *             interrupt context.
+  */
+void NAU8822_WriteReg(S_NAU8822_T *psCodec, uint32_t u32Reg, uint32_t u32Value)
+{
+    uint32_t u32PriMask = __get_PRIMASK();
+
+    if ((u32Reg == NAU8822_R_RESET) || (u32Reg >= NAU8822_REG_NUM))
+        return;
+
+    u32Value &= 0x1FFUL;
+
+    __set_PRIMASK(1);
+
+    if (NAU8822_IsKnown(psCodec, u32Reg) && (psCodec->au16Shadow[u32Reg] == u32Value))
+        psCodec->u32Skips++;
+    else
+    {
+        psCodec->au16Shadow[u32Reg] = (uint16_t)u32Value;
+        NAU8822_SetDirty(psCodec, u32Reg);
+
+        if (psCodec->u8Busy == 0)
+            NAU8822_Next(psCodec);
+    }
+
+    __set_PRIMASK(u32PriMask);
+}
+
+/**
+  * @brief      Change some bits of a codec register in the background
+  *
+  * @param[in]  psCodec     The pointer of the codec context.
+  * @param[in]  u32Reg      Register number, 1 up to 79.
+  * @param[in]  u32Mask     Bits to change.
+  * @param[in]  u32Value    New value of the bits.
+  *
+  * @return     None
+  *
+  * @details    The other bits come from the shadow, the codec is not read.
+  */
+void NAU8822_UpdateBits(S_NAU8822_T *psCodec, uint32_t u32Reg, uint32_t u32Mask, uint32_t u32Value)
+{
+    uint32_t u32PriMask = __get_PRIMASK();
+
+    __set_PRIMASK(1);
+    NAU8822_WriteReg(psCodec, u32Reg, (NAU8822_ReadReg(psCodec, u32Reg) & ~u32Mask) | (u32Value & u32Mask));
+    __set_PRIMASK(u32PriMask);
+}
+
+/**
+  * @brief      Get a register value from the shadow
+  *
+  * @param[in]  psCodec     The pointer of the codec context.
+  * @param[in]  u32Reg      Register number, 0 up to 79.
+  *
+  * @return     Last value written, or the reset value
+  */
+uint32_t NAU8822_ReadReg(S_NAU8822_T *psCodec, uint32_t u32Reg)
+{
+    return (u32Reg < NAU8822_REG_NUM) ? psCodec->au16Shadow[u32Reg] : 0;
+}
+
+/**
+  * @brief      Write a left and right volume pair in the background
+  *
+  * @param[in]  psCodec     The pointer of the codec context.
+  * @param[in]  u32RegL     Left register of the pair: \ref NAU8822_R_DAC_VOL_L, \ref NAU8822_R_ADC_VOL_L,
+  *                         \ref NAU8822_R_PGA_L, \ref NAU8822_R_HP_VOL_L or \ref NAU8822_R_SPK_VOL_L.
+  * @param[in]  u32Left     Left value without \ref NAU8822_VU.
+  * @param[in]  u32Right    Right value without \ref NAU8822_VU.
+  *
+  * @return     None
+  *
+  * @details    The codec applies both channels when the right register is written with the update bit,
+  *             so both registers are queued if either one changed. Nothing is sent if neither changed.
+  *             Other registers have no update bit, bit 8 is a setting there, so they are ignored and must be
+  *             written with \ref NAU8822_WriteReg.
+  */
+void NAU8822_WritePair(S_NAU8822_T *psCodec, uint32_t u32RegL, uint32_t u32Left, uint32_t u32Right)
+{
+    uint32_t u32RegR = u32RegL + 1UL;
+    uint32_t u32PriMask = __get_PRIMASK();
+
+    if ((u32RegL != NAU8822_R_DAC_VOL_L) && (u32RegL != NAU8822_R_ADC_VOL_L) && (u32RegL != NAU8822_R_PGA_L) &&
+            (u32RegL != NAU8822_R_HP_VOL_L) && (u32RegL != NAU8822_R_SPK_VOL_L))
+        return;
+
+    u32Left &= 0x1FFUL & ~NAU8822_VU;
+    u32Right = (u32Right & 0x1FFUL) | NAU8822_VU;
+
+    __set_PRIMASK(1);
+
+    if (NAU8822_IsKnown(psCodec, u32RegL) && NAU8822_IsKnown(psCodec, u32RegR) &&
+            (((psCodec->au16Shadow[u32RegL] ^ u32Left) & ~NAU8822_VU) == 0) &&
+            (((psCodec->au16Shadow[u32RegR] ^ u32Right) & ~NAU8822_VU) == 0))
+        psCodec->u32Skips += 2;
+    else
+    {
+        psCodec->au16Shadow[u32RegL] = (uint16_t)u32Left;
+        psCodec->au16Shadow[u32RegR] = (uint16_t)u32Right;
+        NAU8822_SetDirty(psCodec, u32RegL);
+        NAU8822_SetDirty(psCodec, u32RegR);
+
+        if (psCodec->u8Busy == 0)
+            NAU8822_Next(psCodec);
+    }
+
+    __set_PRIMASK(u32PriMask);
+}
+
+/**
+  * @brief      Set the codec as I2S master at a sample rate
+  *
+  * @param[in]  psCodec         The pointer of the codec context.
+  * @param[in]  u32SampleRate   8000, 11025, 12000, 16000, 22050, 24000, 32000, 44100 or 48000.
+  * @param[in]  u32WordWidth    16, 20, 24 or 32 bits.
+  *
+  * @retval     0                   Success, the registers are queued
+  * @retval     NAU8822_ERR_RATE    Sample rate or word length not supported
+  *
+  * @details    The PLL runs from a \ref NAU8822_MCLK input with the nominal entry of a precomputed table, so
+  *             no division is done at run time. BCLK is 32 fs for 16-bit words and 64 fs otherwise.
+  */
+int32_t NAU8822_SetFormat(S_NAU8822_T *psCodec, uint32_t u32SampleRate, uint32_t u32WordWidth)
+{
+    const S_NAU8822_RATE_T *psRate = NULL;
+    uint32_t i, u32Wl;
+
+    for (i = 0; i < (sizeof(s_asNau8822Rate) / sizeof(s_asNau8822Rate[0])); i++)
+    {
+        if (s_asNau8822Rate[i].u32Rate == u32SampleRate)
+            psRate = &s_asNau8822Rate[i];
+    }
+
+    if (u32WordWidth == 16)
+        u32Wl = 0;
+    else if (u32WordWidth == 20)
+        u32Wl = 1;
+    else if (u32WordWidth == 24)
+        u32Wl = 2;
+    else if (u32WordWidth == 32)
+        u32Wl = 3;
+    else
+        psRate = NULL;
+
+    if (psRate == NULL)
+        return NAU8822_ERR_RATE;
+
+    psCodec->u32PllFamily = psRate->u8Family;
+
+    /* PLL on, I2S format with the word length */
+    NAU8822_UpdateBits(psCodec, NAU8822_R_POWER1, 0x020UL, 0x020UL);
+    NAU8822_UpdateBits(psCodec, NAU8822_R_AUDIO_IF, 0x078UL, (u32Wl << 5) | (2UL << 3));
+
+    /* PLL clock, MCLK divider to 256 fs, BCLK divider, master */
+    NAU8822_WriteReg(psCodec, NAU8822_R_CLOCK1, 0x100UL | ((uint32_t)psRate->u8MclkSel << 5) |
+                     ((u32Wl == 0) ? (3UL << 2) : (2UL << 2)) | 0x001UL);
+    NAU8822_UpdateBits(psCodec, NAU8822_R_CLOCK2, 0x00EUL, (uint32_t)psRate->u8Smplr << 1);
+    NAU8822_TrimPll(psCodec, NAU8822_TRIM_NONE);
+
+    return 0;
+}
+
+/**
+  * @brief      Pull the codec sample rate to follow the USB host
+  *
+  * @param[in]  psCodec     The pointer of the codec context.
+  * @param[in]  i32Trim     \ref NAU8822_TRIM_NONE, \ref NAU8822_TRIM_UP or \ref NAU8822_TRIM_DOWN.
+  *
+  * @return     None
+  *
+  * @details    Only the PLL fraction registers that differ are sent, repeating a trim costs no bus time.
+  */
+void NAU8822_TrimPll(S_NAU8822_T *psCodec, int32_t i32Trim)
+{
+    const uint16_t *pu16Pll;
+    uint32_t i;
+
+    pu16Pll = s_au16Nau8822Pll[psCodec->u32PllFamily][(i32Trim > 0) ? 1 : ((i32Trim < 0) ? 2 : 0)];
+
+    for (i = 0; i < 4; i++)
+        NAU8822_WriteReg(psCodec, NAU8822_R_PLL_N + i, pu16Pll[i]);
+}
+
+/**
+  * @brief      Wait until all queued register writes have been sent
+  *
+  * @param[in]  psCodec     The pointer of the codec context.
+  *
+  * @return     None
+  *
+  * @details    The bus time-out guarantees that the wait ends. It must not be called from interrupt context.
+  */
+void NAU8822_Sync(S_NAU8822_T *psCodec)
+{
+    while (psCodec->u8Busy);
+}
+
+/*@}*/ /* end of group NAU8822_EXPORTED_FUNCTIONS */
+
+/*@}*/ /* end of group NAU8822_Driver */
+
+/*@}*/ /* end of group Standard_Driver */
+
+/*** (C) COPYRIGHT 2021 Nuvoton Technology Corp. ***/
@@ -0,0 +1,362 @@
+/**************************************************************************//**
+ * @file     prof.c
+ * @version  V1.00
+ * @brief    NUC121 series timing probe and PC sampling profiler source file
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * @copyright (C) 2021 Nuvoton Technology Corp. All rights reserved.
+*****************************************************************************/
+#include <stdio.h>
+#include "NuMicro.h"
+
+/** @addtogroup Standard_Driver Standard Driver
+  @{
+*/
+
+/** @addtogroup PROF_Driver PROF Driver
+  @{
+*/
+
+/// @cond HIDDEN_SYMBOLS
+
+#define PROF_CAT(a, b, c)       a##b##c
+#define PROF_XCAT(a, b, c)      PROF_CAT(a, b, c)
+#define PROF_TIMER              PROF_XCAT(TIMER, PROF_SAMPLE_TIMER_NUM, )
+#define PROF_TIMER_IRQn         PROF_XCAT(TMR, PROF_SAMPLE_TIMER_NUM, _IRQn)
+#define PROF_SAMPLE_HANDLER     PROF_XCAT(TMR, PROF_SAMPLE_TIMER_NUM, _IRQHandler)
+
+volatile uint32_t *g_pu32ProfCnt = (volatile uint32_t *)&SysTick->VAL;
+uint32_t g_u32ProfXor = PROF_CNT_MSK;
+
+static uint32_t s_u32ProfFreq;
+static uint32_t s_u32ProfOverhead;      /* Ticks of an empty scope, removed from every scope */
+static S_PROF_PROBE_T *s_psProfProbes;
+
+static uint16_t *s_pu16ProfHist;
+static uint32_t s_u32ProfBuckets;
+static uint32_t s_u32ProfShift;
+static uint32_t s_u32ProfSampleFreq;
+static volatile uint32_t s_u32ProfSamples;
+static volatile uint32_t s_u32ProfOutside;   /* PC out of the histogram, code in SRAM for example */
+
+#ifdef PROF_USE_SAMPLER
+
+/*
+    The sampler is the vector of its TIMER. It finds the exception frame through EXC_RETURN without a branch,
+    passes the stacked PC to PROF_SamplePC and returns by popping EXC_RETURN into PC.
+*/
+#if defined ( __CC_ARM )
+
+__asm void PROF_SAMPLE_HANDLER(void)
+{
+    MOV     R2, LR
+    LSLS    R2, R2, #29             //; EXC_RETURN bit 2 to the sign
+    ASRS    R2, R2, #31             //; All ones if the frame is on PSP
+    MRS     R0, MSP
+    MRS     R1, PSP
+    EORS    R1, R1, R0
+    ANDS    R1, R1, R2
+    EORS    R0, R0, R1              //; Frame address
+    LDR     R0, [R0, #24]           //; Stacked PC
+    PUSH    {R1, LR}
+    BL      __cpp(PROF_SamplePC)
+    POP     {R1, PC}
+}
+
+#elif defined ( __ICCARM__ )
+
+__stackless void PROF_SAMPLE_HANDLER(void)
+{
+    asm("MOV     R2, LR          \n"
+        "LSLS    R2, R2, #29     \n"  //; EXC_RETURN bit 2 to the sign
+        "ASRS    R2, R2, #31     \n"  //; All ones if the frame is on PSP
+        "MRS     R0, MSP         \n"
+        "MRS     R1, PSP         \n"
+        "EORS    R1, R1, R0      \n"
+        "ANDS    R1, R1, R2      \n"
+        "EORS    R0, R0, R1      \n"  //; Frame address
+        "LDR     R0, [R0, #24]   \n"  //; Stacked PC
+        "PUSH    {R1, LR}        \n"
+        "BL      PROF_SamplePC   \n"
+        "POP     {R1, PC}        \n"
+       );
+}
+
+#else
+
+__attribute__((naked))
+void PROF_SAMPLE_HANDLER(void)
+{
+    asm("MOV     R2, LR          \n"
+        "LSLS    R2, #29         \n"  //; EXC_RETURN bit 2 to the sign
+        "ASRS    R2, #31         \n"  //; All ones if the frame is on PSP
+        "MRS     R0, MSP         \n"
+        "MRS     R1, PSP         \n"
+        "EORS    R1, R0          \n"
+        "ANDS    R1, R2          \n"
+        "EORS    R0, R1          \n"  //; Frame address
+        "LDR     R0, [R0, #24]   \n"  //; Stacked PC
+        "PUSH    {R1, LR}        \n"
+        "BL      PROF_SamplePC   \n"
+        "POP     {R1, PC}        \n"
+       );
+}
+
+#endif
+
+#endif /* PROF_USE_SAMPLER */
+
+/// @endcond HIDDEN_SYMBOLS
+
+
+/** @addtogroup PROF_EXPORTED_FUNCTIONS PROF Exported Functions
+  @{
+*/
+
+/**
+  * @brief      Select the timestamp source of the probes
+  *
+  * @param[in]  timer   TIMER to run free at its module clock, or NULL for SysTick at HCLK.
+  *
+  * @return     Tick frequency in Hz
+  *
+  * @details    SysTick gives CPU cycles, but is taken over, so CLK_SysTickDelay and a SysTick interrupt can not
+  *             be used together with it. A TIMER counts its module clock, PCLK gives HCLK cycles if PCLK is
+  *             not divided. The cost of the probe itself is measured here and removed from every scope.
+  */
+uint32_t PROF_Open(TIMER_T *timer)
+{
+    S_PROF_PROBE_T sCal;
+    uint32_t i;
+
+    if (timer == NULL)
+    {
+        SysTick->LOAD = PROF_CNT_MSK;
+        SysTick->VAL = 0;
+        SysTick->CTRL = SysTick_CTRL_CLKSOURCE_Msk | SysTick_CTRL_ENABLE_Msk;
+        g_pu32ProfCnt = (volatile uint32_t *)&SysTick->VAL;
+        g_u32ProfXor = PROF_CNT_MSK;
+        s_u32ProfFreq = SystemCoreClock;
+    }
+    else
+    {
+        timer->CTL = 0;
+        timer->EXTCTL = 0;
+        timer->CMP = PROF_CNT_MSK;
+        timer->INTSTS = TIMER_INTSTS_TIF_Msk;
+        timer->CTL = TIMER_CTL_CNTEN_Msk | TIMER_CONTINUOUS_MODE;
+        g_pu32ProfCnt = (volatile uint32_t *)&timer->CNT;
+        g_u32ProfXor = 0;
+        s_u32ProfFreq = TIMER_GetModuleClock(timer);
+    }
+
+    s_u32ProfOverhead = 0;
+    sCal.u32Min = 0xFFFFFFFFUL;
+    sCal.u32Max = 0;
+    sCal.u32Count = 0;
+    sCal.u64Sum = 0;
+
+    for (i = 0; i < 8UL; i++)
+    {
+        PROF_ENTER(&sCal);
+        PROF_EXIT(&sCal);
+    }
+
+    s_u32ProfOverhead = sCal.u32Min;
+
+    return s_u32ProfFreq;
+}
+
+/**
+  * @brief      Add a probe to the report
+  *
+  * @param[in]  psProbe     The pointer of the probe.
+  * @param[in]  pcName      Name in the report.
+  *
+  * @return     None
+  */
+void PROF_AddProbe(S_PROF_PROBE_T *psProbe, const char *pcName)
+{
+    psProbe->pcName = pcName;
+    psProbe->u32Count = 0;
+    psProbe->u32Min = 0xFFFFFFFFUL;
+    psProbe->u32Max = 0;
+    psProbe->u64Sum = 0;
+    psProbe->psNext = s_psProfProbes;
+    s_psProfProbes = psProbe;
+}
+
+/**
+  * @brief      Account a measured scope
+  *
+  * @param[in]  psProbe     The pointer of the probe.
+  * @param[in]  u32Now      Timestamp at the end of the scope.
+  *
+  * @return     None
+  *
+  * @details    Use \ref PROF_EXIT, which reads the timestamp before the call.
+  */
+void PROF_Exit(S_PROF_PROBE_T *psProbe, uint32_t u32Now)
+{
+    uint32_t u32Ticks = (u32Now - psProbe->u32Start) & PROF_CNT_MSK;
+
+    u32Ticks = (u32Ticks > s_u32ProfOverhead) ? (u32Ticks - s_u32ProfOverhead) : 0UL;
+
+    if (u32Ticks < psProbe->u32Min)
+        psProbe->u32Min = u32Ticks;
+
+    if (u32Ticks > psProbe->u32Max)
+        psProbe->u32Max = u32Ticks;
+
+    psProbe->u64Sum += u32Ticks;
+    psProbe->u32Count++;
+}
+
+/**
+  * @brief      Clear the statistics of all probes
+  *
+  * @return     None
+  */
+void PROF_ResetProbes(void)
+{
+    S_PROF_PROBE_T *psProbe;
+
+    for (psProbe = s_psProfProbes; psProbe != NULL; psProbe = psProbe->psNext)
+    {
+        psProbe->u32Count = 0;
+        psProbe->u32Min = 0xFFFFFFFFUL;
+        psProbe->u32Max = 0;
+        psProbe->u64Sum = 0;
+    }
+}
+
+#ifdef PROF_USE_SAMPLER
+
+/**
+  * @brief      Start the PC sampler
+  *
+  * @param[in]  u32Freq     Samples per second.
+  * @param[in]  pu16Hist    Histogram, bucket i counts PCs from FLASH_BASE + (i << u32Shift).
+  * @param[in]  u32Buckets  Buckets in the histogram.
+  * @param[in]  u32Shift    Bucket size as a power of 2 in bytes, 2 or more.
+  *
+  * @return     Sampling frequency actually set
+  *
+  * @details    The TIMER of \ref PROF_SAMPLE_TIMER_NUM interrupts at the highest priority, so interrupt
+  *             handlers are sampled too. Code running with PRIMASK set is seen at the point interrupts are
+  *             enabled again. Buckets saturate at 65535.
+  */
+uint32_t PROF_SampleStart(uint32_t u32Freq, uint16_t *pu16Hist, uint32_t u32Buckets, uint32_t u32Shift)
+{
+    uint32_t i;
+
+    for (i = 0; i < u32Buckets; i++)
+        pu16Hist[i] = 0;
+
+    s_pu16ProfHist = pu16Hist;
+    s_u32ProfBuckets = u32Buckets;
+    s_u32ProfShift = u32Shift;
+    s_u32ProfSamples = 0;
+    s_u32ProfOutside = 0;
+
+    s_u32ProfSampleFreq = TIMER_Open(PROF_TIMER, TIMER_PERIODIC_MODE, u32Freq);
+    TIMER_EnableInt(PROF_TIMER);
+    NVIC_SetPriority(PROF_TIMER_IRQn, 0);
+    NVIC_EnableIRQ(PROF_TIMER_IRQn);
+    TIMER_Start(PROF_TIMER);
+
+    return s_u32ProfSampleFreq;
+}
+
+/**
+  * @brief      Stop the PC sampler
+  *
+  * @return     None
+  */
+void PROF_SampleStop(void)
+{
+    TIMER_Stop(PROF_TIMER);
+    NVIC_DisableIRQ(PROF_TIMER_IRQn);
+    TIMER_DisableInt(PROF_TIMER);
+    TIMER_ClearIntFlag(PROF_TIMER);
+}
+
+#endif /* PROF_USE_SAMPLER */
+
+/**
+  * @brief      Account one PC sample
+  *
+  * @param[in]  u32PC   Interrupted program counter.
+  *
+  * @return     None
+  *
+  * @details    Called by the sampler interrupt, could be called with any PC of interest too.
+  */
+void PROF_SamplePC(uint32_t u32PC)
+{
+    uint32_t u32Bucket = (u32PC - FLASH_BASE) >> s_u32ProfShift;
+
+#ifdef PROF_USE_SAMPLER
+    TIMER_ClearIntFlag(PROF_TIMER);
+#endif
+
+    s_u32ProfSamples++;
+
+    if (u32Bucket < s_u32ProfBuckets)
+    {
+        if (s_pu16ProfHist[u32Bucket] != 0xFFFFU)
+            s_pu16ProfHist[u32Bucket]++;
+    }
+    else
+        s_u32ProfOutside++;
+}
+
+/**
+  * @brief      Print the probes and the PC histogram
+  *
+  * @return     None
+  *
+  * @details    Goes wherever printf goes, the debug UART or a retargeted USB VCOM. Only buckets with samples
+  *             are listed as "address count" lines. Folding them into functions needs the symbol table of the
+  *             build, for example arm-none-eabi-nm -n -S app.elf or the map file of Keil and IAR.
+  */
+void PROF_Report(void)
+{
+    S_PROF_PROBE_T *psProbe;
+    uint32_t i, u32Avg;
+
+    printf("Probes, %u ticks per second:\n", (unsigned int)s_u32ProfFreq);
+
+    for (psProbe = s_psProfProbes; psProbe != NULL; psProbe = psProbe->psNext)
+    {
+        if (psProbe->u32Count == 0)
+        {
+            printf("  %-16s never run\n", psProbe->pcName);
+            continue;
+        }
+
+        u32Avg = (uint32_t)(psProbe->u64Sum / psProbe->u32Count);
+        printf("  %-16s n %-8u min %-8u avg %-8u max %-8u\n", psProbe->pcName, (unsigned int)psProbe->u32Count,
+               (unsigned int)psProbe->u32Min, (unsigned int)u32Avg, (unsigned int)psProbe->u32Max);
+    }
+
+    if (s_pu16ProfHist == NULL)
+        return;
+
+    printf("PC samples %u at %u Hz, %u outside, %u bytes per bucket:\n", (unsigned int)s_u32ProfSamples,
+           (unsigned int)s_u32ProfSampleFreq, (unsigned int)s_u32ProfOutside, (unsigned int)(1UL << s_u32ProfShift));
+
+    for (i = 0; i < s_u32ProfBuckets; i++)
+    {
+        if (s_pu16ProfHist[i] != 0)
+            printf("  0x%08x %u\n", (unsigned int)(FLASH_BASE + (i << s_u32ProfShift)), s_pu16ProfHist[i]);
+    }
+}
+
+/*@}*/ /* end of group PROF_EXPORTED_FUNCTIONS */
+
+/*@}*/ /* end of group PROF_Driver */
+
+/*@}*/ /* end of group Standard_Driver */
+
+/*** (C) COPYRIGHT 2021 Nuvoton Technology Corp. ***/
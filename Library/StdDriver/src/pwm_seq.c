@@ -0,0 +1,346 @@
+/**************************************************************************//**
+ * @file     pwm_seq.c
+ * @version  V1.00
+ * @brief    NUC121 series PWM/BPWM waveform sequencer source file
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * @copyright (C) 2021 Nuvoton Technology Corp. All rights reserved.
+*****************************************************************************/
+#include "NuMicro.h"
+
+/** @addtogroup Standard_Driver Standard Driver
+  @{
+*/
+
+/** @addtogroup PWM_SEQ_Driver PWM Waveform Sequencer Driver
+  @{
+*/
+
+/** @addtogroup PWM_SEQ_EXPORTED_FUNCTIONS PWM Waveform Sequencer Exported Functions
+  @{
+*/
+
+/**
+ * @brief Pre-compute the register values of a waveform sequence
+ * @param[in] u32ClkFreq PWM/BPWM module clock frequency in Hz.
+ * @param[in] au32Freq Output frequency of each step in Hz.
+ * @param[in] au16Duty Duty of each step in 0.1% units, 0 ~ \ref PWM_SEQ_DUTY_FULL.
+ * @param[in] u32Steps Number of steps.
+ * @param[out] au16Period Buffer of u32Steps entries to receive the PERIOD values.
+ * @param[out] au16Cmp Buffer of u32Steps entries to receive the CMPDAT values.
+ * @param[out] psTable The table descriptor to be filled.
+ * @retval 0 Success
+ * @retval -1 A step frequency is 0, too high, or the frequency range cannot share one prescaler
+ * @details All steps share one prescaler because CLKPSC is not double buffered. The smallest
+ *          prescaler that still fits the lowest step frequency into the 16-bit PERIOD is chosen,
+ *          which keeps the duty resolution of the higher frequencies as fine as possible.
+ *          If every step ends up with the same PERIOD, pu16Period of the table is set to NULL
+ *          so only CMPDAT is updated at run time, which also allows \ref PWM_SEQ_StartPDMA.
+ *          This function has no hardware access and can be run off-line to generate const tables.
+ */
+int32_t PWM_SEQ_BuildTable(uint32_t u32ClkFreq, const uint32_t au32Freq[], const uint16_t au16Duty[], uint32_t u32Steps,
+                           uint16_t au16Period[], uint16_t au16Cmp[], S_PWM_SEQ_TABLE_T *psTable)
+{
+    uint32_t i, u32MinFreq = 0xFFFFFFFFUL, u32Prescale, u32Cnt, u32Fixed = 1;
+
+    if ((u32Steps == 0) || (u32ClkFreq == 0))
+        return -1;
+
+    for (i = 0; i < u32Steps; i++)
+    {
+        if (au32Freq[i] == 0)
+            return -1;
+
+        if (au32Freq[i] < u32MinFreq)
+            u32MinFreq = au32Freq[i];
+    }
+
+    /* Smallest prescaler which keeps the longest period within 16 bits */
+    u32Prescale = ((u32ClkFreq / u32MinFreq) + (PWM_SEQ_MAX_PERIOD - 1)) / PWM_SEQ_MAX_PERIOD;
+
+    if (u32Prescale == 0)
+        u32Prescale = 1;
+
+    if (u32Prescale > PWM_SEQ_MAX_PRESCALE)
+        return -1;
+
+    for (i = 0; i < u32Steps; i++)
+    {
+        u32Cnt = u32ClkFreq / (u32Prescale * au32Freq[i]);
+
+        /* Need at least two counts per period to output a waveform */
+        if (u32Cnt < 2)
+            return -1;
+
+        if (u32Cnt > PWM_SEQ_MAX_PERIOD)
+            u32Cnt = PWM_SEQ_MAX_PERIOD;
+
+        au16Period[i] = (uint16_t)(u32Cnt - 1);
+
+        /* Same duty mapping as PWM_ConfigOutputChannel */
+        if (au16Duty[i] >= PWM_SEQ_DUTY_FULL)
+            au16Cmp[i] = (uint16_t)(u32Cnt - 1);
+        else
+            au16Cmp[i] = (uint16_t)((au16Duty[i] * u32Cnt) / PWM_SEQ_DUTY_FULL);
+
+        if (au16Period[i] != au16Period[0])
+            u32Fixed = 0;
+    }
+
+    psTable->pu16Period = u32Fixed ? NULL : au16Period;
+    psTable->pu16Cmp = au16Cmp;
+    psTable->u16Prescale = (uint16_t)(u32Prescale - 1);
+    psTable->u16Period = au16Period[0];
+    psTable->u32Steps = u32Steps;
+
+    return 0;
+}
+
+/**
+ * @brief Check a waveform table before it is played
+ * @param[in] psTable The table descriptor to be checked.
+ * @return Index + 1 of the first invalid step, 0 if the table is valid, or -1 if the descriptor itself is invalid.
+ * @details A step is invalid if its PERIOD is less than 1 or its CMPDAT is larger than its PERIOD.
+ *          This function has no hardware access so tables generated off-line can be validated on the host.
+ */
+int32_t PWM_SEQ_ValidateTable(const S_PWM_SEQ_TABLE_T *psTable)
+{
+    uint32_t i, u32Period;
+
+    if ((psTable == NULL) || (psTable->pu16Cmp == NULL) || (psTable->u32Steps == 0) ||
+            (psTable->u16Prescale >= PWM_SEQ_MAX_PRESCALE))
+        return -1;
+
+    for (i = 0; i < psTable->u32Steps; i++)
+    {
+        u32Period = (psTable->pu16Period != NULL) ? psTable->pu16Period[i] : psTable->u16Period;
+
+        if ((u32Period < 1) || (psTable->pu16Cmp[i] > u32Period))
+            return (int32_t)(i + 1);
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Bind a sequencer control block to a PWM channel
+ * @param[out] psSeq The pointer of the sequencer control block.
+ * @param[in] pwm The pointer of the specified PWM module
+ *                - PWM0 : PWM Group 0
+ *                - PWM1 : PWM Group 1
+ * @param[in] u32ChannelNum PWM channel number. Valid values are between 0~5
+ * @return None
+ * @details The register addresses of the channel are resolved once here so the interrupt
+ *          handler only performs two stores per step. Because each channel pair shares one
+ *          counter, the period of the even channel of the pair is sequenced.
+ */
+void PWM_SEQ_InitPWM(S_PWM_SEQ_T *psSeq, PWM_T *pwm, uint32_t u32ChannelNum)
+{
+    psSeq->pu32Period = &pwm->PERIOD[(u32ChannelNum >> 1) << 1];
+    psSeq->pu32Cmp = &pwm->CMPDAT[u32ChannelNum];
+    psSeq->pu32Prescale = &pwm->CLKPSC0_1 + (u32ChannelNum >> 1);
+    psSeq->pu32Ctl0 = &pwm->CTL0;
+    psSeq->pu32IntEn = &pwm->INTEN0;
+    psSeq->pu32IntSts = &pwm->INTSTS0;
+    psSeq->u32PeriodIntMsk = (PWM_INTSTS0_PIF0_Msk << ((u32ChannelNum >> 1) << 1));
+    psSeq->u32LoadModeMsk = ((PWM_CTL0_IMMLDEN0_Msk | PWM_CTL0_CTRLD0_Msk) << u32ChannelNum);
+    psSeq->psTable = NULL;
+    psSeq->u32Busy = 0;
+}
+
+/**
+ * @brief Bind a sequencer control block to a BPWM channel
+ * @param[out] psSeq The pointer of the sequencer control block.
+ * @param[in] bpwm The pointer of the specified BPWM module
+ *                - BPWM0 : BPWM Group 0
+ *                - BPWM1 : BPWM Group 1
+ * @param[in] u32ChannelNum BPWM channel number. Valid values are between 0~5
+ * @return None
+ * @details All BPWM channels share one counter, so changing the period of the sequence
+ *          also changes the period of the other channels of the module.
+ */
+void PWM_SEQ_InitBPWM(S_PWM_SEQ_T *psSeq, BPWM_T *bpwm, uint32_t u32ChannelNum)
+{
+    psSeq->pu32Period = &bpwm->PERIOD;
+    psSeq->pu32Cmp = &bpwm->CMPDAT[u32ChannelNum];
+    psSeq->pu32Prescale = &bpwm->CLKPSC;
+    psSeq->pu32Ctl0 = &bpwm->CTL0;
+    psSeq->pu32IntEn = &bpwm->INTEN;
+    psSeq->pu32IntSts = &bpwm->INTSTS0;
+    psSeq->u32PeriodIntMsk = BPWM_INTSTS0_PIF0_Msk;
+    psSeq->u32LoadModeMsk = ((BPWM_CTL0_IMMLDEN0_Msk | BPWM_CTL0_CTRLD0_Msk) << u32ChannelNum);
+    psSeq->psTable = NULL;
+    psSeq->u32Busy = 0;
+}
+
+/**
+ * @brief Start playing a waveform table from the period interrupt
+ * @param[in] psSeq The pointer of the sequencer control block.
+ * @param[in] psTable The table to be played. It must stay valid while the sequence is playing.
+ * @param[in] u32Mode Play mode. Possible options are
+ *                    - \ref PWM_SEQ_ONESHOT
+ *                    - \ref PWM_SEQ_REPEAT
+ * @param[in] pfnDone Callback invoked from the period interrupt when a one-shot sequence has
+ *                    loaded its last step. Could be NULL.
+ * @return None
+ * @details The channel is switched to period loading mode and the first step is written, then the
+ *          period interrupt is enabled. Each period interrupt writes the next step into the double
+ *          buffered PERIOD/CMPDAT registers, which the hardware latches at the end of the current
+ *          period, so every step lasts exactly one PWM period regardless of interrupt latency.
+ *          User must call \ref PWM_SEQ_IRQHandler from the PWM/BPWM IRQ handler.
+ * @note The output waveform, counter type and output enable are left to \ref PWM_ConfigOutputChannel
+ *       or \ref BPWM_ConfigOutputChannel, and the counter is started by \ref PWM_Start or \ref BPWM_Start.
+ */
+void PWM_SEQ_Start(S_PWM_SEQ_T *psSeq, const S_PWM_SEQ_TABLE_T *psTable, uint32_t u32Mode, PWM_SEQ_CB pfnDone)
+{
+    psSeq->psTable = psTable;
+    psSeq->u32Mode = u32Mode;
+    psSeq->pfnDone = pfnDone;
+
+    /* Period loading mode: new PERIOD/CMPDAT take effect at the end of each period */
+    *psSeq->pu32Ctl0 &= ~psSeq->u32LoadModeMsk;
+
+    *psSeq->pu32Prescale = psTable->u16Prescale;
+    *psSeq->pu32Period = (psTable->pu16Period != NULL) ? psTable->pu16Period[0] : psTable->u16Period;
+    *psSeq->pu32Cmp = psTable->pu16Cmp[0];
+
+    psSeq->u32Index = 1;
+    psSeq->u32Busy = 1;
+
+    *psSeq->pu32IntSts = psSeq->u32PeriodIntMsk;
+    *psSeq->pu32IntEn |= psSeq->u32PeriodIntMsk;
+}
+
+/**
+ * @brief Stop updating the waveform
+ * @param[in] psSeq The pointer of the sequencer control block.
+ * @return None
+ * @details The period interrupt of the channel is disabled and the output keeps the last loaded step.
+ */
+void PWM_SEQ_Stop(S_PWM_SEQ_T *psSeq)
+{
+    *psSeq->pu32IntEn &= ~psSeq->u32PeriodIntMsk;
+    psSeq->u32Busy = 0;
+}
+
+/**
+ * @brief Load the next step of a playing sequence
+ * @param[in] psSeq The pointer of the sequencer control block.
+ * @return None
+ * @details Call this function from PWMx_IRQHandler or BPWMx_IRQHandler. It checks and clears the
+ *          period interrupt flag of the sequenced channel and leaves other flags untouched.
+ */
+void PWM_SEQ_IRQHandler(S_PWM_SEQ_T *psSeq)
+{
+    const S_PWM_SEQ_TABLE_T *psTable = psSeq->psTable;
+    uint32_t u32Index;
+
+    if ((*psSeq->pu32IntSts & psSeq->u32PeriodIntMsk) == 0)
+        return;
+
+    *psSeq->pu32IntSts = psSeq->u32PeriodIntMsk;
+
+    if (psSeq->u32Busy == 0)
+        return;
+
+    u32Index = psSeq->u32Index;
+
+    if (u32Index >= psTable->u32Steps)
+    {
+        if (psSeq->u32Mode != PWM_SEQ_REPEAT)
+        {
+            /* The last step is now playing. Nothing more to load. */
+            PWM_SEQ_Stop(psSeq);
+
+            if (psSeq->pfnDone != NULL)
+                psSeq->pfnDone();
+
+            return;
+        }
+
+        u32Index = 0;
+    }
+
+    if (psTable->pu16Period != NULL)
+        *psSeq->pu32Period = psTable->pu16Period[u32Index];
+
+    *psSeq->pu32Cmp = psTable->pu16Cmp[u32Index];
+    psSeq->u32Index = u32Index + 1;
+}
+
+/**
+ * @brief Play a fixed-period waveform table by PDMA without CPU intervention
+ * @param[in] psSeq The pointer of the sequencer control block.
+ * @param[in] psTable The table to be played. Its pu16Period must be NULL (fixed period).
+ * @param[in] u32Ch PDMA channel used to stream the CMPDAT values. Valid values are between 0~4.
+ * @param[in] timer Timer used to pace the PDMA requests. It could be TIMER0, TIMER1, TIMER2, TIMER3.
+ * @param[in] u32ClkFreq PWM/BPWM module clock frequency in Hz.
+ * @retval 0 Success
+ * @retval -1 The table does not have a fixed period or the timer cannot be set to the PWM period
+ * @details PWM/BPWM have no PDMA request for output, so the timer is programmed to time-out once
+ *          per PWM period and trigger PDMA_TMRx, which writes the next CMPDAT value. Period loading
+ *          mode latches each value at the next period boundary, so the output never glitches even
+ *          though the timer is not phase locked to the PWM counter.
+ *          The table is played once. The PDMA transfer done interrupt can be used to restart it.
+ * @note The timer and the PWM should be clocked from the same source, otherwise a step may
+ *       occasionally be repeated or skipped when the two clocks drift.
+ */
+int32_t PWM_SEQ_StartPDMA(S_PWM_SEQ_T *psSeq, const S_PWM_SEQ_TABLE_T *psTable, uint32_t u32Ch, TIMER_T *timer, uint32_t u32ClkFreq)
+{
+    uint64_t u64Ticks;
+    uint32_t u32Prescale, u32Peripheral;
+
+    if ((psTable->pu16Period != NULL) || (u32ClkFreq == 0))
+        return -1;
+
+    /* Timer ticks per PWM period = timer clock * (PSC + 1) * (PERIOD + 1) / PWM clock */
+    u64Ticks = (uint64_t)TIMER_GetModuleClock(timer) * (psTable->u16Prescale + 1UL) * (psTable->u16Period + 1UL) / u32ClkFreq;
+    u32Prescale = (uint32_t)(u64Ticks >> 24);  /* for 24 bits CMPDAT */
+
+    if ((u32Prescale > 0xFFUL) || (u64Ticks < 2))
+        return -1;
+
+    if (timer == TIMER0)
+        u32Peripheral = PDMA_TMR0;
+    else if (timer == TIMER1)
+        u32Peripheral = PDMA_TMR1;
+    else if (timer == TIMER2)
+        u32Peripheral = PDMA_TMR2;
+    else
+        u32Peripheral = PDMA_TMR3;
+
+    psSeq->psTable = psTable;
+    psSeq->u32Mode = PWM_SEQ_ONESHOT;
+    psSeq->pfnDone = NULL;
+    psSeq->u32Busy = 0;
+
+    *psSeq->pu32IntEn &= ~psSeq->u32PeriodIntMsk;
+    *psSeq->pu32Ctl0 &= ~psSeq->u32LoadModeMsk;
+    *psSeq->pu32Prescale = psTable->u16Prescale;
+    *psSeq->pu32Period = psTable->u16Period;
+    *psSeq->pu32Cmp = psTable->pu16Cmp[0];
+
+    if (psTable->u32Steps > 1)
+    {
+        PDMA_Open(1UL << u32Ch);
+        PDMA_SetTransferCnt(u32Ch, PDMA_WIDTH_16, psTable->u32Steps - 1);
+        PDMA_SetTransferAddr(u32Ch, (uint32_t)&psTable->pu16Cmp[1], PDMA_SAR_INC, (uint32_t)psSeq->pu32Cmp, PDMA_DAR_FIX);
+        PDMA_SetTransferMode(u32Ch, u32Peripheral, FALSE, 0);
+        PDMA_SetBurstType(u32Ch, PDMA_REQ_SINGLE, 0);
+
+        timer->CTL = 0;
+        timer->CMP = (uint32_t)(u64Ticks / (u32Prescale + 1UL));
+        timer->CTL = TIMER_PERIODIC_MODE | TIMER_TRGSRC_TIMEOUT_EVENT | TIMER_TRG_TO_PDMA | u32Prescale;
+        TIMER_Start(timer);
+    }
+
+    return 0;
+}
+
+/*@}*/ /* end of group PWM_SEQ_EXPORTED_FUNCTIONS */
+
+/*@}*/ /* end of group PWM_SEQ_Driver */
+
+/*@}*/ /* end of group Standard_Driver */
+
+/*** (C) COPYRIGHT 2021 Nuvoton Technology Corp. ***/
@@ -32,14 +32,12 @@ struct __FILE
 FILE __stdout;
 FILE __stdin;
 
-#ifndef __GNUC__
-    #if defined( __ICCARM__ )
-        __WEAK
-    #else
-        __attribute__((weak))
-    #endif
-    uint32_t ProcessHardFault(uint32_t lr, uint32_t msp, uint32_t psp);
+#if defined( __ICCARM__ )
+    __WEAK
+#else
+    __attribute__((weak))
 #endif
+uint32_t ProcessHardFault(uint32_t lr, uint32_t msp, uint32_t psp);
 
 int kbhit(void);
 int IsDebugFifoEmpty(void);
@@ -67,7 +65,6 @@ enum { r0, r1, r2, r3, r12, lr, pc, psr};
  */
 static void stackDump(uint32_t stack[])
 {
- /*
     printf("r0  = 0x%x\n", stack[r0]);
     printf("r1  = 0x%x\n", stack[r1]);
     printf("r2  = 0x%x\n", stack[r2]);
@@ -76,17 +73,26 @@ static void stackDump(uint32_t stack[])
     printf("lr  = 0x%x\n", stack[lr]);
     printf("pc  = 0x%x\n", stack[pc]);
     printf("psr = 0x%x\n", stack[psr]);
- */
 }
 
 /**
  * @brief       Hard fault handler
  * @param[in]   stack pointer points to the dumped registers in SRAM
+ * @param[in]   exc_return LR value at the exception entry
  * @return      None
- * @details     Replace while(1) at the end of this function with chip reset if WDT is not enabled for end product
+ * @details     A ProcessHardFault linked in, such as the one of the crash dump driver, takes over the fault.
+ *              Replace while(1) at the end of this function with chip reset if WDT is not enabled for end product
  */
-void Hard_Fault_Handler(uint32_t stack[])
+void Hard_Fault_Handler(uint32_t stack[], uint32_t exc_return)
 {
+    if (ProcessHardFault != NULL)
+    {
+        if (exc_return & 4)
+            ProcessHardFault(exc_return, __get_MSP(), (uint32_t)stack);
+        else
+            ProcessHardFault(exc_return, (uint32_t)stack, __get_PSP());
+    }
+
     printf("In Hard Fault Handler\n");
 
     stackDump(stack);
@@ -101,15 +107,83 @@ void Hard_Fault_Handler(uint32_t stack[])
 /* Routine to write a char                                                                                 */
 /*---------------------------------------------------------------------------------------------------------*/
 #if defined(DEBUG_ENABLE_SEMIHOST)
+#ifndef DEBUG_SEMIHOST_BUF_SIZE
+#define DEBUG_SEMIHOST_BUF_SIZE     64
+#endif
+
 /* The static buffer is used to speed up the semihost */
-static char g_buf[16];
-static char g_buf_len = 0;
+static char g_buf[DEBUG_SEMIHOST_BUF_SIZE];
+static uint32_t g_buf_len = 0;
+
+/* Cleared by the first command that finds no ICE, later messages go to UART without trapping */
+static uint8_t g_u8ShIce = 1;
 
 /* Make sure won't goes here only because --gnu is defined , so
    add !__CC_ARM and !__ICCARM__ checking */
 # if defined ( __GNUC__ ) && !(__CC_ARM) && !(__ICCARM__)
 static volatile int32_t g_ICE_Conneced = 1;
 
+/**
+ *
+ * @brief      The function to process semihosted command
+ * @param[in]  n32In_R0  : semihost register 0
+ * @param[in]  n32In_R1  : semihost register 1
+ * @param[out] pn32Out_R0: semihost register 0
+ * @retval     0: No ICE debug
+ * @retval     1: ICE debug
+ *
+ */
+__attribute__((naked))
+int32_t SH_DoCommand(int32_t n32In_R0, int32_t n32In_R1, int32_t *pn32Out_R0)
+{
+    asm("BKPT   0xAB          \n"       //; This instruction will cause ICE trap or system HardFault
+        "B      1f            \n"
+        "MOVS   R0, #0        \n"       //; Captured by HardFault, set return value to 0
+        "BX     lr            \n"
+        "1:                   \n"       //; Captured by ICE
+        "CMP    R2, #0        \n"
+        "BEQ    2f            \n"
+        "STR    R0, [R2]      \n"       //; Save the return value to *pn32Out_R0
+        "2:                   \n"
+        "MOVS   R0, #1        \n"       //; Set return value to 1
+        "BX     lr            \n"
+       );
+}
+
+/**
+ * @brief    This HardFault handler is implemented to support semihost
+ * @param    None
+ * @returns  None
+ * @details  A BKPT of SH_DoCommand without ICE resumes after it, any other fault goes to Hard_Fault_Handler.
+ *
+ */
+__attribute__((naked))
+void HardFault_Handler(void)
+{
+    asm("MOV     R0, LR        \n"
+        "LSLS    R0, #29       \n"        //; Check bit 2
+        "BMI     1f            \n"        //; previous stack is PSP
+        "MRS     R0, MSP       \n"        //; previous stack is MSP, read MSP
+        "B       2f            \n"
+        "1:                    \n"
+        "MRS     R0, PSP       \n"        //; Read PSP
+        "2:                    \n"
+        "LDR     R1, [R0, #24] \n"        //; Get previous PC
+        "LDRH    R3, [R1]      \n"        //; Get instruction
+        "MOVS    R2, #0xBE     \n"        //; The special BKPT instruction 0xBEAB
+        "LSLS    R2, #8        \n"
+        "ADDS    R2, #0xAB     \n"
+        "CMP     R3, R2        \n"        //; Test if the instruction at previous PC is BKPT
+        "BNE     3f            \n"        //; Not BKPT
+        "ADDS    R1, #4        \n"        //; Skip BKPT and next line
+        "STR     R1, [R0, #24] \n"        //; Save previous PC
+        "BX      LR            \n"        //; Return
+        "3:                    \n"
+        "MOV     R1, LR        \n"        //; LR current value
+        "B       Hard_Fault_Handler \n"
+       );
+}
+
 
 /**
  *
@@ -377,6 +451,7 @@ SH_End
  * @details  This function is implement to print r0, r1, r2, r3, r12, lr, pc, psr.
  *
  */
+__attribute__((naked))
 void HardFault_Handler(void)
 {
     asm("MOV     R0, LR  \n"
@@ -391,7 +466,7 @@ void HardFault_Handler(void)
 
 
 __attribute__((weak))
-void ProcessHardFault(uint32_t lr, uint32_t msp, uint32_t psp)
+uint32_t ProcessHardFault(uint32_t lr, uint32_t msp, uint32_t psp)
 {
     uint32_t *sp;
 
@@ -578,6 +653,13 @@ void SendChar_ToUART(int ch)
 void SendChar(int ch)
 {
 #if defined(DEBUG_ENABLE_SEMIHOST)
+
+    if (!g_u8ShIce)
+    {
+        SendChar_ToUART(ch);
+        return;
+    }
+
     g_buf[g_buf_len++] = ch;
     g_buf[g_buf_len] = '\0';
 
@@ -591,7 +673,10 @@ void SendChar(int ch)
         }
         else
         {
-            int i;
+            uint32_t i;
+
+            /* No ICE, stop trapping */
+            g_u8ShIce = 0;
 
             for (i = 0; i < g_buf_len; i++)
                 SendChar_ToUART(g_buf[i]);
@@ -617,6 +702,14 @@ void SendChar(int ch)
 char GetChar(void)
 {
 #ifdef DEBUG_ENABLE_SEMIHOST
+
+    if (!g_u8ShIce)
+    {
+        while ((DEBUG_PORT->FIFOSTS & UART_FIFOSTS_RXEMPTY_Msk) != 0U);
+
+        return (DEBUG_PORT->DAT);
+    }
+
 # if defined (__CC_ARM)
     int nRet;
 
@@ -0,0 +1,549 @@
+/**************************************************************************//**
+ * @file     rtos_drv.c
+ * @version  V1.00
+ * @brief    NUC121 series CMSIS-RTOS2 RTX driver wrappers and tickless idle source file
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * @copyright (C) 2021 Nuvoton Technology Corp. All rights reserved.
+*****************************************************************************/
+#include "NuMicro.h"
+#include "rtos_drv.h"
+
+/** @addtogroup Standard_Driver Standard Driver
+  @{
+*/
+
+/** @addtogroup RTOS_DRV_Driver RTOS_DRV Driver
+  @{
+*/
+
+/// @cond HIDDEN_SYMBOLS
+
+#define RTOS_FLAG_TX            (0x01UL)
+#define RTOS_FLAG_RX            (0x02UL)
+#define RTOS_FLAG_SPI           (0x01UL)
+
+static TIMER_T *s_psRtosTimer = NULL;
+static IRQn_Type s_eRtosTimerIrq;
+static uint32_t s_u32RtosTimerClk;
+static uint32_t s_u32RtosMinPDTicks;
+static S_RTOS_IDLE_STAT_T s_sRtosIdleStat;
+
+static osMutexId_t RTOS_NewMutex(uint32_t *pu32Cb, uint32_t u32Attr)
+{
+    osMutexAttr_t sAttr = {NULL, 0, NULL, 0};
+
+    sAttr.attr_bits = u32Attr;
+    sAttr.cb_mem = pu32Cb;
+    sAttr.cb_size = osRtxMutexCbSize;
+
+    return osMutexNew(&sAttr);
+}
+
+static osEventFlagsId_t RTOS_NewFlags(uint32_t *pu32Cb)
+{
+    osEventFlagsAttr_t sAttr = {NULL, 0, NULL, 0};
+
+    sAttr.cb_mem = pu32Cb;
+    sAttr.cb_size = osRtxEventFlagsCbSize;
+
+    return osEventFlagsNew(&sAttr);
+}
+
+/* Power-down stops HIRC and HXT, wait for the ones that were running */
+static void RTOS_RestoreClock(uint32_t u32PwrCtl)
+{
+    uint32_t u32Stable = 0;
+
+    if ((u32PwrCtl & CLK_PWRCTL_XTLEN_Msk) == CLK_PWRCTL_HXTEN)
+        u32Stable |= CLK_STATUS_HXTSTB_Msk;
+
+    if (u32PwrCtl & CLK_PWRCTL_HIRCEN_Msk)
+        u32Stable |= CLK_STATUS_HIRCSTB_Msk;
+
+    if (u32Stable != 0)
+        CLK_WaitClockReady(u32Stable);
+}
+
+/* Completion callback of I2C_XFER, wakes the submitting thread */
+static void RTOS_I2CDone(S_I2C_XFER_T *psXfer)
+{
+    osThreadFlagsSet((osThreadId_t)psXfer->pvArg, RTOS_THREAD_FLAG_I2C);
+}
+
+/// @endcond HIDDEN_SYMBOLS
+
+
+/** @addtogroup RTOS_DRV_EXPORTED_FUNCTIONS RTOS_DRV Exported Functions
+  @{
+*/
+
+/**
+  * @brief      Open a UART for use by several threads
+  *
+  * @param[in]  psUart      The pointer of the wrapper.
+  * @param[in]  uart        The pointer of the UART.
+  * @param[in]  u32Baudrate Baud rate.
+  *
+  * @return     0 or \ref RTOS_ERR_OS
+  *
+  * @details    The kernel objects live in the wrapper, no RTX dynamic memory is used. Enable the NVIC interrupt
+  *             and call \ref RTOS_UART_IRQHandler from the UART IRQ handler. Call it after osKernelInitialize.
+  */
+int32_t RTOS_UART_Open(S_RTOS_UART_T *psUart, UART_T *uart, uint32_t u32Baudrate)
+{
+    psUart->uart = uart;
+    psUart->u32TxLeft = 0;
+    psUart->u32RxLeft = 0;
+    psUart->sTxLock = RTOS_NewMutex(psUart->au32TxLockCb, osMutexPrioInherit);
+    psUart->sRxLock = RTOS_NewMutex(psUart->au32RxLockCb, osMutexPrioInherit);
+    psUart->sFlags = RTOS_NewFlags(psUart->au32FlagsCb);
+
+    if ((psUart->sTxLock == NULL) || (psUart->sRxLock == NULL) || (psUart->sFlags == NULL))
+        return RTOS_ERR_OS;
+
+    UART_Open(uart, u32Baudrate);
+
+    return 0;
+}
+
+/**
+  * @brief      Write to a UART, blocking the calling thread only
+  *
+  * @param[in]  psUart      The pointer of the wrapper.
+  * @param[in]  pvBuf       Data to send.
+  * @param[in]  u32Len      Bytes to send.
+  * @param[in]  u32Timeout  Time-out in kernel ticks, osWaitForever to wait until done.
+  *
+  * @return     Bytes loaded into the TX FIFO, fewer on time-out, \ref RTOS_ERR_TIMEOUT if none
+  *
+  * @details    Writers are served one at a time in priority order, a write is never interleaved with another.
+  *             The thread sleeps while the TX FIFO empty interrupt feeds the data.
+  */
+int32_t RTOS_UART_Write(S_RTOS_UART_T *psUart, const void *pvBuf, uint32_t u32Len, uint32_t u32Timeout)
+{
+    uint32_t u32PriMask, u32Left;
+
+    if (osMutexAcquire(psUart->sTxLock, u32Timeout) != osOK)
+        return RTOS_ERR_TIMEOUT;
+
+    osEventFlagsClear(psUart->sFlags, RTOS_FLAG_TX);
+    psUart->pu8Tx = (const uint8_t *)pvBuf;
+    psUart->u32TxLeft = u32Len;
+
+    if (u32Len != 0)
+    {
+        UART_ENABLE_INT(psUart->uart, UART_INTEN_THREIEN_Msk);
+        osEventFlagsWait(psUart->sFlags, RTOS_FLAG_TX, osFlagsWaitAny, u32Timeout);
+    }
+
+    u32PriMask = __get_PRIMASK();
+    __set_PRIMASK(1);
+    UART_DISABLE_INT(psUart->uart, UART_INTEN_THREIEN_Msk);
+    u32Left = psUart->u32TxLeft;
+    psUart->u32TxLeft = 0;
+    __set_PRIMASK(u32PriMask);
+
+    osMutexRelease(psUart->sTxLock);
+
+    return ((u32Left == u32Len) && (u32Len != 0)) ? RTOS_ERR_TIMEOUT : (int32_t)(u32Len - u32Left);
+}
+
+/**
+  * @brief      Read from a UART, blocking the calling thread only
+  *
+  * @param[in]  psUart      The pointer of the wrapper.
+  * @param[out] pvBuf       Destination.
+  * @param[in]  u32Len      Bytes to receive.
+  * @param[in]  u32Timeout  Time-out in kernel ticks, osWaitForever to wait until done.
+  *
+  * @return     Bytes received, fewer on time-out, \ref RTOS_ERR_TIMEOUT if none
+  *
+  * @details    Bytes arriving while no thread reads wait in the RX FIFO.
+  */
+int32_t RTOS_UART_Read(S_RTOS_UART_T *psUart, void *pvBuf, uint32_t u32Len, uint32_t u32Timeout)
+{
+    uint32_t u32PriMask, u32Left;
+
+    if (osMutexAcquire(psUart->sRxLock, u32Timeout) != osOK)
+        return RTOS_ERR_TIMEOUT;
+
+    osEventFlagsClear(psUart->sFlags, RTOS_FLAG_RX);
+    psUart->pu8Rx = (uint8_t *)pvBuf;
+    psUart->u32RxLeft = u32Len;
+
+    if (u32Len != 0)
+    {
+        UART_ENABLE_INT(psUart->uart, UART_INTEN_RDAIEN_Msk | UART_INTEN_RXTOIEN_Msk);
+        osEventFlagsWait(psUart->sFlags, RTOS_FLAG_RX, osFlagsWaitAny, u32Timeout);
+    }
+
+    u32PriMask = __get_PRIMASK();
+    __set_PRIMASK(1);
+    UART_DISABLE_INT(psUart->uart, UART_INTEN_RDAIEN_Msk | UART_INTEN_RXTOIEN_Msk);
+    u32Left = psUart->u32RxLeft;
+    psUart->u32RxLeft = 0;
+    __set_PRIMASK(u32PriMask);
+
+    osMutexRelease(psUart->sRxLock);
+
+    return ((u32Left == u32Len) && (u32Len != 0)) ? RTOS_ERR_TIMEOUT : (int32_t)(u32Len - u32Left);
+}
+
+/**
+  * @brief      UART interrupt service of the wrapper
+  *
+  * @param[in]  psUart      The pointer of the wrapper.
+  *
+  * @return     None
+  */
+void RTOS_UART_IRQHandler(S_RTOS_UART_T *psUart)
+{
+    UART_T *uart = psUart->uart;
+
+    if ((uart->INTEN & UART_INTEN_THREIEN_Msk) && (uart->INTSTS & UART_INTSTS_THREIF_Msk))
+    {
+        while (psUart->u32TxLeft && !(uart->FIFOSTS & UART_FIFOSTS_TXFULL_Msk))
+        {
+            uart->DAT = *psUart->pu8Tx++;
+            psUart->u32TxLeft--;
+        }
+
+        if (psUart->u32TxLeft == 0)
+        {
+            UART_DISABLE_INT(uart, UART_INTEN_THREIEN_Msk);
+            osEventFlagsSet(psUart->sFlags, RTOS_FLAG_TX);
+        }
+    }
+
+    if ((uart->INTEN & UART_INTEN_RDAIEN_Msk) && (uart->INTSTS & (UART_INTSTS_RDAIF_Msk | UART_INTSTS_RXTOIF_Msk)))
+    {
+        while (psUart->u32RxLeft && !(uart->FIFOSTS & UART_FIFOSTS_RXEMPTY_Msk))
+        {
+            *psUart->pu8Rx++ = (uint8_t)uart->DAT;
+            psUart->u32RxLeft--;
+        }
+
+        if (psUart->u32RxLeft == 0)
+        {
+            UART_DISABLE_INT(uart, UART_INTEN_RDAIEN_Msk | UART_INTEN_RXTOIEN_Msk);
+            osEventFlagsSet(psUart->sFlags, RTOS_FLAG_RX);
+        }
+    }
+}
+
+/**
+  * @brief      Open an SPI master for use by several threads
+  *
+  * @param[in]  psSpi       The pointer of the wrapper.
+  * @param[in]  spi         The pointer of the SPI.
+  * @param[in]  u32SPIMode  SPI_MODE_0 to SPI_MODE_3.
+  * @param[in]  u32BusClock Bus clock in Hz.
+  *
+  * @return     0 or \ref RTOS_ERR_OS
+  *
+  * @details    8-bit frames. Enable the NVIC interrupt and call \ref RTOS_SPI_IRQHandler from the SPI IRQ handler.
+  */
+int32_t RTOS_SPI_Open(S_RTOS_SPI_T *psSpi, SPI_T *spi, uint32_t u32SPIMode, uint32_t u32BusClock)
+{
+    psSpi->spi = spi;
+    psSpi->u32Left = 0;
+    psSpi->sLock = RTOS_NewMutex(psSpi->au32LockCb, osMutexRecursive | osMutexPrioInherit);
+    psSpi->sFlags = RTOS_NewFlags(psSpi->au32FlagsCb);
+
+    if ((psSpi->sLock == NULL) || (psSpi->sFlags == NULL))
+        return RTOS_ERR_OS;
+
+    SPI_Open(spi, SPI_MASTER, u32SPIMode, 8, u32BusClock);
+
+    return 0;
+}
+
+/**
+  * @brief      Take the SPI bus for several transfers
+  *
+  * @param[in]  psSpi       The pointer of the wrapper.
+  * @param[in]  u32Timeout  Time-out in kernel ticks.
+  *
+  * @return     0 or \ref RTOS_ERR_TIMEOUT
+  *
+  * @details    Keeps other threads off the bus while the caller drives a chip select by GPIO. Calls nest.
+  */
+int32_t RTOS_SPI_Acquire(S_RTOS_SPI_T *psSpi, uint32_t u32Timeout)
+{
+    return (osMutexAcquire(psSpi->sLock, u32Timeout) == osOK) ? 0 : RTOS_ERR_TIMEOUT;
+}
+
+/**
+  * @brief      Give back the SPI bus
+  *
+  * @param[in]  psSpi       The pointer of the wrapper.
+  *
+  * @return     None
+  */
+void RTOS_SPI_Release(S_RTOS_SPI_T *psSpi)
+{
+    osMutexRelease(psSpi->sLock);
+}
+
+/**
+  * @brief      Full duplex SPI transfer, blocking the calling thread only
+  *
+  * @param[in]  psSpi       The pointer of the wrapper.
+  * @param[in]  pvTx        Data to send, NULL sends 0xFF.
+  * @param[out] pvRx        Received data, NULL drops it.
+  * @param[in]  u32Len      Frames to transfer.
+  * @param[in]  u32Timeout  Time-out in kernel ticks for the bus and for the transfer.
+  *
+  * @return     0 or \ref RTOS_ERR_TIMEOUT
+  *
+  * @details    One unit transfer interrupt per frame, meant for register accesses and short commands.
+  */
+int32_t RTOS_SPI_Transfer(S_RTOS_SPI_T *psSpi, const void *pvTx, void *pvRx, uint32_t u32Len, uint32_t u32Timeout)
+{
+    SPI_T *spi = psSpi->spi;
+    uint32_t u32PriMask, u32Left;
+
+    if (u32Len == 0)
+        return 0;
+
+    if (osMutexAcquire(psSpi->sLock, u32Timeout) != osOK)
+        return RTOS_ERR_TIMEOUT;
+
+    osEventFlagsClear(psSpi->sFlags, RTOS_FLAG_SPI);
+    psSpi->pu8Tx = (const uint8_t *)pvTx;
+    psSpi->pu8Rx = (uint8_t *)pvRx;
+    psSpi->u32Left = u32Len;
+
+    spi->FIFOCTL |= SPI_FIFOCTL_RXRST_Msk | SPI_FIFOCTL_TXRST_Msk;
+    spi->STATUS = SPI_STATUS_UNITIF_Msk;
+    spi->CTL |= SPI_CTL_UNITIEN_Msk;
+    SPI_WRITE_TX(spi, (psSpi->pu8Tx != NULL) ? *psSpi->pu8Tx++ : 0xFFUL);
+
+    osEventFlagsWait(psSpi->sFlags, RTOS_FLAG_SPI, osFlagsWaitAny, u32Timeout);
+
+    u32PriMask = __get_PRIMASK();
+    __set_PRIMASK(1);
+    spi->CTL &= ~SPI_CTL_UNITIEN_Msk;
+    u32Left = psSpi->u32Left;
+    psSpi->u32Left = 0;
+    __set_PRIMASK(u32PriMask);
+
+    osMutexRelease(psSpi->sLock);
+
+    return (u32Left != 0) ? RTOS_ERR_TIMEOUT : 0;
+}
+
+/**
+  * @brief      SPI interrupt service of the wrapper
+  *
+  * @param[in]  psSpi       The pointer of the wrapper.
+  *
+  * @return     None
+  */
+void RTOS_SPI_IRQHandler(S_RTOS_SPI_T *psSpi)
+{
+    SPI_T *spi = psSpi->spi;
+    uint8_t u8Data;
+
+    if (!(spi->STATUS & SPI_STATUS_UNITIF_Msk))
+        return;
+
+    spi->STATUS = SPI_STATUS_UNITIF_Msk;
+    u8Data = (uint8_t)SPI_READ_RX(spi);
+
+    if (psSpi->u32Left == 0)
+        return;
+
+    if (psSpi->pu8Rx != NULL)
+        *psSpi->pu8Rx++ = u8Data;
+
+    if (--psSpi->u32Left != 0)
+        SPI_WRITE_TX(spi, (psSpi->pu8Tx != NULL) ? *psSpi->pu8Tx++ : 0xFFUL);
+    else
+    {
+        spi->CTL &= ~SPI_CTL_UNITIEN_Msk;
+        osEventFlagsSet(psSpi->sFlags, RTOS_FLAG_SPI);
+    }
+}
+
+/**
+  * @brief      Run an I2C transaction, blocking the calling thread only
+  *
+  * @param[in]  psBus   Bus opened by I2C_XFER_Open or UI2C_XFER_Open.
+  * @param[in]  psXfer  Transaction prepared by I2C_XFER_Setup.
+  *
+  * @return     I2C_XFER status of the transaction, or \ref RTOS_ERR_OS
+  *
+  * @details    I2C_XFER already queues transactions of all threads in order, so no lock is needed. The thread
+  *             sleeps on \ref RTOS_THREAD_FLAG_I2C until the completion callback, the bus time-out and recovery
+  *             of I2C_XFER bound the wait.
+  */
+int32_t RTOS_I2C_Transfer(S_I2C_XFER_BUS_T *psBus, S_I2C_XFER_T *psXfer)
+{
+    osThreadFlagsClear(RTOS_THREAD_FLAG_I2C);
+
+    if (I2C_XFER_Submit(psBus, psXfer, RTOS_I2CDone, osThreadGetId()) != 0)
+        return RTOS_ERR_OS;
+
+    osThreadFlagsWait(RTOS_THREAD_FLAG_I2C, osFlagsWaitAny, osWaitForever);
+
+    return psXfer->i32Status;
+}
+
+/**
+  * @brief      Let the idle thread stop the kernel tick
+  *
+  * @param[in]  timer           TIMER clocked by LIRC or LXT, it keeps counting in Power-down mode.
+  * @param[in]  u32MinPDTicks   Shortest sleep in kernel ticks worth a Power-down entry, shorter ones use Idle mode.
+  *
+  * @return     None
+  *
+  * @details    The idle thread of this driver suspends the kernel, sleeps until the next kernel time-out or an
+  *             interrupt with the TIMER as wake-up source, and resumes the kernel with the ticks slept. SysTick
+  *             stops meanwhile. The TIMER interrupt is only enabled in the NVIC while the idle thread sleeps with
+  *             PRIMASK set, its handler never runs. Until this is called the idle thread only waits for interrupts.
+  */
+void RTOS_TicklessInit(TIMER_T *timer, uint32_t u32MinPDTicks)
+{
+    if (timer == TIMER0)
+        s_eRtosTimerIrq = TMR0_IRQn;
+    else if (timer == TIMER1)
+        s_eRtosTimerIrq = TMR1_IRQn;
+    else if (timer == TIMER2)
+        s_eRtosTimerIrq = TMR2_IRQn;
+    else
+        s_eRtosTimerIrq = TMR3_IRQn;
+
+    NVIC_DisableIRQ(s_eRtosTimerIrq);
+    timer->CTL = 0;
+    s_u32RtosTimerClk = TIMER_GetModuleClock(timer);
+    s_u32RtosMinPDTicks = u32MinPDTicks;
+    s_psRtosTimer = timer;
+}
+
+/**
+  * @brief      Get the statistics of the idle thread
+  *
+  * @param      None
+  *
+  * @return     The pointer of the statistics
+  */
+const S_RTOS_IDLE_STAT_T *RTOS_GetIdleStat(void)
+{
+    return &s_sRtosIdleStat;
+}
+
+/*@}*/ /* end of group RTOS_DRV_EXPORTED_FUNCTIONS */
+
+/// @cond HIDDEN_SYMBOLS
+
+/*
+    Replaces the weak idle thread of RTX_Config.c. It sleeps with WFI and PRIMASK set, so an interrupt pending
+    since osKernelSuspend ends the WFI at once and one during the sleep wakes it, but none is taken before the
+    clocks are back and the slept time is known. WFE would not do: the exception return of the osKernelSuspend SVC
+    sets the event register and the WFE would never sleep.
+*/
+__NO_RETURN void osRtxIdleThread(void *argument)
+{
+    TIMER_T *timer;
+    uint32_t u32Ticks, u32Cnt, u32TickFreq, u32PD, u32Locked, u32PwrCtl;
+
+    (void)argument;
+
+    while (1)
+    {
+        timer = s_psRtosTimer;
+
+        if (timer == NULL)
+        {
+            __WFI();
+            continue;
+        }
+
+        u32Ticks = osKernelSuspend();
+
+        if (u32Ticks == 0)
+        {
+            osKernelResume(0);
+            continue;
+        }
+
+        u32TickFreq = osKernelGetTickFreq();
+
+        __set_PRIMASK(1);
+
+        u32Cnt = (uint32_t)(((uint64_t)u32Ticks * s_u32RtosTimerClk) / u32TickFreq);
+
+        if (u32Cnt > TIMER_CMP_CMPDAT_Msk)
+            u32Cnt = TIMER_CMP_CMPDAT_Msk;
+        else if (u32Cnt < 2UL)
+            u32Cnt = 2UL;
+
+        timer->CMP = u32Cnt;
+        timer->INTSTS = TIMER_INTSTS_TIF_Msk | TIMER_INTSTS_TWKF_Msk;
+        timer->CTL = TIMER_ONESHOT_MODE | TIMER_CTL_WKEN_Msk | TIMER_CTL_INTEN_Msk | TIMER_CTL_CNTEN_Msk;
+        NVIC_EnableIRQ(s_eRtosTimerIrq);
+
+        /* A debug UART still shifting out would be cut by the stopped clock */
+        u32PD = (u32Ticks >= s_u32RtosMinPDTicks) && (DEBUG_PORT->FIFOSTS & UART_FIFOSTS_TXEMPTYF_Msk);
+
+        u32PwrCtl = CLK->PWRCTL;
+        u32Locked = SYS_IsRegLocked();
+
+        if (u32Locked)
+            SYS_UnlockReg();
+
+        if (u32PD)
+        {
+            s_sRtosIdleStat.u32PDCount++;
+            CLK->PWRCTL |= CLK_PWRCTL_PDEN_Msk;
+            SCB->SCR |= SCB_SCR_SLEEPDEEP_Msk;
+        }
+        else
+        {
+            s_sRtosIdleStat.u32IdleCount++;
+            CLK->PWRCTL &= ~CLK_PWRCTL_PDEN_Msk;
+            SCB->SCR &= ~SCB_SCR_SLEEPDEEP_Msk;
+        }
+
+        __WFI();
+
+        SCB->SCR &= ~SCB_SCR_SLEEPDEEP_Msk;
+        CLK->PWRCTL &= ~CLK_PWRCTL_PDEN_Msk;
+
+        if (u32Locked)
+            SYS_LockReg();
+
+        if (u32PD)
+            RTOS_RestoreClock(u32PwrCtl);
+
+        /* Whole ticks slept, the rest of a tick is lost */
+        if (!(timer->INTSTS & TIMER_INTSTS_TIF_Msk))
+            u32Cnt = timer->CNT;
+
+        u32Cnt = (uint32_t)(((uint64_t)u32Cnt * u32TickFreq) / s_u32RtosTimerClk);
+
+        if (u32Cnt > u32Ticks)
+            u32Cnt = u32Ticks;
+
+        timer->CTL = 0;
+        timer->INTSTS = TIMER_INTSTS_TIF_Msk | TIMER_INTSTS_TWKF_Msk;
+        NVIC_DisableIRQ(s_eRtosTimerIrq);
+        NVIC_ClearPendingIRQ(s_eRtosTimerIrq);
+
+        s_sRtosIdleStat.u32SleptTicks += u32Cnt;
+
+        /* The interrupt that ended the sleep is taken here, an SVC with PRIMASK set would be a HardFault */
+        __set_PRIMASK(0);
+        osKernelResume(u32Cnt);
+    }
+}
+
+/// @endcond HIDDEN_SYMBOLS
+
+/*@}*/ /* end of group RTOS_DRV_Driver */
+
+/*@}*/ /* end of group Standard_Driver */
+
+/*** (C) COPYRIGHT 2021 Nuvoton Technology Corp. ***/
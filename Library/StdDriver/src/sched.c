@@ -0,0 +1,251 @@
+/**************************************************************************//**
+ * @file     sched.c
+ * @version  V1.00
+ * @brief    NUC121 series cooperative run-to-completion event scheduler source file
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * @copyright (C) 2021 Nuvoton Technology Corp. All rights reserved.
+*****************************************************************************/
+#include "NuMicro.h"
+
+/** @addtogroup Standard_Driver Standard Driver
+  @{
+*/
+
+/** @addtogroup SCHED_Driver SCHED Driver
+  @{
+*/
+
+/// @cond HIDDEN_SYMBOLS
+
+static S_SCHED_EVENT_T *s_apsSchedHead[SCHED_PRIO_NUM];
+static S_SCHED_EVENT_T *s_apsSchedTail[SCHED_PRIO_NUM];
+static SCHED_IDLE_FUNC s_pfnSchedIdle = CLK_Idle;
+static S_SCHED_STAT_T s_sSchedStat;
+
+/// @endcond HIDDEN_SYMBOLS
+
+
+/** @addtogroup SCHED_EXPORTED_FUNCTIONS SCHED Exported Functions
+  @{
+*/
+
+/**
+  * @brief      Initialize an event
+  *
+  * @param[in]  psEvent     The pointer of the event.
+  * @param[in]  pfnHandler  Function run by the scheduler for the event.
+  * @param[in]  pvArg       Argument passed to pfnHandler.
+  * @param[in]  u32Prio     Priority, 0 to \ref SCHED_PRIO_NUM - 1, 0 is handled first.
+  *
+  * @return     None
+  *
+  * @details    Events are allocated by the caller, statically for example, the scheduler owns no memory.
+  */
+void SCHED_InitEvent(S_SCHED_EVENT_T *psEvent, SCHED_FUNC pfnHandler, void *pvArg, uint32_t u32Prio)
+{
+    psEvent->psNext = NULL;
+    psEvent->pfnHandler = pfnHandler;
+    psEvent->pvArg = pvArg;
+    psEvent->u32Prio = (u32Prio < SCHED_PRIO_NUM) ? u32Prio : (SCHED_PRIO_NUM - 1UL);
+    psEvent->u32Flags = 0;
+}
+
+/**
+  * @brief      Post an event
+  *
+  * @param[in]  psEvent     The pointer of the event.
+  * @param[in]  u32Flags    Reasons of the post, not 0, \ref SCHED_FLAG_POST if there is only one.
+  *
+  * @return     None
+  *
+  * @details    Safe in interrupt context, an ISR clears its flag, posts and returns, the work runs later in the
+  *             handler. Posting an event that is still queued only adds its flags, so an event is queued at
+  *             most once and nothing is allocated or lost, the handler sees all flags posted since its last run.
+  *             A queued event is one with flags, so a post with u32Flags 0 is ignored.
+  */
+void SCHED_Post(S_SCHED_EVENT_T *psEvent, uint32_t u32Flags)
+{
+    uint32_t u32PriMask = __get_PRIMASK(), u32Prio = psEvent->u32Prio;
+
+    if (u32Flags == 0)
+        return;
+
+    __set_PRIMASK(1);
+
+    if (psEvent->u32Flags == 0)
+    {
+        psEvent->psNext = NULL;
+
+        if (s_apsSchedHead[u32Prio] == NULL)
+            s_apsSchedHead[u32Prio] = psEvent;
+        else
+            s_apsSchedTail[u32Prio]->psNext = psEvent;
+
+        s_apsSchedTail[u32Prio] = psEvent;
+        s_sSchedStat.u32Posted++;
+    }
+    else
+        s_sSchedStat.u32Merged++;
+
+    psEvent->u32Flags |= u32Flags;
+
+    __set_PRIMASK(u32PriMask);
+}
+
+/**
+  * @brief      Post an event from a software timer
+  *
+  * @param[in]  pvArg   The pointer of the event.
+  *
+  * @return     None
+  *
+  * @details    A SWTIMER_CB, pass it with the event as argument to SWTIMER_Start for delayed or periodic work.
+  *             The event gets \ref SCHED_FLAG_TIMER.
+  */
+void SCHED_PostFromTimer(void *pvArg)
+{
+    SCHED_Post((S_SCHED_EVENT_T *)pvArg, SCHED_FLAG_TIMER);
+}
+
+/**
+  * @brief      Remove a queued event
+  *
+  * @param[in]  psEvent     The pointer of the event.
+  *
+  * @return     None
+  *
+  * @details    The flags posted are dropped. Nothing happens if the event is not queued.
+  */
+void SCHED_Cancel(S_SCHED_EVENT_T *psEvent)
+{
+    S_SCHED_EVENT_T **ppsLink, *psPrev = NULL;
+    uint32_t u32PriMask = __get_PRIMASK(), u32Prio = psEvent->u32Prio;
+
+    __set_PRIMASK(1);
+
+    if (psEvent->u32Flags != 0)
+    {
+        for (ppsLink = &s_apsSchedHead[u32Prio]; *ppsLink != psEvent; ppsLink = &(*ppsLink)->psNext)
+            psPrev = *ppsLink;
+
+        *ppsLink = psEvent->psNext;
+
+        if (s_apsSchedTail[u32Prio] == psEvent)
+            s_apsSchedTail[u32Prio] = psPrev;
+
+        psEvent->u32Flags = 0;
+    }
+
+    __set_PRIMASK(u32PriMask);
+}
+
+/**
+  * @brief      Run the handler of the most urgent queued event
+  *
+  * @retval     1   A handler was run
+  * @retval     0   No event was queued
+  *
+  * @details    For a super-loop that keeps its own idle handling. Events of the same priority run in post order.
+  */
+uint32_t SCHED_RunOnce(void)
+{
+    S_SCHED_EVENT_T *psEvent = NULL;
+    uint32_t i, u32Flags = 0, u32PriMask = __get_PRIMASK();
+
+    __set_PRIMASK(1);
+
+    for (i = 0; i < SCHED_PRIO_NUM; i++)
+    {
+        psEvent = s_apsSchedHead[i];
+
+        if (psEvent != NULL)
+        {
+            s_apsSchedHead[i] = psEvent->psNext;
+            u32Flags = psEvent->u32Flags;
+            psEvent->u32Flags = 0;
+            s_sSchedStat.u32Handled++;
+            break;
+        }
+    }
+
+    __set_PRIMASK(u32PriMask);
+
+    if (psEvent == NULL)
+        return 0;
+
+    /* Interrupts are enabled again, the handler could post its own event */
+    psEvent->pfnHandler(psEvent->pvArg, u32Flags);
+
+    return 1;
+}
+
+/**
+  * @brief      Run the scheduler
+  *
+  * @return     Never returns
+  *
+  * @details    Handlers run to completion, one after the other. When none is queued the idle hook is called
+  *             with PRIMASK set, so a post from an interrupt that came after the last check still ends the sleep:
+  *             WFI wakes on a pending interrupt even when PRIMASK masks it.
+  */
+void SCHED_Run(void)
+{
+    uint32_t i;
+
+    while (1)
+    {
+        while (SCHED_RunOnce());
+
+        __set_PRIMASK(1);
+
+        for (i = 0; i < SCHED_PRIO_NUM; i++)
+        {
+            if (s_apsSchedHead[i] != NULL)
+                break;
+        }
+
+        if (i == SCHED_PRIO_NUM)
+        {
+            s_sSchedStat.u32IdleCount++;
+            s_pfnSchedIdle();
+        }
+
+        __set_PRIMASK(0);
+    }
+}
+
+/**
+  * @brief      Set the function called when no event is queued
+  *
+  * @param[in]  pfnIdle     Idle hook, NULL for CLK_Idle.
+  *
+  * @return     None
+  *
+  * @details    The hook must return after an interrupt. A wrapper around LPM_Sleep lets the low power manager
+  *             choose between Idle and Power-down mode.
+  */
+void SCHED_SetIdleHook(SCHED_IDLE_FUNC pfnIdle)
+{
+    s_pfnSchedIdle = (pfnIdle != NULL) ? pfnIdle : CLK_Idle;
+}
+
+/**
+  * @brief      Get the scheduler statistics
+  *
+  * @param      None
+  *
+  * @return     The pointer of the statistics
+  */
+const S_SCHED_STAT_T *SCHED_GetStat(void)
+{
+    return &s_sSchedStat;
+}
+
+/*@}*/ /* end of group SCHED_EXPORTED_FUNCTIONS */
+
+/*@}*/ /* end of group SCHED_Driver */
+
+/*@}*/ /* end of group Standard_Driver */
+
+/*** (C) COPYRIGHT 2021 Nuvoton Technology Corp. ***/
@@ -0,0 +1,349 @@
+/**************************************************************************//**
+ * @file     semihost.c
+ * @version  V1.00
+ * @brief    NUC121 series buffered semihost file I/O source file
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * @copyright (C) 2021 Nuvoton Technology Corp. All rights reserved.
+*****************************************************************************/
+#include <string.h>
+#include "NuMicro.h"
+
+/** @addtogroup Standard_Driver Standard Driver
+  @{
+*/
+
+/** @addtogroup SEMIHOST_Driver SEMIHOST Driver
+  @{
+*/
+
+/// @cond HIDDEN_SYMBOLS
+
+/* Semihost operations */
+#define SEMIHOST_SYS_OPEN       0x01
+#define SEMIHOST_SYS_CLOSE      0x02
+#define SEMIHOST_SYS_WRITE0     0x04
+#define SEMIHOST_SYS_WRITE      0x05
+#define SEMIHOST_SYS_READ       0x06
+#define SEMIHOST_SYS_FLEN       0x0C
+
+#ifdef DEBUG_ENABLE_SEMIHOST
+/* BKPT 0xAB trap of retarget.c, returns 0 when the HardFault handler caught it for lack of an ICE */
+int32_t SH_DoCommand(int32_t n32In_R0, int32_t n32In_R1, int32_t *pn32Out_R0);
+#endif
+
+static uint8_t s_u8ShAttached;
+static uint32_t s_u32ShTraps;
+static int32_t s_i32ShStream = -1;
+static uint32_t s_u32ShFill;
+static uint8_t s_au8ShBuf[SEMIHOST_BUF_SIZE];
+
+/* One trap, 0 without a debugger. A debugger that goes away is not trapped for again. */
+static int32_t SEMIHOST_Call(uint32_t u32Op, const void *pvArg, int32_t *pi32Ret)
+{
+#ifdef DEBUG_ENABLE_SEMIHOST
+
+    if (s_u8ShAttached)
+    {
+        s_u32ShTraps++;
+
+        if (SH_DoCommand((int32_t)u32Op, (int32_t)pvArg, pi32Ret) != 0)
+            return 1;
+    }
+
+#else
+    (void)u32Op;
+    (void)pvArg;
+    (void)pi32Ret;
+#endif
+    s_u8ShAttached = 0;
+
+    return 0;
+}
+
+/* Raw bytes, no newline translation, binary dumps stay intact */
+static void SEMIHOST_ToUART(const uint8_t *pu8Buf, uint32_t u32Len)
+{
+    while (u32Len--)
+    {
+        while (DEBUG_PORT->FIFOSTS & UART_FIFOSTS_TXFULL_Msk);
+
+        DEBUG_PORT->DAT = *pu8Buf++;
+    }
+}
+
+/// @endcond HIDDEN_SYMBOLS
+
+
+/** @addtogroup SEMIHOST_EXPORTED_FUNCTIONS SEMIHOST Exported Functions
+  @{
+*/
+
+/**
+  * @brief      Look for a debugger
+  *
+  * @retval     1   A debugger serves semihost calls
+  * @retval     0   None, streams fall back to the debug UART and files fail
+  *
+  * @details    Costs one trap, through the HardFault handler of retarget.c when no debugger is attached. Every
+  *             later call without a debugger returns at once. Always 0 unless DEBUG_ENABLE_SEMIHOST is defined.
+  */
+int32_t SEMIHOST_Open(void)
+{
+    int32_t i32Ret;
+
+    s_u8ShAttached = 1;
+
+    /* An empty string, the one command every semihost debugger supports */
+    SEMIHOST_Call(SEMIHOST_SYS_WRITE0, "", &i32Ret);
+
+    return s_u8ShAttached;
+}
+
+/**
+  * @brief      Check for the debugger found by \ref SEMIHOST_Open
+  *
+  * @retval     1   Attached
+  * @retval     0   Not attached
+  */
+int32_t SEMIHOST_IsAttached(void)
+{
+    return s_u8ShAttached;
+}
+
+/**
+  * @brief      Get the number of semihost traps taken
+  *
+  * @return     Traps since reset, the one of \ref SEMIHOST_Open included
+  */
+uint32_t SEMIHOST_GetTrapCount(void)
+{
+    return s_u32ShTraps;
+}
+
+/**
+  * @brief      Open a file of the host
+  *
+  * @param[in]  pcName      Path on the host, relative to the working directory of the debugger, or
+  *                         \ref SEMIHOST_CONSOLE.
+  * @param[in]  u32Mode     \ref SEMIHOST_MODE_READ, \ref SEMIHOST_MODE_WRITE or \ref SEMIHOST_MODE_APPEND.
+  *
+  * @return     Handle, \ref SEMIHOST_ERR_NO_HOST or \ref SEMIHOST_ERR_IO
+  */
+int32_t SEMIHOST_FileOpen(const char *pcName, uint32_t u32Mode)
+{
+    uint32_t au32Arg[3];
+    int32_t i32Ret;
+
+    au32Arg[0] = (uint32_t)pcName;
+    au32Arg[1] = u32Mode;
+    au32Arg[2] = strlen(pcName);
+
+    if (!SEMIHOST_Call(SEMIHOST_SYS_OPEN, au32Arg, &i32Ret))
+        return SEMIHOST_ERR_NO_HOST;
+
+    return ((i32Ret < 0) ? SEMIHOST_ERR_IO : i32Ret);
+}
+
+/**
+  * @brief      Close a file of the host
+  *
+  * @param[in]  i32Handle   Handle of \ref SEMIHOST_FileOpen.
+  *
+  * @return     0, \ref SEMIHOST_ERR_NO_HOST or \ref SEMIHOST_ERR_IO
+  */
+int32_t SEMIHOST_FileClose(int32_t i32Handle)
+{
+    uint32_t au32Arg[1];
+    int32_t i32Ret;
+
+    au32Arg[0] = (uint32_t)i32Handle;
+
+    if (!SEMIHOST_Call(SEMIHOST_SYS_CLOSE, au32Arg, &i32Ret))
+        return SEMIHOST_ERR_NO_HOST;
+
+    return ((i32Ret != 0) ? SEMIHOST_ERR_IO : 0);
+}
+
+/**
+  * @brief      Read from a file of the host
+  *
+  * @param[in]  i32Handle   Handle of \ref SEMIHOST_FileOpen.
+  * @param[out] pvBuf       Destination.
+  * @param[in]  u32Len      Bytes to read.
+  *
+  * @return     Bytes read, fewer at the end of the file, or \ref SEMIHOST_ERR_NO_HOST
+  *
+  * @details    One trap for the whole block, load test vectors in chunks as large as RAM allows.
+  */
+int32_t SEMIHOST_FileRead(int32_t i32Handle, void *pvBuf, uint32_t u32Len)
+{
+    uint32_t au32Arg[3];
+    int32_t i32Ret;
+
+    au32Arg[0] = (uint32_t)i32Handle;
+    au32Arg[1] = (uint32_t)pvBuf;
+    au32Arg[2] = u32Len;
+
+    if (!SEMIHOST_Call(SEMIHOST_SYS_READ, au32Arg, &i32Ret))
+        return SEMIHOST_ERR_NO_HOST;
+
+    /* The host returns the bytes it did not read */
+    return (int32_t)(u32Len - (uint32_t)i32Ret);
+}
+
+/**
+  * @brief      Write to a file of the host
+  *
+  * @param[in]  i32Handle   Handle of \ref SEMIHOST_FileOpen.
+  * @param[in]  pvBuf       Source.
+  * @param[in]  u32Len      Bytes to write.
+  *
+  * @return     Bytes written or \ref SEMIHOST_ERR_NO_HOST
+  */
+int32_t SEMIHOST_FileWrite(int32_t i32Handle, const void *pvBuf, uint32_t u32Len)
+{
+    uint32_t au32Arg[3];
+    int32_t i32Ret;
+
+    au32Arg[0] = (uint32_t)i32Handle;
+    au32Arg[1] = (uint32_t)pvBuf;
+    au32Arg[2] = u32Len;
+
+    if (!SEMIHOST_Call(SEMIHOST_SYS_WRITE, au32Arg, &i32Ret))
+        return SEMIHOST_ERR_NO_HOST;
+
+    /* The host returns the bytes it did not write */
+    return (int32_t)(u32Len - (uint32_t)i32Ret);
+}
+
+/**
+  * @brief      Get the length of a file of the host
+  *
+  * @param[in]  i32Handle   Handle of \ref SEMIHOST_FileOpen.
+  *
+  * @return     Length in bytes, \ref SEMIHOST_ERR_NO_HOST or \ref SEMIHOST_ERR_IO
+  */
+int32_t SEMIHOST_FileLength(int32_t i32Handle)
+{
+    uint32_t au32Arg[1];
+    int32_t i32Ret;
+
+    au32Arg[0] = (uint32_t)i32Handle;
+
+    if (!SEMIHOST_Call(SEMIHOST_SYS_FLEN, au32Arg, &i32Ret))
+        return SEMIHOST_ERR_NO_HOST;
+
+    return ((i32Ret < 0) ? SEMIHOST_ERR_IO : i32Ret);
+}
+
+/**
+  * @brief      Start the buffered output stream
+  *
+  * @param[in]  pcName  File of the host to create, \ref SEMIHOST_CONSOLE for the debugger console.
+  *
+  * @return     0, \ref SEMIHOST_ERR_NO_HOST or \ref SEMIHOST_ERR_IO
+  *
+  * @details    Without a debugger the stream still works and its bytes go out of the debug UART unchanged.
+  */
+int32_t SEMIHOST_StreamOpen(const char *pcName)
+{
+    int32_t i32Handle;
+
+    SEMIHOST_StreamClose();
+
+    i32Handle = SEMIHOST_FileOpen(pcName, SEMIHOST_MODE_WRITE);
+
+    if (i32Handle < 0)
+        return i32Handle;
+
+    s_i32ShStream = i32Handle;
+
+    return 0;
+}
+
+/**
+  * @brief      Write to the buffered output stream
+  *
+  * @param[in]  pvBuf   Source.
+  * @param[in]  u32Len  Bytes to write.
+  *
+  * @return     None
+  *
+  * @details    Bytes are collected in \ref SEMIHOST_BUF_SIZE and sent with one SYS_WRITE when it is full. Blocks of
+  *             at least that size are sent straight from the caller.
+  */
+void SEMIHOST_StreamWrite(const void *pvBuf, uint32_t u32Len)
+{
+    const uint8_t *pu8Buf = (const uint8_t *)pvBuf;
+    uint32_t u32Part;
+
+    if (s_i32ShStream < 0)
+    {
+        SEMIHOST_ToUART(pu8Buf, u32Len);
+        return;
+    }
+
+    while (u32Len)
+    {
+        if ((s_u32ShFill == 0) && (u32Len >= SEMIHOST_BUF_SIZE))
+        {
+            if (SEMIHOST_FileWrite(s_i32ShStream, pu8Buf, u32Len) == SEMIHOST_ERR_NO_HOST)
+                SEMIHOST_ToUART(pu8Buf, u32Len);
+
+            return;
+        }
+
+        u32Part = SEMIHOST_BUF_SIZE - s_u32ShFill;
+
+        if (u32Part > u32Len)
+            u32Part = u32Len;
+
+        memcpy(&s_au8ShBuf[s_u32ShFill], pu8Buf, u32Part);
+        s_u32ShFill += u32Part;
+        pu8Buf += u32Part;
+        u32Len -= u32Part;
+
+        if (s_u32ShFill == SEMIHOST_BUF_SIZE)
+            SEMIHOST_StreamFlush();
+    }
+}
+
+/**
+  * @brief      Send what the output stream has collected
+  *
+  * @return     None
+  */
+void SEMIHOST_StreamFlush(void)
+{
+    if ((s_i32ShStream >= 0) && (s_u32ShFill != 0))
+    {
+        if (SEMIHOST_FileWrite(s_i32ShStream, s_au8ShBuf, s_u32ShFill) == SEMIHOST_ERR_NO_HOST)
+            SEMIHOST_ToUART(s_au8ShBuf, s_u32ShFill);
+    }
+
+    s_u32ShFill = 0;
+}
+
+/**
+  * @brief      Flush and close the output stream
+  *
+  * @return     None
+  */
+void SEMIHOST_StreamClose(void)
+{
+    if (s_i32ShStream < 0)
+        return;
+
+    SEMIHOST_StreamFlush();
+    SEMIHOST_FileClose(s_i32ShStream);
+    s_i32ShStream = -1;
+}
+
+/*@}*/ /* end of group SEMIHOST_EXPORTED_FUNCTIONS */
+
+/*@}*/ /* end of group SEMIHOST_Driver */
+
+/*@}*/ /* end of group Standard_Driver */
+
+/*** (C) COPYRIGHT 2021 Nuvoton Technology Corp. ***/
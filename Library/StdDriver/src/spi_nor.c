@@ -0,0 +1,831 @@
+/**************************************************************************//**
+ * @file     spi_nor.c
+ * @version  V1.00
+ * @brief    NUC121 series SPI NOR flash driver source file
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * @copyright (C) 2021 Nuvoton Technology Corp. All rights reserved.
+*****************************************************************************/
+#include <string.h>
+#include "NuMicro.h"
+
+/** @addtogroup Standard_Driver Standard Driver
+  @{
+*/
+
+/** @addtogroup SPI_NOR_Driver SPI_NOR Driver
+  @{
+*/
+
+/// @cond HIDDEN_SYMBOLS
+
+#define SPI_NOR_CMD_WREN        (0x06U)
+#define SPI_NOR_CMD_RDSR        (0x05U)
+#define SPI_NOR_CMD_PP          (0x02U)
+#define SPI_NOR_CMD_FAST_READ   (0x0BU)
+#define SPI_NOR_CMD_SE          (0x20U)
+#define SPI_NOR_CMD_BE64        (0xD8U)
+#define SPI_NOR_CMD_RDID        (0x9FU)
+#define SPI_NOR_CMD_RDP         (0xABU)     /* Release from deep power-down */
+
+#define SPI_NOR_SR_WIP          (0x01U)
+#define SPI_NOR_FIFO_DEPTH      (4UL)       /* Frames in flight, the receive FIFO never overruns */
+#define SPI_NOR_NO_SECTOR       (0xFFFFFFFFUL)
+#define SPI_NOR_BLOCKS          (SPI_NOR_SECTOR_SIZE / SPI_NOR_BLOCK_SIZE)
+
+static void SPI_NOR_Select(S_SPI_NOR_T *psDev)
+{
+    SPI_ClearRxFIFO(psDev->spi);
+    SPI_SET_SS_LOW(psDev->spi);
+}
+
+static void SPI_NOR_Deselect(S_SPI_NOR_T *psDev)
+{
+    while (SPI_IS_BUSY(psDev->spi));
+
+    SPI_SET_SS_HIGH(psDev->spi);
+}
+
+/* Byte transfer by the CPU, NULL sends 0xFF or discards */
+static void SPI_NOR_Fifo(S_SPI_NOR_T *psDev, const uint8_t *pu8Tx, uint8_t *pu8Rx, uint32_t u32Len)
+{
+    SPI_T *spi = psDev->spi;
+    uint32_t u32Tx = 0, u32Rx = 0, u32Data;
+
+    while (u32Rx < u32Len)
+    {
+        if ((u32Tx < u32Len) && ((u32Tx - u32Rx) < SPI_NOR_FIFO_DEPTH) && ((spi->STATUS & SPI_STATUS_TXFULL_Msk) == 0))
+        {
+            SPI_WRITE_TX(spi, (pu8Tx != NULL) ? pu8Tx[u32Tx] : 0xFFUL);
+            u32Tx++;
+        }
+
+        if ((spi->STATUS & SPI_STATUS_RXEMPTY_Msk) == 0)
+        {
+            u32Data = SPI_READ_RX(spi);
+
+            if (pu8Rx != NULL)
+                pu8Rx[u32Rx] = (uint8_t)u32Data;
+
+            u32Rx++;
+        }
+    }
+}
+
+/* Command, optional 3-byte address and dummy byte, the device stays selected */
+static void SPI_NOR_Cmd(S_SPI_NOR_T *psDev, uint8_t u8Cmd, uint32_t u32Addr, uint32_t u32HdrLen)
+{
+    uint8_t au8Hdr[5];
+
+    au8Hdr[0] = u8Cmd;
+    au8Hdr[1] = (uint8_t)(u32Addr >> 16);
+    au8Hdr[2] = (uint8_t)(u32Addr >> 8);
+    au8Hdr[3] = (uint8_t)u32Addr;
+    au8Hdr[4] = 0xFFU;
+
+    SPI_NOR_Select(psDev);
+    SPI_NOR_Fifo(psDev, au8Hdr, NULL, u32HdrLen);
+}
+
+/* Read the status register until WIP clears, the register is sent again and again while selected */
+static int32_t SPI_NOR_WaitReady(S_SPI_NOR_T *psDev, uint32_t u32PollMax)
+{
+    uint32_t i;
+    uint8_t u8Sr = SPI_NOR_SR_WIP;
+
+    if (psDev->u8Busy == 0)
+        return 0;
+
+    SPI_NOR_Cmd(psDev, SPI_NOR_CMD_RDSR, 0, 1);
+
+    for (i = 0; i < u32PollMax; i++)
+    {
+        SPI_NOR_Fifo(psDev, NULL, &u8Sr, 1);
+
+        if ((u8Sr & SPI_NOR_SR_WIP) == 0)
+            break;
+
+        psDev->u32Polls++;
+    }
+
+    SPI_NOR_Deselect(psDev);
+
+    if ((u8Sr & SPI_NOR_SR_WIP) != 0)
+        return SPI_NOR_ERR_BUSY;
+
+    psDev->u8Busy = 0;
+
+    return 0;
+}
+
+static void SPI_NOR_WriteEnable(S_SPI_NOR_T *psDev)
+{
+    SPI_NOR_Cmd(psDev, SPI_NOR_CMD_WREN, 0, 1);
+    SPI_NOR_Deselect(psDev);
+}
+
+static void SPI_NOR_PdmaStop(S_SPI_NOR_T *psDev)
+{
+    SPI_DISABLE_TX_PDMA(psDev->spi);
+    SPI_DISABLE_RX_PDMA(psDev->spi);
+    PDMA_CLR_TD_FLAG((1UL << psDev->u32TxCh) | (1UL << psDev->u32RxCh));
+}
+
+/* Data phase of a read. The RX channel runs through a scatter-gather table while the TX channel clocks 0xFF,
+   each pass takes up to SPI_NOR_DESC_NUM descriptors and SPI_NOR_PDMA_MAX bytes. */
+static void SPI_NOR_ReadData(S_SPI_NOR_T *psDev, const S_SPI_NOR_SG_T *psSg, uint32_t u32Num)
+{
+    SPI_T *spi = psDev->spi;
+    PDMA_DSCT_T *psDesc = NULL;
+    uint32_t u32Off = 0, u32Len, u32Total, n;
+
+    while (u32Num != 0)
+    {
+        u32Total = 0;
+        n = 0;
+
+        while ((n < SPI_NOR_DESC_NUM) && (u32Num != 0) && (u32Total < SPI_NOR_PDMA_MAX))
+        {
+            u32Len = psSg->u32Len - u32Off;
+
+            if (u32Len > (SPI_NOR_PDMA_MAX - u32Total))
+                u32Len = SPI_NOR_PDMA_MAX - u32Total;
+
+            if (u32Len != 0)
+            {
+                psDesc = &psDev->asDesc[n++];
+                psDesc->SA = (uint32_t)&spi->RX;
+                psDesc->FIRST = (uint32_t)&psDev->asDesc[n] - PDMA->SCATBA;
+
+                if (psSg->pu8Buf != NULL)
+                {
+                    psDesc->DA = (uint32_t)&psSg->pu8Buf[u32Off];
+                    psDesc->CTL = PDMA_DAR_INC;
+                }
+                else
+                {
+                    psDesc->DA = (uint32_t)&psDev->u32DummyRx;
+                    psDesc->CTL = PDMA_DAR_FIX;
+                }
+
+                psDesc->CTL |= ((u32Len - 1UL) << PDMA_DSCT_CTL_TXCNT_Pos) | PDMA_WIDTH_8 | PDMA_SAR_FIX |
+                               PDMA_REQ_SINGLE | PDMA_OP_SCATTER;
+                u32Total += u32Len;
+                u32Off += u32Len;
+            }
+
+            if (u32Off >= psSg->u32Len)
+            {
+                psSg++;
+                u32Num--;
+                u32Off = 0;
+            }
+        }
+
+        if (n == 0)
+            break;
+
+        /* The last descriptor ends the chain */
+        psDesc->CTL = (psDesc->CTL & ~PDMA_DSCT_CTL_OPMODE_Msk) | PDMA_OP_BASIC;
+
+        PDMA_SetTransferMode(psDev->u32RxCh, PDMA_SPI0_RX, TRUE, (uint32_t)&psDev->asDesc[0]);
+
+        PDMA_SetTransferCnt(psDev->u32TxCh, PDMA_WIDTH_8, u32Total);
+        PDMA_SetTransferAddr(psDev->u32TxCh, (uint32_t)&psDev->u32DummyTx, PDMA_SAR_FIX, (uint32_t)&spi->TX, PDMA_DAR_FIX);
+        PDMA_SetTransferMode(psDev->u32TxCh, PDMA_SPI0_TX, FALSE, 0);
+        PDMA_SetBurstType(psDev->u32TxCh, PDMA_REQ_SINGLE, 0);
+
+        SPI_TRIGGER_RX_PDMA(spi);
+        SPI_TRIGGER_TX_PDMA(spi);
+
+        /* The channel goes idle after the basic descriptor */
+        while ((PDMA->DSCT[psDev->u32RxCh].CTL & PDMA_DSCT_CTL_OPMODE_Msk) != PDMA_OP_IDLE);
+
+        SPI_NOR_PdmaStop(psDev);
+    }
+}
+
+/* Data phase of a page program */
+static void SPI_NOR_WriteData(S_SPI_NOR_T *psDev, const uint8_t *pu8Data, uint32_t u32Len)
+{
+    SPI_T *spi = psDev->spi;
+
+    if ((psDev->u32TxCh == SPI_NOR_NO_PDMA) || (u32Len < SPI_NOR_PDMA_MIN))
+    {
+        SPI_NOR_Fifo(psDev, pu8Data, NULL, u32Len);
+        return;
+    }
+
+    PDMA_SetTransferCnt(psDev->u32RxCh, PDMA_WIDTH_8, u32Len);
+    PDMA_SetTransferAddr(psDev->u32RxCh, (uint32_t)&spi->RX, PDMA_SAR_FIX, (uint32_t)&psDev->u32DummyRx, PDMA_DAR_FIX);
+    PDMA_SetTransferMode(psDev->u32RxCh, PDMA_SPI0_RX, FALSE, 0);
+    PDMA_SetBurstType(psDev->u32RxCh, PDMA_REQ_SINGLE, 0);
+
+    PDMA_SetTransferCnt(psDev->u32TxCh, PDMA_WIDTH_8, u32Len);
+    PDMA_SetTransferAddr(psDev->u32TxCh, (uint32_t)pu8Data, PDMA_SAR_INC, (uint32_t)&spi->TX, PDMA_DAR_FIX);
+    PDMA_SetTransferMode(psDev->u32TxCh, PDMA_SPI0_TX, FALSE, 0);
+    PDMA_SetBurstType(psDev->u32TxCh, PDMA_REQ_SINGLE, 0);
+
+    SPI_TRIGGER_RX_PDMA(spi);
+    SPI_TRIGGER_TX_PDMA(spi);
+
+    while ((PDMA_GET_TD_STS() & (1UL << psDev->u32RxCh)) == 0);
+
+    SPI_NOR_PdmaStop(psDev);
+}
+
+/* An erased range grows when the next erase follows it, otherwise it restarts */
+static void SPI_NOR_MarkErased(S_SPI_NOR_T *psDev, uint32_t u32Addr, uint32_t u32Len)
+{
+    if ((psDev->u32BlankStart == psDev->u32BlankEnd) || (u32Addr != psDev->u32BlankEnd))
+        psDev->u32BlankStart = u32Addr;
+
+    psDev->u32BlankEnd = u32Addr + u32Len;
+}
+
+/* Programmed bytes leave the erased range, keep the larger known part */
+static void SPI_NOR_MarkWritten(S_SPI_NOR_T *psDev, uint32_t u32Addr, uint32_t u32Len)
+{
+    if ((u32Addr >= psDev->u32BlankEnd) || ((u32Addr + u32Len) <= psDev->u32BlankStart))
+        return;
+
+    if (u32Addr <= psDev->u32BlankStart)
+        psDev->u32BlankStart = ((u32Addr + u32Len) < psDev->u32BlankEnd) ? (u32Addr + u32Len) : psDev->u32BlankEnd;
+    else
+        psDev->u32BlankEnd = u32Addr;
+}
+
+static int32_t SPI_NOR_EraseCmd(S_SPI_NOR_T *psDev, uint32_t u32Addr, uint32_t u32Len)
+{
+    int32_t i32Ret = SPI_NOR_WaitReady(psDev, psDev->u32PollMax);
+
+    if (i32Ret != 0)
+        return i32Ret;
+
+    SPI_NOR_WriteEnable(psDev);
+    SPI_NOR_Cmd(psDev, (u32Len == SPI_NOR_BLOCK64_SIZE) ? SPI_NOR_CMD_BE64 : SPI_NOR_CMD_SE, u32Addr, 4);
+    SPI_NOR_Deselect(psDev);
+
+    psDev->u8Busy = 1;
+    psDev->u32Erases++;
+    SPI_NOR_MarkErased(psDev, u32Addr, u32Len);
+
+    return 0;
+}
+
+/* The erase-ahead queue goes one sector at a time, so a foreground access never waits for a 64 KB erase */
+static int32_t SPI_NOR_EraseStep(S_SPI_NOR_T *psDev)
+{
+    int32_t i32Ret = SPI_NOR_EraseCmd(psDev, psDev->u32EraseNext, SPI_NOR_SECTOR_SIZE);
+
+    if (i32Ret == 0)
+    {
+        psDev->u32EraseNext += SPI_NOR_SECTOR_SIZE;
+        psDev->u32AheadErases++;
+    }
+
+    return i32Ret;
+}
+
+/* Queued sectors in the range are erased now, a program must not hit a sector the queue erases later */
+static int32_t SPI_NOR_EraseUntil(S_SPI_NOR_T *psDev, uint32_t u32Addr, uint32_t u32Len)
+{
+    int32_t i32Ret;
+
+    while ((psDev->u32EraseNext < psDev->u32EraseEnd) && (psDev->u32EraseNext < (u32Addr + u32Len)) &&
+            (psDev->u32EraseEnd > u32Addr))
+    {
+        i32Ret = SPI_NOR_EraseStep(psDev);
+
+        if (i32Ret != 0)
+            return i32Ret;
+    }
+
+    return 0;
+}
+
+/* Write the cached sector. A sector still erased is programmed as is, otherwise the blocks not in the cache
+   are gathered by one read, then the sector is erased and programmed. */
+static int32_t SPI_NOR_Flush(S_SPI_NOR_T *psDev)
+{
+    S_SPI_NOR_SG_T asSg[SPI_NOR_BLOCKS];
+    uint32_t i, j, u32Num, u32Addr = psDev->u32CacheAddr;
+    uint8_t *pu8Buf;
+    int32_t i32Ret;
+
+    if ((u32Addr == SPI_NOR_NO_SECTOR) || (psDev->u8CacheDirty == 0))
+        return 0;
+
+    i32Ret = SPI_NOR_EraseUntil(psDev, u32Addr, SPI_NOR_SECTOR_SIZE);
+
+    if (i32Ret != 0)
+        return i32Ret;
+
+    if ((u32Addr >= psDev->u32BlankStart) && ((u32Addr + SPI_NOR_SECTOR_SIZE) <= psDev->u32BlankEnd))
+    {
+        for (i = 0; i < SPI_NOR_BLOCKS; i++)
+        {
+            if ((psDev->u8CacheValid & (1UL << i)) == 0)
+                memset(&psDev->pu8Cache[i * SPI_NOR_BLOCK_SIZE], 0xFF, SPI_NOR_BLOCK_SIZE);
+        }
+    }
+    else
+    {
+        if (psDev->u8CacheValid != ((1UL << SPI_NOR_BLOCKS) - 1UL))
+        {
+            /* Dirty blocks are skipped, runs of blocks share one entry */
+            u32Num = 0;
+
+            for (i = 0; i < SPI_NOR_BLOCKS; i++)
+            {
+                pu8Buf = (psDev->u8CacheValid & (1UL << i)) ? NULL : &psDev->pu8Cache[i * SPI_NOR_BLOCK_SIZE];
+
+                if ((u32Num != 0) && ((asSg[u32Num - 1].pu8Buf == NULL) == (pu8Buf == NULL)))
+                    asSg[u32Num - 1].u32Len += SPI_NOR_BLOCK_SIZE;
+                else
+                {
+                    asSg[u32Num].pu8Buf = pu8Buf;
+                    asSg[u32Num].u32Len = SPI_NOR_BLOCK_SIZE;
+                    u32Num++;
+                }
+            }
+
+            i32Ret = SPI_NOR_ReadSG(psDev, u32Addr, asSg, u32Num);
+
+            if (i32Ret != 0)
+                return i32Ret;
+        }
+
+        i32Ret = SPI_NOR_EraseCmd(psDev, u32Addr, SPI_NOR_SECTOR_SIZE);
+
+        if (i32Ret != 0)
+            return i32Ret;
+
+        psDev->u8CacheDirty = (uint8_t)((1UL << SPI_NOR_BLOCKS) - 1UL);
+    }
+
+    psDev->u8CacheValid = (uint8_t)((1UL << SPI_NOR_BLOCKS) - 1UL);
+
+    /* Program runs of dirty blocks */
+    for (i = 0; i < SPI_NOR_BLOCKS; i = j)
+    {
+        for (j = i; (j < SPI_NOR_BLOCKS) && (psDev->u8CacheDirty & (1UL << j)); j++);
+
+        if (j == i)
+        {
+            j++;
+            continue;
+        }
+
+        i32Ret = SPI_NOR_Write(psDev, u32Addr + i * SPI_NOR_BLOCK_SIZE, &psDev->pu8Cache[i * SPI_NOR_BLOCK_SIZE],
+                               (j - i) * SPI_NOR_BLOCK_SIZE);
+
+        if (i32Ret != 0)
+            return i32Ret;
+    }
+
+    psDev->u8CacheDirty = 0;
+    psDev->u32Flushes++;
+
+    return 0;
+}
+
+static int32_t SPI_NOR_BlkRead(void *pvDev, uint32_t u32Block, uint8_t *pu8Buf, uint32_t u32Count)
+{
+    S_SPI_NOR_T *psDev = (S_SPI_NOR_T *)pvDev;
+    uint32_t i, u32Addr = u32Block * SPI_NOR_BLOCK_SIZE, u32Len = u32Count * SPI_NOR_BLOCK_SIZE, u32Blk;
+    int32_t i32Ret = SPI_NOR_Read(psDev, u32Addr, pu8Buf, u32Len);
+
+    if ((i32Ret != 0) || (psDev->u8CacheDirty == 0))
+        return i32Ret;
+
+    /* Dirty blocks are newer than the device */
+    for (i = 0; i < SPI_NOR_BLOCKS; i++)
+    {
+        u32Blk = psDev->u32CacheAddr + i * SPI_NOR_BLOCK_SIZE;
+
+        if ((psDev->u8CacheDirty & (1UL << i)) && (u32Blk >= u32Addr) && (u32Blk < (u32Addr + u32Len)))
+            memcpy(&pu8Buf[u32Blk - u32Addr], &psDev->pu8Cache[i * SPI_NOR_BLOCK_SIZE], SPI_NOR_BLOCK_SIZE);
+    }
+
+    return 0;
+}
+
+static int32_t SPI_NOR_BlkWrite(void *pvDev, uint32_t u32Block, const uint8_t *pu8Buf, uint32_t u32Count)
+{
+    S_SPI_NOR_T *psDev = (S_SPI_NOR_T *)pvDev;
+    uint32_t u32Addr, u32Sector, u32Idx;
+    int32_t i32Ret;
+
+    if ((u32Block > (psDev->u32Size / SPI_NOR_BLOCK_SIZE)) || (u32Count > ((psDev->u32Size / SPI_NOR_BLOCK_SIZE) - u32Block)))
+        return SPI_NOR_ERR_RANGE;
+
+    for (; u32Count != 0; u32Count--, u32Block++, pu8Buf += SPI_NOR_BLOCK_SIZE)
+    {
+        u32Addr = u32Block * SPI_NOR_BLOCK_SIZE;
+        u32Sector = u32Addr & ~(SPI_NOR_SECTOR_SIZE - 1UL);
+
+        if (u32Sector != psDev->u32CacheAddr)
+        {
+            i32Ret = SPI_NOR_Flush(psDev);
+
+            if (i32Ret != 0)
+                return i32Ret;
+
+            psDev->u32CacheAddr = u32Sector;
+            psDev->u8CacheValid = 0;
+            psDev->u8CacheDirty = 0;
+        }
+
+        u32Idx = (u32Addr - u32Sector) / SPI_NOR_BLOCK_SIZE;
+        memcpy(&psDev->pu8Cache[u32Idx * SPI_NOR_BLOCK_SIZE], pu8Buf, SPI_NOR_BLOCK_SIZE);
+        psDev->u8CacheValid |= (uint8_t)(1UL << u32Idx);
+        psDev->u8CacheDirty |= (uint8_t)(1UL << u32Idx);
+    }
+
+    return 0;
+}
+
+static int32_t SPI_NOR_BlkSync(void *pvDev)
+{
+    S_SPI_NOR_T *psDev = (S_SPI_NOR_T *)pvDev;
+    int32_t i32Ret = SPI_NOR_Flush(psDev);
+
+    if (i32Ret != 0)
+        return i32Ret;
+
+    return SPI_NOR_Sync(psDev);
+}
+
+/// @endcond HIDDEN_SYMBOLS
+
+/** @addtogroup SPI_NOR_EXPORTED_FUNCTIONS SPI_NOR Exported Functions
+  @{
+*/
+
+/**
+  * @brief      Attach a JEDEC SPI NOR flash
+  *
+  * @param[in]  psDev       The pointer of the device context.
+  * @param[in]  spi         SPI0, opened by \ref SPI_Open as a master with 8-bit data width in mode 0 or 3.
+  * @param[in]  u32TxCh     PDMA channel for SPI TX, \ref SPI_NOR_NO_PDMA to move all data by the CPU.
+  * @param[in]  u32RxCh     PDMA channel for SPI RX.
+  *
+  * @retval     0               Success
+  * @retval     SPI_NOR_ERR_ID  No device answered the JEDEC ID command, or it needs 4-byte addresses
+  *
+  * @details    The driver controls SPI0_SS by software, the automatic slave selection must stay disabled.
+  *             The device is woken up from deep power-down, then its size is taken from the JEDEC capacity
+  *             byte. The PDMA channels are opened here and must not be used by other drivers.
+  */
+int32_t SPI_NOR_Open(S_SPI_NOR_T *psDev, SPI_T *spi, uint32_t u32TxCh, uint32_t u32RxCh)
+{
+    uint8_t au8Cmd[4] = {SPI_NOR_CMD_RDID, 0xFF, 0xFF, 0xFF}, au8Id[4];
+
+    psDev->spi = spi;
+    psDev->u8Busy = 0;
+    psDev->u32Size = 0;
+    psDev->u32PollMax = SPI_NOR_POLL_MAX;
+    psDev->u32EraseNext = 0;
+    psDev->u32EraseEnd = 0;
+    psDev->u32BlankStart = 0;
+    psDev->u32BlankEnd = 0;
+    psDev->pu8Cache = NULL;
+    psDev->u32CacheAddr = SPI_NOR_NO_SECTOR;
+    psDev->u8CacheValid = 0;
+    psDev->u8CacheDirty = 0;
+    psDev->u32DummyTx = 0xFFFFFFFFUL;
+    psDev->u32PagePrograms = 0;
+    psDev->u32Erases = 0;
+    psDev->u32AheadErases = 0;
+    psDev->u32Polls = 0;
+    psDev->u32Flushes = 0;
+
+    if ((u32TxCh < PDMA_CH_MAX) && (u32RxCh < PDMA_CH_MAX) && (u32TxCh != u32RxCh))
+    {
+        PDMA_Open((1UL << u32TxCh) | (1UL << u32RxCh));
+        psDev->u32TxCh = u32TxCh;
+        psDev->u32RxCh = u32RxCh;
+    }
+    else
+    {
+        psDev->u32TxCh = SPI_NOR_NO_PDMA;
+        psDev->u32RxCh = SPI_NOR_NO_PDMA;
+    }
+
+    SPI_DisableAutoSS(spi);
+    SPI_SET_SS_HIGH(spi);
+
+    /* 16 bytes clocked while deselected cover tRES1 of 3 us at bus clocks up to 24 MHz */
+    SPI_NOR_Cmd(psDev, SPI_NOR_CMD_RDP, 0, 1);
+    SPI_NOR_Deselect(psDev);
+    SPI_NOR_Fifo(psDev, NULL, NULL, 16);
+
+    SPI_NOR_Select(psDev);
+    SPI_NOR_Fifo(psDev, au8Cmd, au8Id, 4);
+    SPI_NOR_Deselect(psDev);
+
+    psDev->au8Id[0] = au8Id[1];
+    psDev->au8Id[1] = au8Id[2];
+    psDev->au8Id[2] = au8Id[3];
+
+    if ((au8Id[1] == 0x00) || (au8Id[1] == 0xFF) || (au8Id[3] < 0x10) || (au8Id[3] > 0x18))
+        return SPI_NOR_ERR_ID;
+
+    psDev->u32Size = 1UL << au8Id[3];
+
+    return 0;
+}
+
+/**
+  * @brief      Read from the flash
+  *
+  * @param[in]  psDev       The pointer of the device context.
+  * @param[in]  u32Addr     Flash address.
+  * @param[out] pu8Buf      Buffer for the data.
+  * @param[in]  u32Len      Number of bytes.
+  *
+  * @retval     0                   Success
+  * @retval     SPI_NOR_ERR_RANGE   Access beyond the end of the device
+  * @retval     SPI_NOR_ERR_BUSY    Previous program or erase did not end
+  */
+int32_t SPI_NOR_Read(S_SPI_NOR_T *psDev, uint32_t u32Addr, uint8_t *pu8Buf, uint32_t u32Len)
+{
+    S_SPI_NOR_SG_T sSg;
+
+    sSg.pu8Buf = pu8Buf;
+    sSg.u32Len = u32Len;
+
+    return SPI_NOR_ReadSG(psDev, u32Addr, &sSg, 1);
+}
+
+/**
+  * @brief      Read consecutive flash bytes into several buffers
+  *
+  * @param[in]  psDev       The pointer of the device context.
+  * @param[in]  u32Addr     Flash address.
+  * @param[in]  psSg        Buffers in flash order, a NULL buffer skips its bytes.
+  * @param[in]  u32Num      Number of buffers.
+  *
+  * @retval     0                   Success
+  * @retval     SPI_NOR_ERR_RANGE   Access beyond the end of the device
+  * @retval     SPI_NOR_ERR_BUSY    Previous program or erase did not end
+  *
+  * @details    All buffers are filled by one fast read command. With PDMA the RX channel follows a scatter-gather
+  *             table, so a header and a payload could land in different buffers without a gap on the bus.
+  *             Reads shorter than \ref SPI_NOR_PDMA_MIN bytes are moved by the CPU.
+  */
+int32_t SPI_NOR_ReadSG(S_SPI_NOR_T *psDev, uint32_t u32Addr, const S_SPI_NOR_SG_T *psSg, uint32_t u32Num)
+{
+    uint32_t i, u32Len = 0;
+    int32_t i32Ret;
+
+    for (i = 0; i < u32Num; i++)
+        u32Len += psSg[i].u32Len;
+
+    if ((u32Addr > psDev->u32Size) || (u32Len > (psDev->u32Size - u32Addr)))
+        return SPI_NOR_ERR_RANGE;
+
+    if (u32Len == 0)
+        return 0;
+
+    i32Ret = SPI_NOR_WaitReady(psDev, psDev->u32PollMax);
+
+    if (i32Ret != 0)
+        return i32Ret;
+
+    SPI_NOR_Cmd(psDev, SPI_NOR_CMD_FAST_READ, u32Addr, 5);
+
+    if ((psDev->u32RxCh != SPI_NOR_NO_PDMA) && (u32Len >= SPI_NOR_PDMA_MIN))
+        SPI_NOR_ReadData(psDev, psSg, u32Num);
+    else
+    {
+        for (i = 0; i < u32Num; i++)
+            SPI_NOR_Fifo(psDev, NULL, psSg[i].pu8Buf, psSg[i].u32Len);
+    }
+
+    SPI_NOR_Deselect(psDev);
+
+    return 0;
+}
+
+/**
+  * @brief      Program erased flash
+  *
+  * @param[in]  psDev       The pointer of the device context.
+  * @param[in]  u32Addr     Flash address.
+  * @param[in]  pu8Data     Data to program.
+  * @param[in]  u32Len      Number of bytes.
+  *
+  * @retval     0                   Success
+  * @retval     SPI_NOR_ERR_RANGE   Access beyond the end of the device
+  * @retval     SPI_NOR_ERR_BUSY    A program or erase did not end
+  *
+  * @details    Data is split on page boundaries so each page takes one page program command. Sectors of the
+  *             range still in the erase-ahead queue are erased first. This API returns while the last page
+  *             is programmed, the next access or \ref SPI_NOR_Sync waits for it.
+  */
+int32_t SPI_NOR_Write(S_SPI_NOR_T *psDev, uint32_t u32Addr, const uint8_t *pu8Data, uint32_t u32Len)
+{
+    uint32_t u32Len1;
+    int32_t i32Ret;
+
+    if ((u32Addr > psDev->u32Size) || (u32Len > (psDev->u32Size - u32Addr)))
+        return SPI_NOR_ERR_RANGE;
+
+    i32Ret = SPI_NOR_EraseUntil(psDev, u32Addr, u32Len);
+
+    if (i32Ret != 0)
+        return i32Ret;
+
+    SPI_NOR_MarkWritten(psDev, u32Addr, u32Len);
+
+    while (u32Len != 0)
+    {
+        /* A page program wraps inside the page */
+        u32Len1 = SPI_NOR_PAGE_SIZE - (u32Addr & (SPI_NOR_PAGE_SIZE - 1UL));
+
+        if (u32Len1 > u32Len)
+            u32Len1 = u32Len;
+
+        i32Ret = SPI_NOR_WaitReady(psDev, psDev->u32PollMax);
+
+        if (i32Ret != 0)
+            return i32Ret;
+
+        SPI_NOR_WriteEnable(psDev);
+        SPI_NOR_Cmd(psDev, SPI_NOR_CMD_PP, u32Addr, 4);
+        SPI_NOR_WriteData(psDev, pu8Data, u32Len1);
+        SPI_NOR_Deselect(psDev);
+
+        psDev->u8Busy = 1;
+        psDev->u32PagePrograms++;
+
+        u32Addr += u32Len1;
+        pu8Data += u32Len1;
+        u32Len -= u32Len1;
+    }
+
+    return 0;
+}
+
+/**
+  * @brief      Erase flash now
+  *
+  * @param[in]  psDev       The pointer of the device context.
+  * @param[in]  u32Addr     Flash address, a multiple of \ref SPI_NOR_SECTOR_SIZE.
+  * @param[in]  u32Len      Number of bytes, a multiple of \ref SPI_NOR_SECTOR_SIZE.
+  *
+  * @retval     0                   Success
+  * @retval     SPI_NOR_ERR_RANGE   Access beyond the end of the device
+  * @retval     SPI_NOR_ERR_ALIGN   Range is not sector aligned
+  * @retval     SPI_NOR_ERR_BUSY    A program or erase did not end
+  *
+  * @details    Aligned 64 KB parts take one block erase, the rest one sector erase per 4 KB.
+  *             This API returns while the last erase is running.
+  */
+int32_t SPI_NOR_Erase(S_SPI_NOR_T *psDev, uint32_t u32Addr, uint32_t u32Len)
+{
+    uint32_t u32Len1;
+    int32_t i32Ret;
+
+    if ((u32Addr > psDev->u32Size) || (u32Len > (psDev->u32Size - u32Addr)))
+        return SPI_NOR_ERR_RANGE;
+
+    if (((u32Addr | u32Len) & (SPI_NOR_SECTOR_SIZE - 1UL)) != 0)
+        return SPI_NOR_ERR_ALIGN;
+
+    while (u32Len != 0)
+    {
+        u32Len1 = (((u32Addr & (SPI_NOR_BLOCK64_SIZE - 1UL)) == 0) && (u32Len >= SPI_NOR_BLOCK64_SIZE)) ?
+                  SPI_NOR_BLOCK64_SIZE : SPI_NOR_SECTOR_SIZE;
+
+        i32Ret = SPI_NOR_EraseCmd(psDev, u32Addr, u32Len1);
+
+        if (i32Ret != 0)
+            return i32Ret;
+
+        u32Addr += u32Len1;
+        u32Len -= u32Len1;
+    }
+
+    return 0;
+}
+
+/**
+  * @brief      Queue flash for erase in the background
+  *
+  * @param[in]  psDev       The pointer of the device context.
+  * @param[in]  u32Addr     Flash address, a multiple of \ref SPI_NOR_SECTOR_SIZE.
+  * @param[in]  u32Len      Number of bytes, a multiple of \ref SPI_NOR_SECTOR_SIZE.
+  *
+  * @retval     0                   Success
+  * @retval     SPI_NOR_ERR_RANGE   Access beyond the end of the device
+  * @retval     SPI_NOR_ERR_ALIGN   Range is not sector aligned
+  * @retval     SPI_NOR_ERR_BUSY    A program or erase did not end
+  *
+  * @details    The content of the range is given up. \ref SPI_NOR_Poll erases one sector whenever the device
+  *             is idle, so reads and writes elsewhere wait for one sector erase at most. A write into a sector
+  *             still in the queue erases the queue up to that sector first. A range that does not follow
+  *             the queued one finishes the queue before it starts.
+  */
+int32_t SPI_NOR_EraseAhead(S_SPI_NOR_T *psDev, uint32_t u32Addr, uint32_t u32Len)
+{
+    int32_t i32Ret;
+
+    if ((u32Addr > psDev->u32Size) || (u32Len > (psDev->u32Size - u32Addr)))
+        return SPI_NOR_ERR_RANGE;
+
+    if (((u32Addr | u32Len) & (SPI_NOR_SECTOR_SIZE - 1UL)) != 0)
+        return SPI_NOR_ERR_ALIGN;
+
+    if ((psDev->u32EraseNext < psDev->u32EraseEnd) && (u32Addr != psDev->u32EraseEnd))
+    {
+        i32Ret = SPI_NOR_EraseUntil(psDev, 0, psDev->u32Size);
+
+        if (i32Ret != 0)
+            return i32Ret;
+    }
+
+    if (psDev->u32EraseNext >= psDev->u32EraseEnd)
+        psDev->u32EraseNext = u32Addr;
+
+    psDev->u32EraseEnd = u32Addr + u32Len;
+
+    SPI_NOR_Poll(psDev);
+
+    return 0;
+}
+
+/**
+  * @brief      Run the erase-ahead queue
+  *
+  * @param[in]  psDev       The pointer of the device context.
+  *
+  * @return     Bytes still queued for erase
+  *
+  * @details    Call it from the main loop or a software timer. It reads the status register once and
+  *             starts the next sector erase if the device is idle, it never waits.
+  */
+uint32_t SPI_NOR_Poll(S_SPI_NOR_T *psDev)
+{
+    if (psDev->u32EraseNext >= psDev->u32EraseEnd)
+        return 0;
+
+    if (SPI_NOR_WaitReady(psDev, 1) == 0)
+        SPI_NOR_EraseStep(psDev);
+
+    return psDev->u32EraseEnd - psDev->u32EraseNext;
+}
+
+/**
+  * @brief      Wait for the last program or erase
+  *
+  * @param[in]  psDev       The pointer of the device context.
+  *
+  * @retval     0                   Data is stored
+  * @retval     SPI_NOR_ERR_BUSY    The program or erase did not end
+  *
+  * @details    Sectors still in the erase-ahead queue are left to \ref SPI_NOR_Poll.
+  */
+int32_t SPI_NOR_Sync(S_SPI_NOR_T *psDev)
+{
+    return SPI_NOR_WaitReady(psDev, psDev->u32PollMax);
+}
+
+/**
+  * @brief      Get the block device interface of the flash
+  *
+  * @param[in]  psDev        The pointer of the device context.
+  * @param[out] psBlk        Block device with \ref SPI_NOR_BLOCK_SIZE bytes blocks.
+  * @param[in]  pu8SectorBuf Buffer of \ref SPI_NOR_SECTOR_SIZE bytes for the write-behind sector.
+  *
+  * @return     None
+  *
+  * @details    Written blocks are collected in the sector buffer and reach the flash when a block of another
+  *             sector is written or at \ref BLKDEV_SYNC. The sector is then read for the blocks not written,
+  *             erased and programmed, unless it is known to be erased, for example by \ref SPI_NOR_EraseAhead.
+  *             Do not mix block device writes with \ref SPI_NOR_Write or \ref SPI_NOR_Erase on the same sectors.
+  */
+void SPI_NOR_GetBlockDev(S_SPI_NOR_T *psDev, S_BLKDEV_T *psBlk, uint8_t *pu8SectorBuf)
+{
+    psDev->pu8Cache = pu8SectorBuf;
+    psDev->u32CacheAddr = SPI_NOR_NO_SECTOR;
+    psDev->u8CacheValid = 0;
+    psDev->u8CacheDirty = 0;
+
+    psBlk->pvDev = psDev;
+    psBlk->u32BlockSize = SPI_NOR_BLOCK_SIZE;
+    psBlk->u32BlockNum = psDev->u32Size / SPI_NOR_BLOCK_SIZE;
+    psBlk->pfnRead = SPI_NOR_BlkRead;
+    psBlk->pfnWrite = SPI_NOR_BlkWrite;
+    psBlk->pfnSync = SPI_NOR_BlkSync;
+}
+
+/*@}*/ /* end of group SPI_NOR_EXPORTED_FUNCTIONS */
+
+/*@}*/ /* end of group SPI_NOR_Driver */
+
+/*@}*/ /* end of group Standard_Driver */
+
+/*** (C) COPYRIGHT 2021 Nuvoton Technology Corp. ***/
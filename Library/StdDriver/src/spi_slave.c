@@ -0,0 +1,492 @@
+/**************************************************************************//**
+ * @file     spi_slave.c
+ * @version  V1.00
+ * @brief    NUC121 series SPI slave stream source file
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * @copyright (C) 2021 Nuvoton Technology Corp. All rights reserved.
+*****************************************************************************/
+#include <string.h>
+#include "NuMicro.h"
+
+/** @addtogroup Standard_Driver Standard Driver
+  @{
+*/
+
+/** @addtogroup SPI_SLAVE_Driver SPI_SLAVE Driver
+  @{
+*/
+
+/// @cond HIDDEN_SYMBOLS
+
+#define SPI_SLAVE_INT_MASK      (SPI_SSINACT_INT_MASK | SPI_TXUF_INT_MASK | SPI_FIFO_RXOV_INT_MASK)
+
+/* Frames from the application offset to the end of the ring, u32Frames at most */
+static uint32_t SPI_SLAVE_Span(S_SPI_SLAVE_T *psSlave, S_SPI_SLAVE_RING_T *psRing, uint32_t u32Frames)
+{
+    uint32_t u32Len = psSlave->u32RingFrames - psRing->u32Off;
+
+    return (u32Len > u32Frames) ? u32Frames : u32Len;
+}
+
+static void SPI_SLAVE_Advance(S_SPI_SLAVE_T *psSlave, S_SPI_SLAVE_RING_T *psRing, uint32_t u32Len)
+{
+    psRing->u32Off += u32Len;
+
+    if (psRing->u32Off == psSlave->u32RingFrames)
+        psRing->u32Off = 0;
+}
+
+/* Copy frames of the application into the ring at the application offset */
+static void SPI_SLAVE_CopyIn(S_SPI_SLAVE_T *psSlave, S_SPI_SLAVE_RING_T *psRing, const uint8_t *pu8Data, uint32_t u32Frames)
+{
+    uint32_t u32Len, u32Shift = psSlave->u32FrameShift;
+
+    while (u32Frames != 0)
+    {
+        u32Len = SPI_SLAVE_Span(psSlave, psRing, u32Frames);
+        memcpy(&psRing->pu8Ring[psRing->u32Off << u32Shift], pu8Data, u32Len << u32Shift);
+        pu8Data += u32Len << u32Shift;
+        u32Frames -= u32Len;
+        SPI_SLAVE_Advance(psSlave, psRing, u32Len);
+    }
+}
+
+/* Copy frames of the ring at the application offset out to the application */
+static void SPI_SLAVE_CopyOut(S_SPI_SLAVE_T *psSlave, S_SPI_SLAVE_RING_T *psRing, uint8_t *pu8Data, uint32_t u32Frames)
+{
+    uint32_t u32Len, u32Shift = psSlave->u32FrameShift;
+
+    while (u32Frames != 0)
+    {
+        u32Len = SPI_SLAVE_Span(psSlave, psRing, u32Frames);
+        memcpy(pu8Data, &psRing->pu8Ring[psRing->u32Off << u32Shift], u32Len << u32Shift);
+        pu8Data += u32Len << u32Shift;
+        u32Frames -= u32Len;
+        SPI_SLAVE_Advance(psSlave, psRing, u32Len);
+    }
+}
+
+/* The PDMA writes back the descriptor it finished, rearm it for the next lap */
+static uint32_t SPI_SLAVE_NextSeg(S_SPI_SLAVE_T *psSlave, S_SPI_SLAVE_RING_T *psRing)
+{
+    uint32_t u32Done = psRing->u32Seg;
+
+    psRing->asDesc[u32Done].CTL = psRing->u32DescCtl;
+    psRing->u32Seg = (u32Done + 1UL == psSlave->u32SegNum) ? 0 : (u32Done + 1UL);
+    psRing->u32HwFrames += psSlave->u32SegFrames;
+
+    return u32Done;
+}
+
+/* TX segment sent: idle goes where nothing new is written, a writer left behind restarts at the PDMA */
+static void SPI_SLAVE_TxSeg(S_SPI_SLAVE_T *psSlave)
+{
+    S_SPI_SLAVE_RING_T *psRing = &psSlave->sTx;
+    uint32_t u32Seg = psSlave->u32SegFrames;
+    uint32_t u32Done = SPI_SLAVE_NextSeg(psSlave, psRing);
+    int32_t i32Level = (int32_t)(psRing->u32AppFrames - psRing->u32HwFrames);
+    uint32_t u32Last = psSlave->u32RingFrames - u32Seg;
+    uint32_t u32From = (i32Level > (int32_t)u32Last) ? (uint32_t)i32Level : u32Last;
+
+    if (u32From < psSlave->u32RingFrames)
+        memset(&psRing->pu8Ring[(u32Done * u32Seg + u32From - u32Last) << psSlave->u32FrameShift], SPI_SLAVE_IDLE_BYTE,
+               (psSlave->u32RingFrames - u32From) << psSlave->u32FrameShift);
+
+    if (i32Level < 0)
+    {
+        psSlave->u32TxUnderruns++;
+        psRing->u32AppFrames = psRing->u32HwFrames;
+        psRing->u32Off = psRing->u32Seg * u32Seg;
+    }
+}
+
+/* RX segment filled: drop the oldest segment if the PDMA starts to fill it again */
+static void SPI_SLAVE_RxSeg(S_SPI_SLAVE_T *psSlave)
+{
+    S_SPI_SLAVE_RING_T *psRing = &psSlave->sRx;
+    uint32_t u32Seg = psSlave->u32SegFrames, u32Oldest;
+
+    SPI_SLAVE_NextSeg(psSlave, psRing);
+
+    if ((psRing->u32HwFrames + u32Seg - psRing->u32AppFrames) > psSlave->u32RingFrames)
+    {
+        psSlave->u32RxOverruns++;
+        u32Oldest = (psRing->u32Seg + 1UL == psSlave->u32SegNum) ? 0 : (psRing->u32Seg + 1UL);
+        psRing->u32AppFrames = psRing->u32HwFrames + u32Seg - psSlave->u32RingFrames;
+        psRing->u32Off = u32Oldest * u32Seg;
+    }
+}
+
+static uint32_t SPI_SLAVE_Service(S_SPI_SLAVE_T *psSlave, S_SPI_SLAVE_RING_T *psRing)
+{
+    if ((PDMA_GET_TD_STS() & (1UL << psRing->u32PdmaCh)) == 0)
+        return 0;
+
+    PDMA_CLR_TD_FLAG(1UL << psRing->u32PdmaCh);
+
+    if (psRing == &psSlave->sTx)
+        SPI_SLAVE_TxSeg(psSlave);
+    else
+        SPI_SLAVE_RxSeg(psSlave);
+
+    return 1;
+}
+
+/* Frames of the current segment already moved, the channel counts down after every frame.
+   Called with interrupts masked, a segment that ends meanwhile is accounted first. */
+static uint32_t SPI_SLAVE_Live(S_SPI_SLAVE_T *psSlave, S_SPI_SLAVE_RING_T *psRing)
+{
+    uint32_t u32Left;
+
+    if (psSlave->u8Running == 0)
+        return 0;
+
+    do
+    {
+        SPI_SLAVE_Service(psSlave, psRing);
+        u32Left = ((PDMA->DSCT[psRing->u32PdmaCh].CTL & PDMA_DSCT_CTL_TXCNT_Msk) >> PDMA_DSCT_CTL_TXCNT_Pos) + 1UL;
+    }
+    while (PDMA_GET_TD_STS() & (1UL << psRing->u32PdmaCh));
+
+    return (u32Left < psSlave->u32SegFrames) ? (psSlave->u32SegFrames - u32Left) : 0;
+}
+
+static void SPI_SLAVE_InitRing(S_SPI_SLAVE_T *psSlave, S_SPI_SLAVE_RING_T *psRing, uint32_t u32PdmaCh, void *pvRing,
+                               uint32_t u32Width, uint32_t u32Tx)
+{
+    SPI_T *spi = psSlave->spi;
+    uint32_t i, u32Seg;
+
+    psRing->pu8Ring = (uint8_t *)pvRing;
+    psRing->u32PdmaCh = u32PdmaCh;
+    psRing->u32Seg = 0;
+    psRing->u32Off = 0;
+    psRing->u32HwFrames = 0;
+    psRing->u32AppFrames = 0;
+    psRing->u32DescCtl = ((psSlave->u32SegFrames - 1UL) << PDMA_DSCT_CTL_TXCNT_Pos) | u32Width | PDMA_REQ_SINGLE |
+                         PDMA_OP_SCATTER | (u32Tx ? (PDMA_SAR_INC | PDMA_DAR_FIX) : (PDMA_SAR_FIX | PDMA_DAR_INC));
+
+    for (i = 0; i < psSlave->u32SegNum; i++)
+    {
+        u32Seg = (uint32_t)&psRing->pu8Ring[(i * psSlave->u32SegFrames) << psSlave->u32FrameShift];
+        psRing->asDesc[i].CTL = psRing->u32DescCtl;
+        psRing->asDesc[i].SA = u32Tx ? u32Seg : (uint32_t)&spi->RX;
+        psRing->asDesc[i].DA = u32Tx ? (uint32_t)&spi->TX : u32Seg;
+        psRing->asDesc[i].FIRST = (uint32_t)&psRing->asDesc[(i + 1UL) % psSlave->u32SegNum] - PDMA->SCATBA;
+    }
+}
+
+/// @endcond HIDDEN_SYMBOLS
+
+/** @addtogroup SPI_SLAVE_EXPORTED_FUNCTIONS SPI_SLAVE Exported Functions
+  @{
+*/
+
+/**
+  * @brief      Set up PDMA fed TX and RX rings for an SPI slave
+  *
+  * @param[in]  psSlave         The pointer of the slave context.
+  * @param[in]  spi             SPI0 opened by \ref SPI_Open as \ref SPI_SLAVE with 8, 16 or 32-bit frames.
+  * @param[in]  u32TxCh         PDMA channel of the TX ring.
+  * @param[in]  u32RxCh         PDMA channel of the RX ring.
+  * @param[in]  pvTxRing        TX ring of u32SegFrames * u32SegNum frames.
+  * @param[in]  pvRxRing        RX ring of the same size.
+  * @param[in]  u32SegFrames    Frames of one segment, \ref SPI_SLAVE_TX_MARGIN up to 16384.
+  * @param[in]  u32SegNum       Segments in each ring, 2 up to \ref SPI_SLAVE_SEG_MAX.
+  *
+  * @retval     0               Success
+  * @retval     -1              Invalid argument or frame width
+  *
+  * @details    Both rings are circular descriptor lists, so the PDMA keeps the 4-level FIFOs served at any
+  *             bus rate the PDMA can follow, without an interrupt per frame. The FIFO thresholds do not
+  *             matter here because the PDMA is requested at every free or filled FIFO level.
+  */
+int32_t SPI_SLAVE_Open(S_SPI_SLAVE_T *psSlave, SPI_T *spi, uint32_t u32TxCh, uint32_t u32RxCh,
+                       void *pvTxRing, void *pvRxRing, uint32_t u32SegFrames, uint32_t u32SegNum)
+{
+    uint32_t u32Bits = (spi->CTL & SPI_CTL_DWIDTH_Msk) >> SPI_CTL_DWIDTH_Pos, u32Width;
+
+    if ((u32TxCh >= PDMA_CH_MAX) || (u32RxCh >= PDMA_CH_MAX) || (u32TxCh == u32RxCh) || (u32SegNum < 2) ||
+            (u32SegNum > SPI_SLAVE_SEG_MAX) || (u32SegFrames < SPI_SLAVE_TX_MARGIN) || (u32SegFrames > 0x4000UL))
+        return -1;
+
+    if (u32Bits == 8)
+    {
+        psSlave->u32FrameShift = 0;
+        u32Width = PDMA_WIDTH_8;
+    }
+    else if (u32Bits == 16)
+    {
+        psSlave->u32FrameShift = 1;
+        u32Width = PDMA_WIDTH_16;
+    }
+    else if (u32Bits == 0)
+    {
+        psSlave->u32FrameShift = 2;
+        u32Width = PDMA_WIDTH_32;
+    }
+    else
+        return -1;
+
+    psSlave->spi = spi;
+    psSlave->u32SegFrames = u32SegFrames;
+    psSlave->u32SegNum = u32SegNum;
+    psSlave->u32RingFrames = u32SegFrames * u32SegNum;
+    psSlave->u8Running = 0;
+    psSlave->pfnInactive = NULL;
+    psSlave->pvArg = NULL;
+    psSlave->u32Bursts = 0;
+    psSlave->u32TxUnderruns = 0;
+    psSlave->u32RxOverruns = 0;
+    psSlave->u32FifoUnderruns = 0;
+    psSlave->u32FifoOverruns = 0;
+
+    SPI_SLAVE_InitRing(psSlave, &psSlave->sTx, u32TxCh, pvTxRing, u32Width, 1);
+    SPI_SLAVE_InitRing(psSlave, &psSlave->sRx, u32RxCh, pvRxRing, u32Width, 0);
+    memset(pvTxRing, SPI_SLAVE_IDLE_BYTE, psSlave->u32RingFrames << psSlave->u32FrameShift);
+
+    PDMA_Open((1UL << u32TxCh) | (1UL << u32RxCh));
+
+    return 0;
+}
+
+/**
+  * @brief      Install the slave select inactive callback
+  *
+  * @param[in]  psSlave     The pointer of the slave context.
+  * @param[in]  pfnInactive Called in interrupt context at the end of each burst, could be NULL.
+  * @param[in]  pvArg       Argument kept for the callback.
+  *
+  * @return     None
+  */
+void SPI_SLAVE_SetCallback(S_SPI_SLAVE_T *psSlave, SPI_SLAVE_CB pfnInactive, void *pvArg)
+{
+    psSlave->pvArg = pvArg;
+    psSlave->pfnInactive = pfnInactive;
+}
+
+/**
+  * @brief      Start both PDMA rings
+  *
+  * @param[in]  psSlave     The pointer of the slave context.
+  *
+  * @return     None
+  *
+  * @details    Write the first reply with \ref SPI_SLAVE_Write before the start, the TX PDMA fills the FIFO at
+  *             once. PDMA_IRQn must call \ref SPI_SLAVE_PDMAHandler and SPI0_IRQn \ref SPI_SLAVE_IRQHandler.
+  */
+void SPI_SLAVE_Start(S_SPI_SLAVE_T *psSlave)
+{
+    SPI_T *spi = psSlave->spi;
+
+    SPI_ClearRxFIFO(spi);
+    SPI_ClearTxFIFO(spi);
+    SPI_ClearIntFlag(spi, SPI_SLAVE_INT_MASK);
+
+    PDMA_SetTransferMode(psSlave->sTx.u32PdmaCh, PDMA_SPI0_TX, TRUE, (uint32_t)&psSlave->sTx.asDesc[0]);
+    PDMA_SetTransferMode(psSlave->sRx.u32PdmaCh, PDMA_SPI0_RX, TRUE, (uint32_t)&psSlave->sRx.asDesc[0]);
+    PDMA_EnableInt(psSlave->sTx.u32PdmaCh, PDMA_INT_TRANS_DONE);
+    PDMA_EnableInt(psSlave->sRx.u32PdmaCh, PDMA_INT_TRANS_DONE);
+
+    psSlave->u8Running = 1;
+    SPI_EnableInt(spi, SPI_SLAVE_INT_MASK);
+    SPI_TRIGGER_RX_PDMA(spi);
+    SPI_TRIGGER_TX_PDMA(spi);
+}
+
+/**
+  * @brief      Stop both PDMA rings
+  *
+  * @param[in]  psSlave     The pointer of the slave context.
+  *
+  * @return     None
+  *
+  * @details    Call \ref SPI_SLAVE_Open again before the next start.
+  */
+void SPI_SLAVE_Stop(S_SPI_SLAVE_T *psSlave)
+{
+    SPI_T *spi = psSlave->spi;
+
+    spi->PDMACTL &= ~(SPI_PDMACTL_TXPDMAEN_Msk | SPI_PDMACTL_RXPDMAEN_Msk);
+    SPI_DisableInt(spi, SPI_SLAVE_INT_MASK);
+    PDMA_DisableInt(psSlave->sTx.u32PdmaCh, PDMA_INT_TRANS_DONE);
+    PDMA_DisableInt(psSlave->sRx.u32PdmaCh, PDMA_INT_TRANS_DONE);
+    PDMA->DSCT[psSlave->sTx.u32PdmaCh].CTL = PDMA_OP_IDLE;
+    PDMA->DSCT[psSlave->sRx.u32PdmaCh].CTL = PDMA_OP_IDLE;
+    PDMA_CLR_TD_FLAG((1UL << psSlave->sTx.u32PdmaCh) | (1UL << psSlave->sRx.u32PdmaCh));
+    psSlave->u8Running = 0;
+}
+
+/**
+  * @brief      Queue frames for the master
+  *
+  * @param[in]  psSlave     The pointer of the slave context.
+  * @param[in]  pvData      Frames, uint8_t, uint16_t or uint32_t as the frame width.
+  * @param[in]  u32Frames   Number of frames.
+  *
+  * @return     Frames taken, less than u32Frames if the ring is full
+  *
+  * @details    If the master has clocked out everything written, idle bytes were sent and the new frames
+  *             follow the frames the PDMA has already fetched. Interrupts are masked while copying.
+  */
+uint32_t SPI_SLAVE_Write(S_SPI_SLAVE_T *psSlave, const void *pvData, uint32_t u32Frames)
+{
+    S_SPI_SLAVE_RING_T *psRing = &psSlave->sTx;
+    uint32_t u32Level, u32Live, u32Skip;
+    uint32_t u32PriMask = __get_PRIMASK();
+
+    __set_PRIMASK(1);
+
+    u32Level = psRing->u32AppFrames - psRing->u32HwFrames;
+
+    if (u32Level < (psSlave->u32SegFrames + SPI_SLAVE_TX_MARGIN))
+    {
+        u32Live = SPI_SLAVE_Live(psSlave, psRing);
+        u32Level = psRing->u32AppFrames - psRing->u32HwFrames;
+
+        if (psSlave->u8Running && (u32Level < (u32Live + SPI_SLAVE_TX_MARGIN)))
+        {
+            u32Skip = u32Live + SPI_SLAVE_TX_MARGIN - u32Level;
+            psSlave->u32TxUnderruns++;
+            psRing->u32AppFrames += u32Skip;
+            psRing->u32Off += u32Skip;
+
+            if (psRing->u32Off >= psSlave->u32RingFrames)
+                psRing->u32Off -= psSlave->u32RingFrames;
+
+            u32Level += u32Skip;
+        }
+    }
+
+    if (u32Frames > (psSlave->u32RingFrames - u32Level))
+        u32Frames = psSlave->u32RingFrames - u32Level;
+
+    SPI_SLAVE_CopyIn(psSlave, psRing, (const uint8_t *)pvData, u32Frames);
+    psRing->u32AppFrames += u32Frames;
+
+    __set_PRIMASK(u32PriMask);
+
+    return u32Frames;
+}
+
+/**
+  * @brief      Take frames received from the master
+  *
+  * @param[in]  psSlave     The pointer of the slave context.
+  * @param[out] pvData      Buffer for frames, uint8_t, uint16_t or uint32_t as the frame width.
+  * @param[in]  u32Frames   Number of frames wanted.
+  *
+  * @return     Frames stored
+  *
+  * @details    Frames of the segment in progress are returned too, so a short burst is readable as soon as
+  *             the slave select goes inactive.
+  */
+uint32_t SPI_SLAVE_Read(S_SPI_SLAVE_T *psSlave, void *pvData, uint32_t u32Frames)
+{
+    S_SPI_SLAVE_RING_T *psRing = &psSlave->sRx;
+    uint32_t u32Avail;
+    uint32_t u32PriMask = __get_PRIMASK();
+
+    __set_PRIMASK(1);
+
+    u32Avail = SPI_SLAVE_Live(psSlave, psRing);
+    u32Avail += psRing->u32HwFrames - psRing->u32AppFrames;
+
+    if (u32Frames > u32Avail)
+        u32Frames = u32Avail;
+
+    SPI_SLAVE_CopyOut(psSlave, psRing, (uint8_t *)pvData, u32Frames);
+    psRing->u32AppFrames += u32Frames;
+
+    __set_PRIMASK(u32PriMask);
+
+    return u32Frames;
+}
+
+/**
+  * @brief      Frames \ref SPI_SLAVE_Write could take now
+  *
+  * @param[in]  psSlave     The pointer of the slave context.
+  *
+  * @return     Number of frames
+  *
+  * @details    The segment the PDMA reads is counted as used until it ends.
+  */
+uint32_t SPI_SLAVE_GetTxFree(S_SPI_SLAVE_T *psSlave)
+{
+    return psSlave->u32RingFrames - (psSlave->sTx.u32AppFrames - psSlave->sTx.u32HwFrames);
+}
+
+/**
+  * @brief      Frames \ref SPI_SLAVE_Read could return now
+  *
+  * @param[in]  psSlave     The pointer of the slave context.
+  *
+  * @return     Number of frames
+  */
+uint32_t SPI_SLAVE_GetRxCount(S_SPI_SLAVE_T *psSlave)
+{
+    uint32_t u32Count;
+    uint32_t u32PriMask = __get_PRIMASK();
+
+    __set_PRIMASK(1);
+    u32Count = SPI_SLAVE_Live(psSlave, &psSlave->sRx);
+    u32Count += psSlave->sRx.u32HwFrames - psSlave->sRx.u32AppFrames;
+    __set_PRIMASK(u32PriMask);
+
+    return u32Count;
+}
+
+/**
+  * @brief      PDMA interrupt service of the slave rings
+  *
+  * @param[in]  psSlave     The pointer of the slave context.
+  *
+  * @return     None
+  *
+  * @details    Call it from PDMA_IRQHandler, channels of other users are left alone.
+  */
+void SPI_SLAVE_PDMAHandler(S_SPI_SLAVE_T *psSlave)
+{
+    SPI_SLAVE_Service(psSlave, &psSlave->sTx);
+    SPI_SLAVE_Service(psSlave, &psSlave->sRx);
+}
+
+/**
+  * @brief      SPI interrupt service of the slave
+  *
+  * @param[in]  psSlave     The pointer of the slave context.
+  *
+  * @return     None
+  *
+  * @details    Counts FIFO underruns and overruns and calls the callback when the slave select goes inactive.
+  */
+void SPI_SLAVE_IRQHandler(S_SPI_SLAVE_T *psSlave)
+{
+    uint32_t u32Flag = SPI_GetIntFlag(psSlave->spi, SPI_SLAVE_INT_MASK);
+
+    SPI_ClearIntFlag(psSlave->spi, u32Flag);
+
+    if (u32Flag & SPI_TXUF_INT_MASK)
+        psSlave->u32FifoUnderruns++;
+
+    if (u32Flag & SPI_FIFO_RXOV_INT_MASK)
+        psSlave->u32FifoOverruns++;
+
+    if (u32Flag & SPI_SSINACT_INT_MASK)
+    {
+        psSlave->u32Bursts++;
+
+        if (psSlave->pfnInactive != NULL)
+            psSlave->pfnInactive(psSlave);
+    }
+}
+
+/*@}*/ /* end of group SPI_SLAVE_EXPORTED_FUNCTIONS */
+
+/*@}*/ /* end of group SPI_SLAVE_Driver */
+
+/*@}*/ /* end of group Standard_Driver */
+
+/*** (C) COPYRIGHT 2021 Nuvoton Technology Corp. ***/
@@ -0,0 +1,289 @@
+/**************************************************************************//**
+ * @file     stkmon.c
+ * @version  V1.00
+ * @brief    NUC121 series stack and heap usage monitor source file
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * @copyright (C) 2021 Nuvoton Technology Corp. All rights reserved.
+*****************************************************************************/
+#include <stdio.h>
+#include "NuMicro.h"
+
+/** @addtogroup Standard_Driver Standard Driver
+  @{
+*/
+
+/** @addtogroup STKMON_Driver STKMON Driver
+  @{
+*/
+
+/// @cond HIDDEN_SYMBOLS
+
+/* Stack and heap bounds as each toolchain names them */
+#if defined ( __CC_ARM ) || (defined (__ARMCC_VERSION) && (__ARMCC_VERSION >= 6010050))
+
+/* Section symbols of the STACK and HEAP areas of startup_NUC121.s */
+extern uint32_t STACK$$Base;
+extern uint32_t STACK$$Limit;
+extern uint32_t HEAP$$Base;
+extern uint32_t HEAP$$Limit;
+
+#define STKMON_STACK_BASE       ((uint32_t)&STACK$$Base)
+#define STKMON_STACK_TOP        ((uint32_t)&STACK$$Limit)
+#define STKMON_HEAP_BASE        ((uint32_t)&HEAP$$Base)
+#define STKMON_HEAP_LIMIT       ((uint32_t)&HEAP$$Limit)
+
+#elif defined ( __ICCARM__ )
+
+#pragma section = "CSTACK"
+#pragma section = "HEAP"
+
+#define STKMON_STACK_BASE       ((uint32_t)__section_begin("CSTACK"))
+#define STKMON_STACK_TOP        ((uint32_t)__section_end("CSTACK"))
+#define STKMON_HEAP_BASE        ((uint32_t)__section_begin("HEAP"))
+#define STKMON_HEAP_LIMIT       ((uint32_t)__section_end("HEAP"))
+
+#else
+
+/* Symbols of startup_NUC121.S and gcc_arm.ld */
+extern uint32_t __StackLimit;
+extern uint32_t __StackTop;
+extern uint32_t __HeapBase;
+extern uint32_t __HeapLimit;
+
+#define STKMON_STACK_BASE       ((uint32_t)&__StackLimit)
+#define STKMON_STACK_TOP        ((uint32_t)&__StackTop)
+#define STKMON_HEAP_BASE        ((uint32_t)&__HeapBase)
+#define STKMON_HEAP_LIMIT       ((uint32_t)&__HeapLimit)
+
+#endif
+
+/* Lowest address an interrupt window is painted from, above the guard words */
+#define STKMON_ISR_FLOOR        (STKMON_STACK_BASE + (STKMON_GUARD_WORDS << 2))
+
+static uint16_t s_au16StkMonIsrPeak[STKMON_ISR_MAX];
+static uint32_t s_u32StkMonLow = 0xFFFFFFFFUL;  /* Deepest word an interrupt window was repainted over */
+
+static void STKMON_Fill(uint32_t u32Start, uint32_t u32End)
+{
+    uint32_t *pu32Word;
+
+    for (pu32Word = (uint32_t *)u32Start; pu32Word < (uint32_t *)u32End; pu32Word++)
+        *pu32Word = STKMON_PATTERN;
+}
+
+/* First word from u32Start up that is not paint, u32End if all are */
+static uint32_t STKMON_ScanUp(uint32_t u32Start, uint32_t u32End)
+{
+    const uint32_t *pu32Word = (const uint32_t *)u32Start;
+
+    while ((pu32Word < (const uint32_t *)u32End) && (*pu32Word == STKMON_PATTERN))
+        pu32Word++;
+
+    return (uint32_t)pu32Word;
+}
+
+/// @endcond HIDDEN_SYMBOLS
+
+
+/** @addtogroup STKMON_EXPORTED_FUNCTIONS STKMON Exported Functions
+  @{
+*/
+
+/**
+  * @brief      Paint the unused stack and the heap
+  *
+  * @return     None
+  *
+  * @details    Call first in main, before anything is allocated from the heap. The stack is painted from its limit
+  *             up to \ref STKMON_MARGIN words below the caller, the heap completely.
+  */
+void STKMON_Paint(void)
+{
+    uint32_t u32Sp = __get_MSP() - (STKMON_MARGIN << 2);
+
+    if (u32Sp > STKMON_STACK_BASE)
+        STKMON_Fill(STKMON_STACK_BASE, u32Sp);
+
+    s_u32StkMonLow = 0xFFFFFFFFUL;
+
+    STKMON_Fill(STKMON_HEAP_BASE, STKMON_HEAP_LIMIT);
+}
+
+/**
+  * @brief      Get the size of the main stack
+  *
+  * @return     Stack size in bytes
+  */
+uint32_t STKMON_GetStackSize(void)
+{
+    return (STKMON_STACK_TOP - STKMON_STACK_BASE);
+}
+
+/**
+  * @brief      Get the deepest stack use since \ref STKMON_Paint
+  *
+  * @return     High-water mark in bytes, including the interrupt handlers
+  *
+  * @details    Marks erased by the window of \ref STKMON_ISR_ENTER were recorded before and count too.
+  */
+uint32_t STKMON_GetStackPeak(void)
+{
+    uint32_t u32Low = STKMON_ScanUp(STKMON_STACK_BASE, STKMON_STACK_TOP);
+
+    if (u32Low > s_u32StkMonLow)
+        u32Low = s_u32StkMonLow;
+
+    return (STKMON_STACK_TOP - u32Low);
+}
+
+/**
+  * @brief      Get the size of the heap
+  *
+  * @return     Heap size in bytes
+  */
+uint32_t STKMON_GetHeapSize(void)
+{
+    return (STKMON_HEAP_LIMIT - STKMON_HEAP_BASE);
+}
+
+/**
+  * @brief      Get the highest heap address used since \ref STKMON_Paint
+  *
+  * @return     High-water mark in bytes from the heap base
+  *
+  * @details    Allocators grow the heap from its base, the words above the last one written are still paint.
+  */
+uint32_t STKMON_GetHeapPeak(void)
+{
+    const uint32_t *pu32Word = (const uint32_t *)STKMON_HEAP_LIMIT;
+
+    while ((pu32Word > (const uint32_t *)STKMON_HEAP_BASE) && (pu32Word[-1] == STKMON_PATTERN))
+        pu32Word--;
+
+    return ((uint32_t)pu32Word - STKMON_HEAP_BASE);
+}
+
+/**
+  * @brief      Check the guard words at the stack limit
+  *
+  * @retval     0                       Guard words are intact
+  * @retval     STKMON_ERR_OVERFLOW     Stack overflowed into the guard words
+  *
+  * @details    Cheap enough for the SysTick handler, \ref STKMON_GUARD_WORDS compares.
+  */
+int32_t STKMON_Check(void)
+{
+    const uint32_t *pu32Word = (const uint32_t *)STKMON_STACK_BASE;
+    uint32_t i;
+
+    for (i = 0; i < STKMON_GUARD_WORDS; i++)
+    {
+        if (pu32Word[i] != STKMON_PATTERN)
+            return STKMON_ERR_OVERFLOW;
+    }
+
+    return 0;
+}
+
+/**
+  * @brief      Paint the stack window of an interrupt handler
+  *
+  * @return     Stack pointer the depth is measured from
+  *
+  * @details    Use \ref STKMON_ISR_ENTER. The deepest mark in the window is recorded before it is painted over,
+  *             so \ref STKMON_GetStackPeak still sees the main stack and outer handler use it held.
+  */
+uint32_t STKMON_IsrEnter(void)
+{
+    uint32_t u32Sp = __get_MSP();
+    uint32_t *pu32Word = (uint32_t *)(u32Sp - (STKMON_ISR_WINDOW << 2));
+    uint32_t *pu32Mark;
+
+    if (((uint32_t)pu32Word < STKMON_ISR_FLOOR) || ((uint32_t)pu32Word > u32Sp))
+        pu32Word = (uint32_t *)STKMON_ISR_FLOOR;
+
+    /* Inline, a call would put its own frame into the window being scanned and painted */
+    pu32Mark = pu32Word;
+
+    while (((uint32_t)pu32Mark < u32Sp) && (*pu32Mark == STKMON_PATTERN))
+        pu32Mark++;
+
+    if ((uint32_t)pu32Mark < s_u32StkMonLow)
+        s_u32StkMonLow = (uint32_t)pu32Mark;
+
+    while ((uint32_t)pu32Word < u32Sp)
+        *pu32Word++ = STKMON_PATTERN;
+
+    return u32Sp;
+}
+
+/**
+  * @brief      Account the stack depth of an interrupt handler
+  *
+  * @param[in]  u32Id   Handler number, 0 to \ref STKMON_ISR_MAX - 1.
+  * @param[in]  u32Sp   Value returned by \ref STKMON_IsrEnter.
+  *
+  * @return     None
+  *
+  * @details    Use \ref STKMON_ISR_EXIT.
+  */
+void STKMON_IsrExit(uint32_t u32Id, uint32_t u32Sp)
+{
+    uint32_t u32Low = u32Sp - (STKMON_ISR_WINDOW << 2);
+    uint32_t u32Depth;
+
+    if ((u32Low < STKMON_ISR_FLOOR) || (u32Low > u32Sp))
+        u32Low = STKMON_ISR_FLOOR;
+
+    if ((u32Id >= STKMON_ISR_MAX) || (u32Low >= u32Sp))
+        return;
+
+    u32Depth = u32Sp - STKMON_ScanUp(u32Low, u32Sp);
+
+    if (u32Depth > s_au16StkMonIsrPeak[u32Id])
+        s_au16StkMonIsrPeak[u32Id] = (uint16_t)u32Depth;
+}
+
+/**
+  * @brief      Get the deepest stack use of an interrupt handler
+  *
+  * @param[in]  u32Id   Handler number, 0 to \ref STKMON_ISR_MAX - 1.
+  *
+  * @return     Bytes below the stack pointer at its entry, \ref STKMON_ISR_WINDOW words if the window was too small
+  */
+uint32_t STKMON_GetIsrPeak(uint32_t u32Id)
+{
+    return ((u32Id < STKMON_ISR_MAX) ? s_au16StkMonIsrPeak[u32Id] : 0UL);
+}
+
+/**
+  * @brief      Print stack and heap usage
+  *
+  * @return     None
+  *
+  * @details    Goes wherever printf goes. Interrupt handlers that were never measured are left out.
+  */
+void STKMON_Report(void)
+{
+    uint32_t i;
+
+    printf("Stack %u of %u bytes, guard %s\n", (unsigned int)STKMON_GetStackPeak(), (unsigned int)STKMON_GetStackSize(),
+           (STKMON_Check() == 0) ? "intact" : "OVERWRITTEN");
+    printf("Heap  %u of %u bytes\n", (unsigned int)STKMON_GetHeapPeak(), (unsigned int)STKMON_GetHeapSize());
+
+    for (i = 0; i < STKMON_ISR_MAX; i++)
+    {
+        if (s_au16StkMonIsrPeak[i] != 0)
+            printf("ISR %u %u bytes%s\n", (unsigned int)i, s_au16StkMonIsrPeak[i],
+                   (s_au16StkMonIsrPeak[i] >= (STKMON_ISR_WINDOW << 2)) ? " or more" : "");
+    }
+}
+
+/*@}*/ /* end of group STKMON_EXPORTED_FUNCTIONS */
+
+/*@}*/ /* end of group STKMON_Driver */
+
+/*@}*/ /* end of group Standard_Driver */
+
+/*** (C) COPYRIGHT 2021 Nuvoton Technology Corp. ***/
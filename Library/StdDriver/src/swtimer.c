@@ -0,0 +1,543 @@
+/**************************************************************************//**
+ * @file     swtimer.c
+ * @version  V1.00
+ * @brief    NUC121 series timebase and software timer driver source file
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * @copyright (C) 2021 Nuvoton Technology Corp. All rights reserved.
+*****************************************************************************/
+#include "NuMicro.h"
+
+/** @addtogroup Standard_Driver Standard Driver
+  @{
+*/
+
+/** @addtogroup SWTIMER_Driver SWTIMER Driver
+  @{
+*/
+
+/// @cond HIDDEN_SYMBOLS
+
+#define SWTIMER_WHEEL_SIZE      (1UL << SWTIMER_WHEEL_BITS)
+#define SWTIMER_WHEEL_MASK      (SWTIMER_WHEEL_SIZE - 1UL)
+#define SWTIMER_WHEEL_SPAN      (1UL << (SWTIMER_WHEEL_BITS * SWTIMER_WHEEL_LEVELS))
+#define SWTIMER_TICK_MASK       ((1UL << SWTIMER_TICK_SHIFT) - 1UL)
+#define SWTIMER_CNT_BITS        (24UL)
+#define SWTIMER_CNT_MASK        ((1UL << SWTIMER_CNT_BITS) - 1UL)
+/* The counter must be sampled at least once per 24-bit wrap, so never sleep longer than half of it */
+#define SWTIMER_GUARD_TICKS     ((1UL << (SWTIMER_CNT_BITS - 1UL)) >> SWTIMER_TICK_SHIFT)
+
+static TIMER_T *s_psSwTimer = NULL;
+static IRQn_Type s_eSwTimerIRQn;
+static uint32_t s_u32Wraps;         /* Number of 24-bit counter wrap-arounds */
+static uint32_t s_u32LastCnt;       /* Counter value of the last sample */
+static uint32_t s_u32WheelNow;      /* Next wheel tick to be processed */
+static uint32_t s_au32Pending[SWTIMER_WHEEL_LEVELS];
+static S_SWTIMER_T *s_apsSlot[SWTIMER_WHEEL_LEVELS][SWTIMER_WHEEL_SIZE];
+
+/* Extend the 24-bit counter to 32 bits. Must be called with interrupts disabled. */
+static uint32_t SWTIMER_Sync(void)
+{
+    uint32_t u32Cnt = s_psSwTimer->CNT & SWTIMER_CNT_MASK;
+
+    if (u32Cnt < s_u32LastCnt)
+        s_u32Wraps++;
+
+    s_u32LastCnt = u32Cnt;
+
+    return ((s_u32Wraps << SWTIMER_CNT_BITS) | u32Cnt);
+}
+
+/* Wheel tick of the last sample. Full 32-bit range, so tick arithmetic wraps cleanly. */
+static uint32_t SWTIMER_NowTick(void)
+{
+    return ((s_u32Wraps << (SWTIMER_CNT_BITS - SWTIMER_TICK_SHIFT)) | (s_u32LastCnt >> SWTIMER_TICK_SHIFT));
+}
+
+static void SWTIMER_Link(S_SWTIMER_T *psTimer)
+{
+    uint32_t u32Place = psTimer->u32Expire;
+    uint32_t u32Delta = u32Place - s_u32WheelNow;
+    uint32_t u32Level, u32Slot;
+
+    if ((int32_t)u32Delta < 0)
+    {
+        /* Already due: run on the next processed tick */
+        u32Delta = 0;
+        u32Place = s_u32WheelNow;
+    }
+    else if (u32Delta >= SWTIMER_WHEEL_SPAN)
+    {
+        /* Beyond the wheel: park in the farthest slot, it is re-cascaded from there */
+        u32Delta = SWTIMER_WHEEL_SPAN - 1UL;
+        u32Place = s_u32WheelNow + u32Delta;
+    }
+
+    for (u32Level = 0; u32Level < (SWTIMER_WHEEL_LEVELS - 1UL); u32Level++)
+    {
+        if (u32Delta < (1UL << (SWTIMER_WHEEL_BITS * (u32Level + 1UL))))
+            break;
+    }
+
+    u32Slot = (u32Place >> (SWTIMER_WHEEL_BITS * u32Level)) & SWTIMER_WHEEL_MASK;
+
+    psTimer->psNext = s_apsSlot[u32Level][u32Slot];
+
+    if (psTimer->psNext != NULL)
+        psTimer->psNext->ppsPrev = &psTimer->psNext;
+
+    s_apsSlot[u32Level][u32Slot] = psTimer;
+    psTimer->ppsPrev = &s_apsSlot[u32Level][u32Slot];
+    s_au32Pending[u32Level] |= (1UL << u32Slot);
+}
+
+static void SWTIMER_Unlink(S_SWTIMER_T *psTimer)
+{
+    S_SWTIMER_T **ppsPrev = psTimer->ppsPrev;
+    uint32_t u32Idx;
+
+    *ppsPrev = psTimer->psNext;
+
+    if (psTimer->psNext != NULL)
+    {
+        psTimer->psNext->ppsPrev = ppsPrev;
+    }
+    else if ((ppsPrev >= &s_apsSlot[0][0]) && (ppsPrev < &s_apsSlot[0][0] + (SWTIMER_WHEEL_LEVELS * SWTIMER_WHEEL_SIZE)))
+    {
+        /* Last timer of the slot was removed */
+        u32Idx = (uint32_t)(ppsPrev - &s_apsSlot[0][0]);
+        s_au32Pending[u32Idx >> SWTIMER_WHEEL_BITS] &= ~(1UL << (u32Idx & SWTIMER_WHEEL_MASK));
+    }
+
+    psTimer->ppsPrev = NULL;
+}
+
+static uint32_t SWTIMER_Cascade(uint32_t u32Level, uint32_t u32Slot)
+{
+    S_SWTIMER_T *psTimer = s_apsSlot[u32Level][u32Slot], *psNext;
+
+    s_apsSlot[u32Level][u32Slot] = NULL;
+    s_au32Pending[u32Level] &= ~(1UL << u32Slot);
+
+    while (psTimer != NULL)
+    {
+        psNext = psTimer->psNext;
+        SWTIMER_Link(psTimer);
+        psTimer = psNext;
+    }
+
+    return u32Slot;
+}
+
+/* Find the next wheel tick at which a timer expires or a slot is cascaded. */
+static int32_t SWTIMER_NextTick(uint32_t *pu32Tick)
+{
+    uint32_t u32Now = s_u32WheelNow;
+    uint32_t u32Level, u32Shift, u32Cur, u32Dist, u32Delta, u32Best = 0xFFFFFFFFUL;
+
+    for (u32Level = 0; u32Level < SWTIMER_WHEEL_LEVELS; u32Level++)
+    {
+        if (s_au32Pending[u32Level] == 0)
+            continue;
+
+        u32Shift = SWTIMER_WHEEL_BITS * u32Level;
+        u32Cur = (u32Now >> u32Shift) & SWTIMER_WHEEL_MASK;
+
+        for (u32Dist = 0; u32Dist < SWTIMER_WHEEL_SIZE; u32Dist++)
+        {
+            if ((s_au32Pending[u32Level] & (1UL << ((u32Cur + u32Dist) & SWTIMER_WHEEL_MASK))) == 0)
+                continue;
+
+            if (u32Level == 0)
+            {
+                u32Delta = u32Dist;
+            }
+            else if ((u32Dist == 0) && ((u32Now & ((1UL << u32Shift) - 1UL)) != 0))
+            {
+                /* Current slot was cascaded already, its next turn is a full round later */
+                u32Delta = ((((u32Now >> u32Shift) + SWTIMER_WHEEL_SIZE) << u32Shift) - u32Now);
+
+                if (u32Delta < u32Best)
+                    u32Best = u32Delta;
+
+                continue;
+            }
+            else
+            {
+                u32Delta = ((((u32Now >> u32Shift) + u32Dist) << u32Shift) - u32Now);
+            }
+
+            if (u32Delta < u32Best)
+                u32Best = u32Delta;
+
+            break;
+        }
+    }
+
+    if (u32Best == 0xFFFFFFFFUL)
+        return 0;
+
+    *pu32Tick = u32Now + u32Best;
+
+    return 1;
+}
+
+/* Expire the timers of tick s_u32WheelNow. Called with interrupts disabled, re-enables them for callbacks. */
+static void SWTIMER_RunTick(uint32_t u32PriMask)
+{
+    S_SWTIMER_T *psList, *psTimer;
+    uint32_t u32Tick = s_u32WheelNow, u32Idx = u32Tick & SWTIMER_WHEEL_MASK, u32Level, u32Base, u32Frac;
+
+    if (u32Idx == 0)
+    {
+        for (u32Level = 1; u32Level < SWTIMER_WHEEL_LEVELS; u32Level++)
+        {
+            if (SWTIMER_Cascade(u32Level, (u32Tick >> (SWTIMER_WHEEL_BITS * u32Level)) & SWTIMER_WHEEL_MASK) != 0)
+                break;
+        }
+    }
+
+    /* Detach the slot so that re-armed timers land in a fresh list */
+    psList = s_apsSlot[0][u32Idx];
+    s_apsSlot[0][u32Idx] = NULL;
+    s_au32Pending[0] &= ~(1UL << u32Idx);
+
+    if (psList != NULL)
+        psList->ppsPrev = &psList;
+
+    s_u32WheelNow = u32Tick + 1UL;
+
+    while ((psTimer = psList) != NULL)
+    {
+        psList = psTimer->psNext;
+
+        if (psList != NULL)
+            psList->ppsPrev = &psList;
+
+        psTimer->ppsPrev = NULL;
+
+        if ((psTimer->u32Period != 0) || (psTimer->u16PeriodFrac != 0))
+        {
+            /* Re-arm from the previous deadline, not from now, so periodic timers do not drift */
+            u32Base = psTimer->u32Expire - ((psTimer->u16Frac != 0) ? 1UL : 0UL);
+            u32Frac = psTimer->u16Frac + psTimer->u16PeriodFrac;
+            u32Base += psTimer->u32Period + (u32Frac >> SWTIMER_TICK_SHIFT);
+            u32Frac &= SWTIMER_TICK_MASK;
+            psTimer->u32Expire = u32Base + ((u32Frac != 0) ? 1UL : 0UL);
+            psTimer->u16Frac = (uint16_t)u32Frac;
+            SWTIMER_Link(psTimer);
+        }
+
+        __set_PRIMASK(u32PriMask);
+        psTimer->pfnCallback(psTimer->pvArg);
+        __set_PRIMASK(1);
+    }
+}
+
+/* Program the compare register for the next event. Return 1 if the event is already due. */
+static int32_t SWTIMER_Arm(void)
+{
+    uint32_t u32Now, u32NowTick, u32Next, u32Delta, u32Deadline;
+
+    SWTIMER_Sync();
+    u32NowTick = SWTIMER_NowTick();
+
+    if (SWTIMER_NextTick(&u32Next))
+    {
+        u32Delta = u32Next - u32NowTick;
+
+        if ((int32_t)u32Delta <= 0)
+            return 1;
+
+        if (u32Delta > SWTIMER_GUARD_TICKS)
+            u32Delta = SWTIMER_GUARD_TICKS;
+    }
+    else
+    {
+        u32Delta = SWTIMER_GUARD_TICKS;
+    }
+
+    u32Deadline = (u32NowTick + u32Delta) << SWTIMER_TICK_SHIFT;
+
+    /* Compare value 0 and 1 are not allowed */
+    if ((u32Deadline & SWTIMER_CNT_MASK) < 2)
+        u32Deadline = (u32Deadline & ~SWTIMER_CNT_MASK) | 2UL;
+
+    s_psSwTimer->CMP = u32Deadline & SWTIMER_CNT_MASK;
+
+    /* The counter may have passed the compare value before it was written */
+    u32Now = SWTIMER_Sync();
+
+    if ((int32_t)(u32Deadline - u32Now) <= 2)
+        return 1;
+
+    return 0;
+}
+
+/// @endcond HIDDEN_SYMBOLS
+
+/** @addtogroup SWTIMER_EXPORTED_FUNCTIONS SWTIMER Exported Functions
+  @{
+*/
+
+/**
+  * @brief      Open the free-running timebase
+  *
+  * @param[in]  timer       The pointer of the specified Timer module. It could be TIMER0, TIMER1, TIMER2, TIMER3.
+  *
+  * @return     Real timebase frequency
+  *
+  * @details    This API runs the timer in continuous counting mode as a monotonic timebase of
+  *             \ref SWTIMER_TIMEBASE_FREQ. The 24-bit counter is extended to 32 bits in software and
+  *             the compare register is moved to the next software timer deadline, so all software
+  *             timers share this one hardware timer and the CPU is only interrupted when a timer expires.
+  *             If the timer clock is not a multiple of 1 MHz the closest frequency is used and returned.
+  * @note       User must enable the timer NVIC and call \ref SWTIMER_IRQHandler from TMRx_IRQHandler.
+  */
+uint32_t SWTIMER_Open(TIMER_T *timer)
+{
+    uint32_t u32Clk = TIMER_GetModuleClock(timer);
+    uint32_t u32Prescale = 0UL, u32Level, u32Slot;
+
+    if (u32Clk > SWTIMER_TIMEBASE_FREQ)
+    {
+        u32Prescale = (u32Clk / SWTIMER_TIMEBASE_FREQ) - 1UL;
+
+        if (u32Prescale > 0xFFUL)
+            u32Prescale = 0xFFUL;
+    }
+
+    if (timer == TIMER0)
+        s_eSwTimerIRQn = TMR0_IRQn;
+    else if (timer == TIMER1)
+        s_eSwTimerIRQn = TMR1_IRQn;
+    else if (timer == TIMER2)
+        s_eSwTimerIRQn = TMR2_IRQn;
+    else
+        s_eSwTimerIRQn = TMR3_IRQn;
+
+    for (u32Level = 0; u32Level < SWTIMER_WHEEL_LEVELS; u32Level++)
+    {
+        s_au32Pending[u32Level] = 0;
+
+        for (u32Slot = 0; u32Slot < SWTIMER_WHEEL_SIZE; u32Slot++)
+            s_apsSlot[u32Level][u32Slot] = NULL;
+    }
+
+    s_psSwTimer = timer;
+    s_u32Wraps = 0;
+    s_u32LastCnt = 0;
+    s_u32WheelNow = 0;
+
+    timer->CTL = 0;
+    timer->EXTCTL = 0;
+    timer->CMP = (SWTIMER_GUARD_TICKS << SWTIMER_TICK_SHIFT);
+    timer->INTSTS = TIMER_INTSTS_TIF_Msk;
+    timer->CTL = TIMER_CTL_CNTEN_Msk | TIMER_CTL_INTEN_Msk | TIMER_CONTINUOUS_MODE | u32Prescale;
+
+    return (u32Clk / (u32Prescale + 1UL));
+}
+
+/**
+  * @brief      Close the timebase
+  *
+  * @param      None
+  *
+  * @return     None
+  *
+  * @details    This API stops the timer. Pending software timers are kept and resume when the timebase is re-opened.
+  */
+void SWTIMER_Close(void)
+{
+    if (s_psSwTimer != NULL)
+    {
+        TIMER_Close(s_psSwTimer);
+        s_psSwTimer = NULL;
+    }
+}
+
+/**
+  * @brief      Get the monotonic timebase
+  *
+  * @param      None
+  *
+  * @return     32-bit timebase counts, micro seconds at \ref SWTIMER_TIMEBASE_FREQ
+  *
+  * @details    The value wraps after 2^32 counts (about 71 minutes at 1 MHz). Use unsigned subtraction to
+  *             compute intervals. It is safe to call this API from any context.
+  */
+uint32_t SWTIMER_GetTime(void)
+{
+    uint32_t u32PriMask = __get_PRIMASK(), u32Now;
+
+    __set_PRIMASK(1);
+    u32Now = SWTIMER_Sync();
+    __set_PRIMASK(u32PriMask);
+
+    return u32Now;
+}
+
+/**
+  * @brief      Get the current wheel tick
+  *
+  * @param      None
+  *
+  * @return     32-bit wheel tick, one tick is (1 << \ref SWTIMER_TICK_SHIFT) timebase counts
+  */
+uint32_t SWTIMER_GetTicks(void)
+{
+    uint32_t u32PriMask = __get_PRIMASK(), u32Tick;
+
+    __set_PRIMASK(1);
+    SWTIMER_Sync();
+    u32Tick = SWTIMER_NowTick();
+    __set_PRIMASK(u32PriMask);
+
+    return u32Tick;
+}
+
+/**
+  * @brief      Start a software timer
+  *
+  * @param[in]  psTimer     The pointer of the software timer. It must stay valid while the timer is active.
+  * @param[in]  u32Timeout  Time to the first expiry in timebase counts. Valid values are between 0 ~ 0x7FFFFFFF.
+  * @param[in]  u32Period   Reload period in timebase counts, or \ref SWTIMER_ONESHOT.
+  * @param[in]  pfnCallback Function called from \ref SWTIMER_IRQHandler when the timer expires.
+  * @param[in]  pvArg       Argument passed to pfnCallback.
+  *
+  * @return     None
+  *
+  * @details    Insertion and removal are O(1). The expiry is rounded up to the next wheel tick, so a timer never
+  *             expires early. Periodic timers keep the sub-tick remainder of the period and are re-armed from
+  *             their previous expiry, so they do not drift from the timebase.
+  *             If the timer is already active it is restarted. It is safe to call this API from a callback.
+  */
+void SWTIMER_Start(S_SWTIMER_T *psTimer, uint32_t u32Timeout, uint32_t u32Period, SWTIMER_CB pfnCallback, void *pvArg)
+{
+    uint32_t u32PriMask = __get_PRIMASK(), u32NowTick, u32Next, u32Frac;
+
+    __set_PRIMASK(1);
+
+    if (psTimer->ppsPrev != NULL)
+        SWTIMER_Unlink(psTimer);
+
+    SWTIMER_Sync();
+    u32NowTick = SWTIMER_NowTick();
+
+    /* Deadline = now + timeout, expire on the first tick at or after it */
+    u32Frac = (s_u32LastCnt & SWTIMER_TICK_MASK) + u32Timeout;
+    psTimer->u16Frac = (uint16_t)(u32Frac & SWTIMER_TICK_MASK);
+    psTimer->u32Expire = u32NowTick + (u32Frac >> SWTIMER_TICK_SHIFT) + ((psTimer->u16Frac != 0) ? 1UL : 0UL);
+    psTimer->u32Period = u32Period >> SWTIMER_TICK_SHIFT;
+    psTimer->u16PeriodFrac = (uint16_t)(u32Period & SWTIMER_TICK_MASK);
+    psTimer->pfnCallback = pfnCallback;
+    psTimer->pvArg = pvArg;
+
+    /* After a long idle period the wheel lags behind the timebase. Catch up if nothing is due in between. */
+    if ((int32_t)(u32NowTick - s_u32WheelNow) >= 0)
+    {
+        if ((SWTIMER_NextTick(&u32Next) == 0) || ((int32_t)(u32Next - u32NowTick) > 0))
+            s_u32WheelNow = u32NowTick + 1UL;
+    }
+
+    SWTIMER_Link(psTimer);
+
+    if (SWTIMER_Arm())
+        NVIC_SetPendingIRQ(s_eSwTimerIRQn);
+
+    __set_PRIMASK(u32PriMask);
+}
+
+/**
+  * @brief      Stop a software timer
+  *
+  * @param[in]  psTimer     The pointer of the software timer.
+  *
+  * @return     None
+  *
+  * @details    Stopping a timer which is not active has no effect. It is safe to call this API from a callback.
+  */
+void SWTIMER_Stop(S_SWTIMER_T *psTimer)
+{
+    uint32_t u32PriMask = __get_PRIMASK();
+
+    __set_PRIMASK(1);
+
+    if (psTimer->ppsPrev != NULL)
+        SWTIMER_Unlink(psTimer);
+
+    __set_PRIMASK(u32PriMask);
+}
+
+/**
+  * @brief      Get time to the next software timer event
+  *
+  * @param      None
+  *
+  * @return     Timebase counts until the next expiry, 0 if one is due, or 0xFFFFFFFF if no timer is active
+  *
+  * @details    Power management can use this value to decide how long the system may sleep.
+  */
+uint32_t SWTIMER_GetNextTimeout(void)
+{
+    uint32_t u32PriMask = __get_PRIMASK(), u32Now, u32Next, u32Ret = 0xFFFFFFFFUL;
+
+    __set_PRIMASK(1);
+    u32Now = SWTIMER_Sync();
+
+    if (SWTIMER_NextTick(&u32Next))
+    {
+        u32Next = (u32Next << SWTIMER_TICK_SHIFT) - u32Now;
+        u32Ret = ((int32_t)u32Next > 0) ? u32Next : 0UL;
+    }
+
+    __set_PRIMASK(u32PriMask);
+
+    return u32Ret;
+}
+
+/**
+  * @brief      Software timer interrupt service
+  *
+  * @param      None
+  *
+  * @return     None
+  *
+  * @details    Call this API from the TMRx_IRQHandler of the timer passed to \ref SWTIMER_Open. It runs every
+  *             expired callback in expiry order and programs the compare register for the next deadline.
+  *             Idle wheel ticks are skipped, so the cost does not depend on how long the CPU has been asleep.
+  */
+void SWTIMER_IRQHandler(void)
+{
+    uint32_t u32PriMask = __get_PRIMASK(), u32NowTick, u32Next;
+
+    if (TIMER_GetIntFlag(s_psSwTimer))
+        TIMER_ClearIntFlag(s_psSwTimer);
+
+    __set_PRIMASK(1);
+
+    do
+    {
+        SWTIMER_Sync();
+        u32NowTick = SWTIMER_NowTick();
+
+        while (SWTIMER_NextTick(&u32Next) && ((int32_t)(u32Next - u32NowTick) <= 0))
+        {
+            s_u32WheelNow = u32Next;
+            SWTIMER_RunTick(u32PriMask);
+        }
+
+        s_u32WheelNow = u32NowTick + 1UL;
+    }
+    while (SWTIMER_Arm());
+
+    __set_PRIMASK(u32PriMask);
+}
+
+/*@}*/ /* end of group SWTIMER_EXPORTED_FUNCTIONS */
+
+/*@}*/ /* end of group SWTIMER_Driver */
+
+/*@}*/ /* end of group Standard_Driver */
+
+/*** (C) COPYRIGHT 2021 Nuvoton Technology Corp. ***/
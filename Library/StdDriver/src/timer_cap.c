@@ -0,0 +1,415 @@
+/**************************************************************************//**
+ * @file     timer_cap.c
+ * @version  V1.00
+ * @brief    NUC121 series timer capture timestamp driver source file
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * @copyright (C) 2021 Nuvoton Technology Corp. All rights reserved.
+*****************************************************************************/
+#include "NuMicro.h"
+
+/** @addtogroup Standard_Driver Standard Driver
+  @{
+*/
+
+/** @addtogroup TIMER_CAP_Driver TIMER_CAP Driver
+  @{
+*/
+
+/// @cond HIDDEN_SYMBOLS
+
+#define TIMER_CAP_CNT_BITS      (24UL)
+#define TIMER_CAP_CNT_MASK      ((1UL << TIMER_CAP_CNT_BITS) - 1UL)
+#define TIMER_CAP_CNT_HALF      (1UL << (TIMER_CAP_CNT_BITS - 1UL))
+#define TIMER_CAP_PDMA_MAX      (16384UL)
+/* CAP is 24-bit, so PDMA never writes a value with the top byte set. Consumed slots are marked with it. */
+#define TIMER_CAP_EMPTY         (0xFFFFFFFFUL)
+
+static void TIMER_CAP_Stat(S_TIMER_CAP_T *psCap, uint32_t u32Stamp)
+{
+    uint32_t u32Period;
+
+    if (psCap->u32Stamps != 0)
+    {
+        u32Period = u32Stamp - psCap->u32LastStamp;
+        psCap->u32PeriodLast = u32Period;
+
+        if (u32Period < psCap->u32PeriodMin)
+            psCap->u32PeriodMin = u32Period;
+
+        if (u32Period > psCap->u32PeriodMax)
+            psCap->u32PeriodMax = u32Period;
+
+        psCap->u64PeriodSum += u32Period;
+        psCap->u32Periods++;
+    }
+
+    psCap->u32LastStamp = u32Stamp;
+    psCap->u32Stamps++;
+}
+
+/// @endcond HIDDEN_SYMBOLS
+
+/** @addtogroup TIMER_CAP_EXPORTED_FUNCTIONS TIMER_CAP Exported Functions
+  @{
+*/
+
+/**
+  * @brief      Open a capture timestamp channel
+  *
+  * @param[in]  psCap       The pointer of the capture channel.
+  * @param[in]  timer       The pointer of the specified Timer module. It could be TIMER0, TIMER1, TIMER2, TIMER3.
+  * @param[in]  u32Freq     Target counting frequency in Hz. It sets the timestamp resolution.
+  * @param[in]  u32Edge     Capture edge. Possible values are
+  *                         - \ref TIMER_CAPTURE_FALLING_EDGE
+  *                         - \ref TIMER_CAPTURE_RISING_EDGE
+  *                         - \ref TIMER_CAPTURE_FALLING_AND_RISING_EDGE
+  *                         The value can be ORed with \ref TIMER_CAP_DEBOUNCE.
+  * @param[in]  pu32Buf     Timestamp queue buffer.
+  * @param[in]  u32Size     Number of entries of pu32Buf. It must be a power of 2.
+  *
+  * @return     Real counting frequency, 0 if u32Size is not a power of 2
+  *
+  * @details    The timer runs in continuous counting mode and the capture latches the free-running counter on
+  *             every TMx_EXT edge. The counter wraps every 2^24 counts, so the compare interrupt is placed at the
+  *             top of the counter and counts the wrap-arounds, which extends every timestamp to 32 bits.
+  *             The channel is opened stopped, call \ref TIMER_CAP_Start to start capturing.
+  * @note       User must enable the timer NVIC and call \ref TIMER_CAP_IRQHandler from TMRx_IRQHandler,
+  *             unless \ref TIMER_CAP_EnablePDMA is used.
+  */
+uint32_t TIMER_CAP_Open(S_TIMER_CAP_T *psCap, TIMER_T *timer, uint32_t u32Freq, uint32_t u32Edge, uint32_t *pu32Buf, uint32_t u32Size)
+{
+    uint32_t u32Clk = TIMER_GetModuleClock(timer);
+    uint32_t u32Prescale = 0UL;
+
+    if ((u32Size == 0) || ((u32Size & (u32Size - 1UL)) != 0))
+        return 0;
+
+    if ((u32Freq != 0) && (u32Clk > u32Freq))
+    {
+        u32Prescale = (u32Clk / u32Freq) - 1UL;
+
+        if (u32Prescale > 0xFFUL)
+            u32Prescale = 0xFFUL;
+    }
+
+    psCap->timer = timer;
+    psCap->pu32Buf = pu32Buf;
+    psCap->u32Mask = u32Size - 1UL;
+    psCap->u32PdmaCh = TIMER_CAP_NO_PDMA;
+    psCap->u32Freq = u32Clk / (u32Prescale + 1UL);
+
+    timer->CTL = 0;
+    timer->EXTCTL = 0;
+    timer->CMP = TIMER_CAP_CNT_MASK;
+    timer->INTSTS = TIMER_INTSTS_TIF_Msk;
+    timer->EINTSTS = TIMER_EINTSTS_CAPIF_Msk;
+    timer->CTL = TIMER_CTL_INTEN_Msk | TIMER_CONTINUOUS_MODE | u32Prescale;
+    timer->EXTCTL = TIMER_EXTCTL_CAPEN_Msk | TIMER_EXTCTL_CAPIEN_Msk | TIMER_CAPTURE_FREE_COUNTING_MODE |
+                    (u32Edge & (TIMER_EXTCTL_CAPEDGE_Msk | TIMER_EXTCTL_CAPDBEN_Msk));
+
+    return psCap->u32Freq;
+}
+
+/**
+  * @brief      Move a capture channel to PDMA
+  *
+  * @param[in]  psCap       The pointer of the capture channel.
+  * @param[in]  u32Ch       PDMA channel. Valid values are between 0~4.
+  *
+  * @retval     0           Success
+  * @retval     -1          Queue is larger than one PDMA transfer or channel is invalid
+  *
+  * @details    Each capture event triggers PDMA_TMRx, which copies the capture register into the queue through
+  *             a scatter-gather descriptor linked to itself, so the queue is filled forever without any
+  *             interrupt. The wrap-arounds are then reconstructed by \ref TIMER_CAP_Read, which requires at least
+  *             one edge every 2^24 counts. The consumer must also keep up with the queue, since PDMA cannot tell
+  *             a full queue and overwrites the oldest entries.
+  *             Call it after \ref TIMER_CAP_Open and before \ref TIMER_CAP_Start.
+  * @note       The queue buffer and psCap must be located in SRAM.
+  */
+int32_t TIMER_CAP_EnablePDMA(S_TIMER_CAP_T *psCap, uint32_t u32Ch)
+{
+    TIMER_T *timer = psCap->timer;
+    uint32_t u32Peripheral, i;
+
+    if ((u32Ch >= PDMA_CH_MAX) || ((psCap->u32Mask + 1UL) > TIMER_CAP_PDMA_MAX))
+        return -1;
+
+    if (timer == TIMER0)
+        u32Peripheral = PDMA_TMR0;
+    else if (timer == TIMER1)
+        u32Peripheral = PDMA_TMR1;
+    else if (timer == TIMER2)
+        u32Peripheral = PDMA_TMR2;
+    else
+        u32Peripheral = PDMA_TMR3;
+
+    for (i = 0; i <= psCap->u32Mask; i++)
+        psCap->pu32Buf[i] = TIMER_CAP_EMPTY;
+
+    psCap->u32PdmaCh = u32Ch;
+
+    psCap->sDesc.CTL = (psCap->u32Mask << PDMA_DSCT_CTL_TXCNT_Pos) | PDMA_WIDTH_32 | PDMA_SAR_FIX | PDMA_DAR_INC |
+                       PDMA_REQ_SINGLE | PDMA_DSCT_CTL_TBINTDIS_Msk | PDMA_OP_SCATTER;
+    psCap->sDesc.SA = (uint32_t)&timer->CAP;
+    psCap->sDesc.DA = (uint32_t)psCap->pu32Buf;
+    psCap->sDesc.NEXT = (uint32_t)&psCap->sDesc - (PDMA->SCATBA);
+
+    PDMA_Open(1UL << u32Ch);
+    PDMA_SetTransferMode(u32Ch, u32Peripheral, TRUE, (uint32_t)&psCap->sDesc);
+
+    /* No CPU involvement: capture events go to PDMA and the wrap interrupt is not needed */
+    timer->EXTCTL &= ~TIMER_EXTCTL_CAPIEN_Msk;
+    timer->CTL = (timer->CTL & ~TIMER_CTL_INTEN_Msk) | TIMER_TRGSRC_CAPTURE_EVENT | TIMER_TRG_TO_PDMA;
+
+    return 0;
+}
+
+/**
+  * @brief      Start capturing
+  *
+  * @param[in]  psCap       The pointer of the capture channel.
+  *
+  * @return     None
+  *
+  * @details    The counter is reset, the queue is emptied and the statistics are cleared.
+  */
+void TIMER_CAP_Start(S_TIMER_CAP_T *psCap)
+{
+    TIMER_T *timer = psCap->timer;
+
+    psCap->u32Head = 0;
+    psCap->u32Tail = 0;
+    psCap->u32Dropped = 0;
+    psCap->u32Wraps = 0;
+    psCap->u32PdmaWraps = 0;
+    psCap->u32PdmaLast = 0;
+    TIMER_CAP_ResetStat(psCap);
+
+    timer->CTL |= TIMER_CTL_RSTCNT_Msk;
+    timer->INTSTS = TIMER_INTSTS_TIF_Msk;
+    timer->EINTSTS = TIMER_EINTSTS_CAPIF_Msk;
+    timer->CTL |= TIMER_CTL_CNTEN_Msk;
+}
+
+/**
+  * @brief      Stop capturing
+  *
+  * @param[in]  psCap       The pointer of the capture channel.
+  *
+  * @return     None
+  *
+  * @details    Timestamps already in the queue can still be read.
+  */
+void TIMER_CAP_Stop(S_TIMER_CAP_T *psCap)
+{
+    psCap->timer->CTL &= ~TIMER_CTL_CNTEN_Msk;
+
+    if (psCap->u32PdmaCh != TIMER_CAP_NO_PDMA)
+        PDMA->CHCTL &= ~(1UL << psCap->u32PdmaCh);
+}
+
+/**
+  * @brief      Capture channel interrupt handler
+  *
+  * @param[in]  psCap       The pointer of the capture channel.
+  *
+  * @return     None
+  *
+  * @details    Call it from TMRx_IRQHandler. It extends the captured value to 32 bits and puts it into the
+  *             queue, or counts it in u32Dropped if the queue is full. A capture taken just after a counter
+  *             wrap-around whose interrupt is still pending is recognised by its small value, so timestamps stay
+  *             monotonic as long as the handler runs within 2^23 counts.
+  */
+void TIMER_CAP_IRQHandler(S_TIMER_CAP_T *psCap)
+{
+    TIMER_T *timer = psCap->timer;
+    uint32_t u32Wraps = psCap->u32Wraps;
+    uint32_t u32Cap = 0, u32CapIF, u32Head;
+
+    /* Capture must be sampled before the wrap flag, see above */
+    u32CapIF = timer->EINTSTS & TIMER_EINTSTS_CAPIF_Msk;
+
+    if (u32CapIF)
+    {
+        u32Cap = timer->CAP & TIMER_CAP_CNT_MASK;
+        timer->EINTSTS = TIMER_EINTSTS_CAPIF_Msk;
+    }
+
+    if (timer->INTSTS & TIMER_INTSTS_TIF_Msk)
+    {
+        timer->INTSTS = TIMER_INTSTS_TIF_Msk;
+        psCap->u32Wraps = u32Wraps + 1UL;
+
+        if (u32Cap < TIMER_CAP_CNT_HALF)
+            u32Wraps++;
+    }
+
+    if (u32CapIF)
+    {
+        u32Head = psCap->u32Head;
+
+        if ((u32Head - psCap->u32Tail) > psCap->u32Mask)
+            psCap->u32Dropped++;
+        else
+        {
+            psCap->pu32Buf[u32Head & psCap->u32Mask] = (u32Wraps << TIMER_CAP_CNT_BITS) | u32Cap;
+            psCap->u32Head = u32Head + 1UL;
+        }
+    }
+}
+
+/**
+  * @brief      Get number of queued timestamps
+  *
+  * @param[in]  psCap       The pointer of the capture channel.
+  *
+  * @return     Number of timestamps that can be read
+  */
+uint32_t TIMER_CAP_GetCount(S_TIMER_CAP_T *psCap)
+{
+    uint32_t u32Count;
+
+    if (psCap->u32PdmaCh == TIMER_CAP_NO_PDMA)
+        return (psCap->u32Head - psCap->u32Tail);
+
+    for (u32Count = 0; u32Count <= psCap->u32Mask; u32Count++)
+    {
+        if (psCap->pu32Buf[(psCap->u32Tail + u32Count) & psCap->u32Mask] == TIMER_CAP_EMPTY)
+            break;
+    }
+
+    return u32Count;
+}
+
+/**
+  * @brief      Read timestamps from the queue
+  *
+  * @param[in]  psCap       The pointer of the capture channel.
+  * @param[out] pu32Stamp   Buffer for the 32-bit timestamps. It could be NULL to only update the statistics.
+  * @param[in]  u32Max      Maximum number of timestamps to read.
+  *
+  * @return     Number of timestamps read
+  *
+  * @details    Timestamps are in counts of the capture timer and wrap after 2^32 counts, so use unsigned
+  *             subtraction for intervals. Each timestamp also updates the period statistics.
+  *             Only one context may read a channel; it may run concurrently with the producer.
+  */
+uint32_t TIMER_CAP_Read(S_TIMER_CAP_T *psCap, uint32_t *pu32Stamp, uint32_t u32Max)
+{
+    uint32_t u32Tail = psCap->u32Tail;
+    uint32_t u32Count = TIMER_CAP_GetCount(psCap);
+    uint32_t u32Stamp, u32Idx, i;
+
+    if (u32Count > u32Max)
+        u32Count = u32Max;
+
+    for (i = 0; i < u32Count; i++)
+    {
+        u32Idx = (u32Tail + i) & psCap->u32Mask;
+        u32Stamp = psCap->pu32Buf[u32Idx];
+
+        if (psCap->u32PdmaCh != TIMER_CAP_NO_PDMA)
+        {
+            psCap->pu32Buf[u32Idx] = TIMER_CAP_EMPTY;
+
+            u32Stamp &= TIMER_CAP_CNT_MASK;
+
+            if (u32Stamp < psCap->u32PdmaLast)
+                psCap->u32PdmaWraps++;
+
+            psCap->u32PdmaLast = u32Stamp;
+            u32Stamp |= (psCap->u32PdmaWraps << TIMER_CAP_CNT_BITS);
+        }
+
+        TIMER_CAP_Stat(psCap, u32Stamp);
+
+        if (pu32Stamp != NULL)
+            pu32Stamp[i] = u32Stamp;
+    }
+
+    psCap->u32Tail = u32Tail + u32Count;
+
+    return u32Count;
+}
+
+/**
+  * @brief      Clear the period statistics
+  *
+  * @param[in]  psCap       The pointer of the capture channel.
+  *
+  * @return     None
+  *
+  * @details    The next timestamp read starts a new measurement.
+  */
+void TIMER_CAP_ResetStat(S_TIMER_CAP_T *psCap)
+{
+    psCap->u32Stamps = 0;
+    psCap->u32PeriodLast = 0;
+    psCap->u32PeriodMin = 0xFFFFFFFFUL;
+    psCap->u32PeriodMax = 0;
+    psCap->u32Periods = 0;
+    psCap->u64PeriodSum = 0;
+}
+
+/**
+  * @brief      Get the average period
+  *
+  * @param[in]  psCap       The pointer of the capture channel.
+  *
+  * @return     Average period in counts, 0 if no period was measured
+  */
+uint32_t TIMER_CAP_GetAvgPeriod(S_TIMER_CAP_T *psCap)
+{
+    if (psCap->u32Periods == 0)
+        return 0;
+
+    return (uint32_t)(psCap->u64PeriodSum / psCap->u32Periods);
+}
+
+/**
+  * @brief      Get the average input frequency
+  *
+  * @param[in]  psCap       The pointer of the capture channel.
+  *
+  * @return     Frequency in milli Hz, 0 if no period was measured
+  *
+  * @details    With \ref TIMER_CAPTURE_FALLING_AND_RISING_EDGE every half period is measured, so the
+  *             returned value is twice the signal frequency.
+  */
+uint32_t TIMER_CAP_GetFreq(S_TIMER_CAP_T *psCap)
+{
+    uint32_t u32Avg = TIMER_CAP_GetAvgPeriod(psCap);
+
+    if (u32Avg == 0)
+        return 0;
+
+    return (uint32_t)(((uint64_t)psCap->u32Freq * 1000UL) / u32Avg);
+}
+
+/**
+  * @brief      Get the average rotation speed
+  *
+  * @param[in]  psCap           The pointer of the capture channel.
+  * @param[in]  u32PulsePerRev  Captured edges per revolution, for example the tachometer pulses of a fan.
+  *
+  * @return     Revolutions per minute, 0 if no period was measured
+  */
+uint32_t TIMER_CAP_GetRPM(S_TIMER_CAP_T *psCap, uint32_t u32PulsePerRev)
+{
+    uint32_t u32Avg = TIMER_CAP_GetAvgPeriod(psCap);
+
+    if ((u32Avg == 0) || (u32PulsePerRev == 0))
+        return 0;
+
+    return (uint32_t)(((uint64_t)psCap->u32Freq * 60UL) / ((uint64_t)u32Avg * u32PulsePerRev));
+}
+
+/*@}*/ /* end of group TIMER_CAP_EXPORTED_FUNCTIONS */
+
+/*@}*/ /* end of group TIMER_CAP_Driver */
+
+/*@}*/ /* end of group Standard_Driver */
+
+/*** (C) COPYRIGHT 2021 Nuvoton Technology Corp. ***/
@@ -618,10 +618,10 @@ void USBD_PrepareCtrlIn(uint8_t *pu8Buf, uint32_t u32Size)
   *
   * @return   None
   *
-  * @details  This function processes the remained data of Control IN transfer.
+  * @details  This function processes the remained data of Control IN transfer. It runs from SRAM when USE_RAMFUNC is defined.
   *
   */
-void USBD_CtrlIn(void)
+__RAMFUNC_HOT void USBD_CtrlIn(void)
 {
     DBG_PRINTF("Ctrl In Ack. residue %d\n", g_USBD_u32CtrlInSize);
 
@@ -695,10 +695,10 @@ void USBD_PrepareCtrlOut(uint8_t *pu8Buf, uint32_t u32Size)
   *
   * @return   None
   *
-  * @details  This function processes the successive Control OUT transfer.
+  * @details  This function processes the successive Control OUT transfer. It runs from SRAM when USE_RAMFUNC is defined.
   *
   */
-void USBD_CtrlOut(void)
+__RAMFUNC_HOT void USBD_CtrlOut(void)
 {
     uint32_t u32Size;
     uint32_t addr;
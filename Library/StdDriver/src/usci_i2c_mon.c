@@ -0,0 +1,400 @@
+/**************************************************************************//**
+ * @file     usci_i2c_mon.c
+ * @version  V1.00
+ * @brief    NUC121 series USCI_I2C passive bus monitor source file
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * @copyright (C) 2021 Nuvoton Technology Corp. All rights reserved.
+*****************************************************************************/
+#include "NuMicro.h"
+
+/** @addtogroup Standard_Driver Standard Driver
+  @{
+*/
+
+/** @addtogroup UI2C_MON_Driver UI2C_MON Driver
+  @{
+*/
+
+/// @cond HIDDEN_SYMBOLS
+
+#define UI2C_MON_ST_IDLE        (0UL)   /* Between STOP and START */
+#define UI2C_MON_ST_ADDR        (1UL)   /* Next byte is an address */
+#define UI2C_MON_ST_DATA        (2UL)   /* Next byte is data */
+
+#define UI2C_MON_REC(u32Type, u32Nack, u32Byte, u32Time) \
+    (((u32Type) << 29) | ((u32Nack) << 28) | (((u32Byte) & 0xFFUL) << 20) | ((u32Time) & 0xFFFFFUL))
+
+#define UI2C_MON_STAT_OTHER     (UI2C_MON_STAT_NUM + 1UL)
+
+/* Store an event with the TIME and LOST records it needs, or drop it as a whole */
+static void UI2C_MON_Event(S_UI2C_MON_T *psMon, uint32_t u32Type, uint32_t u32Nack, uint32_t u32Byte)
+{
+    uint32_t u32Now = SWTIMER_GetTime();
+    uint32_t u32Head = psMon->u32Head;
+    uint32_t u32Need = 1UL;
+
+    if (psMon->u32Lost)
+        u32Need++;
+
+    if ((u32Now >> 20) != psMon->u32High)
+        u32Need++;
+
+    if ((psMon->u32Mask + 1UL - (u32Head - psMon->u32Tail)) < u32Need)
+    {
+        psMon->u32Lost++;
+        psMon->u32Dropped++;
+        return;
+    }
+
+    if (psMon->u32Lost)
+    {
+        psMon->pu32Ring[u32Head++ & psMon->u32Mask] = (UI2C_MON_REC_LOST << 29) | psMon->u32Lost;
+        psMon->u32Lost = 0;
+    }
+
+    if ((u32Now >> 20) != psMon->u32High)
+    {
+        psMon->u32High = u32Now >> 20;
+        psMon->pu32Ring[u32Head++ & psMon->u32Mask] = (UI2C_MON_REC_TIME << 29) | psMon->u32High;
+    }
+
+    psMon->pu32Ring[u32Head++ & psMon->u32Mask] = UI2C_MON_REC(u32Type, u32Nack, u32Byte, u32Now);
+    psMon->u32Head = u32Head;
+    psMon->u32Events++;
+}
+
+static uint32_t UI2C_MON_StatEntry(S_UI2C_MON_STAT_T *psStat, uint32_t u32Addr)
+{
+    uint32_t i;
+
+    for (i = 0; i < psStat->u32AddrNum; i++)
+    {
+        if (psStat->asAddr[i].u8Addr == u32Addr)
+            return i;
+    }
+
+    if (i == UI2C_MON_STAT_NUM)
+        return UI2C_MON_STAT_OTHER;
+
+    psStat->asAddr[i].u8Addr = (uint8_t)u32Addr;
+    psStat->u32AddrNum++;
+
+    return i;
+}
+
+/// @endcond HIDDEN_SYMBOLS
+
+/** @addtogroup UI2C_MON_EXPORTED_FUNCTIONS UI2C_MON Exported Functions
+  @{
+*/
+
+/**
+  * @brief      Open a USCI as a passive I2C bus monitor
+  *
+  * @param[in]  psMon       The pointer of the monitor context.
+  * @param[in]  ui2c        USCI_I2C port, UI2C0.
+  * @param[in]  pu32Ring    Record ring.
+  * @param[in]  u32Size     Ring size in records, a power of 2 from 4.
+  * @param[in]  u32Mode     \ref UI2C_MON_PASSIVE or \ref UI2C_MON_STRETCH.
+  *
+  * @retval     0           Success
+  * @retval     -1          Invalid ring size
+  *
+  * @details    Every address is matched, so the monitor records all traffic without driving SDA. The records use
+  *             the SWTIMER timebase, open it first. Enable USCI_IRQn and call \ref UI2C_MON_IRQHandler from
+  *             USCI_IRQHandler. The interrupt has to be served within one byte time, about 9 us at 1 MHz.
+  */
+int32_t UI2C_MON_Open(S_UI2C_MON_T *psMon, UI2C_T *ui2c, uint32_t *pu32Ring, uint32_t u32Size, uint32_t u32Mode)
+{
+    if ((u32Size < 4) || (u32Size & (u32Size - 1UL)))
+        return -1;
+
+    psMon->ui2c = ui2c;
+    psMon->pu32Ring = pu32Ring;
+    psMon->u32Mask = u32Size - 1UL;
+    psMon->u32Head = 0;
+    psMon->u32Tail = 0;
+    psMon->u32State = UI2C_MON_ST_IDLE;
+    psMon->u32High = 0xFFFFFFFFUL;
+    psMon->u32Lost = 0;
+    psMon->u32Events = 0;
+    psMon->u32Dropped = 0;
+
+    UI2C_Open(ui2c, 100000);
+
+    /* All address bits masked */
+    UI2C_SetSlaveAddr(ui2c, 0, 0, UI2C_GCMODE_DISABLE);
+    UI2C_SetSlaveAddrMask(ui2c, 0, 0x7F);
+    UI2C_SetSlaveAddr(ui2c, 1, 0, UI2C_GCMODE_DISABLE);
+    UI2C_SetSlaveAddrMask(ui2c, 1, 0x7F);
+
+    UI2C_ENABLE_PROT_INT(ui2c, (UI2C_PROTIEN_ACKIEN_Msk | UI2C_PROTIEN_NACKIEN_Msk |
+                                UI2C_PROTIEN_STORIEN_Msk | UI2C_PROTIEN_STARIEN_Msk));
+
+    ui2c->PROTCTL |= UI2C_PROTCTL_MONEN_Msk | ((u32Mode == UI2C_MON_STRETCH) ? UI2C_PROTCTL_SCLOUTEN_Msk : 0);
+    UI2C_SET_CONTROL_REG(ui2c, (UI2C_CTL_PTRG | UI2C_CTL_AA));
+
+    return 0;
+}
+
+/**
+  * @brief      Close a bus monitor
+  *
+  * @param[in]  psMon       The pointer of the monitor context.
+  *
+  * @return     None
+  */
+void UI2C_MON_Close(S_UI2C_MON_T *psMon)
+{
+    psMon->ui2c->PROTIEN = 0;
+    psMon->ui2c->PROTCTL &= ~(UI2C_PROTCTL_MONEN_Msk | UI2C_PROTCTL_SCLOUTEN_Msk);
+    UI2C_Close(psMon->ui2c);
+}
+
+/**
+  * @brief      Get the number of records in the ring
+  *
+  * @param[in]  psMon       The pointer of the monitor context.
+  *
+  * @return     Records ready to read
+  */
+uint32_t UI2C_MON_GetCount(S_UI2C_MON_T *psMon)
+{
+    return psMon->u32Head - psMon->u32Tail;
+}
+
+/**
+  * @brief      Take records from the ring
+  *
+  * @param[in]  psMon       The pointer of the monitor context.
+  * @param[out] pu32Buf     Records, in bus order.
+  * @param[in]  u32Max      Size of pu32Buf in records.
+  *
+  * @return     Number of records
+  *
+  * @details    The ring has one reader, call this API from one context only.
+  */
+uint32_t UI2C_MON_Read(S_UI2C_MON_T *psMon, uint32_t *pu32Buf, uint32_t u32Max)
+{
+    uint32_t u32Tail = psMon->u32Tail;
+    uint32_t u32Num = psMon->u32Head - u32Tail;
+    uint32_t i;
+
+    if (u32Num > u32Max)
+        u32Num = u32Max;
+
+    for (i = 0; i < u32Num; i++)
+        pu32Buf[i] = psMon->pu32Ring[(u32Tail + i) & psMon->u32Mask];
+
+    psMon->u32Tail = u32Tail + u32Num;
+
+    return u32Num;
+}
+
+/**
+  * @brief      Bus monitor interrupt service
+  *
+  * @param[in]  psMon       The pointer of the monitor context.
+  *
+  * @return     None
+  *
+  * @details    If the interrupt was late and several events are pending, a START on an idle bus is recorded
+  *             first, then the byte, the STOP and a following START.
+  */
+void UI2C_MON_IRQHandler(S_UI2C_MON_T *psMon)
+{
+    UI2C_T *ui2c = psMon->ui2c;
+    uint32_t u32Status = UI2C_GET_PROT_STATUS(ui2c);
+
+    UI2C_CLR_PROT_INT_FLAG(ui2c, u32Status & (UI2C_PROTSTS_STARIF_Msk | UI2C_PROTSTS_ACKIF_Msk | UI2C_PROTSTS_NACKIF_Msk |
+                                              UI2C_PROTSTS_STORIF_Msk | UI2C_PROTSTS_ARBLOIF_Msk | UI2C_PROTSTS_ERRIF_Msk |
+                                              UI2C_PROTSTS_TOIF_Msk));
+
+    if ((u32Status & UI2C_PROTSTS_STARIF_Msk) && (psMon->u32State == UI2C_MON_ST_IDLE))
+    {
+        UI2C_MON_Event(psMon, UI2C_MON_REC_START, 0, 0);
+        psMon->u32State = UI2C_MON_ST_ADDR;
+        u32Status &= ~UI2C_PROTSTS_STARIF_Msk;
+    }
+
+    if (u32Status & (UI2C_PROTSTS_ACKIF_Msk | UI2C_PROTSTS_NACKIF_Msk))
+    {
+        UI2C_MON_Event(psMon, (psMon->u32State == UI2C_MON_ST_ADDR) ? UI2C_MON_REC_ADDR : UI2C_MON_REC_DATA,
+                       (u32Status & UI2C_PROTSTS_NACKIF_Msk) ? 1UL : 0UL, UI2C_GET_DATA(ui2c));
+        psMon->u32State = UI2C_MON_ST_DATA;
+    }
+
+    if (u32Status & UI2C_PROTSTS_STORIF_Msk)
+    {
+        UI2C_MON_Event(psMon, UI2C_MON_REC_STOP, 0, 0);
+        psMon->u32State = UI2C_MON_ST_IDLE;
+    }
+
+    if (u32Status & UI2C_PROTSTS_STARIF_Msk)
+    {
+        UI2C_MON_Event(psMon, (psMon->u32State == UI2C_MON_ST_IDLE) ? UI2C_MON_REC_START : UI2C_MON_REC_RESTART, 0, 0);
+        psMon->u32State = UI2C_MON_ST_ADDR;
+    }
+
+    UI2C_SET_CONTROL_REG(ui2c, (UI2C_CTL_PTRG | UI2C_CTL_AA));
+}
+
+/**
+  * @brief      Reset bus statistics
+  *
+  * @param[in]  psStat      The pointer of the statistics.
+  *
+  * @return     None
+  */
+void UI2C_MON_StatInit(S_UI2C_MON_STAT_T *psStat)
+{
+    uint32_t i;
+
+    for (i = 0; i < UI2C_MON_STAT_NUM; i++)
+    {
+        psStat->asAddr[i].u8Addr = 0;
+        psStat->asAddr[i].u32Xfers = 0;
+        psStat->asAddr[i].u32Bytes = 0;
+        psStat->asAddr[i].u32Nacks = 0;
+        psStat->asAddr[i].u32TotalTime = 0;
+        psStat->asAddr[i].u32MaxTime = 0;
+    }
+
+    psStat->u32AddrNum = 0;
+    psStat->u32OtherXfers = 0;
+    psStat->u32High = 0;
+    psStat->u32First = 0;
+    psStat->u32Last = 0;
+    psStat->u32Start = 0;
+    psStat->u32Busy = 0;
+    psStat->u32Cur = UI2C_MON_STAT_NUM;
+    psStat->u32Open = 0;
+    psStat->u32Lost = 0;
+    psStat->u32Events = 0;
+}
+
+/**
+  * @brief      Decode records into bus statistics
+  *
+  * @param[in]  psStat      The pointer of the statistics.
+  * @param[in]  pu32Rec     Records in bus order.
+  * @param[in]  u32Num      Number of records.
+  *
+  * @return     None
+  *
+  * @details    A transaction runs from START to STOP, its time is the latency seen by the master. It counts for
+  *             the first address after the START. This API only uses the records, it could also decode a
+  *             record stream on another machine. A LOST record drops the open transaction.
+  */
+void UI2C_MON_StatFeed(S_UI2C_MON_STAT_T *psStat, const uint32_t *pu32Rec, uint32_t u32Num)
+{
+    S_UI2C_MON_ADDR_STAT_T *psAddr;
+    uint32_t u32Rec, u32Time, u32Len;
+
+    while (u32Num--)
+    {
+        u32Rec = *pu32Rec++;
+
+        if (UI2C_MON_REC_TYPE(u32Rec) == UI2C_MON_REC_TIME)
+        {
+            psStat->u32High = UI2C_MON_REC_COUNT(u32Rec) & 0xFFFUL;
+            continue;
+        }
+
+        if (UI2C_MON_REC_TYPE(u32Rec) == UI2C_MON_REC_LOST)
+        {
+            psStat->u32Lost += UI2C_MON_REC_COUNT(u32Rec);
+            psStat->u32Open = 0;
+            psStat->u32Cur = UI2C_MON_STAT_NUM;
+            continue;
+        }
+
+        u32Time = (psStat->u32High << 20) | UI2C_MON_REC_TIMEL(u32Rec);
+
+        if (psStat->u32Events++ == 0)
+            psStat->u32First = u32Time;
+
+        psStat->u32Last = u32Time;
+        psAddr = (psStat->u32Cur < UI2C_MON_STAT_NUM) ? &psStat->asAddr[psStat->u32Cur] : NULL;
+
+        switch (UI2C_MON_REC_TYPE(u32Rec))
+        {
+            case UI2C_MON_REC_START:
+                psStat->u32Open = 1;
+                psStat->u32Start = u32Time;
+                psStat->u32Cur = UI2C_MON_STAT_NUM;
+                break;
+
+            case UI2C_MON_REC_ADDR:
+                if (psStat->u32Open && (psStat->u32Cur == UI2C_MON_STAT_NUM))
+                {
+                    psStat->u32Cur = UI2C_MON_StatEntry(psStat, UI2C_MON_REC_BYTE(u32Rec) >> 1);
+                    psAddr = (psStat->u32Cur < UI2C_MON_STAT_NUM) ? &psStat->asAddr[psStat->u32Cur] : NULL;
+
+                    if (psAddr != NULL)
+                        psAddr->u32Xfers++;
+                    else
+                        psStat->u32OtherXfers++;
+                }
+
+                if ((psAddr != NULL) && UI2C_MON_REC_NACK(u32Rec))
+                    psAddr->u32Nacks++;
+
+                break;
+
+            case UI2C_MON_REC_DATA:
+                if (psAddr != NULL)
+                    psAddr->u32Bytes++;
+
+                break;
+
+            case UI2C_MON_REC_STOP:
+                if (psStat->u32Open)
+                {
+                    u32Len = u32Time - psStat->u32Start;
+                    psStat->u32Busy += u32Len;
+
+                    if (psAddr != NULL)
+                    {
+                        psAddr->u32TotalTime += u32Len;
+
+                        if (u32Len > psAddr->u32MaxTime)
+                            psAddr->u32MaxTime = u32Len;
+                    }
+                }
+
+                psStat->u32Open = 0;
+                psStat->u32Cur = UI2C_MON_STAT_NUM;
+                break;
+
+            default:                                    /* Repeated START continues the transaction */
+                break;
+        }
+    }
+}
+
+/**
+  * @brief      Get the bus utilization
+  *
+  * @param[in]  psStat      The pointer of the statistics.
+  *
+  * @return     Time between START and STOP in 0.1 % of the decoded time span
+  */
+uint32_t UI2C_MON_StatUtilization(S_UI2C_MON_STAT_T *psStat)
+{
+    uint32_t u32Span = psStat->u32Last - psStat->u32First;
+
+    if (u32Span == 0)
+        return 0;
+
+    return (uint32_t)(((uint64_t)psStat->u32Busy * 1000UL) / u32Span);
+}
+
+/*@}*/ /* end of group UI2C_MON_EXPORTED_FUNCTIONS */
+
+/*@}*/ /* end of group UI2C_MON_Driver */
+
+/*@}*/ /* end of group Standard_Driver */
+
+/*** (C) COPYRIGHT 2021 Nuvoton Technology Corp. ***/
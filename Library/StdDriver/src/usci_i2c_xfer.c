@@ -0,0 +1,178 @@
+/**************************************************************************//**
+ * @file     usci_i2c_xfer.c
+ * @version  V1.00
+ * @brief    NUC121 series USCI_I2C back-end of the I2C master transaction queue source file
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * @copyright (C) 2021 Nuvoton Technology Corp. All rights reserved.
+*****************************************************************************/
+#include "NuMicro.h"
+
+/** @addtogroup Standard_Driver Standard Driver
+  @{
+*/
+
+/** @addtogroup I2C_XFER_Driver I2C_XFER Driver
+  @{
+*/
+
+/// @cond HIDDEN_SYMBOLS
+
+#define UI2C_XFER_INT_MASK      (UI2C_TO_INT_MASK | UI2C_STAR_INT_MASK | UI2C_NACK_INT_MASK | \
+                                 UI2C_ARBLO_INT_MASK | UI2C_ERR_INT_MASK | UI2C_ACK_INT_MASK)
+
+#define UI2C_XFER_TIMEOUT_CNT   (0x3FFUL)
+
+static uint32_t UI2C_XFER_HwOpen(S_I2C_XFER_BUS_T *psBus)
+{
+    uint32_t u32Clk = UI2C_Open((UI2C_T *)psBus->pvPort, psBus->u32BusClock);
+
+    UI2C_EnableInt((UI2C_T *)psBus->pvPort, UI2C_XFER_INT_MASK);
+
+    return u32Clk;
+}
+
+static void UI2C_XFER_HwClose(S_I2C_XFER_BUS_T *psBus)
+{
+    UI2C_DisableInt((UI2C_T *)psBus->pvPort, UI2C_XFER_INT_MASK);
+    UI2C_DisableTimeout((UI2C_T *)psBus->pvPort);
+    UI2C_Close((UI2C_T *)psBus->pvPort);
+    SYS_ResetModule(USCI0_RST);
+}
+
+/* One flag per call, the interrupt stays pending while other flags are set */
+static uint32_t UI2C_XFER_HwEvent(S_I2C_XFER_BUS_T *psBus)
+{
+    UI2C_T *ui2c = (UI2C_T *)psBus->pvPort;
+    uint32_t u32Status = UI2C_GET_PROT_STATUS(ui2c);
+
+    /* STOP is not waited for, the next START is queued behind it */
+    if (u32Status & UI2C_PROTSTS_STORIF_Msk)
+        UI2C_CLR_PROT_INT_FLAG(ui2c, UI2C_PROTSTS_STORIF_Msk);
+
+    if (u32Status & UI2C_PROTSTS_TOIF_Msk)
+    {
+        UI2C_CLR_PROT_INT_FLAG(ui2c, UI2C_PROTSTS_TOIF_Msk);
+        return I2C_XFER_EV_TIMEOUT;
+    }
+
+    if (u32Status & UI2C_PROTSTS_ARBLOIF_Msk)
+    {
+        UI2C_CLR_PROT_INT_FLAG(ui2c, UI2C_PROTSTS_ARBLOIF_Msk);
+        return I2C_XFER_EV_ARB;
+    }
+
+    if (u32Status & UI2C_PROTSTS_ERRIF_Msk)
+    {
+        UI2C_CLR_PROT_INT_FLAG(ui2c, UI2C_PROTSTS_ERRIF_Msk);
+        return I2C_XFER_EV_BUS;
+    }
+
+    if (u32Status & UI2C_PROTSTS_STARIF_Msk)
+    {
+        UI2C_CLR_PROT_INT_FLAG(ui2c, UI2C_PROTSTS_STARIF_Msk);
+        return I2C_XFER_EV_START;
+    }
+
+    if (u32Status & UI2C_PROTSTS_NACKIF_Msk)
+    {
+        UI2C_CLR_PROT_INT_FLAG(ui2c, UI2C_PROTSTS_NACKIF_Msk);
+        return I2C_XFER_EV_NACK;
+    }
+
+    if (u32Status & UI2C_PROTSTS_ACKIF_Msk)
+    {
+        UI2C_CLR_PROT_INT_FLAG(ui2c, UI2C_PROTSTS_ACKIF_Msk);
+        return I2C_XFER_EV_ACK;
+    }
+
+    return I2C_XFER_EV_NONE;
+}
+
+static void UI2C_XFER_HwCtrl(S_I2C_XFER_BUS_T *psBus, uint32_t u32Ctrl)
+{
+    UI2C_T *ui2c = (UI2C_T *)psBus->pvPort;
+    uint32_t u32Reg = 0;
+
+    if (u32Ctrl & I2C_XFER_CTL_ACK)
+        u32Reg |= UI2C_CTL_PTRG;
+
+    if (u32Ctrl & I2C_XFER_CTL_STO)
+        u32Reg |= UI2C_CTL_STO;
+
+    if (u32Ctrl & I2C_XFER_CTL_AA)
+        u32Reg |= UI2C_CTL_AA;
+
+    if ((u32Ctrl & I2C_XFER_CTL_STA) == 0)
+        UI2C_SET_CONTROL_REG(ui2c, u32Reg);
+    else if ((u32Ctrl & I2C_XFER_CTL_STO) == 0)
+        UI2C_SET_CONTROL_REG(ui2c, u32Reg | UI2C_CTL_STA);
+    else
+    {
+        /* STOP then START, as two blocking UI2C functions called back to back */
+        UI2C_SET_CONTROL_REG(ui2c, u32Reg);
+        UI2C_START(ui2c);
+    }
+}
+
+static void UI2C_XFER_HwWrite(S_I2C_XFER_BUS_T *psBus, uint8_t u8Data)
+{
+    UI2C_SET_DATA((UI2C_T *)psBus->pvPort, u8Data);
+}
+
+static uint8_t UI2C_XFER_HwRead(S_I2C_XFER_BUS_T *psBus)
+{
+    return (uint8_t)UI2C_GET_DATA((UI2C_T *)psBus->pvPort);
+}
+
+static void UI2C_XFER_HwTimeout(S_I2C_XFER_BUS_T *psBus, uint32_t u32En)
+{
+    if (u32En)
+        UI2C_EnableTimeout((UI2C_T *)psBus->pvPort, UI2C_XFER_TIMEOUT_CNT);
+    else
+        UI2C_DisableTimeout((UI2C_T *)psBus->pvPort);
+}
+
+/* USCI_I2C has no PDMA request, every byte is moved by the interrupt */
+static const S_I2C_XFER_OPS_T s_sUI2CXferOps =
+{
+    UI2C_XFER_HwOpen,
+    UI2C_XFER_HwClose,
+    UI2C_XFER_HwEvent,
+    UI2C_XFER_HwCtrl,
+    UI2C_XFER_HwWrite,
+    UI2C_XFER_HwRead,
+    UI2C_XFER_HwTimeout,
+    NULL
+};
+
+/// @endcond HIDDEN_SYMBOLS
+
+/** @addtogroup I2C_XFER_EXPORTED_FUNCTIONS I2C_XFER Exported Functions
+  @{
+*/
+
+/**
+  * @brief      Open a USCI_I2C controller as a queued master
+  *
+  * @param[in]  psBus       The pointer of the bus context.
+  * @param[in]  ui2c        USCI_I2C controller, UI2C0.
+  * @param[in]  u32BusClock Target bus clock in Hz.
+  *
+  * @return     Actual bus clock in Hz
+  *
+  * @details    Same queue and state machine as \ref I2C_XFER_Open. Enable USCI_IRQn and call
+  *             \ref I2C_XFER_IRQHandler from USCI_IRQHandler. \ref I2C_XFER_EnablePDMA is not supported.
+  */
+uint32_t UI2C_XFER_Open(S_I2C_XFER_BUS_T *psBus, UI2C_T *ui2c, uint32_t u32BusClock)
+{
+    return I2C_XFER_OpenBackend(psBus, ui2c, &s_sUI2CXferOps, u32BusClock);
+}
+
+/*@}*/ /* end of group I2C_XFER_EXPORTED_FUNCTIONS */
+
+/*@}*/ /* end of group I2C_XFER_Driver */
+
+/*@}*/ /* end of group Standard_Driver */
+
+/*** (C) COPYRIGHT 2021 Nuvoton Technology Corp. ***/
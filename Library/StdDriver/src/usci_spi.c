@@ -16,6 +16,165 @@
   @{
 */
 
+/// @cond HIDDEN_SYMBOLS
+
+/* Frames in flight, the transmit buffer and the shift register, so the receive buffer never overruns */
+#define USPI_XFER_INFLIGHT      (2UL)
+
+static void USPI_XferCsActive(S_USPI_XFER_T *psXfer)
+{
+    if (psXfer->u32CsActive == 0)
+    {
+        USPI_SET_SS_LOW(psXfer->uspi);
+        psXfer->u32CsActive = 1;
+    }
+}
+
+static void USPI_XferEnd(S_USPI_XFER_T *psXfer)
+{
+    while (USPI_IS_BUSY(psXfer->uspi));
+
+    if ((psXfer->u32Flags & USPI_XFER_CS_HOLD) == 0)
+    {
+        USPI_SET_SS_HIGH(psXfer->uspi);
+        psXfer->u32CsActive = 0;
+    }
+
+    /* Not busy before the callback, so it could start the next segment */
+    psXfer->u32Busy = 0;
+
+    if (psXfer->pfnDone != NULL)
+        psXfer->pfnDone(psXfer);
+}
+
+/* Keep both buffer levels loaded */
+static void USPI_XferFill(S_USPI_XFER_T *psXfer)
+{
+    USPI_T *uspi = psXfer->uspi;
+    uint32_t u32Data;
+
+    while ((psXfer->u32TxCnt < psXfer->u32Len) && ((psXfer->u32TxCnt - psXfer->u32RxCnt) < USPI_XFER_INFLIGHT) &&
+            ((uspi->BUFSTS & USPI_BUFSTS_TXFULL_Msk) == 0))
+    {
+        if (psXfer->pvTx == NULL)
+            u32Data = USPI_XFER_DUMMY;
+        else if (psXfer->u32Wide)
+            u32Data = ((const uint16_t *)psXfer->pvTx)[psXfer->u32TxCnt];
+        else
+            u32Data = ((const uint8_t *)psXfer->pvTx)[psXfer->u32TxCnt];
+
+        USPI_WRITE_TX(uspi, u32Data);
+        psXfer->u32TxCnt++;
+    }
+}
+
+static void USPI_XferDrain(S_USPI_XFER_T *psXfer)
+{
+    USPI_T *uspi = psXfer->uspi;
+    uint32_t u32Data;
+
+    while ((uspi->BUFSTS & USPI_BUFSTS_RXEMPTY_Msk) == 0)
+    {
+        u32Data = USPI_READ_RX(uspi);
+
+        if (psXfer->u32RxCnt >= psXfer->u32Len)
+            continue;
+
+        if (psXfer->pvRx != NULL)
+        {
+            if (psXfer->u32Wide)
+                ((uint16_t *)psXfer->pvRx)[psXfer->u32RxCnt] = (uint16_t)u32Data;
+            else
+                ((uint8_t *)psXfer->pvRx)[psXfer->u32RxCnt] = (uint8_t)u32Data;
+        }
+
+        psXfer->u32RxCnt++;
+    }
+}
+
+/* Move the next block of up to USPI_XFER_PDMA_MAX frames */
+static void USPI_XferStartPDMA(S_USPI_XFER_T *psXfer)
+{
+    USPI_T *uspi = psXfer->uspi;
+    uint32_t u32Width = psXfer->u32Wide ? PDMA_WIDTH_16 : PDMA_WIDTH_8;
+    uint32_t u32Offset = psXfer->u32RxCnt << psXfer->u32Wide;
+    uint32_t u32Len = psXfer->u32Len - psXfer->u32RxCnt;
+
+    if (u32Len > USPI_XFER_PDMA_MAX)
+        u32Len = USPI_XFER_PDMA_MAX;
+
+    psXfer->u32PdmaLen = u32Len;
+
+    PDMA_SetTransferCnt(psXfer->u32PdmaRxCh, u32Width, u32Len);
+
+    if (psXfer->pvRx != NULL)
+        PDMA_SetTransferAddr(psXfer->u32PdmaRxCh, (uint32_t)&uspi->RXDAT, PDMA_SAR_FIX, (uint32_t)psXfer->pvRx + u32Offset, PDMA_DAR_INC);
+    else
+        PDMA_SetTransferAddr(psXfer->u32PdmaRxCh, (uint32_t)&uspi->RXDAT, PDMA_SAR_FIX, (uint32_t)&psXfer->u32DummyRx, PDMA_DAR_FIX);
+
+    PDMA_SetTransferMode(psXfer->u32PdmaRxCh, PDMA_USCI0_RX, FALSE, 0);
+    PDMA_SetBurstType(psXfer->u32PdmaRxCh, PDMA_REQ_SINGLE, 0);
+
+    PDMA_SetTransferCnt(psXfer->u32PdmaTxCh, u32Width, u32Len);
+
+    if (psXfer->pvTx != NULL)
+        PDMA_SetTransferAddr(psXfer->u32PdmaTxCh, (uint32_t)psXfer->pvTx + u32Offset, PDMA_SAR_INC, (uint32_t)&uspi->TXDAT, PDMA_DAR_FIX);
+    else
+        PDMA_SetTransferAddr(psXfer->u32PdmaTxCh, (uint32_t)&psXfer->u32DummyTx, PDMA_SAR_FIX, (uint32_t)&uspi->TXDAT, PDMA_DAR_FIX);
+
+    PDMA_SetTransferMode(psXfer->u32PdmaTxCh, PDMA_USCI0_TX, FALSE, 0);
+    PDMA_SetBurstType(psXfer->u32PdmaTxCh, PDMA_REQ_SINGLE, 0);
+
+    USPI_ENABLE_PDMA(uspi);
+}
+
+/* Receive done means the block is on the bus, start the next one or finish */
+static void USPI_XferPDMADone(S_USPI_XFER_T *psXfer)
+{
+    PDMA_CLR_TD_FLAG((1UL << psXfer->u32PdmaRxCh) | (1UL << psXfer->u32PdmaTxCh));
+    USPI_DISABLE_PDMA(psXfer->uspi);
+
+    psXfer->u32RxCnt += psXfer->u32PdmaLen;
+    psXfer->u32TxCnt = psXfer->u32RxCnt;
+
+    if (psXfer->u32RxCnt < psXfer->u32Len)
+        USPI_XferStartPDMA(psXfer);
+    else
+    {
+        PDMA_DisableInt(psXfer->u32PdmaRxCh, PDMA_INT_TRANS_DONE);
+        USPI_XferEnd(psXfer);
+    }
+}
+
+/* Returns -1 if busy, 1 if the transfer runs by PDMA, otherwise 0 */
+static int32_t USPI_XferStart(S_USPI_XFER_T *psXfer, const void *pvTx, void *pvRx, uint32_t u32Len, uint32_t u32Flags,
+                              USPI_XFER_CB pfnDone, void *pvArg)
+{
+    USPI_T *uspi = psXfer->uspi;
+    uint32_t u32Width = (uspi->LINECTL & USPI_LINECTL_DWIDTH_Msk) >> USPI_LINECTL_DWIDTH_Pos;
+
+    if (psXfer->u32Busy)
+        return -1;
+
+    psXfer->pvTx = pvTx;
+    psXfer->pvRx = pvRx;
+    psXfer->u32Len = u32Len;
+    psXfer->u32TxCnt = 0;
+    psXfer->u32RxCnt = 0;
+    psXfer->u32Flags = u32Flags;
+    psXfer->u32Wide = ((u32Width == 0) || (u32Width > 8)) ? 1 : 0;
+    psXfer->pfnDone = pfnDone;
+    psXfer->pvArg = pvArg;
+    psXfer->u32Busy = 1;
+
+    USPI_ClearRxBuf(uspi);
+    USPI_XferCsActive(psXfer);
+
+    return ((psXfer->u32PdmaRxCh != USPI_XFER_NO_PDMA) && (u32Len >= psXfer->u32PdmaMin)) ? 1 : 0;
+}
+
+/// @endcond HIDDEN_SYMBOLS
+
 /** @addtogroup USPI_EXPORTED_FUNCTIONS USPI Exported Functions
   @{
 */
@@ -489,6 +648,179 @@ void USPI_DisableWakeup(USPI_T *uspi)
     uspi->WKCTL &= ~USPI_WKCTL_WKEN_Msk;
 }
 
+/**
+  * @brief  Initialize a transfer context.
+  * @param[in]  psXfer The pointer of the transfer context.
+  * @param[in]  uspi The pointer of the USPI module opened as master by \ref USPI_Open.
+  * @return None
+  * @details The transfer API drives USCI_SPI_SS itself, the automatic slave select function is disabled.
+  */
+void USPI_XferInit(S_USPI_XFER_T *psXfer, USPI_T *uspi)
+{
+    psXfer->uspi = uspi;
+    psXfer->u32Busy = 0;
+    psXfer->u32CsActive = 0;
+    psXfer->u32PdmaTxCh = USPI_XFER_NO_PDMA;
+    psXfer->u32PdmaRxCh = USPI_XFER_NO_PDMA;
+    psXfer->u32PdmaMin = 0;
+    psXfer->u32DummyTx = USPI_XFER_DUMMY;
+    psXfer->pfnDone = NULL;
+    psXfer->pvArg = NULL;
+
+    USPI_SET_SS_HIGH(uspi);
+}
+
+/**
+  * @brief  Move long transfers by PDMA.
+  * @param[in]  psXfer The pointer of the transfer context.
+  * @param[in]  u32TxCh PDMA channel for transmit. Valid values are between 0~4.
+  * @param[in]  u32RxCh PDMA channel for receive. Valid values are between 0~4.
+  * @param[in]  u32MinLen Transfers of at least u32MinLen frames use PDMA, shorter ones are cheaper by CPU.
+  * @retval 0 Success
+  * @retval -1 Invalid channel
+  * @details For \ref USPI_TransferAsync, enable PDMA_IRQn and call \ref USPI_XferPDMAHandler from PDMA_IRQHandler.
+  */
+int32_t USPI_XferEnablePDMA(S_USPI_XFER_T *psXfer, uint32_t u32TxCh, uint32_t u32RxCh, uint32_t u32MinLen)
+{
+    if ((u32TxCh >= PDMA_CH_MAX) || (u32RxCh >= PDMA_CH_MAX) || (u32TxCh == u32RxCh))
+        return -1;
+
+    PDMA_Open((1UL << u32TxCh) | (1UL << u32RxCh));
+    psXfer->u32PdmaTxCh = u32TxCh;
+    psXfer->u32PdmaRxCh = u32RxCh;
+    psXfer->u32PdmaMin = (u32MinLen != 0) ? u32MinLen : 1;
+
+    return 0;
+}
+
+/**
+  * @brief  Full-duplex transfer, wait until it is done.
+  * @param[in]  psXfer The pointer of the transfer context.
+  * @param[in]  pvTx Transmit frames, NULL sends \ref USPI_XFER_DUMMY.
+  * @param[out] pvRx Receive frames, NULL discards them.
+  * @param[in]  u32Len Number of frames. Frames are uint8_t for data width up to 8 bits, otherwise uint16_t.
+  * @param[in]  u32Flags 0 or \ref USPI_XFER_CS_HOLD.
+  * @retval 0 Success
+  * @retval -1 A transfer is running
+  * @details USCI_SPI_SS goes active at the first transfer and stays active while \ref USPI_XFER_CS_HOLD is given,
+  *          so a command and its data could come from different buffers. Without PDMA the CPU keeps the transmit
+  *          buffer and the shift register loaded, so frames go out back to back.
+  */
+int32_t USPI_Transfer(S_USPI_XFER_T *psXfer, const void *pvTx, void *pvRx, uint32_t u32Len, uint32_t u32Flags)
+{
+    int32_t i32Mode = USPI_XferStart(psXfer, pvTx, pvRx, u32Len, u32Flags, NULL, NULL);
+
+    if (i32Mode < 0)
+        return -1;
+
+    if (i32Mode > 0)
+    {
+        PDMA_DisableInt(psXfer->u32PdmaRxCh, PDMA_INT_TRANS_DONE);
+        USPI_XferStartPDMA(psXfer);
+
+        while (psXfer->u32Busy)
+        {
+            if (PDMA_GET_TD_STS() & (1UL << psXfer->u32PdmaRxCh))
+                USPI_XferPDMADone(psXfer);
+        }
+    }
+    else
+    {
+        while (psXfer->u32RxCnt < psXfer->u32Len)
+        {
+            USPI_XferFill(psXfer);
+            USPI_XferDrain(psXfer);
+        }
+
+        USPI_XferEnd(psXfer);
+    }
+
+    return 0;
+}
+
+/**
+  * @brief  Full-duplex transfer in the background.
+  * @param[in]  psXfer The pointer of the transfer context.
+  * @param[in]  pvTx Transmit frames, NULL sends \ref USPI_XFER_DUMMY.
+  * @param[out] pvRx Receive frames, NULL discards them.
+  * @param[in]  u32Len Number of frames. Frames are uint8_t for data width up to 8 bits, otherwise uint16_t.
+  * @param[in]  u32Flags 0 or \ref USPI_XFER_CS_HOLD.
+  * @param[in]  pfnDone Called from the interrupt when the transfer is done, could be NULL.
+  * @param[in]  pvArg Stored in the transfer context for pfnDone.
+  * @retval 0 Success
+  * @retval -1 A transfer is running
+  * @details Enable USCI_IRQn and call \ref USPI_XferIRQHandler from USCI_IRQHandler. Transfers moved by PDMA
+  *          complete in \ref USPI_XferPDMAHandler. Poll \ref USPI_XFER_IS_BUSY or wait for pfnDone.
+  */
+int32_t USPI_TransferAsync(S_USPI_XFER_T *psXfer, const void *pvTx, void *pvRx, uint32_t u32Len, uint32_t u32Flags,
+                           USPI_XFER_CB pfnDone, void *pvArg)
+{
+    int32_t i32Mode = USPI_XferStart(psXfer, pvTx, pvRx, u32Len, u32Flags, pfnDone, pvArg);
+
+    if (i32Mode < 0)
+        return -1;
+
+    if (i32Mode > 0)
+    {
+        PDMA_EnableInt(psXfer->u32PdmaRxCh, PDMA_INT_TRANS_DONE);
+        USPI_XferStartPDMA(psXfer);
+    }
+    else if (u32Len == 0)
+        USPI_XferEnd(psXfer);
+    else
+    {
+        USPI_CLR_PROT_INT_FLAG(psXfer->uspi, USPI_PROTSTS_RXENDIF_Msk);
+        psXfer->uspi->INTEN |= USPI_INTEN_RXENDIEN_Msk;
+        USPI_XferFill(psXfer);
+    }
+
+    return 0;
+}
+
+/**
+  * @brief  Transfer interrupt service.
+  * @param[in]  psXfer The pointer of the transfer context.
+  * @return None
+  * @details Call this API from USCI_IRQHandler. Each received frame is replaced by the next one to send.
+  */
+void USPI_XferIRQHandler(S_USPI_XFER_T *psXfer)
+{
+    USPI_T *uspi = psXfer->uspi;
+
+    if ((uspi->PROTSTS & USPI_PROTSTS_RXENDIF_Msk) == 0)
+        return;
+
+    USPI_CLR_PROT_INT_FLAG(uspi, USPI_PROTSTS_RXENDIF_Msk);
+
+    if ((psXfer->u32Busy == 0) || ((uspi->INTEN & USPI_INTEN_RXENDIEN_Msk) == 0))
+        return;
+
+    USPI_XferDrain(psXfer);
+
+    if (psXfer->u32RxCnt < psXfer->u32Len)
+        USPI_XferFill(psXfer);
+    else
+    {
+        uspi->INTEN &= ~USPI_INTEN_RXENDIEN_Msk;
+        USPI_XferEnd(psXfer);
+    }
+}
+
+/**
+  * @brief  Transfer PDMA interrupt service.
+  * @param[in]  psXfer The pointer of the transfer context.
+  * @return None
+  * @details Call this API from PDMA_IRQHandler. Only the transfer done flags of the transfer channels are cleared.
+  */
+void USPI_XferPDMAHandler(S_USPI_XFER_T *psXfer)
+{
+    if ((psXfer->u32Busy == 0) || (psXfer->u32PdmaRxCh == USPI_XFER_NO_PDMA))
+        return;
+
+    if (PDMA_GET_TD_STS() & (1UL << psXfer->u32PdmaRxCh))
+        USPI_XferPDMADone(psXfer);
+}
+
 /*@}*/ /* end of group USPI_EXPORTED_FUNCTIONS */
 
 /*@}*/ /* end of group USPI_Driver */
@@ -0,0 +1,215 @@
+/**************************************************************************//**
+ * @file     main.c
+ * @version  V1.00
+ * @brief    Scale HCLK with the CPU load while keeping UART and timebase intact.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * @copyright (C) 2021 Nuvoton Technology Corp. All rights reserved.
+ ******************************************************************************/
+#include <stdio.h>
+#include "NuMicro.h"
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Macro, type and constant definitions                                                                    */
+/*---------------------------------------------------------------------------------------------------------*/
+#define WINDOW_MS       100             /* Load measurement window */
+#define LIGHT_WORK      2000            /* Work units per window in the light phase */
+#define HEAVY_WORK      300000          /* Work units per window in the heavy phase */
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Global Interface Variables Declarations                                                                 */
+/*---------------------------------------------------------------------------------------------------------*/
+static const S_CLK_GOV_LEVEL_T s_asLevels[] =
+{
+    { CLK_CLKSEL0_HCLKSEL_HIRC, CLK_CLKDIV0_HCLK(4), 0 },           /* 12 MHz */
+    { CLK_CLKSEL0_HCLKSEL_HIRC, CLK_CLKDIV0_HCLK(2), 0 },           /* 24 MHz */
+    { CLK_CLKSEL0_HCLKSEL_HIRC, CLK_CLKDIV0_HCLK(1), 0 },           /* 48 MHz */
+    { CLK_CLKSEL0_HCLKSEL_PLL,  CLK_CLKDIV0_HCLK(2), 50000000 },    /* 50 MHz */
+};
+
+#define LEVEL_NUM       (sizeof(s_asLevels) / sizeof(s_asLevels[0]))
+
+static S_SWTIMER_T s_sWindow;
+static S_CLK_GOV_NOTIFIER_T s_sUartNotifier;
+
+volatile uint32_t g_u32WindowCount = 0;
+
+
+/**
+ * @brief       Timer0 IRQ
+ *
+ * @param       None
+ *
+ * @return      None
+ *
+ * @details     The Timer0 default IRQ, declared in startup_NUC121.s.
+ */
+void TMR0_IRQHandler(void)
+{
+    SWTIMER_IRQHandler();
+}
+
+void WindowTick(void *pvArg)
+{
+    (void)pvArg;
+    g_u32WindowCount++;
+}
+
+void SYS_Init(void)
+{
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Init System Clock                                                                                       */
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Enable HIRC clock */
+    CLK_EnableXtalRC(CLK_PWRCTL_HIRCEN_Msk);
+
+    /* Waiting for HIRC clock ready */
+    CLK_WaitClockReady(CLK_STATUS_HIRCSTB_Msk);
+
+    /* Switch HCLK clock source to HIRC */
+    CLK_SetHCLK(CLK_CLKSEL0_HCLKSEL_HIRC, CLK_CLKDIV0_HCLK(1));
+
+    /*------------------------------------------------------------------------------------------------------*/
+    /* Enable Module Clock                                                                                  */
+    /*------------------------------------------------------------------------------------------------------*/
+    /* Enable peripheral clock */
+    CLK_EnableModuleClock(UART0_MODULE);
+    CLK_EnableModuleClock(TMR0_MODULE);
+
+    /* UART0 and TIMER0 are clocked from HIRC/2, so they do not depend on the HCLK chosen by the governor */
+    CLK_SetModuleClock(UART0_MODULE, CLK_CLKSEL1_UARTSEL_HIRC_DIV2, CLK_CLKDIV0_UART(1));
+    CLK_SetModuleClock(TMR0_MODULE, CLK_CLKSEL1_TMR0SEL_HIRC_DIV2, 0);
+
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Init I/O Multi-function                                                                                 */
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* PB.0 is UART0_RX */
+    SYS->GPB_MFPL &= ~SYS_GPB_MFPL_PB0MFP_Msk;
+    SYS->GPB_MFPL |= (1 << SYS_GPB_MFPL_PB0MFP_Pos);
+    /* PB.1 is UART0_TX */
+    SYS->GPB_MFPL &= ~SYS_GPB_MFPL_PB1MFP_Msk;
+    SYS->GPB_MFPL |= (1 << SYS_GPB_MFPL_PB1MFP_Pos);
+
+}
+
+void UART0_Init(void)
+{
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Init UART                                                                                               */
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Reset UART module */
+    SYS_ResetModule(UART0_RST);
+
+    /* Configure UART0 and set UART0 Baudrate */
+    UART_Open(UART0, 115200);
+}
+
+/* A fixed amount of CPU work, so it takes longer at lower HCLK */
+void DoWork(uint32_t u32Units)
+{
+    volatile uint32_t u32Acc = 0;
+
+    while (u32Units-- != 0)
+        u32Acc += u32Units;
+}
+
+/* Run one window of the given work and return the load in percent */
+uint32_t RunWindow(uint32_t u32Units)
+{
+    uint32_t u32Window = g_u32WindowCount;
+    uint32_t u32Start = SWTIMER_GetTime(), u32Busy;
+
+    DoWork(u32Units);
+    u32Busy = SWTIMER_GetTime() - u32Start;
+
+    /* Rest of the window is idle */
+    while (g_u32WindowCount == u32Window);
+
+    if (u32Busy >= SWTIMER_MS_TO_COUNT(WINDOW_MS))
+        return 100;
+
+    return (u32Busy * 100) / SWTIMER_MS_TO_COUNT(WINDOW_MS);
+}
+
+/* Run a load phase and return the level reached at its end */
+uint32_t RunPhase(char *pcName, uint32_t u32Units, uint32_t u32Windows)
+{
+    uint32_t i, u32Load = 0;
+
+    for (i = 0; i < u32Windows; i++)
+    {
+        u32Load = RunWindow(u32Units);
+        CLK_GOV_SetLoad(u32Load);
+    }
+
+    printf("  %s phase: load %3d%%, level %d, HCLK %8d Hz\n", pcName, u32Load, CLK_GOV_GetLevel(), SystemCoreClock);
+
+    return CLK_GOV_GetLevel();
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/*  MAIN function                                                                                          */
+/*---------------------------------------------------------------------------------------------------------*/
+int main(void)
+{
+    const S_CLK_GOV_STAT_T *psStat;
+    uint32_t u32LightLevel, u32HeavyLevel, u32HoldLevel, i;
+
+    /* Unlock protected registers */
+    SYS_UnlockReg();
+
+    /* Init System, peripheral clock and multi-function I/O */
+    SYS_Init();
+
+    /* Lock protected registers */
+    SYS_LockReg();
+
+    /* Init UART0 for printf */
+    UART0_Init();
+
+    printf("\n\nCPU @ %d Hz\n", SystemCoreClock);
+    printf("+--------------------------------------------+\n");
+    printf("|     Clock Frequency Governor Sample Code   |\n");
+    printf("+--------------------------------------------+\n\n");
+
+    SWTIMER_Open(TIMER0);
+    NVIC_EnableIRQ(TMR0_IRQn);
+    SWTIMER_Start(&s_sWindow, SWTIMER_MS_TO_COUNT(WINDOW_MS), SWTIMER_MS_TO_COUNT(WINDOW_MS), WindowTick, NULL);
+
+    /* UART0 keeps its baud rate on its own, but the notifier drains TX before every change */
+    CLK_GOV_RegisterNotifier(&s_sUartNotifier, CLK_GOV_NotifyUART, UART0, 115200);
+
+    CLK_GOV_Init(s_asLevels, LEVEL_NUM, SWTIMER_GetTime);
+
+    for (i = 0; i < 2; i++)
+    {
+        printf("Round %d\n", i);
+        u32LightLevel = RunPhase("Light", LIGHT_WORK, 10);
+        u32HeavyLevel = RunPhase("Heavy", HEAVY_WORK, 3);
+    }
+
+    /* A hold keeps a minimum level, for example during a fast serial session */
+    CLK_GOV_Hold(2);
+    u32HoldLevel = RunPhase("Held ", LIGHT_WORK, 10);
+    CLK_GOV_Release(2);
+
+    psStat = CLK_GOV_GetStat();
+
+    printf("\n  %d transitions, last %d us, max %d us\n", psStat->u32Transitions, psStat->u32LastTime, psStat->u32MaxTime);
+
+    for (i = 0; i < LEVEL_NUM; i++)
+        printf("  Level %d entered %d times\n", i, psStat->au32Enter[i]);
+
+    if ((u32LightLevel != 0) || (u32HeavyLevel != (LEVEL_NUM - 1)) || (u32HoldLevel != 2))
+    {
+        printf("*** FAIL ***\n");
+
+        while (1);
+    }
+
+    printf("*** PASS ***\n");
+
+    while (1);
+}
+
+/*** (C) COPYRIGHT 2021 Nuvoton Technology Corp. ***/
@@ -0,0 +1,242 @@
+/**************************************************************************//**
+ * @file     main.c
+ * @version  V1.00
+ * @brief    Enter idle or power-down mode from the idle loop according to device states and timer deadlines.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * @copyright (C) 2021 Nuvoton Technology Corp. All rights reserved.
+ ******************************************************************************/
+#include <stdio.h>
+#include "NuMicro.h"
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Macro, type and constant definitions                                                                    */
+/*---------------------------------------------------------------------------------------------------------*/
+#define BLINK_MS        500             /* LED period */
+#define REPORT_MS       2000            /* Status print period */
+#define RUN_MS          10000           /* Test duration */
+#define MIN_PD_MS       5               /* Shorter sleeps are not worth the power-down wake-up time */
+
+/* Timebase runs from LIRC, so convert with the real counting frequency */
+#define MS_TO_COUNT(ms) (((ms) * s_u32Freq) / 1000UL)
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Global Interface Variables Declarations                                                                 */
+/*---------------------------------------------------------------------------------------------------------*/
+static S_SWTIMER_T s_sBlink, s_sReport, s_sEnd;
+static S_LPM_DEV_T s_sUartDev, s_sLedDev;
+static uint32_t s_u32Freq;
+static uint32_t s_u32LedState;
+
+volatile uint32_t g_u32BlinkCount = 0;
+volatile uint32_t g_u32ReportCount = 0;
+volatile uint32_t g_u32KeyCount = 0;
+volatile uint32_t g_u32Done = 0;
+
+
+/**
+ * @brief       Timer0 IRQ
+ *
+ * @param       None
+ *
+ * @return      None
+ *
+ * @details     The Timer0 default IRQ, declared in startup_NUC121.s.
+ */
+void TMR0_IRQHandler(void)
+{
+    SWTIMER_IRQHandler();
+}
+
+/**
+ * @brief       PortA/PortB IRQ
+ *
+ * @param       None
+ *
+ * @return      None
+ *
+ * @details     The PortA/PortB default IRQ, declared in startup_NUC121.s.
+ */
+void GPAB_IRQHandler(void)
+{
+    uint32_t u32Status;
+
+    if (GPIO_GET_INT_FLAG(PB, BIT2))
+        g_u32KeyCount++;
+
+    /* Clear all PB interrupts */
+    u32Status = PB->INTSRC;
+    PB->INTSRC = u32Status;
+}
+
+void Blink(void *pvArg)
+{
+    (void)pvArg;
+    g_u32BlinkCount++;
+    PB4 ^= 1;
+}
+
+void Report(void *pvArg)
+{
+    (void)pvArg;
+    g_u32ReportCount++;
+}
+
+void End(void *pvArg)
+{
+    (void)pvArg;
+    g_u32Done = 1;
+}
+
+/* UART0 stops in power-down mode, so only idle is allowed until the last character is sent */
+uint32_t UartMode(void *pvArg)
+{
+    return UART_IS_TX_EMPTY((UART_T *)pvArg) ? LPM_MODE_PD : LPM_MODE_IDLE;
+}
+
+/* Turn the LED off while the chip is in power-down mode */
+void LedSuspend(void *pvArg)
+{
+    (void)pvArg;
+    s_u32LedState = PB4;
+    PB4 = 1;
+}
+
+void LedResume(void *pvArg)
+{
+    (void)pvArg;
+    PB4 = s_u32LedState;
+}
+
+void SYS_Init(void)
+{
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Init System Clock                                                                                       */
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Enable HIRC and LIRC clock */
+    CLK_EnableXtalRC(CLK_PWRCTL_HIRCEN_Msk | CLK_PWRCTL_LIRCEN_Msk);
+
+    /* Waiting for HIRC and LIRC clock ready */
+    CLK_WaitClockReady(CLK_STATUS_HIRCSTB_Msk | CLK_STATUS_LIRCSTB_Msk);
+
+    /* Switch HCLK clock source to HIRC */
+    CLK_SetHCLK(CLK_CLKSEL0_HCLKSEL_HIRC, CLK_CLKDIV0_HCLK(1));
+
+    /*------------------------------------------------------------------------------------------------------*/
+    /* Enable Module Clock                                                                                  */
+    /*------------------------------------------------------------------------------------------------------*/
+    /* Enable peripheral clock */
+    CLK_EnableModuleClock(UART0_MODULE);
+    CLK_EnableModuleClock(TMR0_MODULE);
+
+    /* TIMER0 runs from LIRC, so the software timers keep running in power-down mode */
+    CLK_SetModuleClock(UART0_MODULE, CLK_CLKSEL1_UARTSEL_HIRC_DIV2, CLK_CLKDIV0_UART(1));
+    CLK_SetModuleClock(TMR0_MODULE, CLK_CLKSEL1_TMR0SEL_LIRC, 0);
+
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Init I/O Multi-function                                                                                 */
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* PB.0 is UART0_RX */
+    SYS->GPB_MFPL &= ~SYS_GPB_MFPL_PB0MFP_Msk;
+    SYS->GPB_MFPL |= (1 << SYS_GPB_MFPL_PB0MFP_Pos);
+    /* PB.1 is UART0_TX */
+    SYS->GPB_MFPL &= ~SYS_GPB_MFPL_PB1MFP_Msk;
+    SYS->GPB_MFPL |= (1 << SYS_GPB_MFPL_PB1MFP_Pos);
+
+}
+
+void UART0_Init(void)
+{
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Init UART                                                                                               */
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Reset UART module */
+    SYS_ResetModule(UART0_RST);
+
+    /* Configure UART0 and set UART0 Baudrate */
+    UART_Open(UART0, 115200);
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/*  MAIN function                                                                                          */
+/*---------------------------------------------------------------------------------------------------------*/
+int main(void)
+{
+    const S_LPM_STAT_T *psStat;
+    uint32_t u32Report = 0;
+
+    /* Unlock protected registers */
+    SYS_UnlockReg();
+
+    /* Init System, peripheral clock and multi-function I/O */
+    SYS_Init();
+
+    /* Lock protected registers */
+    SYS_LockReg();
+
+    /* Init UART0 for printf */
+    UART0_Init();
+
+    printf("\n\nCPU @ %d Hz\n", SystemCoreClock);
+    printf("+--------------------------------------------+\n");
+    printf("|      Low Power Manager Sample Code         |\n");
+    printf("+--------------------------------------------+\n\n");
+    printf("# LED on PB.4 blinks from software timer, key on PB.2 wakes up the chip.\n");
+
+    /* LED output and key input with wake-up interrupt */
+    GPIO_SetMode(PB, BIT4, GPIO_MODE_OUTPUT);
+    GPIO_SetMode(PB, BIT2, GPIO_MODE_INPUT);
+    GPIO_EnableInt(PB, 2, GPIO_INT_FALLING);
+    NVIC_EnableIRQ(GPAB_IRQn);
+
+    s_u32Freq = SWTIMER_Open(TIMER0);
+    NVIC_EnableIRQ(TMR0_IRQn);
+
+    printf("# Timebase %d Hz\n\n", s_u32Freq);
+
+    LPM_Init(TIMER0, MS_TO_COUNT(MIN_PD_MS));
+    LPM_RegisterDevice(&s_sUartDev, UartMode, NULL, NULL, UART0);
+    LPM_RegisterDevice(&s_sLedDev, NULL, LedSuspend, LedResume, NULL);
+
+    SWTIMER_Start(&s_sBlink, MS_TO_COUNT(BLINK_MS), MS_TO_COUNT(BLINK_MS), Blink, NULL);
+    SWTIMER_Start(&s_sReport, MS_TO_COUNT(REPORT_MS), MS_TO_COUNT(REPORT_MS), Report, NULL);
+    SWTIMER_Start(&s_sEnd, MS_TO_COUNT(RUN_MS), SWTIMER_ONESHOT, End, NULL);
+
+    /* Idle loop, all work is done by events */
+    while (g_u32Done == 0)
+    {
+        if (u32Report != g_u32ReportCount)
+        {
+            u32Report = g_u32ReportCount;
+            psStat = LPM_GetStat();
+            printf("  %2d s: blink %d, key %d, idle %d, power-down %d\n", u32Report * REPORT_MS / 1000, g_u32BlinkCount,
+                   g_u32KeyCount, psStat->u32IdleCount, psStat->u32PDCount);
+        }
+
+        LPM_Sleep();
+    }
+
+    SWTIMER_Stop(&s_sBlink);
+    SWTIMER_Stop(&s_sReport);
+
+    psStat = LPM_GetStat();
+
+    printf("\n  Slept %d of %d ms, %d timer wake-ups\n", (psStat->u32SleepTime * 1000) / s_u32Freq,
+           RUN_MS, psStat->u32TimerWakeCount);
+    printf("  Wake-up latency last %d us, max %d us\n", (psStat->u32LastWakeLatency * 1000) / (s_u32Freq / 1000),
+           (psStat->u32MaxWakeLatency * 1000) / (s_u32Freq / 1000));
+
+    if ((psStat->u32PDCount == 0) || (psStat->u32TimerWakeCount == 0) ||
+            (g_u32BlinkCount < (RUN_MS / BLINK_MS - 1)) || (g_u32BlinkCount > (RUN_MS / BLINK_MS)))
+    {
+        printf("*** FAIL ***\n");
+
+        while (1);
+    }
+
+    printf("*** PASS ***\n");
+
+    while (1);
+}
+
+/*** (C) COPYRIGHT 2021 Nuvoton Technology Corp. ***/
@@ -0,0 +1,322 @@
+/**************************************************************************//**
+ * @file     main.c
+ * @version  V1.00
+ * @brief    Store parameters in a 24Cxx EEPROM with page writes, ACK polling and a read cache.
+ *           I2C1 acts as a 24C32 with a 5 ms write cycle. Connect I2C0 (master) and I2C1 (EEPROM).
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * @copyright (C) 2021 Nuvoton Technology Corp. All rights reserved.
+ ******************************************************************************/
+#include <stdio.h>
+#include "NuMicro.h"
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Macro, type and constant definitions                                                                    */
+/*---------------------------------------------------------------------------------------------------------*/
+#define EEPROM_ADDR         0x50
+#define EEPROM_SIZE         4096            /* 24C32 */
+#define EEPROM_PAGE         32
+#define EEPROM_WRITE_MS     5               /* Worst case write cycle of the data sheet */
+
+#define MODEL_SIZE          1024            /* Upper part of the model mirrors the first 1 KB */
+
+#define PARAM_ADDR          0x0015          /* Not page aligned on purpose */
+#define PARAM_LEN           100
+#define PARAM_PAGES         4               /* 11 + 32 + 32 + 25 bytes */
+#define BLOCK_NO            8
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Global variables                                                                                        */
+/*---------------------------------------------------------------------------------------------------------*/
+static S_I2C_XFER_BUS_T s_sBus;
+static S_I2C_EEPROM_T s_sEeprom;
+static S_BLKDEV_T s_sBlk;
+static S_SWTIMER_T s_sWriteCycle;
+
+static uint8_t s_au8Param[PARAM_LEN], s_au8ParamRead[PARAM_LEN];
+static uint8_t s_au8Block[EEPROM_PAGE], s_au8BlockRead[EEPROM_PAGE];
+
+/* EEPROM model */
+static uint8_t s_au8Mem[MODEL_SIZE];
+static uint32_t s_u32MemAddr;
+static uint32_t s_u32AddrLen;
+static uint32_t s_u32DataLen;
+
+
+/*---------------------------------------------------------------------------------------------------------*/
+/*  Timer0 IRQ Handler                                                                                     */
+/*---------------------------------------------------------------------------------------------------------*/
+void TMR0_IRQHandler(void)
+{
+    SWTIMER_IRQHandler();
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/*  I2C0 IRQ Handler                                                                                       */
+/*---------------------------------------------------------------------------------------------------------*/
+void I2C0_IRQHandler(void)
+{
+    I2C_XFER_IRQHandler(&s_sBus);
+}
+
+/* End of the model write cycle, answer the slave address again */
+void WriteCycleDone(void *pvArg)
+{
+    (void)pvArg;
+    I2C_SET_CONTROL_REG(I2C1, I2C_CTL_AA);
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/*  I2C1 IRQ Handler, 24Cxx model with two address bytes and page roll-over                                */
+/*---------------------------------------------------------------------------------------------------------*/
+void I2C1_IRQHandler(void)
+{
+    uint32_t u32Status;
+
+    if (I2C_GET_TIMEOUT_FLAG(I2C1))
+    {
+        I2C_ClearTimeoutFlag(I2C1);
+        return;
+    }
+
+    u32Status = I2C_GET_STATUS(I2C1);
+
+    if (u32Status == 0x60)                      /* Own SLA+W has been receive; ACK has been return */
+    {
+        s_u32AddrLen = 0;
+        s_u32DataLen = 0;
+    }
+    else if (u32Status == 0x80)                 /* Data has been received; ACK has been returned */
+    {
+        if (s_u32AddrLen < 2)
+        {
+            s_u32MemAddr = ((s_u32MemAddr << 8) | I2C_GET_DATA(I2C1)) & (EEPROM_SIZE - 1);
+            s_u32AddrLen++;
+        }
+        else
+        {
+            /* The address counter wraps inside the page */
+            s_au8Mem[s_u32MemAddr % MODEL_SIZE] = (uint8_t)I2C_GET_DATA(I2C1);
+            s_u32MemAddr = (s_u32MemAddr & ~(EEPROM_PAGE - 1)) | ((s_u32MemAddr + 1) & (EEPROM_PAGE - 1));
+            s_u32DataLen++;
+        }
+    }
+    else if ((u32Status == 0xA8) || (u32Status == 0xB8))    /* Own SLA+R received or data transmitted with ACK */
+    {
+        I2C_SET_DATA(I2C1, s_au8Mem[s_u32MemAddr % MODEL_SIZE]);
+        s_u32MemAddr = (s_u32MemAddr + 1) & (EEPROM_SIZE - 1);
+    }
+    else if ((u32Status == 0xA0) && (s_u32DataLen != 0))    /* STOP after data, start the write cycle */
+    {
+        s_u32DataLen = 0;
+        SWTIMER_Start(&s_sWriteCycle, SWTIMER_MS_TO_COUNT(EEPROM_WRITE_MS), SWTIMER_ONESHOT, WriteCycleDone, NULL);
+
+        /* Without AA the own address is not acknowledged */
+        I2C_SET_CONTROL_REG(I2C1, I2C_CTL_SI);
+        return;
+    }
+
+    /* 0x88, 0xA0 and 0xC0 only need the slave to be ready for the next transfer */
+    I2C_SET_CONTROL_REG(I2C1, I2C_CTL_SI_AA);
+}
+
+void SYS_Init(void)
+{
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Init System Clock                                                                                       */
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Enable Internal RC 48 MHz clock */
+    CLK_EnableXtalRC(CLK_PWRCTL_HIRCEN_Msk);
+
+    /* Waiting for Internal RC clock ready */
+    CLK_WaitClockReady(CLK_STATUS_HIRCSTB_Msk);
+
+    /* Switch HCLK clock source to Internal RC and HCLK source divide 1 */
+    CLK_SetHCLK(CLK_CLKSEL0_HCLKSEL_HIRC, CLK_CLKDIV0_HCLK(1));
+
+    /* Enable module clock */
+    CLK_EnableModuleClock(UART0_MODULE);
+    CLK_EnableModuleClock(I2C0_MODULE);
+    CLK_EnableModuleClock(I2C1_MODULE);
+    CLK_EnableModuleClock(TMR0_MODULE);
+
+    /* Select UART and TIMER0 clock source from HIRC */
+    CLK_SetModuleClock(UART0_MODULE, CLK_CLKSEL1_UARTSEL_HIRC_DIV2, CLK_CLKDIV0_UART(1));
+    CLK_SetModuleClock(TMR0_MODULE, CLK_CLKSEL1_TMR0SEL_HIRC_DIV2, 0);
+
+    /* Update System Core Clock */
+    SystemCoreClockUpdate();
+
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Init I/O Multi-function                                                                                 */
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Set PB multi-function pins for UART0 RXD and TXD */
+    SYS->GPB_MFPL = SYS_GPB_MFPL_PB0MFP_UART0_RXD | SYS_GPB_MFPL_PB1MFP_UART0_TXD;
+
+    /* Set I2C0 PC multi-function pins */
+    SYS->GPC_MFPH &= ~(SYS_GPC_MFPH_PC11MFP_Msk | SYS_GPC_MFPH_PC12MFP_Msk);
+    SYS->GPC_MFPH |= (SYS_GPC_MFPH_PC11MFP_I2C0_SDA | SYS_GPC_MFPH_PC12MFP_I2C0_SCL);
+
+    /* Set I2C1 multi-function pins */
+    SYS->GPC_MFPL = (SYS->GPC_MFPL & ~(SYS_GPC_MFPL_PC2MFP_Msk | SYS_GPC_MFPL_PC3MFP_Msk)) |
+                    (SYS_GPC_MFPL_PC2MFP_I2C1_SCL | SYS_GPC_MFPL_PC3MFP_I2C1_SDA);
+
+    /* I2C pins enable schmitt trigger */
+    PC->SMTEN |= GPIO_SMTEN_SMTEN2_Msk | GPIO_SMTEN_SMTEN3_Msk;
+    PC->SMTEN |= GPIO_SMTEN_SMTEN11_Msk | GPIO_SMTEN_SMTEN12_Msk;
+}
+
+void UART0_Init()
+{
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Init UART                                                                                               */
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Reset IP */
+    SYS_ResetModule(UART0_RST);
+
+    /* Configure UART0 and set UART0 Baudrate */
+    UART_Open(UART0, 115200);
+}
+
+void I2C1_Init(void)
+{
+    /* Open I2C1 module as slave */
+    I2C_Open(I2C1, 100000);
+    I2C_SetSlaveAddr(I2C1, 0, EEPROM_ADDR, 0);
+
+    /* Enable I2C1 interrupt and enter no address SLV mode */
+    I2C_EnableInt(I2C1);
+    NVIC_EnableIRQ(I2C1_IRQn);
+    I2C_SET_CONTROL_REG(I2C1, I2C_CTL_SI_AA);
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/*  Main Function                                                                                          */
+/*---------------------------------------------------------------------------------------------------------*/
+int32_t main(void)
+{
+    uint32_t i, u32Start, u32Write, u32Sync;
+    int32_t i32Err = 0;
+    uint8_t au8Small[4];
+
+    /* Unlock protected registers */
+    SYS_UnlockReg();
+
+    /* Init System, IP clock and multi-function I/O */
+    SYS_Init();
+
+    /* Lock protected registers */
+    SYS_LockReg();
+
+    /* Init UART0 for printf */
+    UART0_Init();
+
+    printf("+-------------------------------------------------------+\n");
+    printf("|    I2C Paged EEPROM Sample Code                       |\n");
+    printf("|                                                       |\n");
+    printf("|    I2C0 (master) <---> I2C1 (24C32 model)             |\n");
+    printf("+-------------------------------------------------------+\n");
+    printf("Connect I2C0_SDA(PC.11) to I2C1_SDA(PC.3) and I2C0_SCL(PC.12) to I2C1_SCL(PC.2).\n\n");
+
+    SWTIMER_Open(TIMER0);
+    NVIC_EnableIRQ(TMR0_IRQn);
+
+    I2C1_Init();
+
+    I2C_XFER_Open(&s_sBus, I2C0, 100000);
+    NVIC_EnableIRQ(I2C0_IRQn);
+
+    I2C_EEPROM_Open(&s_sEeprom, &s_sBus, EEPROM_ADDR, EEPROM_SIZE, EEPROM_PAGE);
+
+    for (i = 0; i < PARAM_LEN; i++)
+        s_au8Param[i] = (uint8_t)(i * 7 + 3);
+
+    /* Page writes, the last write cycle runs while the CPU continues */
+    u32Start = SWTIMER_GetTime();
+
+    if (I2C_EEPROM_Write(&s_sEeprom, PARAM_ADDR, s_au8Param, PARAM_LEN) != 0)
+        i32Err = -1;
+
+    u32Write = SWTIMER_GetTime() - u32Start;
+
+    if (I2C_EEPROM_Sync(&s_sEeprom) != 0)
+        i32Err = -1;
+
+    u32Sync = SWTIMER_GetTime() - u32Start;
+
+    printf("Write %d bytes: %d page writes, %d polls, %d us to return, %d us to store\n", PARAM_LEN,
+           s_sEeprom.u32PageWrites, s_sEeprom.u32Polls, u32Write, u32Sync);
+    printf("Byte writes with fixed %d ms delays would take %d us\n", EEPROM_WRITE_MS,
+           PARAM_LEN * EEPROM_WRITE_MS * 1000);
+
+    if ((s_sEeprom.u32PageWrites != PARAM_PAGES) || (s_sEeprom.u32Polls == 0))
+        i32Err = -1;
+
+    /* Long read goes to the device in one transaction */
+    if (I2C_EEPROM_Read(&s_sEeprom, PARAM_ADDR, s_au8ParamRead, PARAM_LEN) != 0)
+        i32Err = -1;
+
+    for (i = 0; i < PARAM_LEN; i++)
+    {
+        if (s_au8ParamRead[i] != s_au8Param[i])
+            i32Err = -1;
+    }
+
+    /* Small parameters in one cache line cost one transaction */
+    for (i = 0; i < 3; i++)
+    {
+        if ((I2C_EEPROM_Read(&s_sEeprom, 0x20 + i * 4, au8Small, 4) != 0) ||
+                (au8Small[0] != s_au8Param[0x20 + i * 4 - PARAM_ADDR]))
+            i32Err = -1;
+    }
+
+    /* Written data goes through the cache too */
+    au8Small[0] = 0x5A;
+    au8Small[1] = 0xA5;
+
+    if (I2C_EEPROM_Write(&s_sEeprom, 0x22, au8Small, 2) != 0)
+        i32Err = -1;
+
+    if ((I2C_EEPROM_Read(&s_sEeprom, 0x20, au8Small, 4) != 0) || (au8Small[2] != 0x5A) || (au8Small[3] != 0xA5))
+        i32Err = -1;
+
+    printf("Cache hits %d, misses %d\n", s_sEeprom.u32CacheHits, s_sEeprom.u32CacheMisses);
+
+    if ((s_sEeprom.u32CacheHits != 3) || (s_sEeprom.u32CacheMisses != 1))
+        i32Err = -1;
+
+    /* Same device as block device, one block per page */
+    I2C_EEPROM_GetBlockDev(&s_sEeprom, &s_sBlk);
+
+    for (i = 0; i < EEPROM_PAGE; i++)
+        s_au8Block[i] = (uint8_t)(0xFF - i);
+
+    if ((BLKDEV_WRITE(&s_sBlk, BLOCK_NO, s_au8Block, 1) != 0) || (BLKDEV_SYNC(&s_sBlk) != 0))
+        i32Err = -1;
+
+    I2C_EEPROM_Invalidate(&s_sEeprom);
+
+    if (BLKDEV_READ(&s_sBlk, BLOCK_NO, s_au8BlockRead, 1) != 0)
+        i32Err = -1;
+
+    for (i = 0; i < EEPROM_PAGE; i++)
+    {
+        if (s_au8BlockRead[i] != s_au8Block[i])
+            i32Err = -1;
+    }
+
+    printf("Block device: %d blocks of %d bytes\n", s_sBlk.u32BlockNum, s_sBlk.u32BlockSize);
+
+    if (i32Err != 0)
+    {
+        printf("*** FAIL ***\n");
+
+        while (1);
+    }
+
+    printf("*** PASS ***\n");
+
+    while (1);
+}
+
+/*** (C) COPYRIGHT 2021 Nuvoton Technology Corp. ***/
@@ -0,0 +1,288 @@
+/**************************************************************************//**
+ * @file     main.c
+ * @version  V1.00
+ * @brief    Serve slave register maps at 1 MHz with PDMA staging and consistent snapshots.
+ *           Connect I2C0 (master) and I2C1 (register map slave).
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * @copyright (C) 2021 Nuvoton Technology Corp. All rights reserved.
+ ******************************************************************************/
+#include <stdio.h>
+#include <string.h>
+#include "NuMicro.h"
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Macro, type and constant definitions                                                                    */
+/*---------------------------------------------------------------------------------------------------------*/
+#define BUS_CLOCK           1000000
+#define CTRL_ADDR           0x16
+#define STATUS_ADDR         0x36
+#define MASTER_PDMA_TX_CH   0
+#define MASTER_PDMA_RX_CH   1
+#define SLAVE_PDMA_TX_CH    2
+#define SLAVE_PDMA_RX_CH    3
+#define CTRL_SIZE           256
+#define STATUS_SIZE         16
+#define SHORT_REG           0x10
+#define SHORT_LEN           24
+#define LONG_REG            0x40
+#define LONG_LEN            40
+#define STATUS_READS        200
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Global variables                                                                                        */
+/*---------------------------------------------------------------------------------------------------------*/
+static S_I2C_XFER_BUS_T s_sBus;
+static S_I2C_XFER_T s_sXfer;
+static S_I2C_REGMAP_T s_sMap;
+static S_SWTIMER_T s_sStatusTimer;
+
+static uint8_t s_au8Ctrl[CTRL_SIZE];
+static uint8_t s_au8Status[STATUS_SIZE];
+static uint8_t s_au8Tx[LONG_LEN], s_au8Rx[LONG_LEN];
+static int32_t s_i32CtrlWin, s_i32StatusWin;
+
+volatile uint32_t g_u32Counter = 0;
+volatile uint32_t g_u32Commits = 0;
+
+
+/*---------------------------------------------------------------------------------------------------------*/
+/*  I2C0 IRQ Handler                                                                                       */
+/*---------------------------------------------------------------------------------------------------------*/
+void I2C0_IRQHandler(void)
+{
+    I2C_XFER_IRQHandler(&s_sBus);
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/*  I2C1 IRQ Handler                                                                                       */
+/*---------------------------------------------------------------------------------------------------------*/
+void I2C1_IRQHandler(void)
+{
+    I2C_REGMAP_IRQHandler(&s_sMap);
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/*  TMR0 IRQ Handler                                                                                       */
+/*---------------------------------------------------------------------------------------------------------*/
+void TMR0_IRQHandler(void)
+{
+    SWTIMER_IRQHandler();
+}
+
+/* The status registers hold a counter and its complement, a torn read breaks the pair */
+void StatusUpdate(void *pvArg)
+{
+    uint32_t u32Cnt = ++g_u32Counter;
+    uint32_t au32Status[2];
+
+    (void)pvArg;
+
+    au32Status[0] = u32Cnt;
+    au32Status[1] = ~u32Cnt;
+    I2C_REGMAP_Update(&s_sMap, (uint32_t)s_i32StatusWin, 0, (uint8_t *)au32Status, sizeof(au32Status));
+}
+
+void CtrlWritten(S_I2C_REGMAP_T *psMap, uint32_t u32Win, uint32_t u32Reg, uint32_t u32Len)
+{
+    (void)psMap;
+    (void)u32Win;
+    (void)u32Reg;
+    (void)u32Len;
+    g_u32Commits++;
+}
+
+void SYS_Init(void)
+{
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Init System Clock                                                                                       */
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Enable Internal RC 48 MHz clock */
+    CLK_EnableXtalRC(CLK_PWRCTL_HIRCEN_Msk);
+
+    /* Waiting for Internal RC clock ready */
+    CLK_WaitClockReady(CLK_STATUS_HIRCSTB_Msk);
+
+    /* Switch HCLK clock source to Internal RC and HCLK source divide 1 */
+    CLK_SetHCLK(CLK_CLKSEL0_HCLKSEL_HIRC, CLK_CLKDIV0_HCLK(1));
+
+    /* Enable module clock */
+    CLK_EnableModuleClock(UART0_MODULE);
+    CLK_EnableModuleClock(I2C0_MODULE);
+    CLK_EnableModuleClock(I2C1_MODULE);
+    CLK_EnableModuleClock(PDMA_MODULE);
+    CLK_EnableModuleClock(TMR0_MODULE);
+
+    /* Select UART and TIMER0 clock source from HIRC */
+    CLK_SetModuleClock(UART0_MODULE, CLK_CLKSEL1_UARTSEL_HIRC_DIV2, CLK_CLKDIV0_UART(1));
+    CLK_SetModuleClock(TMR0_MODULE, CLK_CLKSEL1_TMR0SEL_HIRC_DIV2, 0);
+
+    /* Update System Core Clock */
+    SystemCoreClockUpdate();
+
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Init I/O Multi-function                                                                                 */
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Set PB multi-function pins for UART0 RXD and TXD */
+    SYS->GPB_MFPL = SYS_GPB_MFPL_PB0MFP_UART0_RXD | SYS_GPB_MFPL_PB1MFP_UART0_TXD;
+
+    /* Set I2C0 PC multi-function pins */
+    SYS->GPC_MFPH &= ~(SYS_GPC_MFPH_PC11MFP_Msk | SYS_GPC_MFPH_PC12MFP_Msk);
+    SYS->GPC_MFPH |= (SYS_GPC_MFPH_PC11MFP_I2C0_SDA | SYS_GPC_MFPH_PC12MFP_I2C0_SCL);
+
+    /* Set I2C1 multi-function pins */
+    SYS->GPC_MFPL = (SYS->GPC_MFPL & ~(SYS_GPC_MFPL_PC2MFP_Msk | SYS_GPC_MFPL_PC3MFP_Msk)) |
+                    (SYS_GPC_MFPL_PC2MFP_I2C1_SCL | SYS_GPC_MFPL_PC3MFP_I2C1_SDA);
+
+    /* I2C pins enable schmitt trigger */
+    PC->SMTEN |= GPIO_SMTEN_SMTEN2_Msk | GPIO_SMTEN_SMTEN3_Msk;
+    PC->SMTEN |= GPIO_SMTEN_SMTEN11_Msk | GPIO_SMTEN_SMTEN12_Msk;
+}
+
+void UART0_Init()
+{
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Init UART                                                                                               */
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Reset IP */
+    SYS_ResetModule(UART0_RST);
+
+    /* Configure UART0 and set UART0 Baudrate */
+    UART_Open(UART0, 115200);
+}
+
+/* Write registers, then read them back with a register address write and a repeated START */
+int32_t WriteRead(uint8_t u8Addr, uint32_t u32Reg, uint32_t u32Len)
+{
+    I2C_XFER_Setup(&s_sXfer, u8Addr, u32Reg, 1, s_au8Tx, u32Len, NULL, 0);
+
+    if (I2C_XFER_Transfer(&s_sBus, &s_sXfer) != I2C_XFER_OK)
+        return -1;
+
+    memset(s_au8Rx, 0, sizeof(s_au8Rx));
+    I2C_XFER_Setup(&s_sXfer, u8Addr, u32Reg, 1, NULL, 0, s_au8Rx, u32Len);
+
+    if (I2C_XFER_Transfer(&s_sBus, &s_sXfer) != I2C_XFER_OK)
+        return -1;
+
+    return 0;
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/*  Main Function                                                                                          */
+/*---------------------------------------------------------------------------------------------------------*/
+int32_t main(void)
+{
+    uint32_t i, u32Torn = 0;
+    uint32_t au32Status[2];
+    int32_t i32Err = 0;
+
+    /* Unlock protected registers */
+    SYS_UnlockReg();
+
+    /* Init System, IP clock and multi-function I/O */
+    SYS_Init();
+
+    /* Lock protected registers */
+    SYS_LockReg();
+
+    /* Init UART0 for printf */
+    UART0_Init();
+
+    printf("+-------------------------------------------------------+\n");
+    printf("|    I2C Slave Register Map Sample Code                 |\n");
+    printf("|                                                       |\n");
+    printf("|    I2C0 (master) <---> I2C1 (register map slave)      |\n");
+    printf("+-------------------------------------------------------+\n");
+    printf("Connect I2C0_SDA(PC.11) to I2C1_SDA(PC.3) and I2C0_SCL(PC.12) to I2C1_SCL(PC.2).\n");
+    printf("Use strong pull-up resistors, about 1 kohm, for 1 MHz.\n\n");
+
+    /* Slave: a control window and a read-only status window, both moved by PDMA */
+    I2C_REGMAP_Open(&s_sMap, I2C1, BUS_CLOCK, 1);
+    s_i32CtrlWin = I2C_REGMAP_AddWindow(&s_sMap, CTRL_ADDR, 0, s_au8Ctrl, CTRL_SIZE, I2C_REGMAP_RW);
+    s_i32StatusWin = I2C_REGMAP_AddWindow(&s_sMap, STATUS_ADDR, 0, s_au8Status, STATUS_SIZE, I2C_REGMAP_RO);
+    I2C_REGMAP_EnablePDMA(&s_sMap, SLAVE_PDMA_TX_CH, SLAVE_PDMA_RX_CH);
+    I2C_REGMAP_SetWriteCallback(&s_sMap, CtrlWritten);
+    NVIC_EnableIRQ(I2C1_IRQn);
+
+    /* Master */
+    printf("I2C0 clock %d Hz\n", I2C_XFER_Open(&s_sBus, I2C0, BUS_CLOCK));
+    I2C_XFER_EnablePDMA(&s_sBus, MASTER_PDMA_TX_CH, MASTER_PDMA_RX_CH, 4);
+    NVIC_EnableIRQ(I2C0_IRQn);
+
+    /* The application refreshes the status window every tick */
+    SWTIMER_Open(TIMER0);
+    NVIC_EnableIRQ(TMR0_IRQn);
+    SWTIMER_Start(&s_sStatusTimer, SWTIMER_MS_TO_COUNT(1), SWTIMER_MS_TO_COUNT(1), StatusUpdate, NULL);
+
+    for (i = 0; i < LONG_LEN; i++)
+        s_au8Tx[i] = (uint8_t)(0x5A ^ (i * 7));
+
+    /* One staged commit */
+    if ((WriteRead(CTRL_ADDR, SHORT_REG, SHORT_LEN) != 0) || (memcmp(s_au8Rx, s_au8Tx, SHORT_LEN) != 0))
+        i32Err = -1;
+
+    printf("%d bytes at 0x%02X: %s\n", SHORT_LEN, SHORT_REG, i32Err ? "mismatch" : "ok");
+
+    /* Longer than the staging buffer, committed in two pieces */
+    if ((WriteRead(CTRL_ADDR, LONG_REG, LONG_LEN) != 0) || (memcmp(s_au8Rx, s_au8Tx, LONG_LEN) != 0))
+        i32Err = -1;
+
+    I2C_REGMAP_Snapshot(&s_sMap, (uint32_t)s_i32CtrlWin, LONG_REG, s_au8Rx, LONG_LEN);
+
+    if (memcmp(s_au8Rx, s_au8Tx, LONG_LEN) != 0)
+        i32Err = -1;
+
+    printf("%d bytes at 0x%02X: %s, %d write commits\n", LONG_LEN, LONG_REG, i32Err ? "mismatch" : "ok", g_u32Commits);
+
+    if (g_u32Commits != 3)
+        i32Err = -1;
+
+    /* Read-only window, the master write is acknowledged and dropped */
+    I2C_XFER_Setup(&s_sXfer, STATUS_ADDR, 8, 1, s_au8Tx, 4, NULL, 0);
+
+    if ((I2C_XFER_Transfer(&s_sBus, &s_sXfer) != I2C_XFER_OK) || (s_sMap.u32Dropped != 4))
+        i32Err = -1;
+
+    printf("Dropped %d bytes written to the status window\n", s_sMap.u32Dropped);
+
+    /* Status reads never see a half updated counter */
+    for (i = 0; i < STATUS_READS; i++)
+    {
+        I2C_XFER_Setup(&s_sXfer, STATUS_ADDR, 0, 1, NULL, 0, (uint8_t *)au32Status, sizeof(au32Status));
+
+        if ((I2C_XFER_Transfer(&s_sBus, &s_sXfer) != I2C_XFER_OK) || (au32Status[0] != ~au32Status[1]))
+            u32Torn++;
+    }
+
+    printf("%d status reads, %d torn, counter %d\n", STATUS_READS, u32Torn, g_u32Counter);
+
+    if (u32Torn != 0)
+        i32Err = -1;
+
+    /* Set the register address only, a read without register address continues there */
+    I2C_XFER_Setup(&s_sXfer, CTRL_ADDR, LONG_REG, 1, NULL, 0, NULL, 0);
+
+    if (I2C_XFER_Transfer(&s_sBus, &s_sXfer) != I2C_XFER_OK)
+        i32Err = -1;
+
+    I2C_XFER_Setup(&s_sXfer, CTRL_ADDR, 0, 0, NULL, 0, s_au8Rx, 4);
+
+    if ((I2C_XFER_Transfer(&s_sBus, &s_sXfer) != I2C_XFER_OK) || (memcmp(s_au8Rx, s_au8Tx, 4) != 0))
+        i32Err = -1;
+
+    printf("Slave reads %d, writes %d\n", s_sMap.u32Reads, s_sMap.u32Writes);
+
+    if (i32Err != 0)
+    {
+        printf("*** FAIL ***\n");
+
+        while (1);
+    }
+
+    printf("*** PASS ***\n");
+
+    while (1);
+}
+
+/*** (C) COPYRIGHT 2021 Nuvoton Technology Corp. ***/
@@ -0,0 +1,287 @@
+/**************************************************************************//**
+ * @file     main.c
+ * @version  V1.00
+ * @brief    Queue I2C master transactions that run from the interrupt and by PDMA.
+ *           Connect I2C0 (master) and I2C1 (slave).
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * @copyright (C) 2021 Nuvoton Technology Corp. All rights reserved.
+ ******************************************************************************/
+#include <stdio.h>
+#include "NuMicro.h"
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Macro, type and constant definitions                                                                    */
+/*---------------------------------------------------------------------------------------------------------*/
+#define SLAVE_ADDR          0x16
+#define ABSENT_ADDR         0x50
+#define MASTER_PDMA_TX_CH   0
+#define MASTER_PDMA_RX_CH   1
+#define PDMA_MIN_LEN        16
+#define BLOCK_LEN           64
+#define BLOCK_ADDR          0x0010
+#define SMALL_NUM           8
+#define SMALL_LEN           4
+#define SMALL_ADDR          0x0080
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Global variables                                                                                        */
+/*---------------------------------------------------------------------------------------------------------*/
+static S_I2C_XFER_BUS_T s_sBus;
+static S_I2C_XFER_T s_sBlockWrite, s_sBlockRead, s_sProbe, s_sSmallRead, s_asSmall[SMALL_NUM];
+
+static uint8_t s_au8Block[BLOCK_LEN], s_au8BlockRead[BLOCK_LEN];
+static uint8_t s_au8Small[SMALL_NUM][SMALL_LEN], s_au8SmallRead[SMALL_NUM * SMALL_LEN];
+
+volatile uint32_t g_u32Callbacks = 0;
+
+/* Slave register file, addressed by two bytes */
+static uint8_t s_au8SlvData[256];
+static uint32_t s_u32SlvAddr;
+static uint32_t s_u32SlvAddrLen;
+
+
+/*---------------------------------------------------------------------------------------------------------*/
+/*  I2C0 IRQ Handler                                                                                       */
+/*---------------------------------------------------------------------------------------------------------*/
+void I2C0_IRQHandler(void)
+{
+    I2C_XFER_IRQHandler(&s_sBus);
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/*  I2C1 IRQ Handler, simple slave with a 256 bytes register file                                          */
+/*---------------------------------------------------------------------------------------------------------*/
+void I2C1_IRQHandler(void)
+{
+    uint32_t u32Status;
+
+    if (I2C_GET_TIMEOUT_FLAG(I2C1))
+    {
+        I2C_ClearTimeoutFlag(I2C1);
+        return;
+    }
+
+    u32Status = I2C_GET_STATUS(I2C1);
+
+    if (u32Status == 0x60)                      /* Own SLA+W has been receive; ACK has been return */
+    {
+        s_u32SlvAddrLen = 0;
+    }
+    else if (u32Status == 0x80)                 /* Data has been received; ACK has been returned */
+    {
+        if (s_u32SlvAddrLen < 2)
+        {
+            s_u32SlvAddr = ((s_u32SlvAddr << 8) | I2C_GET_DATA(I2C1)) & 0xFF;
+            s_u32SlvAddrLen++;
+        }
+        else
+            s_au8SlvData[s_u32SlvAddr++ & 0xFF] = (uint8_t)I2C_GET_DATA(I2C1);
+    }
+    else if ((u32Status == 0xA8) || (u32Status == 0xB8))    /* Own SLA+R received or data transmitted with ACK */
+    {
+        I2C_SET_DATA(I2C1, s_au8SlvData[s_u32SlvAddr++ & 0xFF]);
+    }
+
+    /* 0x88, 0xA0 and 0xC0 only need the slave to be ready for the next transfer */
+    I2C_SET_CONTROL_REG(I2C1, I2C_CTL_SI_AA);
+}
+
+/* Release a slave that holds SDA low by clocking SCL (PC.12) as GPIO */
+void BusClear(void *pvArg)
+{
+    uint32_t i;
+
+    (void)pvArg;
+
+    PC12 = 1;
+    GPIO_SetMode(PC, BIT12, GPIO_MODE_OPEN_DRAIN);
+    SYS->GPC_MFPH &= ~SYS_GPC_MFPH_PC12MFP_Msk;
+
+    for (i = 0; i < 9; i++)
+    {
+        PC12 = 0;
+        CLK_SysTickDelay(5);
+        PC12 = 1;
+        CLK_SysTickDelay(5);
+    }
+
+    SYS->GPC_MFPH |= SYS_GPC_MFPH_PC12MFP_I2C0_SCL;
+}
+
+void XferDone(S_I2C_XFER_T *psXfer)
+{
+    (void)psXfer;
+    g_u32Callbacks++;
+}
+
+void SYS_Init(void)
+{
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Init System Clock                                                                                       */
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Enable Internal RC 48 MHz clock */
+    CLK_EnableXtalRC(CLK_PWRCTL_HIRCEN_Msk);
+
+    /* Waiting for Internal RC clock ready */
+    CLK_WaitClockReady(CLK_STATUS_HIRCSTB_Msk);
+
+    /* Switch HCLK clock source to Internal RC and HCLK source divide 1 */
+    CLK_SetHCLK(CLK_CLKSEL0_HCLKSEL_HIRC, CLK_CLKDIV0_HCLK(1));
+
+    /* Enable module clock */
+    CLK_EnableModuleClock(UART0_MODULE);
+    CLK_EnableModuleClock(I2C0_MODULE);
+    CLK_EnableModuleClock(I2C1_MODULE);
+    CLK_EnableModuleClock(PDMA_MODULE);
+
+    /* Select UART clock source from HIRC */
+    CLK_SetModuleClock(UART0_MODULE, CLK_CLKSEL1_UARTSEL_HIRC_DIV2, CLK_CLKDIV0_UART(1));
+
+    /* Update System Core Clock */
+    SystemCoreClockUpdate();
+
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Init I/O Multi-function                                                                                 */
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Set PB multi-function pins for UART0 RXD and TXD */
+    SYS->GPB_MFPL = SYS_GPB_MFPL_PB0MFP_UART0_RXD | SYS_GPB_MFPL_PB1MFP_UART0_TXD;
+
+    /* Set I2C0 PC multi-function pins */
+    SYS->GPC_MFPH &= ~(SYS_GPC_MFPH_PC11MFP_Msk | SYS_GPC_MFPH_PC12MFP_Msk);
+    SYS->GPC_MFPH |= (SYS_GPC_MFPH_PC11MFP_I2C0_SDA | SYS_GPC_MFPH_PC12MFP_I2C0_SCL);
+
+    /* Set I2C1 multi-function pins */
+    SYS->GPC_MFPL = (SYS->GPC_MFPL & ~(SYS_GPC_MFPL_PC2MFP_Msk | SYS_GPC_MFPL_PC3MFP_Msk)) |
+                    (SYS_GPC_MFPL_PC2MFP_I2C1_SCL | SYS_GPC_MFPL_PC3MFP_I2C1_SDA);
+
+    /* I2C pins enable schmitt trigger */
+    PC->SMTEN |= GPIO_SMTEN_SMTEN2_Msk | GPIO_SMTEN_SMTEN3_Msk;
+    PC->SMTEN |= GPIO_SMTEN_SMTEN11_Msk | GPIO_SMTEN_SMTEN12_Msk;
+}
+
+void UART0_Init()
+{
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Init UART                                                                                               */
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Reset IP */
+    SYS_ResetModule(UART0_RST);
+
+    /* Configure UART0 and set UART0 Baudrate */
+    UART_Open(UART0, 115200);
+}
+
+void I2C1_Init(void)
+{
+    /* Open I2C1 module as slave */
+    I2C_Open(I2C1, 100000);
+    I2C_SetSlaveAddr(I2C1, 0, SLAVE_ADDR, 0);
+
+    /* Enable I2C1 interrupt and enter no address SLV mode */
+    I2C_EnableInt(I2C1);
+    NVIC_EnableIRQ(I2C1_IRQn);
+    I2C_SET_CONTROL_REG(I2C1, I2C_CTL_SI_AA);
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/*  Main Function                                                                                          */
+/*---------------------------------------------------------------------------------------------------------*/
+int32_t main(void)
+{
+    uint32_t i, j, u32Free = 0;
+    int32_t i32Err = 0;
+
+    /* Unlock protected registers */
+    SYS_UnlockReg();
+
+    /* Init System, IP clock and multi-function I/O */
+    SYS_Init();
+
+    /* Lock protected registers */
+    SYS_LockReg();
+
+    /* Init UART0 for printf */
+    UART0_Init();
+
+    printf("+-------------------------------------------------------+\n");
+    printf("|    I2C Transaction Queue Sample Code                  |\n");
+    printf("|                                                       |\n");
+    printf("|    I2C0 (master, queued) <---> I2C1 (slave)           |\n");
+    printf("+-------------------------------------------------------+\n");
+    printf("Connect I2C0_SDA(PC.11) to I2C1_SDA(PC.3) and I2C0_SCL(PC.12) to I2C1_SCL(PC.2).\n\n");
+
+    I2C1_Init();
+
+    printf("I2C0 clock %d Hz\n", I2C_XFER_Open(&s_sBus, I2C0, 100000));
+    I2C_XFER_SetRecover(&s_sBus, BusClear, NULL);
+    I2C_XFER_EnablePDMA(&s_sBus, MASTER_PDMA_TX_CH, MASTER_PDMA_RX_CH, PDMA_MIN_LEN);
+    NVIC_EnableIRQ(I2C0_IRQn);
+
+    for (i = 0; i < BLOCK_LEN; i++)
+        s_au8Block[i] = (uint8_t)(i * 3 + 1);
+
+    for (i = 0; i < SMALL_NUM; i++)
+        for (j = 0; j < SMALL_LEN; j++)
+            s_au8Small[i][j] = (uint8_t)(0xA0 + i * SMALL_LEN + j);
+
+    /* An absent device is reported by NACK */
+    I2C_XFER_Setup(&s_sProbe, ABSENT_ADDR, 0, 0, NULL, 0, NULL, 0);
+
+    if (I2C_XFER_Transfer(&s_sBus, &s_sProbe) != I2C_XFER_ERR_NACK)
+        i32Err = -1;
+
+    printf("Probe 0x%02X: %d\n", ABSENT_ADDR, s_sProbe.i32Status);
+
+    /* Queue everything at once, the CPU is free while the bus works */
+    I2C_XFER_Setup(&s_sBlockWrite, SLAVE_ADDR, BLOCK_ADDR, 2, s_au8Block, BLOCK_LEN, NULL, 0);
+    I2C_XFER_Submit(&s_sBus, &s_sBlockWrite, XferDone, NULL);
+
+    for (i = 0; i < SMALL_NUM; i++)
+    {
+        I2C_XFER_Setup(&s_asSmall[i], SLAVE_ADDR, SMALL_ADDR + i * SMALL_LEN, 2, s_au8Small[i], SMALL_LEN, NULL, 0);
+        I2C_XFER_Submit(&s_sBus, &s_asSmall[i], XferDone, NULL);
+    }
+
+    /* Write register address, repeated START, then read */
+    I2C_XFER_Setup(&s_sBlockRead, SLAVE_ADDR, BLOCK_ADDR, 2, NULL, 0, s_au8BlockRead, BLOCK_LEN);
+    I2C_XFER_Submit(&s_sBus, &s_sBlockRead, XferDone, NULL);
+
+    I2C_XFER_Setup(&s_sSmallRead, SLAVE_ADDR, SMALL_ADDR, 2, NULL, 0, s_au8SmallRead, sizeof(s_au8SmallRead));
+    I2C_XFER_Submit(&s_sBus, &s_sSmallRead, XferDone, NULL);
+
+    while (!I2C_XFER_IS_DONE(&s_sSmallRead))
+        u32Free++;
+
+    printf("%d callbacks, %d loops of free CPU time while queued\n", g_u32Callbacks, u32Free);
+    printf("Done %d, NACK %d, error %d, time-out %d\n", s_sBus.u32Done, s_sBus.u32Nack, s_sBus.u32Error, s_sBus.u32Timeout);
+
+    if ((s_sBlockWrite.i32Status != I2C_XFER_OK) || (s_sBlockRead.i32Status != I2C_XFER_OK) ||
+            (s_sSmallRead.i32Status != I2C_XFER_OK) || (g_u32Callbacks != (SMALL_NUM + 3)))
+        i32Err = -1;
+
+    for (i = 0; i < BLOCK_LEN; i++)
+    {
+        if (s_au8BlockRead[i] != s_au8Block[i])
+            i32Err = -1;
+    }
+
+    for (i = 0; i < (SMALL_NUM * SMALL_LEN); i++)
+    {
+        if (s_au8SmallRead[i] != s_au8Small[i / SMALL_LEN][i % SMALL_LEN])
+            i32Err = -1;
+    }
+
+    if (i32Err != 0)
+    {
+        printf("*** FAIL ***\n");
+
+        while (1);
+    }
+
+    printf("*** PASS ***\n");
+
+    while (1);
+}
+
+/*** (C) COPYRIGHT 2021 Nuvoton Technology Corp. ***/
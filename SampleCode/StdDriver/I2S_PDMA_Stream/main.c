@@ -0,0 +1,179 @@
+/**************************************************************************//**
+ * @file     main.c
+ * @version  V1.00
+ * @brief    Demonstrate the I2S stream API: play and record rings of PDMA descriptors with format
+ *           conversion. I2S_DO is looped back to I2S_DI and the recorded ramp is checked for gaps.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * @copyright (C) 2021 Nuvoton Technology Corp. All rights reserved.
+*****************************************************************************/
+#include <stdio.h>
+#include "NuMicro.h"
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Macro, type and constant definitions                                                                    */
+/*---------------------------------------------------------------------------------------------------------*/
+#define I2S_TX_DMA_CH       1
+#define I2S_RX_DMA_CH       2
+#define SAMPLE_RATE         16000
+#define PERIOD_WORDS        64      /* 64 stereo frames of 16 bits, 4 ms */
+#define PERIOD_NUM          4
+#define CHUNK_FRAMES        32
+#define REPORT_PERIODS      (SAMPLE_RATE / PERIOD_WORDS)
+#define REPORT_NUM          10
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Global variables                                                                                        */
+/*---------------------------------------------------------------------------------------------------------*/
+static S_I2S_STREAM_T s_sPlay, s_sRec;
+static uint32_t s_au32PlayRing[PERIOD_WORDS * PERIOD_NUM];
+static uint32_t s_au32RecRing[PERIOD_WORDS * PERIOD_NUM];
+
+static int16_t s_ai16Mono[CHUNK_FRAMES];
+static int16_t s_ai16Stereo[CHUNK_FRAMES * 2];
+
+
+/*---------------------------------------------------------------------------------------------------------*/
+/*  PDMA IRQ Handler                                                                                       */
+/*---------------------------------------------------------------------------------------------------------*/
+void PDMA_IRQHandler(void)
+{
+    I2S_STREAM_IRQHandler(&s_sPlay);
+    I2S_STREAM_IRQHandler(&s_sRec);
+}
+
+void SYS_Init(void)
+{
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Init System Clock                                                                                       */
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Enable HIRC clock */
+    CLK_EnableXtalRC(CLK_PWRCTL_HIRCEN_Msk);
+
+    /* Waiting for HIRC clock ready */
+    CLK_WaitClockReady(CLK_STATUS_HIRCSTB_Msk);
+
+    /* Switch HCLK clock source to HIRC */
+    CLK_SetHCLK(CLK_CLKSEL0_HCLKSEL_HIRC, CLK_CLKDIV0_HCLK(1));
+
+    /* Select IP clock source */
+    CLK_SetModuleClock(UART0_MODULE, CLK_CLKSEL1_UARTSEL_HIRC_DIV2, CLK_CLKDIV0_UART(1));
+    CLK_SetModuleClock(SPI0_MODULE, CLK_CLKSEL2_SPI0SEL_PCLK0, MODULE_NoMsk);
+
+    /* Enable IP peripheral clock */
+    CLK_EnableModuleClock(UART0_MODULE);
+    CLK_EnableModuleClock(SPI0_MODULE);
+    CLK_EnableModuleClock(PDMA_MODULE);
+
+    /* Update System Core Clock */
+    SystemCoreClockUpdate();
+
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Init I/O Multi-function                                                                                 */
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Set GPB multi-function pins for UART0 RXD and TXD */
+    SYS->GPB_MFPL = SYS_GPB_MFPL_PB0MFP_UART0_RXD | SYS_GPB_MFPL_PB1MFP_UART0_TXD;
+
+    /* PC.0 is I2S_LRCLK, PC.1 is I2S_BCLK, PC.2 is I2S_DI, PC.3 is I2S_DO */
+    SYS->GPC_MFPL &= ~(SYS_GPC_MFPL_PC0MFP_Msk | SYS_GPC_MFPL_PC1MFP_Msk | SYS_GPC_MFPL_PC2MFP_Msk | SYS_GPC_MFPL_PC3MFP_Msk);
+    SYS->GPC_MFPL |= (1 << SYS_GPC_MFPL_PC0MFP_Pos) | (1 << SYS_GPC_MFPL_PC1MFP_Pos) |
+                     (1 << SYS_GPC_MFPL_PC2MFP_Pos) | (1 << SYS_GPC_MFPL_PC3MFP_Pos);
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/*  Main Function                                                                                          */
+/*---------------------------------------------------------------------------------------------------------*/
+int main(void)
+{
+    uint32_t i, u32Frames, u32Report = 0, u32Synced = 0, u32Errors = 0;
+    uint16_t u16Ramp = 1, u16Expect = 0;
+
+    /* Unlock protected registers */
+    SYS_UnlockReg();
+
+    /* Init system, peripheral clock and multi-function I/O */
+    SYS_Init();
+
+    /* Lock protected registers */
+    SYS_LockReg();
+
+    /* Init UART to 115200-8n1 for print message */
+    UART_Open(UART0, 115200);
+
+    printf("\n\n");
+    printf("+--------------------------------------------------------------+\n");
+    printf("|                 I2S + PDMA Stream Sample Code                |\n");
+    printf("+--------------------------------------------------------------+\n");
+    printf("  16 kHz, 16-bit stereo, %d periods of %d frames\n", PERIOD_NUM, PERIOD_WORDS);
+    printf("  Mono ramp is played on both channels and recorded as stereo.\n");
+    printf("  The I/O connection for I2S:\n");
+    printf("      I2S0_LRCLK (PC00)\n      I2S0_BCLK (PC01)\n");
+    printf("      I2S0_DI (PC02) <--> I2S0_DO (PC03)\n\n");
+
+    I2S_Open(SPI0, I2S_MODE_MASTER, SAMPLE_RATE, I2S_DATABIT_16, I2S_STEREO, I2S_FORMAT_I2S);
+
+    I2S_STREAM_Open(&s_sPlay, SPI0, I2S_STREAM_TX, I2S_TX_DMA_CH, s_au32PlayRing, PERIOD_WORDS, PERIOD_NUM, NULL, NULL);
+    I2S_STREAM_Open(&s_sRec, SPI0, I2S_STREAM_RX, I2S_RX_DMA_CH, s_au32RecRing, PERIOD_WORDS, PERIOD_NUM, NULL, NULL);
+    NVIC_EnableIRQ(PDMA_IRQn);
+
+    I2S_STREAM_Start(&s_sRec);
+    I2S_STREAM_Start(&s_sPlay);
+
+    while (u32Report < REPORT_NUM)
+    {
+        /* Keep the play ring full */
+        while (I2S_STREAM_GetFree(&s_sPlay) >= CHUNK_FRAMES)
+        {
+            for (i = 0; i < CHUNK_FRAMES; i++)
+                s_ai16Mono[i] = (int16_t)u16Ramp++;
+
+            I2S_STREAM_Write(&s_sPlay, s_ai16Mono, CHUNK_FRAMES, I2S_STREAM_PCM16, 1);
+        }
+
+        /* The ramp must come back on both channels without a gap once the first sample arrives */
+        u32Frames = I2S_STREAM_Read(&s_sRec, s_ai16Stereo, CHUNK_FRAMES, I2S_STREAM_PCM16, 2);
+
+        for (i = 0; i < u32Frames; i++)
+        {
+            if (s_ai16Stereo[i * 2] != s_ai16Stereo[i * 2 + 1])
+                u32Errors++;
+
+            if (u32Synced)
+            {
+                if ((uint16_t)s_ai16Stereo[i * 2] != u16Expect)
+                    u32Errors++;
+            }
+            else if (s_ai16Stereo[i * 2] == 0)
+                continue;
+
+            u32Synced = 1;
+            u16Expect = (uint16_t)s_ai16Stereo[i * 2] + 1;
+        }
+
+        if (s_sRec.u32Periods >= (u32Report + 1) * REPORT_PERIODS)
+        {
+            u32Report++;
+            printf("%2d s: periods %d/%d, xruns %d/%d, errors %d\n", u32Report, s_sPlay.u32Periods, s_sRec.u32Periods,
+                   s_sPlay.u32Xruns, s_sRec.u32Xruns, u32Errors);
+        }
+    }
+
+    I2S_STREAM_Stop(&s_sPlay);
+    I2S_STREAM_Stop(&s_sRec);
+    NVIC_DisableIRQ(PDMA_IRQn);
+    I2S_Close(SPI0);
+
+    /* The first period of the play ring is silence, later underruns break the ramp */
+    if ((u32Errors != 0) || !u32Synced || (s_sPlay.u32Xruns > 1) || (s_sRec.u32Xruns != 0))
+    {
+        printf("*** FAIL ***\n");
+
+        while (1);
+    }
+
+    printf("*** PASS ***\n");
+
+    while (1);
+}
+
+/*** (C) COPYRIGHT 2021 Nuvoton Technology Corp. ***/
@@ -0,0 +1,230 @@
+/**************************************************************************//**
+ * @file     main.c
+ * @version  V1.00
+ * @brief
+ *           Play pre-computed PWM/BPWM waveform tables by period interrupt and by PDMA.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * @copyright (C) 2021 Nuvoton Technology Corp. All rights reserved.
+ *
+ ******************************************************************************/
+#include <stdio.h>
+#include "NuMicro.h"
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Macro, type and constant definitions                                                                    */
+/*---------------------------------------------------------------------------------------------------------*/
+#define PLL_CLOCK       100000000
+
+#define RAMP_STEPS      32
+#define BREATH_STEPS    64
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Global variables                                                                                        */
+/*---------------------------------------------------------------------------------------------------------*/
+static uint16_t s_au16RampPeriod[RAMP_STEPS], s_au16RampCmp[RAMP_STEPS];
+static uint16_t s_au16BreathPeriod[BREATH_STEPS], s_au16BreathCmp[BREATH_STEPS];
+static S_PWM_SEQ_TABLE_T s_sRampTable, s_sBreathTable;
+static S_PWM_SEQ_T s_sRampSeq, s_sBreathSeq;
+
+volatile uint32_t g_u32RampDone = 0;
+
+
+/**
+ * @brief       PWM0 IRQ Handler
+ *
+ * @param       None
+ *
+ * @return      None
+ *
+ * @details     ISR to load the next step of the PWM0 channel 0 sequence
+ */
+void PWM0_IRQHandler(void)
+{
+    PWM_SEQ_IRQHandler(&s_sRampSeq);
+}
+
+void RampDone(void)
+{
+    g_u32RampDone = 1;
+}
+
+void SYS_Init(void)
+{
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Init System Clock                                                                                       */
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Enable HIRC clock */
+    CLK_EnableXtalRC(CLK_PWRCTL_HIRCEN_Msk);
+
+    /* Waiting for HIRC clock ready */
+    CLK_WaitClockReady(CLK_STATUS_HIRCSTB_Msk);
+
+    /* Select HCLK clock source as HIRC and and HCLK clock divider as 1 */
+    CLK_SetHCLK(CLK_CLKSEL0_HCLKSEL_HIRC, CLK_CLKDIV0_HCLK(1));
+
+    /* Set core clock as PLL_CLOCK from PLL */
+    CLK_SetCoreClock(PLL_CLOCK);
+
+    /* Waiting for PLL clock ready */
+    CLK_WaitClockReady(CLK_STATUS_PLLSTB_Msk);
+
+    /* Select HCLK clock source as PLL and and HCLK clock divider as 2 */
+    CLK_SetHCLK(CLK_CLKSEL0_HCLKSEL_PLL, CLK_CLKDIV0_HCLK(2));
+
+    /* Enable PWM0, BPWM0, TIMER0 and PDMA module clock */
+    CLK_EnableModuleClock(PWM0_MODULE);
+    CLK_EnableModuleClock(BPWM0_MODULE);
+    CLK_EnableModuleClock(TMR0_MODULE);
+    CLK_EnableModuleClock(PDMA_MODULE);
+
+    /* PWM0, BPWM0 and TIMER0 are all clocked from PCLK0 so the PDMA pacing never drifts from BPWM0 */
+    CLK_SetModuleClock(PWM0_MODULE, CLK_CLKSEL1_PWM0SEL_PCLK0, 0);
+    CLK_SetModuleClock(BPWM0_MODULE, CLK_CLKSEL1_BPWM0SEL_PCLK0, 0);
+    CLK_SetModuleClock(TMR0_MODULE, CLK_CLKSEL1_TMR0SEL_PCLK0, 0);
+
+    /* Enable UART module clock */
+    CLK_EnableModuleClock(UART0_MODULE);
+
+    /* Select UART module clock source as HIRC_DIV2 and UART module clock divider as 1 */
+    CLK_SetModuleClock(UART0_MODULE, CLK_CLKSEL1_UARTSEL_HIRC_DIV2, CLK_CLKDIV0_UART(1));
+
+    /* Reset PWM0, BPWM0, TIMER0 and PDMA module */
+    SYS_ResetModule(PWM0_RST);
+    SYS_ResetModule(BPWM0_RST);
+    SYS_ResetModule(TMR0_RST);
+    SYS_ResetModule(PDMA_RST);
+
+    /* Update System Core Clock */
+    SystemCoreClockUpdate();
+
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Init I/O Multi-function                                                                                 */
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Set PB multi-function pins for UART0 RXD and TXD */
+    SYS->GPB_MFPL &= ~(SYS_GPB_MFPL_PB0MFP_Msk | SYS_GPB_MFPL_PB1MFP_Msk);
+    SYS->GPB_MFPL |= (SYS_GPB_MFPL_PB0MFP_UART0_RXD | SYS_GPB_MFPL_PB1MFP_UART0_TXD);
+
+    /* Set PC multi-function pin for PWM0 Channel0 */
+    SYS->GPC_MFPH = (SYS->GPC_MFPH & (~SYS_GPC_MFPH_PC10MFP_Msk));
+    SYS->GPC_MFPH |= SYS_GPC_MFPH_PC10MFP_PWM0_CH0;
+
+    /* Set PB multi-function pin for BPWM0 Channel0 */
+    SYS->GPB_MFPL = (SYS->GPB_MFPL & (~SYS_GPB_MFPL_PB7MFP_Msk));
+    SYS->GPB_MFPL |= SYS_GPB_MFPL_PB7MFP_BPWM0_CH0;
+}
+
+void UART0_Init()
+{
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Init UART                                                                                               */
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Reset UART module */
+    SYS_ResetModule(UART0_RST);
+
+    /* Configure UART0 and set UART0 baud rate */
+    UART_Open(UART0, 115200);
+}
+
+int32_t BuildTables(uint32_t u32ClkFreq)
+{
+    uint32_t au32Freq[BREATH_STEPS];
+    uint16_t au16Duty[BREATH_STEPS];
+    uint32_t i;
+
+    /* Motor ramp: 1 kHz to 32 kHz at 50% duty */
+    for (i = 0; i < RAMP_STEPS; i++)
+    {
+        au32Freq[i] = 1000 * (i + 1);
+        au16Duty[i] = PWM_SEQ_DUTY_FULL / 2;
+    }
+
+    if (PWM_SEQ_BuildTable(u32ClkFreq, au32Freq, au16Duty, RAMP_STEPS, s_au16RampPeriod, s_au16RampCmp, &s_sRampTable) != 0)
+        return -1;
+
+    /* LED breathing: fixed 1 kHz with a triangle duty profile */
+    for (i = 0; i < BREATH_STEPS; i++)
+    {
+        au32Freq[i] = 1000;
+        au16Duty[i] = (i < (BREATH_STEPS / 2)) ? (i * PWM_SEQ_DUTY_FULL / (BREATH_STEPS / 2)) :
+                      ((BREATH_STEPS - i) * PWM_SEQ_DUTY_FULL / (BREATH_STEPS / 2));
+    }
+
+    if (PWM_SEQ_BuildTable(u32ClkFreq, au32Freq, au16Duty, BREATH_STEPS, s_au16BreathPeriod, s_au16BreathCmp, &s_sBreathTable) != 0)
+        return -1;
+
+    /* Both tables must pass the same check a host-side table generator would apply */
+    if ((PWM_SEQ_ValidateTable(&s_sRampTable) != 0) || (PWM_SEQ_ValidateTable(&s_sBreathTable) != 0))
+        return -1;
+
+    return 0;
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/*  Main Function                                                                                          */
+/*---------------------------------------------------------------------------------------------------------*/
+int32_t main(void)
+{
+    /* Unlock protected registers */
+    SYS_UnlockReg();
+
+    /* Init System, IP clock and multi-function I/O */
+    SYS_Init();
+
+    /* Lock protected registers */
+    SYS_LockReg();
+
+    /* Init UART to 115200-8n1 for print message */
+    UART0_Init();
+
+    printf("\n\nCPU @ %dHz(PLL@ %dHz)\n", SystemCoreClock, PllClock);
+    printf("+------------------------------------------------------------------------+\n");
+    printf("|                   PWM Waveform Sequencer Sample Code                   |\n");
+    printf("+------------------------------------------------------------------------+\n");
+    printf("  PWM0 channel 0 (PC.10) plays a 1 kHz ~ 32 kHz ramp by period interrupt.\n");
+    printf("  BPWM0 channel 0 (PB.7) plays a 1 kHz breathing profile by PDMA.\n");
+
+    /* PWM0 and BPWM0 are clocked from PCLK0, which equals HCLK in this sample */
+    if (BuildTables(SystemCoreClock) != 0)
+    {
+        printf("Waveform table generation failed!\n");
+
+        while (1);
+    }
+
+    printf("  Ramp table  : prescaler %d, %d steps, variable period\n", s_sRampTable.u16Prescale + 1, s_sRampTable.u32Steps);
+    printf("  Breath table: prescaler %d, %d steps, period %d\n", s_sBreathTable.u16Prescale + 1, s_sBreathTable.u32Steps,
+           s_sBreathTable.u16Period + 1);
+
+    /* Output polarity and counter type are configured as usual, the sequencer then owns period and duty */
+    PWM_ConfigOutputChannel(PWM0, 0, 1000, 50);
+    PWM_EnableOutput(PWM0, PWM_CH_0_MASK);
+    BPWM_ConfigOutputChannel(BPWM0, 0, 1000, 50);
+    BPWM_EnableOutput(BPWM0, BPWM_CH_0_MASK);
+
+    /* Ramp: one-shot through the period interrupt */
+    PWM_SEQ_InitPWM(&s_sRampSeq, PWM0, 0);
+    PWM_SEQ_Start(&s_sRampSeq, &s_sRampTable, PWM_SEQ_ONESHOT, RampDone);
+    NVIC_EnableIRQ(PWM0_IRQn);
+
+    /* Breathing: PDMA channel 0 paced by TIMER0, no CPU load */
+    PWM_SEQ_InitBPWM(&s_sBreathSeq, BPWM0, 0);
+
+    if (PWM_SEQ_StartPDMA(&s_sBreathSeq, &s_sBreathTable, 0, TIMER0, SystemCoreClock) != 0)
+    {
+        printf("PDMA sequence start failed!\n");
+
+        while (1);
+    }
+
+    PWM_Start(PWM0, PWM_CH_0_MASK);
+    BPWM_Start(BPWM0, BPWM_CH_0_MASK);
+
+    while (g_u32RampDone == 0);
+
+    printf("\nRamp done. PWM0 channel 0 keeps the last step.\n");
+
+    while (1);
+}
+
+/*** (C) COPYRIGHT 2021 Nuvoton Technology Corp. ***/
@@ -0,0 +1,20 @@
+/**************************************************************************//**
+ * @file     RTE_Components.h
+ * @version  V1.00
+ * @brief    Components of the project for CMSIS-RTOS2 RTX, in place of the file a pack manager would generate.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * @copyright (C) 2021 Nuvoton Technology Corp. All rights reserved.
+*****************************************************************************/
+#ifndef RTE_COMPONENTS_H
+#define RTE_COMPONENTS_H
+
+#define CMSIS_device_header "NuMicro.h"
+
+#define RTE_CMSIS_RTOS2                 /* CMSIS-RTOS2 */
+#define RTE_CMSIS_RTOS2_RTX5            /* CMSIS-RTOS2 Keil RTX5 */
+#define RTE_CMSIS_RTOS2_RTX5_SOURCE     /* CMSIS-RTOS2 Keil RTX5 Source */
+
+#endif /* RTE_COMPONENTS_H */
+
+/*** (C) COPYRIGHT 2021 Nuvoton Technology Corp. ***/
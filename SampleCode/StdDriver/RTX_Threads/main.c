@@ -0,0 +1,272 @@
+/**************************************************************************//**
+ * @file     main.c
+ * @version  V1.00
+ * @brief    Run CMSIS-RTOS2 RTX on NUC121: threads sharing UART0 and SPI0 through the RTOS_DRV wrappers,
+ *           a context switch benchmark, the RAM footprint and tickless idle with TIMER1 in Power-down mode.
+ *
+ * @note     RTX_Config.h of this directory is tuned for 8 KB SRAM, the projects build the RTX sources of
+ *           Library/CMSIS/RTOS2. Code size is found in the map file of the build.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * @copyright (C) 2021 Nuvoton Technology Corp. All rights reserved.
+*****************************************************************************/
+#include <stdio.h>
+#include <stdarg.h>
+#include "NuMicro.h"
+#include "rtos_drv.h"
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Macro, type and constant definitions                                                                    */
+/*---------------------------------------------------------------------------------------------------------*/
+#define APP_STACK_SIZE      640
+#define PONG_STACK_SIZE     192
+#define SENSOR_STACK_SIZE   448
+#define SWITCH_ROUNDS       1000
+#define SENSOR_PERIOD_MS    20
+#define MIN_PD_TICKS        5
+#define SLEEP_MS            1000
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Global variables                                                                                        */
+/*---------------------------------------------------------------------------------------------------------*/
+static S_RTOS_UART_T s_sUart;
+static S_RTOS_SPI_T s_sSpi;
+
+/* Control blocks and stacks are placed here, RTX dynamic memory stays free */
+static uint32_t s_au32AppCb[(osRtxThreadCbSize + 3) / 4];
+static uint32_t s_au32PongCb[(osRtxThreadCbSize + 3) / 4];
+static uint32_t s_au32SensorCb[(osRtxThreadCbSize + 3) / 4];
+static uint64_t s_au64AppStack[APP_STACK_SIZE / 8];
+static uint64_t s_au64PongStack[PONG_STACK_SIZE / 8];
+static uint64_t s_au64SensorStack[SENSOR_STACK_SIZE / 8];
+
+static const osThreadAttr_t s_sAppAttr =
+{
+    "app", osThreadDetached, s_au32AppCb, sizeof(s_au32AppCb), s_au64AppStack, sizeof(s_au64AppStack),
+    osPriorityNormal, 0, 0
+};
+static const osThreadAttr_t s_sPongAttr =
+{
+    "pong", osThreadDetached, s_au32PongCb, sizeof(s_au32PongCb), s_au64PongStack, sizeof(s_au64PongStack),
+    osPriorityHigh, 0, 0
+};
+static const osThreadAttr_t s_sSensorAttr =
+{
+    "sensor", osThreadDetached, s_au32SensorCb, sizeof(s_au32SensorCb), s_au64SensorStack, sizeof(s_au64SensorStack),
+    osPriorityAboveNormal, 0, 0
+};
+
+static osThreadId_t s_sAppId, s_sPongId, s_sSensorId;
+static volatile uint32_t s_u32SensorRounds;
+
+
+void UART0_IRQHandler(void)
+{
+    RTOS_UART_IRQHandler(&s_sUart);
+}
+
+void SPI0_IRQHandler(void)
+{
+    RTOS_SPI_IRQHandler(&s_sSpi);
+}
+
+/* Thread safe print, the line goes out in one RTOS_UART_Write */
+void Print(const char *pcFmt, ...)
+{
+    char acLine[80];
+    va_list ap;
+    int i32Len;
+
+    va_start(ap, pcFmt);
+    i32Len = vsnprintf(acLine, sizeof(acLine), pcFmt, ap);
+    va_end(ap);
+
+    if (i32Len > (int)sizeof(acLine) - 1)
+        i32Len = sizeof(acLine) - 1;
+
+    if (i32Len > 0)
+        RTOS_UART_Write(&s_sUart, acLine, (uint32_t)i32Len, osWaitForever);
+}
+
+/* Answers every flag of the app thread at once */
+__NO_RETURN void PongThread(void *argument)
+{
+    (void)argument;
+
+    while (1)
+    {
+        osThreadFlagsWait(0x1, osFlagsWaitAny, osWaitForever);
+        osThreadFlagsSet(s_sAppId, 0x1);
+    }
+}
+
+/* Polls a stand-in SPI sensor and shares UART0 with the app thread */
+__NO_RETURN void SensorThread(void *argument)
+{
+    uint8_t au8Cmd[4] = {0x9F, 0xFF, 0xFF, 0xFF}, au8Rsp[4];
+
+    (void)argument;
+
+    while (1)
+    {
+        RTOS_SPI_Transfer(&s_sSpi, au8Cmd, au8Rsp, sizeof(au8Cmd), 10);
+
+        if ((++s_u32SensorRounds % 10) == 0)
+            Print("sensor  round %3u, %02x %02x %02x\n", (unsigned int)s_u32SensorRounds, au8Rsp[1], au8Rsp[2],
+                  au8Rsp[3]);
+
+        osDelay(SENSOR_PERIOD_MS);
+    }
+}
+
+void StackReport(const char *pcName, osThreadId_t sId, uint32_t u32Size)
+{
+    uint32_t u32Free = osThreadGetStackSpace(sId);
+
+    Print("  %-8s stack %4u, used %4u\n", pcName, (unsigned int)u32Size, (unsigned int)(u32Size - u32Free));
+}
+
+__NO_RETURN void AppThread(void *argument)
+{
+    const S_RTOS_IDLE_STAT_T *psIdle;
+    uint32_t i, u32Start, u32Cycles, u32Ticks, u32Slept, u32Ok = 1;
+
+    (void)argument;
+
+    /* Context switch: each round wakes pong and comes back, two switches */
+    s_sPongId = osThreadNew(PongThread, NULL, &s_sPongAttr);
+
+    u32Start = osKernelGetSysTimerCount();
+
+    for (i = 0; i < SWITCH_ROUNDS; i++)
+    {
+        osThreadFlagsSet(s_sPongId, 0x1);
+        osThreadFlagsWait(0x1, osFlagsWaitAny, osWaitForever);
+    }
+
+    u32Cycles = osKernelGetSysTimerCount() - u32Start;
+
+    Print("\nThread flag round trip %u HCLK cycles, %u per switch with its flag calls\n",
+          (unsigned int)(u32Cycles / SWITCH_ROUNDS), (unsigned int)(u32Cycles / (2 * SWITCH_ROUNDS)));
+
+    /* Two threads on the same UART and one on SPI */
+    s_sSensorId = osThreadNew(SensorThread, NULL, &s_sSensorAttr);
+
+    for (i = 0; i < 5; i++)
+    {
+        Print("app     line %u\n", (unsigned int)i);
+        osDelay(100);
+    }
+
+    /* Nothing but the sensor wakes the CPU during the sleep */
+    psIdle = RTOS_GetIdleStat();
+    u32Slept = psIdle->u32SleptTicks;
+    u32Ticks = osKernelGetTickCount();
+    osDelay(SLEEP_MS);
+    u32Ticks = osKernelGetTickCount() - u32Ticks;
+    u32Slept = psIdle->u32SleptTicks - u32Slept;
+
+    Print("\nosDelay(%u) took %u ticks, idle %u, power-down %u, %u ticks slept without SysTick\n", SLEEP_MS,
+          (unsigned int)u32Ticks, (unsigned int)psIdle->u32IdleCount, (unsigned int)psIdle->u32PDCount,
+          (unsigned int)u32Slept);
+
+    /* RAM footprint */
+    Print("\nRAM: thread CB %u, mutex CB %u, event flags CB %u, UART wrapper %u, SPI wrapper %u\n",
+          (unsigned int)osRtxThreadCbSize, (unsigned int)osRtxMutexCbSize, (unsigned int)osRtxEventFlagsCbSize,
+          (unsigned int)sizeof(S_RTOS_UART_T), (unsigned int)sizeof(S_RTOS_SPI_T));
+    Print("     kernel info %u, ISR queue %u, idle stack %u, dynamic memory %u\n", (unsigned int)sizeof(osRtxInfo),
+          (unsigned int)(osRtxConfig.isr_queue.max * sizeof(void *)),
+          (unsigned int)osRtxConfig.idle_thread_attr->stack_size, (unsigned int)osRtxConfig.mem.common_size);
+
+    StackReport("app", s_sAppId, APP_STACK_SIZE);
+    StackReport("pong", s_sPongId, PONG_STACK_SIZE);
+    StackReport("sensor", s_sSensorId, SENSOR_STACK_SIZE);
+    StackReport("idle", osRtxInfo.thread.idle, osRtxConfig.idle_thread_attr->stack_size);
+
+    /* Idle entries are counted even if the CPU never sleeps, most of the delay must be slept without SysTick */
+    if ((u32Cycles == 0) || (u32Ticks < SLEEP_MS) || (u32Slept < SLEEP_MS / 2) || (s_u32SensorRounds == 0))
+        u32Ok = 0;
+
+    Print(u32Ok ? "\nPASS\n" : "\nFAIL\n");
+
+    osThreadTerminate(s_sSensorId);
+    osThreadExit();
+}
+
+void SYS_Init(void)
+{
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Init System Clock                                                                                       */
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Enable HIRC and LIRC clock, LIRC keeps the tickless TIMER running in Power-down mode */
+    CLK_EnableXtalRC(CLK_PWRCTL_HIRCEN_Msk | CLK_PWRCTL_LIRCEN_Msk);
+
+    /* Waiting for HIRC and LIRC clock ready */
+    CLK_WaitClockReady(CLK_STATUS_HIRCSTB_Msk | CLK_STATUS_LIRCSTB_Msk);
+
+    /* Switch HCLK clock source to HIRC */
+    CLK_SetHCLK(CLK_CLKSEL0_HCLKSEL_HIRC, CLK_CLKDIV0_HCLK(1));
+
+    /* Select IP clock source */
+    CLK_SetModuleClock(UART0_MODULE, CLK_CLKSEL1_UARTSEL_HIRC_DIV2, CLK_CLKDIV0_UART(1));
+    CLK_SetModuleClock(TMR1_MODULE, CLK_CLKSEL1_TMR1SEL_LIRC, 0);
+    CLK_SetModuleClock(SPI0_MODULE, CLK_CLKSEL2_SPI0SEL_PCLK0, 0);
+
+    /* Enable IP peripheral clock */
+    CLK_EnableModuleClock(UART0_MODULE);
+    CLK_EnableModuleClock(TMR1_MODULE);
+    CLK_EnableModuleClock(SPI0_MODULE);
+
+    /* Update System Core Clock */
+    SystemCoreClockUpdate();
+
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Init I/O Multi-function                                                                                 */
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Set GPB multi-function pins for UART0 RXD and TXD */
+    SYS->GPB_MFPL = (SYS->GPB_MFPL & ~(SYS_GPB_MFPL_PB0MFP_Msk | SYS_GPB_MFPL_PB1MFP_Msk)) |
+                    SYS_GPB_MFPL_PB0MFP_UART0_RXD | SYS_GPB_MFPL_PB1MFP_UART0_TXD;
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/*  Main Function                                                                                          */
+/*---------------------------------------------------------------------------------------------------------*/
+int main(void)
+{
+    /* Unlock protected registers */
+    SYS_UnlockReg();
+
+    /* Init system, peripheral clock and multi-function I/O */
+    SYS_Init();
+
+    /* Lock protected registers */
+    SYS_LockReg();
+
+    /* Init UART to 115200-8n1 for print message */
+    UART_Open(UART0, 115200);
+
+    printf("\n\n");
+    printf("+--------------------------------------------------------------+\n");
+    printf("|                   RTX Threads Sample Code                    |\n");
+    printf("+--------------------------------------------------------------+\n");
+
+    /* printf is polled and not thread safe, threads print through the UART wrapper */
+    osKernelInitialize();
+
+    RTOS_UART_Open(&s_sUart, UART0, 115200);
+    NVIC_EnableIRQ(UART0_IRQn);
+
+    /* The sensor is a stand-in, SPI0 runs without its pins */
+    RTOS_SPI_Open(&s_sSpi, SPI0, SPI_MODE_0, 1000000);
+    NVIC_EnableIRQ(SPI0_IRQn);
+
+    RTOS_TicklessInit(TIMER1, MIN_PD_TICKS);
+
+    s_sAppId = osThreadNew(AppThread, NULL, &s_sAppAttr);
+
+    osKernelStart();
+
+    while (1);
+}
+
+/*** (C) COPYRIGHT 2021 Nuvoton Technology Corp. ***/
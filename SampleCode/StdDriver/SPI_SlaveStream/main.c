@@ -0,0 +1,218 @@
+/**************************************************************************//**
+ * @file     main.c
+ * @version  V1.00
+ * @brief    Demonstrate the SPI slave stream: SPI0 slave with PDMA fed TX and RX rings is clocked by
+ *           USCI_SPI0 as master on the same chip with bursts of random length.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * @copyright (C) 2021 Nuvoton Technology Corp. All rights reserved.
+*****************************************************************************/
+#include <stdio.h>
+#include "NuMicro.h"
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Macro, type and constant definitions                                                                    */
+/*---------------------------------------------------------------------------------------------------------*/
+#define BUS_CLOCK           6000000
+#define SLAVE_TX_DMA_CH     0
+#define SLAVE_RX_DMA_CH     1
+#define MASTER_TX_DMA_CH    2
+#define MASTER_RX_DMA_CH    3
+#define SEG_FRAMES          256
+#define SEG_NUM             4
+#define BURST_MAX           512
+#define BURST_NUM           20000
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Global variables                                                                                        */
+/*---------------------------------------------------------------------------------------------------------*/
+static S_SPI_SLAVE_T s_sSlave;
+static S_USPI_XFER_T s_sMaster;
+
+static uint8_t s_au8SlaveTxRing[SEG_FRAMES * SEG_NUM], s_au8SlaveRxRing[SEG_FRAMES * SEG_NUM];
+static uint8_t s_au8MasterTx[BURST_MAX], s_au8MasterRx[BURST_MAX];
+static uint8_t s_au8Buf[SEG_FRAMES];
+static uint8_t s_u8SlaveTx = 0;
+
+
+/*---------------------------------------------------------------------------------------------------------*/
+/*  Interrupt Handlers                                                                                     */
+/*---------------------------------------------------------------------------------------------------------*/
+void PDMA_IRQHandler(void)
+{
+    SPI_SLAVE_PDMAHandler(&s_sSlave);
+    USPI_XferPDMAHandler(&s_sMaster);
+}
+
+void SPI0_IRQHandler(void)
+{
+    SPI_SLAVE_IRQHandler(&s_sSlave);
+}
+
+void USCI_IRQHandler(void)
+{
+    USPI_XferIRQHandler(&s_sMaster);
+}
+
+/* Fill the slave TX ring with the next values of its byte counter */
+void SlaveRefill(void)
+{
+    uint32_t i, u32Len;
+
+    while ((u32Len = SPI_SLAVE_GetTxFree(&s_sSlave)) != 0)
+    {
+        if (u32Len > sizeof(s_au8Buf))
+            u32Len = sizeof(s_au8Buf);
+
+        for (i = 0; i < u32Len; i++)
+            s_au8Buf[i] = s_u8SlaveTx++;
+
+        SPI_SLAVE_Write(&s_sSlave, s_au8Buf, u32Len);
+    }
+}
+
+void SYS_Init(void)
+{
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Init System Clock                                                                                       */
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Enable HIRC clock */
+    CLK_EnableXtalRC(CLK_PWRCTL_HIRCEN_Msk);
+
+    /* Waiting for HIRC clock ready */
+    CLK_WaitClockReady(CLK_STATUS_HIRCSTB_Msk);
+
+    /* Switch HCLK clock source to HIRC */
+    CLK_SetHCLK(CLK_CLKSEL0_HCLKSEL_HIRC, CLK_CLKDIV0_HCLK(1));
+
+    /* Select IP clock source */
+    CLK_SetModuleClock(UART0_MODULE, CLK_CLKSEL1_UARTSEL_HIRC_DIV2, CLK_CLKDIV0_UART(1));
+    CLK_SetModuleClock(SPI0_MODULE, CLK_CLKSEL2_SPI0SEL_PCLK0, MODULE_NoMsk);
+
+    /* Enable IP peripheral clock */
+    CLK_EnableModuleClock(UART0_MODULE);
+    CLK_EnableModuleClock(SPI0_MODULE);
+    CLK_EnableModuleClock(USCI0_MODULE);
+    CLK_EnableModuleClock(PDMA_MODULE);
+
+    /* Update System Core Clock */
+    SystemCoreClockUpdate();
+
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Init I/O Multi-function                                                                                 */
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Set GPB multi-function pins for UART0 RXD and TXD */
+    SYS->GPB_MFPL = SYS_GPB_MFPL_PB0MFP_UART0_RXD | SYS_GPB_MFPL_PB1MFP_UART0_TXD |
+                    SYS_GPB_MFPL_PB4MFP_USCI0_CTL0 | SYS_GPB_MFPL_PB5MFP_USCI0_CLK |
+                    SYS_GPB_MFPL_PB6MFP_USCI0_DAT0 | SYS_GPB_MFPL_PB7MFP_USCI0_DAT1;
+
+    /* SPI0 slave on PC.0 to PC.3 */
+    SYS->GPC_MFPL = (SYS->GPC_MFPL & ~(SYS_GPC_MFPL_PC0MFP_Msk | SYS_GPC_MFPL_PC1MFP_Msk | SYS_GPC_MFPL_PC2MFP_Msk | SYS_GPC_MFPL_PC3MFP_Msk)) |
+                    SYS_GPC_MFPL_PC0MFP_SPI0_SS | SYS_GPC_MFPL_PC1MFP_SPI0_CLK | SYS_GPC_MFPL_PC2MFP_SPI0_MISO | SYS_GPC_MFPL_PC3MFP_SPI0_MOSI;
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/*  Main Function                                                                                          */
+/*---------------------------------------------------------------------------------------------------------*/
+int main(void)
+{
+    uint32_t i, u32Burst, u32Len, u32Seed = 1;
+    uint32_t u32Errors = 0, u32Frames = 0;
+    uint8_t u8MasterTx = 0, u8SlaveExpect = 0, u8MasterExpect = 0;
+
+    /* Unlock protected registers */
+    SYS_UnlockReg();
+
+    /* Init system, peripheral clock and multi-function I/O */
+    SYS_Init();
+
+    /* Lock protected registers */
+    SYS_LockReg();
+
+    /* Init UART to 115200-8n1 for print message */
+    UART_Open(UART0, 115200);
+
+    printf("\n\n");
+    printf("+--------------------------------------------------------------+\n");
+    printf("|                  SPI Slave Stream Sample Code                |\n");
+    printf("+--------------------------------------------------------------+\n");
+    printf("The I/O connection for USCI_SPI0 master to SPI0 slave:\n");
+    printf("    USCI_SPI0_SS (PB.4) <--> SPI0_SS (PC.0)\n    USCI_SPI0_CLK (PB.5) <--> SPI0_CLK (PC.1)\n");
+    printf("    USCI_SPI0_MOSI (PB.6) <--> SPI0_MOSI (PC.3)\n    USCI_SPI0_MISO (PB.7) <--> SPI0_MISO (PC.2)\n\n");
+
+    /* Slave rings of 4 segments of 256 frames */
+    SPI_Open(SPI0, SPI_SLAVE, SPI_MODE_0, 8, 0);
+    SPI_SLAVE_Open(&s_sSlave, SPI0, SLAVE_TX_DMA_CH, SLAVE_RX_DMA_CH, s_au8SlaveTxRing, s_au8SlaveRxRing, SEG_FRAMES, SEG_NUM);
+
+    /* Master on USCI0 with PDMA for bursts */
+    printf("Bus clock %d Hz\n", USPI_Open(USPI0, USPI_MASTER, USPI_MODE_0, 8, BUS_CLOCK));
+    USPI_XferInit(&s_sMaster, USPI0);
+    USPI_XferEnablePDMA(&s_sMaster, MASTER_TX_DMA_CH, MASTER_RX_DMA_CH, 16);
+
+    NVIC_EnableIRQ(PDMA_IRQn);
+    NVIC_EnableIRQ(SPI0_IRQn);
+    NVIC_EnableIRQ(USCI_IRQn);
+
+    /* The slave has its reply ready before the first clock */
+    SlaveRefill();
+
+    SPI_SLAVE_Start(&s_sSlave);
+
+    for (u32Burst = 0; u32Burst < BURST_NUM; u32Burst++)
+    {
+        /* Keep the slave TX ring full */
+        SlaveRefill();
+
+        /* Burst of 1 to BURST_MAX frames, both sides send a byte counter */
+        u32Seed = u32Seed * 1103515245UL + 12345UL;
+        u32Len = ((u32Seed >> 16) & (BURST_MAX - 1)) + 1;
+
+        for (i = 0; i < u32Len; i++)
+            s_au8MasterTx[i] = u8MasterTx++;
+
+        USPI_Transfer(&s_sMaster, s_au8MasterTx, s_au8MasterRx, u32Len, 0);
+
+        for (i = 0; i < u32Len; i++)
+        {
+            if (s_au8MasterRx[i] != u8MasterExpect++)
+                u32Errors++;
+        }
+
+        /* Everything clocked in must be readable once the slave select is released */
+        while ((u32Len = SPI_SLAVE_Read(&s_sSlave, s_au8Buf, sizeof(s_au8Buf))) != 0)
+        {
+            for (i = 0; i < u32Len; i++)
+            {
+                if (s_au8Buf[i] != u8SlaveExpect++)
+                    u32Errors++;
+            }
+
+            u32Frames += u32Len;
+        }
+
+        if (u8SlaveExpect != u8MasterTx)
+            u32Errors++;
+    }
+
+    printf("Bursts %d, frames %d, errors %d\n", s_sSlave.u32Bursts, u32Frames, u32Errors);
+    printf("TX underruns %d, RX overruns %d, FIFO underruns %d, FIFO overruns %d\n", s_sSlave.u32TxUnderruns,
+           s_sSlave.u32RxOverruns, s_sSlave.u32FifoUnderruns, s_sSlave.u32FifoOverruns);
+
+    SPI_SLAVE_Stop(&s_sSlave);
+    USPI_Close(USPI0);
+    SPI_Close(SPI0);
+
+    if ((u32Errors != 0) || (s_sSlave.u32TxUnderruns != 0) || (s_sSlave.u32RxOverruns != 0) ||
+            (s_sSlave.u32FifoUnderruns != 0) || (s_sSlave.u32FifoOverruns != 0))
+    {
+        printf("*** FAIL ***\n");
+
+        while (1);
+    }
+
+    printf("*** PASS ***\n");
+
+    while (1);
+}
+
+/*** (C) COPYRIGHT 2021 Nuvoton Technology Corp. ***/
@@ -0,0 +1,141 @@
+/**************************************************************************//**
+ * @file     main.c
+ * @version  V1.00
+ * @brief    Demonstrate the crash dump: a hard fault is saved to flash with the stack around it, the chip
+ *           resets, and the next boot prints the record and the boot count.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * @copyright (C) 2021 Nuvoton Technology Corp. All rights reserved.
+*****************************************************************************/
+#include <stdio.h>
+#include "NuMicro.h"
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Macro, type and constant definitions                                                                    */
+/*---------------------------------------------------------------------------------------------------------*/
+/* Last two pages of the 32 KB APROM, outside of the code of this sample */
+#define CRASH_STORE_BASE    (0x8000UL - CRASH_STORE_SIZE)
+
+typedef void (*FAULT_FUNC)(void);
+
+
+/* Kept out of line, so its return address shows up in the backtrace */
+void FaultWrite(uint32_t u32Addr, uint32_t u32Value)
+{
+    M32(u32Addr) = u32Value;
+}
+
+void FaultCall(uint32_t u32Addr)
+{
+    FAULT_FUNC pfnFunc = (FAULT_FUNC)u32Addr;
+
+    pfnFunc();
+}
+
+void SYS_Init(void)
+{
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Init System Clock                                                                                       */
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Enable HIRC clock */
+    CLK_EnableXtalRC(CLK_PWRCTL_HIRCEN_Msk);
+
+    /* Waiting for HIRC clock ready */
+    CLK_WaitClockReady(CLK_STATUS_HIRCSTB_Msk);
+
+    /* Switch HCLK clock source to HIRC */
+    CLK_SetHCLK(CLK_CLKSEL0_HCLKSEL_HIRC, CLK_CLKDIV0_HCLK(1));
+
+    /* Select IP clock source */
+    CLK_SetModuleClock(UART0_MODULE, CLK_CLKSEL1_UARTSEL_HIRC_DIV2, CLK_CLKDIV0_UART(1));
+
+    /* Enable IP peripheral clock */
+    CLK_EnableModuleClock(UART0_MODULE);
+
+    /* Update System Core Clock */
+    SystemCoreClockUpdate();
+
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Init I/O Multi-function                                                                                 */
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Set GPB multi-function pins for UART0 RXD and TXD */
+    SYS->GPB_MFPL = (SYS->GPB_MFPL & ~(SYS_GPB_MFPL_PB0MFP_Msk | SYS_GPB_MFPL_PB1MFP_Msk)) |
+                    SYS_GPB_MFPL_PB0MFP_UART0_RXD | SYS_GPB_MFPL_PB1MFP_UART0_TXD;
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/*  Main Function                                                                                          */
+/*---------------------------------------------------------------------------------------------------------*/
+int main(void)
+{
+    S_CRASH_T sCrash;
+    int32_t i32Ret;
+
+    /* Unlock protected registers */
+    SYS_UnlockReg();
+
+    /* Init system, peripheral clock and multi-function I/O */
+    SYS_Init();
+
+    /* Count the boot first, so a fault anywhere later is captured */
+    i32Ret = CRASH_Open(CRASH_STORE_BASE);
+
+    /* Init UART to 115200-8n1 for print message */
+    UART_Open(UART0, 115200);
+
+    printf("\n\n");
+    printf("+--------------------------------------------------------------+\n");
+    printf("|                   SYS Crash Dump Sample Code                 |\n");
+    printf("+--------------------------------------------------------------+\n");
+
+    if (i32Ret != 0)
+    {
+        printf("Crash store failed %d\n", i32Ret);
+
+        while (1);
+    }
+
+    printf("Boot %d\n\n", CRASH_GetBootCount());
+
+    if (CRASH_Get(&sCrash))
+    {
+        CRASH_Print(&sCrash);
+        CRASH_Clear();
+        printf("\n");
+    }
+    else
+        printf("No crash recorded\n\n");
+
+    SYS_LockReg();
+
+    printf("[1] Write to flash address 0x4\n");
+    printf("[2] Call an address without the Thumb bit\n");
+    printf("[3] Read a word at an unaligned address\n");
+    printf("Any other key resets without a fault.\n");
+
+    switch (getchar())
+    {
+        case '1':
+            FaultWrite(4UL, 0x12345678UL);
+            break;
+
+        case '2':
+            FaultCall(0x00000100UL);
+            break;
+
+        case '3':
+            printf("0x%08x\n", (unsigned int)M32(SRAM_BASE + 2UL));
+            break;
+
+        default:
+            break;
+    }
+
+    /* Wait for the last character, then reset */
+    UART_WAIT_TX_EMPTY(UART0);
+    NVIC_SystemReset();
+
+    while (1);
+}
+
+/*** (C) COPYRIGHT 2021 Nuvoton Technology Corp. ***/
@@ -0,0 +1,98 @@
+/**************************************************************************//**
+ * @file     main.c
+ * @version  V1.00
+ * @brief    Demonstrate the fast boot path: HXT started in SystemInit while RAM is initialised and boot phases
+ *           stamped in HCLK cycles since reset.
+ *
+ * @note     The projects define INIT_HXT_AT_BOOTING and INIT_BOOT_MARK_AT_BOOTING, the GCC project also
+ *           __STARTUP_FAST_BOOT for the table driven RAM initialisation of startup_NUC121.S.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * @copyright (C) 2021 Nuvoton Technology Corp. All rights reserved.
+*****************************************************************************/
+#include <stdio.h>
+#include "NuMicro.h"
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Global variables                                                                                        */
+/*---------------------------------------------------------------------------------------------------------*/
+static const char *s_apcMarkName[BOOT_MARK_NUM] = {"RAM init", "main", "clock", "UART"};
+static uint32_t s_u32HxtReady;
+
+
+void SYS_Init(void)
+{
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Init System Clock                                                                                       */
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Enable HIRC clock */
+    CLK_EnableXtalRC(CLK_PWRCTL_HIRCEN_Msk);
+
+    /* HXT was started by SystemInit, most of its stabilisation time has already passed */
+    s_u32HxtReady = CLK_WaitClockReady(CLK_STATUS_HIRCSTB_Msk | CLK_STATUS_HXTSTB_Msk);
+
+    /* Switch HCLK clock source to HIRC */
+    CLK_SetHCLK(CLK_CLKSEL0_HCLKSEL_HIRC, CLK_CLKDIV0_HCLK(1));
+
+    /* Select IP clock source */
+    CLK_SetModuleClock(UART0_MODULE, CLK_CLKSEL1_UARTSEL_HIRC_DIV2, CLK_CLKDIV0_UART(1));
+
+    /* Enable IP peripheral clock */
+    CLK_EnableModuleClock(UART0_MODULE);
+
+    /* Update System Core Clock */
+    SystemCoreClockUpdate();
+
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Init I/O Multi-function                                                                                 */
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Set GPB multi-function pins for UART0 RXD and TXD */
+    SYS->GPB_MFPL = (SYS->GPB_MFPL & ~(SYS_GPB_MFPL_PB0MFP_Msk | SYS_GPB_MFPL_PB1MFP_Msk)) |
+                    SYS_GPB_MFPL_PB0MFP_UART0_RXD | SYS_GPB_MFPL_PB1MFP_UART0_TXD;
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/*  Main Function                                                                                          */
+/*---------------------------------------------------------------------------------------------------------*/
+int main(void)
+{
+    uint32_t i;
+
+    SystemBootMark(BOOT_MARK_MAIN);
+
+    /* Unlock protected registers */
+    SYS_UnlockReg();
+
+    /* Init system, peripheral clock and multi-function I/O */
+    SYS_Init();
+
+    /* Lock protected registers */
+    SYS_LockReg();
+
+    SystemBootMark(BOOT_MARK_CLOCK);
+
+    /* Init UART to 115200-8n1 for print message */
+    UART_Open(UART0, 115200);
+
+    SystemBootMark(BOOT_MARK_APP);
+
+    printf("\n\n");
+    printf("+--------------------------------------------------------------+\n");
+    printf("|                    SYS Fast Boot Sample Code                 |\n");
+    printf("+--------------------------------------------------------------+\n");
+
+    /* Keil and IAR initialise RAM in their own library, their RAM init stamp stays 0 */
+    for (i = 0; i < BOOT_MARK_NUM; i++)
+        printf("%-10s %8u HCLK cycles\n", s_apcMarkName[i], (unsigned int)g_au32BootMark[i]);
+
+    printf("\nHXT %s\n", s_u32HxtReady ? "stable" : "not stable, is a crystal fitted?");
+
+    if ((g_au32BootMark[BOOT_MARK_MAIN] != 0) && (g_au32BootMark[BOOT_MARK_MAIN] < g_au32BootMark[BOOT_MARK_CLOCK]))
+        printf("\nPASS\n");
+    else
+        printf("\nFAIL\n");
+
+    while (1);
+}
+
+/*** (C) COPYRIGHT 2021 Nuvoton Technology Corp. ***/
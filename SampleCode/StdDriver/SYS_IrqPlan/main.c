@@ -0,0 +1,172 @@
+/**************************************************************************//**
+ * @file     main.c
+ * @version  V1.00
+ * @brief    Demonstrate the interrupt priority planner: a short periodic "audio" interrupt next to a long one,
+ *           first at the default equal priorities, then at the levels planned from their deadlines, with the
+ *           worst audio latency measured in both cases.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * @copyright (C) 2021 Nuvoton Technology Corp. All rights reserved.
+*****************************************************************************/
+#include <stdio.h>
+#include "NuMicro.h"
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Macro, type and constant definitions                                                                    */
+/*---------------------------------------------------------------------------------------------------------*/
+#define AUDIO_FREQ          4000
+#define LONG_FREQ           200
+#define LONG_ISR_US         200
+#define RUN_LONG_ISRS       400
+
+#define PLAN_AUDIO          0
+#define PLAN_USBD           1
+#define PLAN_LONG           2
+#define PLAN_NUM            3
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Global variables                                                                                        */
+/*---------------------------------------------------------------------------------------------------------*/
+/* Deadlines and costs are declared in us, the planner and the monitor fill the zeros */
+static S_IRQ_PLAN_T s_asPlan[PLAN_NUM] =
+{
+    {TMR0_IRQn, "TMR0 audio",  1000000 / AUDIO_FREQ, 10,          0, 0, 0, 0, 0, 0, 0},
+    {USBD_IRQn, "USBD",        1000,                 50,          0, 0, 0, 0, 0, 0, 0},
+    {TMR1_IRQn, "TMR1 long",   1000000 / LONG_FREQ,  LONG_ISR_US, 0, 0, 0, 0, 0, 0, 0},
+};
+static uint32_t s_u32TickFreq;
+static volatile uint32_t s_u32Samples;
+
+
+/* The audio tick, short but urgent */
+void TMR0_IRQHandler(void)
+{
+    IRQ_PLAN_ProbeEntry(&s_asPlan[PLAN_AUDIO], TIMER0);
+
+    s_u32Samples++;
+
+    IRQ_PLAN_EXIT(&s_asPlan[PLAN_AUDIO]);
+}
+
+/* A long handler, a stand-in for a UART or I2C handler that parses a whole frame */
+void TMR1_IRQHandler(void)
+{
+    uint32_t u32Ticks = (uint32_t)((uint64_t)s_u32TickFreq * LONG_ISR_US / 1000000UL);
+
+    IRQ_PLAN_ENTER(&s_asPlan[PLAN_LONG]);
+
+    TIMER_ClearIntFlag(TIMER1);
+
+    while (((PROF_Now() - s_asPlan[PLAN_LONG].u32Entry) & PROF_CNT_MSK) < u32Ticks);
+
+    IRQ_PLAN_EXIT(&s_asPlan[PLAN_LONG]);
+}
+
+void SYS_Init(void)
+{
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Init System Clock                                                                                       */
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Enable HIRC clock */
+    CLK_EnableXtalRC(CLK_PWRCTL_HIRCEN_Msk);
+
+    /* Waiting for HIRC clock ready */
+    CLK_WaitClockReady(CLK_STATUS_HIRCSTB_Msk);
+
+    /* Switch HCLK clock source to HIRC */
+    CLK_SetHCLK(CLK_CLKSEL0_HCLKSEL_HIRC, CLK_CLKDIV0_HCLK(1));
+
+    /* Select IP clock source */
+    CLK_SetModuleClock(UART0_MODULE, CLK_CLKSEL1_UARTSEL_HIRC_DIV2, CLK_CLKDIV0_UART(1));
+    CLK_SetModuleClock(TMR0_MODULE, CLK_CLKSEL1_TMR0SEL_HIRC_DIV2, 0);
+    CLK_SetModuleClock(TMR1_MODULE, CLK_CLKSEL1_TMR1SEL_HIRC_DIV2, 0);
+
+    /* Enable IP peripheral clock */
+    CLK_EnableModuleClock(UART0_MODULE);
+    CLK_EnableModuleClock(TMR0_MODULE);
+    CLK_EnableModuleClock(TMR1_MODULE);
+
+    /* Update System Core Clock */
+    SystemCoreClockUpdate();
+
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Init I/O Multi-function                                                                                 */
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Set GPB multi-function pins for UART0 RXD and TXD */
+    SYS->GPB_MFPL = (SYS->GPB_MFPL & ~(SYS_GPB_MFPL_PB0MFP_Msk | SYS_GPB_MFPL_PB1MFP_Msk)) |
+                    SYS_GPB_MFPL_PB0MFP_UART0_RXD | SYS_GPB_MFPL_PB1MFP_UART0_TXD;
+}
+
+/* Run both interrupts for a while and return the worst audio latency */
+uint32_t RunLoad(void)
+{
+    IRQ_PLAN_Reset(s_asPlan, PLAN_NUM);
+
+    IRQ_PLAN_ProbeStart(&s_asPlan[PLAN_AUDIO], TIMER0, AUDIO_FREQ);
+
+    TIMER_Open(TIMER1, TIMER_PERIODIC_MODE, LONG_FREQ);
+    TIMER_EnableInt(TIMER1);
+    NVIC_EnableIRQ(TMR1_IRQn);
+    TIMER_Start(TIMER1);
+
+    while (s_asPlan[PLAN_LONG].u32Count < RUN_LONG_ISRS);
+
+    TIMER_Stop(TIMER1);
+    NVIC_DisableIRQ(TMR1_IRQn);
+    IRQ_PLAN_ProbeStop(&s_asPlan[PLAN_AUDIO], TIMER0);
+
+    IRQ_PLAN_Report(s_asPlan, PLAN_NUM, s_u32TickFreq);
+
+    return s_asPlan[PLAN_AUDIO].u32MaxLatencyUs;
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/*  Main Function                                                                                          */
+/*---------------------------------------------------------------------------------------------------------*/
+int main(void)
+{
+    uint32_t u32Before, u32After;
+    int32_t i32Miss;
+
+    /* Unlock protected registers */
+    SYS_UnlockReg();
+
+    /* Init system, peripheral clock and multi-function I/O */
+    SYS_Init();
+
+    /* Lock protected registers */
+    SYS_LockReg();
+
+    /* Init UART to 115200-8n1 for print message */
+    UART_Open(UART0, 115200);
+
+    printf("\n\n");
+    printf("+--------------------------------------------------------------+\n");
+    printf("|                    SYS IRQ Plan Sample Code                  |\n");
+    printf("+--------------------------------------------------------------+\n");
+
+    /* SysTick timestamps count CPU cycles */
+    s_u32TickFreq = PROF_Open(NULL);
+
+    printf("\nDefault priorities, every interrupt at level 0:\n");
+    u32Before = RunLoad();
+
+    /* Measured run times replace the declared ones where they are longer */
+    IRQ_PLAN_Learn(s_asPlan, PLAN_NUM, s_u32TickFreq);
+    i32Miss = IRQ_PLAN_Apply(s_asPlan, PLAN_NUM);
+
+    printf("\nPlanned priorities, %d deadline(s) at risk:\n", (int)i32Miss);
+    u32After = RunLoad();
+
+    printf("\nWorst audio latency %u us before, %u us after\n", (unsigned int)u32Before, (unsigned int)u32After);
+
+    if ((i32Miss == 0) && (u32After < u32Before) &&
+            (u32After < s_asPlan[PLAN_AUDIO].u32DeadlineUs))
+        printf("\nPASS\n");
+    else
+        printf("\nFAIL\n");
+
+    while (1);
+}
+
+/*** (C) COPYRIGHT 2021 Nuvoton Technology Corp. ***/
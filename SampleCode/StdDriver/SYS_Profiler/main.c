@@ -0,0 +1,182 @@
+/**************************************************************************//**
+ * @file     main.c
+ * @version  V1.00
+ * @brief    Demonstrate the profiler: timing probes around three workloads and a PC histogram sampled by
+ *           TIMER3 while they run.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * @copyright (C) 2021 Nuvoton Technology Corp. All rights reserved.
+*****************************************************************************/
+#include <stdio.h>
+#include <string.h>
+#include "NuMicro.h"
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Macro, type and constant definitions                                                                    */
+/*---------------------------------------------------------------------------------------------------------*/
+#ifndef PROF_USE_SAMPLER
+#error "The projects define PROF_USE_SAMPLER to build the PC sampler of prof.c"
+#endif
+
+#define SAMPLE_FREQ         2000
+#define BUCKET_SHIFT        6
+#define BUCKET_NUM          (0x8000 >> BUCKET_SHIFT)
+#define DATA_LEN            256
+#define ROUNDS              200
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Global variables                                                                                        */
+/*---------------------------------------------------------------------------------------------------------*/
+static uint16_t s_au16Hist[BUCKET_NUM];
+static uint8_t s_au8Src[DATA_LEN], s_au8Dst[DATA_LEN];
+static uint32_t s_au32Sort[64];
+static S_PROF_PROBE_T s_sProbeCrc, s_sProbeCopy, s_sProbeSort, s_sProbeTimer;
+
+
+void TMR0_IRQHandler(void)
+{
+    PROF_ENTER(&s_sProbeTimer);
+
+    TIMER_ClearIntFlag(TIMER0);
+
+    PROF_EXIT(&s_sProbeTimer);
+}
+
+/* Bitwise CRC-32, the slowest of the three on purpose */
+uint32_t Crc32(const uint8_t *pu8Data, uint32_t u32Len)
+{
+    uint32_t i, u32Crc = 0xFFFFFFFFUL;
+
+    while (u32Len--)
+    {
+        u32Crc ^= *pu8Data++;
+
+        for (i = 0; i < 8; i++)
+            u32Crc = (u32Crc >> 1) ^ (0xEDB88320UL & (0UL - (u32Crc & 1UL)));
+    }
+
+    return ~u32Crc;
+}
+
+void Sort(uint32_t *pu32Data, uint32_t u32Num)
+{
+    uint32_t i, j, u32Tmp;
+
+    for (i = 1; i < u32Num; i++)
+    {
+        u32Tmp = pu32Data[i];
+
+        for (j = i; (j > 0) && (pu32Data[j - 1] > u32Tmp); j--)
+            pu32Data[j] = pu32Data[j - 1];
+
+        pu32Data[j] = u32Tmp;
+    }
+}
+
+void SYS_Init(void)
+{
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Init System Clock                                                                                       */
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Enable HIRC clock */
+    CLK_EnableXtalRC(CLK_PWRCTL_HIRCEN_Msk);
+
+    /* Waiting for HIRC clock ready */
+    CLK_WaitClockReady(CLK_STATUS_HIRCSTB_Msk);
+
+    /* Switch HCLK clock source to HIRC */
+    CLK_SetHCLK(CLK_CLKSEL0_HCLKSEL_HIRC, CLK_CLKDIV0_HCLK(1));
+
+    /* Select IP clock source */
+    CLK_SetModuleClock(UART0_MODULE, CLK_CLKSEL1_UARTSEL_HIRC_DIV2, CLK_CLKDIV0_UART(1));
+    CLK_SetModuleClock(TMR0_MODULE, CLK_CLKSEL1_TMR0SEL_HIRC_DIV2, 0);
+    CLK_SetModuleClock(TMR3_MODULE, CLK_CLKSEL1_TMR3SEL_HIRC_DIV2, 0);
+
+    /* Enable IP peripheral clock */
+    CLK_EnableModuleClock(UART0_MODULE);
+    CLK_EnableModuleClock(TMR0_MODULE);
+    CLK_EnableModuleClock(TMR3_MODULE);
+
+    /* Update System Core Clock */
+    SystemCoreClockUpdate();
+
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Init I/O Multi-function                                                                                 */
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Set GPB multi-function pins for UART0 RXD and TXD */
+    SYS->GPB_MFPL = (SYS->GPB_MFPL & ~(SYS_GPB_MFPL_PB0MFP_Msk | SYS_GPB_MFPL_PB1MFP_Msk)) |
+                    SYS_GPB_MFPL_PB0MFP_UART0_RXD | SYS_GPB_MFPL_PB1MFP_UART0_TXD;
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/*  Main Function                                                                                          */
+/*---------------------------------------------------------------------------------------------------------*/
+int main(void)
+{
+    uint32_t i, j, u32Crc = 0;
+
+    /* Unlock protected registers */
+    SYS_UnlockReg();
+
+    /* Init system, peripheral clock and multi-function I/O */
+    SYS_Init();
+
+    /* Lock protected registers */
+    SYS_LockReg();
+
+    /* Init UART to 115200-8n1 for print message */
+    UART_Open(UART0, 115200);
+
+    printf("\n\n");
+    printf("+--------------------------------------------------------------+\n");
+    printf("|                     SYS Profiler Sample Code                 |\n");
+    printf("+--------------------------------------------------------------+\n");
+
+    for (i = 0; i < DATA_LEN; i++)
+        s_au8Src[i] = (uint8_t)(i * 7);
+
+    /* SysTick timestamps count CPU cycles */
+    PROF_Open(NULL);
+    PROF_AddProbe(&s_sProbeTimer, "TMR0 IRQ");
+    PROF_AddProbe(&s_sProbeSort, "Sort");
+    PROF_AddProbe(&s_sProbeCopy, "memcpy");
+    PROF_AddProbe(&s_sProbeCrc, "Crc32");
+
+    /* Some interrupt load to be measured as well */
+    TIMER_Open(TIMER0, TIMER_PERIODIC_MODE, 1000);
+    TIMER_EnableInt(TIMER0);
+    NVIC_EnableIRQ(TMR0_IRQn);
+    TIMER_Start(TIMER0);
+
+    PROF_SampleStart(SAMPLE_FREQ, s_au16Hist, BUCKET_NUM, BUCKET_SHIFT);
+
+    for (i = 0; i < ROUNDS; i++)
+    {
+        PROF_ENTER(&s_sProbeCrc);
+        u32Crc ^= Crc32(s_au8Src, DATA_LEN);
+        PROF_EXIT(&s_sProbeCrc);
+
+        PROF_ENTER(&s_sProbeCopy);
+        memcpy(s_au8Dst, s_au8Src, DATA_LEN);
+        PROF_EXIT(&s_sProbeCopy);
+
+        for (j = 0; j < 64; j++)
+            s_au32Sort[j] = (j * 2654435761UL) ^ i;
+
+        PROF_ENTER(&s_sProbeSort);
+        Sort(s_au32Sort, 64);
+        PROF_EXIT(&s_sProbeSort);
+    }
+
+    PROF_SampleStop();
+    TIMER_Stop(TIMER0);
+
+    printf("CRC 0x%08x\n\n", (unsigned int)u32Crc);
+    PROF_Report();
+
+    printf("\nLook the addresses up in the symbol table of the build, Crc32 should have the most samples.\n");
+
+    while (1);
+}
+
+/*** (C) COPYRIGHT 2021 Nuvoton Technology Corp. ***/
@@ -0,0 +1,202 @@
+/**************************************************************************//**
+ * @file     main.c
+ * @version  V1.00
+ * @brief    Demonstrate __RAMFUNC: the same interrupt handler and loop run from flash and from SRAM with the
+ *           50 MHz flash wait states, timed by the profiler whose PC histogram shows the next candidates.
+ *
+ * @note     The Keil project links with NUC121.sct, without it the __RAMFUNC code stays in flash.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * @copyright (C) 2021 Nuvoton Technology Corp. All rights reserved.
+*****************************************************************************/
+#include <stdio.h>
+#include "NuMicro.h"
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Macro, type and constant definitions                                                                    */
+/*---------------------------------------------------------------------------------------------------------*/
+#ifndef PROF_USE_SAMPLER
+#error "The projects define PROF_USE_SAMPLER to build the PC sampler of prof.c"
+#endif
+
+#define SAMPLE_FREQ         2000
+#define BUCKET_SHIFT        6
+#define BUCKET_NUM          (0x8000 >> BUCKET_SHIFT)
+#define DATA_LEN            64
+#define ROUNDS              500
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Global variables                                                                                        */
+/*---------------------------------------------------------------------------------------------------------*/
+static uint16_t s_au16Hist[BUCKET_NUM];
+static uint32_t s_au32Data[DATA_LEN];
+static volatile uint32_t s_u32Sum0, s_u32Sum1;
+static S_PROF_PROBE_T s_sProbeFlash, s_sProbeRam, s_sProbeIsrFlash, s_sProbeIsrRam;
+
+
+/* Identical loops, only their placement differs */
+uint32_t MixFlash(const uint32_t *pu32Data, uint32_t u32Len)
+{
+    uint32_t u32Mix = 0;
+
+    while (u32Len--)
+        u32Mix = ((u32Mix << 5) | (u32Mix >> 27)) ^ *pu32Data++;
+
+    return u32Mix;
+}
+
+__RAMFUNC uint32_t MixRam(const uint32_t *pu32Data, uint32_t u32Len)
+{
+    uint32_t u32Mix = 0;
+
+    while (u32Len--)
+        u32Mix = ((u32Mix << 5) | (u32Mix >> 27)) ^ *pu32Data++;
+
+    return u32Mix;
+}
+
+void TMR0_IRQHandler(void)
+{
+    uint32_t i, u32Mix = 0;
+
+    PROF_ENTER(&s_sProbeIsrFlash);
+
+    for (i = 0; i < 16; i++)
+        u32Mix = ((u32Mix << 5) | (u32Mix >> 27)) ^ s_au32Data[i];
+
+    s_u32Sum0 = u32Mix;
+    TIMER_ClearIntFlag(TIMER0);
+
+    PROF_EXIT(&s_sProbeIsrFlash);
+}
+
+/* The vector table takes the SRAM address, no change is needed elsewhere */
+__RAMFUNC void TMR1_IRQHandler(void)
+{
+    uint32_t i, u32Mix = 0;
+
+    PROF_ENTER(&s_sProbeIsrRam);
+
+    for (i = 0; i < 16; i++)
+        u32Mix = ((u32Mix << 5) | (u32Mix >> 27)) ^ s_au32Data[i];
+
+    s_u32Sum1 = u32Mix;
+    TIMER_ClearIntFlag(TIMER1);
+
+    PROF_EXIT(&s_sProbeIsrRam);
+}
+
+void SYS_Init(void)
+{
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Init System Clock                                                                                       */
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Enable HIRC clock */
+    CLK_EnableXtalRC(CLK_PWRCTL_HIRCEN_Msk);
+
+    /* Waiting for HIRC clock ready */
+    CLK_WaitClockReady(CLK_STATUS_HIRCSTB_Msk);
+
+    /* Flash timing for up to 50 MHz, the wait states __RAMFUNC code avoids */
+    FMC_EnableFreqOptimizeMode(FMC_FTCTL_OPTIMIZE_50MHZ);
+
+    /* Switch HCLK clock source to HIRC */
+    CLK_SetHCLK(CLK_CLKSEL0_HCLKSEL_HIRC, CLK_CLKDIV0_HCLK(1));
+
+    /* Select IP clock source */
+    CLK_SetModuleClock(UART0_MODULE, CLK_CLKSEL1_UARTSEL_HIRC_DIV2, CLK_CLKDIV0_UART(1));
+    CLK_SetModuleClock(TMR0_MODULE, CLK_CLKSEL1_TMR0SEL_HIRC_DIV2, 0);
+    CLK_SetModuleClock(TMR1_MODULE, CLK_CLKSEL1_TMR1SEL_HIRC_DIV2, 0);
+    CLK_SetModuleClock(TMR3_MODULE, CLK_CLKSEL1_TMR3SEL_HIRC_DIV2, 0);
+
+    /* Enable IP peripheral clock */
+    CLK_EnableModuleClock(UART0_MODULE);
+    CLK_EnableModuleClock(TMR0_MODULE);
+    CLK_EnableModuleClock(TMR1_MODULE);
+    CLK_EnableModuleClock(TMR3_MODULE);
+
+    /* Update System Core Clock */
+    SystemCoreClockUpdate();
+
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Init I/O Multi-function                                                                                 */
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Set GPB multi-function pins for UART0 RXD and TXD */
+    SYS->GPB_MFPL = (SYS->GPB_MFPL & ~(SYS_GPB_MFPL_PB0MFP_Msk | SYS_GPB_MFPL_PB1MFP_Msk)) |
+                    SYS_GPB_MFPL_PB0MFP_UART0_RXD | SYS_GPB_MFPL_PB1MFP_UART0_TXD;
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/*  Main Function                                                                                          */
+/*---------------------------------------------------------------------------------------------------------*/
+int main(void)
+{
+    uint32_t i, u32Flash = 0, u32Ram = 0;
+
+    /* Unlock protected registers */
+    SYS_UnlockReg();
+
+    /* Init system, peripheral clock and multi-function I/O */
+    SYS_Init();
+
+    /* Lock protected registers */
+    SYS_LockReg();
+
+    /* Init UART to 115200-8n1 for print message */
+    UART_Open(UART0, 115200);
+
+    printf("\n\n");
+    printf("+--------------------------------------------------------------+\n");
+    printf("|                    SYS RAM Function Sample Code              |\n");
+    printf("+--------------------------------------------------------------+\n");
+
+    printf("MixFlash at 0x%08x, MixRam at 0x%08x\n\n", (unsigned int)(uint32_t)MixFlash, (unsigned int)(uint32_t)MixRam);
+
+    for (i = 0; i < DATA_LEN; i++)
+        s_au32Data[i] = i * 2654435761UL;
+
+    /* SysTick timestamps count CPU cycles */
+    PROF_Open(NULL);
+    PROF_AddProbe(&s_sProbeIsrRam, "TMR1 IRQ SRAM");
+    PROF_AddProbe(&s_sProbeIsrFlash, "TMR0 IRQ flash");
+    PROF_AddProbe(&s_sProbeRam, "MixRam");
+    PROF_AddProbe(&s_sProbeFlash, "MixFlash");
+
+    TIMER_Open(TIMER0, TIMER_PERIODIC_MODE, 1000);
+    TIMER_Open(TIMER1, TIMER_PERIODIC_MODE, 1000);
+    TIMER_EnableInt(TIMER0);
+    TIMER_EnableInt(TIMER1);
+    NVIC_EnableIRQ(TMR0_IRQn);
+    NVIC_EnableIRQ(TMR1_IRQn);
+    TIMER_Start(TIMER0);
+    TIMER_Start(TIMER1);
+
+    /* Samples in SRAM code are counted as outside, the flash buckets left are the next candidates */
+    PROF_SampleStart(SAMPLE_FREQ, s_au16Hist, BUCKET_NUM, BUCKET_SHIFT);
+
+    for (i = 0; i < ROUNDS; i++)
+    {
+        PROF_ENTER(&s_sProbeFlash);
+        u32Flash ^= MixFlash(s_au32Data, DATA_LEN);
+        PROF_EXIT(&s_sProbeFlash);
+
+        PROF_ENTER(&s_sProbeRam);
+        u32Ram ^= MixRam(s_au32Data, DATA_LEN);
+        PROF_EXIT(&s_sProbeRam);
+    }
+
+    PROF_SampleStop();
+    TIMER_Stop(TIMER0);
+    TIMER_Stop(TIMER1);
+
+    PROF_Report();
+
+    if ((u32Flash == u32Ram) && (s_u32Sum0 == s_u32Sum1) && (s_sProbeRam.u32Min <= s_sProbeFlash.u32Min))
+        printf("\nPASS\n");
+    else
+        printf("\nFAIL\n");
+
+    while (1);
+}
+
+/*** (C) COPYRIGHT 2021 Nuvoton Technology Corp. ***/
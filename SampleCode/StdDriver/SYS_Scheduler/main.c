@@ -0,0 +1,195 @@
+/**************************************************************************//**
+ * @file     main.c
+ * @version  V1.00
+ * @brief    Demonstrate the cooperative scheduler: UART0, ADC and a software timer only post events from their
+ *           short ISRs, the work runs in prioritised handlers and the CPU idles when none is queued.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * @copyright (C) 2021 Nuvoton Technology Corp. All rights reserved.
+*****************************************************************************/
+#include <stdio.h>
+#include "NuMicro.h"
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Macro, type and constant definitions                                                                    */
+/*---------------------------------------------------------------------------------------------------------*/
+#define ADC_CH              2
+#define ADC_PERIOD_MS       100
+#define ADC_ROUNDS          20
+#define RX_BUF_SIZE         16          /* Power of 2 */
+
+#define PRIO_UART           0
+#define PRIO_ADC_DONE       1
+#define PRIO_ADC_START      2
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Global variables                                                                                        */
+/*---------------------------------------------------------------------------------------------------------*/
+static S_SCHED_EVENT_T s_sUartRx, s_sAdcDone, s_sAdcStart;
+static S_SWTIMER_T s_sAdcTimer;
+static uint8_t s_au8RxBuf[RX_BUF_SIZE];
+static volatile uint32_t s_u32RxHead;
+static uint32_t s_u32RxTail, s_u32AdcRounds, s_u32AdcSum;
+
+
+void TMR0_IRQHandler(void)
+{
+    SWTIMER_IRQHandler();
+}
+
+/* Drain the FIFO into the ring and leave the echo to the handler */
+void UART0_IRQHandler(void)
+{
+    while (!UART_GET_RX_EMPTY(UART0))
+    {
+        s_au8RxBuf[s_u32RxHead & (RX_BUF_SIZE - 1)] = (uint8_t)UART_READ(UART0);
+        s_u32RxHead++;
+    }
+
+    SCHED_Post(&s_sUartRx, SCHED_FLAG_POST);
+}
+
+void ADC_IRQHandler(void)
+{
+    ADC_CLR_INT_FLAG(ADC, ADC_ADF_INT);
+
+    SCHED_Post(&s_sAdcDone, SCHED_FLAG_POST);
+}
+
+void UartRxHandler(void *pvArg, uint32_t u32Flags)
+{
+    (void)pvArg;
+    (void)u32Flags;
+
+    while (s_u32RxTail != s_u32RxHead)
+    {
+        printf("RX '%c'\n", s_au8RxBuf[s_u32RxTail & (RX_BUF_SIZE - 1)]);
+        s_u32RxTail++;
+    }
+}
+
+void AdcStartHandler(void *pvArg, uint32_t u32Flags)
+{
+    (void)pvArg;
+    (void)u32Flags;
+
+    ADC_START_CONV(ADC);
+}
+
+void AdcDoneHandler(void *pvArg, uint32_t u32Flags)
+{
+    const S_SCHED_STAT_T *psStat;
+    uint32_t u32Data = ADC_GET_CONVERSION_DATA(ADC, ADC_CH);
+
+    (void)pvArg;
+    (void)u32Flags;
+
+    s_u32AdcSum += u32Data;
+    printf("ADC CH%d %4u\n", ADC_CH, (unsigned int)u32Data);
+
+    if (++s_u32AdcRounds != ADC_ROUNDS)
+        return;
+
+    SWTIMER_Stop(&s_sAdcTimer);
+
+    psStat = SCHED_GetStat();
+    printf("\nAverage %u, posted %u, merged %u, handled %u, idle %u\n", (unsigned int)(s_u32AdcSum / ADC_ROUNDS),
+           (unsigned int)psStat->u32Posted, (unsigned int)psStat->u32Merged, (unsigned int)psStat->u32Handled,
+           (unsigned int)psStat->u32IdleCount);
+
+    /* Every conversion was handled and the CPU slept in between */
+    if ((psStat->u32Handled >= 2 * ADC_ROUNDS) && (psStat->u32IdleCount >= ADC_ROUNDS))
+        printf("\nPASS\n");
+    else
+        printf("\nFAIL\n");
+
+    printf("Key presses are still echoed by the scheduler\n");
+}
+
+void SYS_Init(void)
+{
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Init System Clock                                                                                       */
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Enable HIRC clock */
+    CLK_EnableXtalRC(CLK_PWRCTL_HIRCEN_Msk);
+
+    /* Waiting for HIRC clock ready */
+    CLK_WaitClockReady(CLK_STATUS_HIRCSTB_Msk);
+
+    /* Switch HCLK clock source to HIRC */
+    CLK_SetHCLK(CLK_CLKSEL0_HCLKSEL_HIRC, CLK_CLKDIV0_HCLK(1));
+
+    /* Select IP clock source */
+    CLK_SetModuleClock(UART0_MODULE, CLK_CLKSEL1_UARTSEL_HIRC_DIV2, CLK_CLKDIV0_UART(1));
+    CLK_SetModuleClock(TMR0_MODULE, CLK_CLKSEL1_TMR0SEL_HIRC_DIV2, 0);
+    CLK_SetModuleClock(ADC_MODULE, CLK_CLKSEL1_ADCSEL_HIRC, CLK_CLKDIV0_ADC(3));
+
+    /* Enable IP peripheral clock */
+    CLK_EnableModuleClock(UART0_MODULE);
+    CLK_EnableModuleClock(TMR0_MODULE);
+    CLK_EnableModuleClock(ADC_MODULE);
+
+    /* Update System Core Clock */
+    SystemCoreClockUpdate();
+
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Init I/O Multi-function                                                                                 */
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Set GPB multi-function pins for UART0 RXD and TXD */
+    SYS->GPB_MFPL = (SYS->GPB_MFPL & ~(SYS_GPB_MFPL_PB0MFP_Msk | SYS_GPB_MFPL_PB1MFP_Msk)) |
+                    SYS_GPB_MFPL_PB0MFP_UART0_RXD | SYS_GPB_MFPL_PB1MFP_UART0_TXD;
+
+    /* Set PD2 to ADC mode for ADC input channel 2 and disable its digital input path */
+    PD->MODE &= ~GPIO_MODE_MODE2_Msk;
+    SYS->GPD_MFPL = (SYS->GPD_MFPL & ~SYS_GPD_MFPL_PD2MFP_Msk) | SYS_GPD_MFPL_PD2MFP_ADC_CH2;
+    GPIO_DISABLE_DIGITAL_PATH(PD, BIT2);
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/*  Main Function                                                                                          */
+/*---------------------------------------------------------------------------------------------------------*/
+int main(void)
+{
+    /* Unlock protected registers */
+    SYS_UnlockReg();
+
+    /* Init system, peripheral clock and multi-function I/O */
+    SYS_Init();
+
+    /* Lock protected registers */
+    SYS_LockReg();
+
+    /* Init UART to 115200-8n1 for print message */
+    UART_Open(UART0, 115200);
+
+    printf("\n\n");
+    printf("+--------------------------------------------------------------+\n");
+    printf("|                    SYS Scheduler Sample Code                 |\n");
+    printf("+--------------------------------------------------------------+\n");
+
+    SCHED_InitEvent(&s_sUartRx, UartRxHandler, NULL, PRIO_UART);
+    SCHED_InitEvent(&s_sAdcDone, AdcDoneHandler, NULL, PRIO_ADC_DONE);
+    SCHED_InitEvent(&s_sAdcStart, AdcStartHandler, NULL, PRIO_ADC_START);
+
+    UART_ENABLE_INT(UART0, UART_INTEN_RDAIEN_Msk);
+    NVIC_EnableIRQ(UART0_IRQn);
+
+    ADC_Open(ADC, ADC_ADCR_DIFFEN_SINGLE_END, ADC_ADCR_ADMD_SINGLE, 0x1 << ADC_CH);
+    ADC_POWER_ON(ADC);
+    ADC_CLR_INT_FLAG(ADC, ADC_ADF_INT);
+    ADC_EnableInt(ADC, ADC_ADF_INT);
+    NVIC_EnableIRQ(ADC_IRQn);
+
+    /* The timer callback only posts, the conversion is started by a handler */
+    SWTIMER_Open(TIMER0);
+    NVIC_EnableIRQ(TMR0_IRQn);
+    SWTIMER_Start(&s_sAdcTimer, SWTIMER_MS_TO_COUNT(ADC_PERIOD_MS), SWTIMER_MS_TO_COUNT(ADC_PERIOD_MS),
+                  SCHED_PostFromTimer, &s_sAdcStart);
+
+    printf("Sampling ADC CH%d every %d ms, type to see the UART events\n\n", ADC_CH, ADC_PERIOD_MS);
+
+    SCHED_Run();
+}
+
+/*** (C) COPYRIGHT 2021 Nuvoton Technology Corp. ***/
@@ -0,0 +1,159 @@
+/**************************************************************************//**
+ * @file     main.c
+ * @version  V1.00
+ * @brief    Demonstrate buffered semihost file I/O: load test vectors from a host file and dump captured data
+ *           to another one, both through the debug UART when no debugger is attached.
+ *
+ * @note     The projects define DEBUG_ENABLE_SEMIHOST, the files are relative to the working directory of the
+ *           debugger.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * @copyright (C) 2021 Nuvoton Technology Corp. All rights reserved.
+*****************************************************************************/
+#include <stdio.h>
+#include "NuMicro.h"
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Macro, type and constant definitions                                                                    */
+/*---------------------------------------------------------------------------------------------------------*/
+#define VECTOR_FILE         "vectors.bin"
+#define CAPTURE_FILE        "capture.bin"
+#define CHUNK_LEN           512
+#define CAPTURE_LEN         2048
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Global variables                                                                                        */
+/*---------------------------------------------------------------------------------------------------------*/
+static uint8_t s_au8Chunk[CHUNK_LEN];
+
+
+void SYS_Init(void)
+{
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Init System Clock                                                                                       */
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Enable HIRC clock */
+    CLK_EnableXtalRC(CLK_PWRCTL_HIRCEN_Msk);
+
+    /* Waiting for HIRC clock ready */
+    CLK_WaitClockReady(CLK_STATUS_HIRCSTB_Msk);
+
+    /* Switch HCLK clock source to HIRC */
+    CLK_SetHCLK(CLK_CLKSEL0_HCLKSEL_HIRC, CLK_CLKDIV0_HCLK(1));
+
+    /* Select IP clock source */
+    CLK_SetModuleClock(UART0_MODULE, CLK_CLKSEL1_UARTSEL_HIRC_DIV2, CLK_CLKDIV0_UART(1));
+
+    /* Enable IP peripheral clock */
+    CLK_EnableModuleClock(UART0_MODULE);
+
+    /* Update System Core Clock */
+    SystemCoreClockUpdate();
+
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Init I/O Multi-function                                                                                 */
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Set GPB multi-function pins for UART0 RXD and TXD */
+    SYS->GPB_MFPL = (SYS->GPB_MFPL & ~(SYS_GPB_MFPL_PB0MFP_Msk | SYS_GPB_MFPL_PB1MFP_Msk)) |
+                    SYS_GPB_MFPL_PB0MFP_UART0_RXD | SYS_GPB_MFPL_PB1MFP_UART0_TXD;
+}
+
+/* Sum of the test vector file, read in chunks with one trap each */
+int32_t LoadVectors(uint32_t *pu32Sum)
+{
+    int32_t i32Handle, i32Len, i32Total = 0;
+    uint32_t i;
+
+    i32Handle = SEMIHOST_FileOpen(VECTOR_FILE, SEMIHOST_MODE_READ);
+
+    if (i32Handle < 0)
+        return i32Handle;
+
+    printf("%s is %d bytes\n", VECTOR_FILE, (int)SEMIHOST_FileLength(i32Handle));
+
+    *pu32Sum = 0;
+
+    while ((i32Len = SEMIHOST_FileRead(i32Handle, s_au8Chunk, CHUNK_LEN)) > 0)
+    {
+        for (i = 0; i < (uint32_t)i32Len; i++)
+            *pu32Sum += s_au8Chunk[i];
+
+        i32Total += i32Len;
+    }
+
+    SEMIHOST_FileClose(i32Handle);
+
+    return i32Total;
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/*  Main Function                                                                                          */
+/*---------------------------------------------------------------------------------------------------------*/
+int main(void)
+{
+    uint32_t i, u32Sum = 0, u32Cycles, u32Traps;
+    uint16_t u16Sample;
+    int32_t i32Ret;
+
+    /* Unlock protected registers */
+    SYS_UnlockReg();
+
+    /* Init system, peripheral clock and multi-function I/O */
+    SYS_Init();
+
+    /* Lock protected registers */
+    SYS_LockReg();
+
+    /* Init UART to 115200-8n1 for print message */
+    UART_Open(UART0, 115200);
+
+    printf("\n\n");
+    printf("+--------------------------------------------------------------+\n");
+    printf("|                  SYS Semihost File Sample Code               |\n");
+    printf("+--------------------------------------------------------------+\n");
+
+    if (SEMIHOST_Open())
+    {
+        printf("Debugger attached\n");
+
+        i32Ret = LoadVectors(&u32Sum);
+
+        if (i32Ret >= 0)
+            printf("Loaded %d bytes, sum 0x%08x\n", (int)i32Ret, (unsigned int)u32Sum);
+        else
+            printf("No %s in the debugger directory (%d)\n", VECTOR_FILE, (int)i32Ret);
+
+        SEMIHOST_StreamOpen(CAPTURE_FILE);
+    }
+    else
+    {
+        printf("No debugger, the capture follows as raw bytes on UART0\n");
+    }
+
+    /* A stand-in for captured 16-bit samples, written one at a time to show the buffering */
+    u32Traps = SEMIHOST_GetTrapCount();
+    SysTick->LOAD = SysTick_LOAD_RELOAD_Msk;
+    SysTick->VAL  = 0;
+    SysTick->CTRL = SysTick_CTRL_CLKSOURCE_Msk | SysTick_CTRL_ENABLE_Msk;
+
+    for (i = 0; i < (CAPTURE_LEN / 2); i++)
+    {
+        u16Sample = (uint16_t)(i * 40503U);
+        SEMIHOST_StreamWrite(&u16Sample, sizeof(u16Sample));
+    }
+
+    SEMIHOST_StreamClose();
+
+    u32Cycles = SysTick_LOAD_RELOAD_Msk - SysTick->VAL;
+    SysTick->CTRL = 0;
+    u32Traps = SEMIHOST_GetTrapCount() - u32Traps;
+
+    printf("\n%u bytes dumped in %u cycles, %u traps\n", CAPTURE_LEN, (unsigned int)u32Cycles,
+           (unsigned int)u32Traps);
+
+    printf("\nPASS\n");
+
+    while (1);
+}
+
+/*** (C) COPYRIGHT 2021 Nuvoton Technology Corp. ***/
@@ -0,0 +1,161 @@
+/**************************************************************************//**
+ * @file     main.c
+ * @version  V1.00
+ * @brief    Demonstrate the stack monitor: stack high-water mark of a call chain, the depth of two interrupt
+ *           handlers and a guard check in the SysTick handler.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * @copyright (C) 2021 Nuvoton Technology Corp. All rights reserved.
+*****************************************************************************/
+#include <stdio.h>
+#include "NuMicro.h"
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Macro, type and constant definitions                                                                    */
+/*---------------------------------------------------------------------------------------------------------*/
+#define ISR_ID_SYSTICK      0
+#define ISR_ID_TMR0         1
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Global variables                                                                                        */
+/*---------------------------------------------------------------------------------------------------------*/
+static volatile uint32_t s_u32Ticks, s_u32Overflow;
+
+
+void SysTick_Handler(void)
+{
+    STKMON_ISR_ENTER(ISR_ID_SYSTICK);
+
+    s_u32Ticks++;
+
+    /* A few compares per tick catch an overflow long before it shows up as a strange fault */
+    if (STKMON_Check() != 0)
+        s_u32Overflow = 1;
+
+    STKMON_ISR_EXIT(ISR_ID_SYSTICK);
+}
+
+void TMR0_IRQHandler(void)
+{
+    STKMON_ISR_ENTER(ISR_ID_TMR0);
+    volatile uint32_t au32Scratch[12];
+    uint32_t i;
+
+    /* Handler with a local buffer, deeper than the SysTick one */
+    for (i = 0; i < 12; i++)
+        au32Scratch[i] = i;
+
+    if (au32Scratch[11] == 11)
+        TIMER_ClearIntFlag(TIMER0);
+
+    STKMON_ISR_EXIT(ISR_ID_TMR0);
+}
+
+/* Each level keeps a 16 bytes buffer alive on the stack */
+uint32_t Nest(uint32_t u32Level)
+{
+    volatile uint8_t au8Buf[16];
+
+    au8Buf[0] = (uint8_t)u32Level;
+
+    if (u32Level == 0)
+        return au8Buf[0];
+
+    return (Nest(u32Level - 1) + au8Buf[0]);
+}
+
+void SYS_Init(void)
+{
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Init System Clock                                                                                       */
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Enable HIRC clock */
+    CLK_EnableXtalRC(CLK_PWRCTL_HIRCEN_Msk);
+
+    /* Waiting for HIRC clock ready */
+    CLK_WaitClockReady(CLK_STATUS_HIRCSTB_Msk);
+
+    /* Switch HCLK clock source to HIRC */
+    CLK_SetHCLK(CLK_CLKSEL0_HCLKSEL_HIRC, CLK_CLKDIV0_HCLK(1));
+
+    /* Select IP clock source */
+    CLK_SetModuleClock(UART0_MODULE, CLK_CLKSEL1_UARTSEL_HIRC_DIV2, CLK_CLKDIV0_UART(1));
+    CLK_SetModuleClock(TMR0_MODULE, CLK_CLKSEL1_TMR0SEL_HIRC_DIV2, 0);
+
+    /* Enable IP peripheral clock */
+    CLK_EnableModuleClock(UART0_MODULE);
+    CLK_EnableModuleClock(TMR0_MODULE);
+
+    /* Update System Core Clock */
+    SystemCoreClockUpdate();
+
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Init I/O Multi-function                                                                                 */
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Set GPB multi-function pins for UART0 RXD and TXD */
+    SYS->GPB_MFPL = (SYS->GPB_MFPL & ~(SYS_GPB_MFPL_PB0MFP_Msk | SYS_GPB_MFPL_PB1MFP_Msk)) |
+                    SYS_GPB_MFPL_PB0MFP_UART0_RXD | SYS_GPB_MFPL_PB1MFP_UART0_TXD;
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/*  Main Function                                                                                          */
+/*---------------------------------------------------------------------------------------------------------*/
+int main(void)
+{
+    uint32_t u32Depth;
+
+    /* Paint before anything else uses the stack below main */
+    STKMON_Paint();
+
+    /* Unlock protected registers */
+    SYS_UnlockReg();
+
+    /* Init system, peripheral clock and multi-function I/O */
+    SYS_Init();
+
+    /* Lock protected registers */
+    SYS_LockReg();
+
+    /* Init UART to 115200-8n1 for print message */
+    UART_Open(UART0, 115200);
+
+    printf("\n\n");
+    printf("+--------------------------------------------------------------+\n");
+    printf("|                  SYS Stack Monitor Sample Code               |\n");
+    printf("+--------------------------------------------------------------+\n");
+
+    printf("Stack %u bytes, %u used after init\n\n", (unsigned int)STKMON_GetStackSize(),
+           (unsigned int)STKMON_GetStackPeak());
+
+    SysTick_Config(SystemCoreClock / 1000);
+
+    TIMER_Open(TIMER0, TIMER_PERIODIC_MODE, 500);
+    TIMER_EnableInt(TIMER0);
+    NVIC_EnableIRQ(TMR0_IRQn);
+    TIMER_Start(TIMER0);
+
+    /* Deeper call chains, the peak only grows */
+    for (u32Depth = 2; u32Depth <= 8; u32Depth += 2)
+    {
+        Nest(u32Depth);
+
+        while (s_u32Ticks < (u32Depth * 50));
+
+        printf("Nest(%u) -> peak %u bytes\n", (unsigned int)u32Depth, (unsigned int)STKMON_GetStackPeak());
+    }
+
+    TIMER_Stop(TIMER0);
+    SysTick->CTRL = 0;
+
+    printf("\n");
+    STKMON_Report();
+
+    if ((s_u32Overflow == 0) && (STKMON_GetIsrPeak(ISR_ID_TMR0) > STKMON_GetIsrPeak(ISR_ID_SYSTICK)))
+        printf("\nPASS. Size buffers against the peaks above.\n");
+    else
+        printf("\nFAIL\n");
+
+    while (1);
+}
+
+/*** (C) COPYRIGHT 2021 Nuvoton Technology Corp. ***/
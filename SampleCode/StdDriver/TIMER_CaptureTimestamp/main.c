@@ -0,0 +1,210 @@
+/**************************************************************************//**
+ * @file     main.c
+ * @version  V1.00
+ * @brief    Timestamp capture edges into queues by interrupt and by PDMA and measure period and RPM.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * @copyright (C) 2021 Nuvoton Technology Corp. All rights reserved.
+ ******************************************************************************/
+#include <stdio.h>
+#include "NuMicro.h"
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Macro, type and constant definitions                                                                    */
+/*---------------------------------------------------------------------------------------------------------*/
+#define QUEUE_SIZE          64
+#define EXPECT_PERIOD       2000        /* 500 Hz input at 1 MHz counting frequency */
+#define PULSE_PER_REV       2           /* Typical PC fan tachometer */
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Global Interface Variables Declarations                                                                 */
+/*---------------------------------------------------------------------------------------------------------*/
+static S_TIMER_CAP_T s_sCapIRQ, s_sCapPDMA;
+static uint32_t s_au32QueueIRQ[QUEUE_SIZE], s_au32QueuePDMA[QUEUE_SIZE];
+
+
+/**
+  * @brief      Timer2 IRQ
+  *
+  * @param      None
+  *
+  * @return     None
+  *
+  * @details    The Timer2 default IRQ, declared in startup_NUC121.s.
+  */
+void TMR2_IRQHandler(void)
+{
+    TIMER_CAP_IRQHandler(&s_sCapIRQ);
+}
+
+void SYS_Init(void)
+{
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Init System Clock                                                                                       */
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Enable HIRC clock */
+    CLK_EnableXtalRC(CLK_PWRCTL_HIRCEN_Msk);
+
+    /* Waiting for HIRC clock ready */
+    CLK_WaitClockReady(CLK_STATUS_HIRCSTB_Msk);
+
+    /* Switch HCLK clock source to HIRC */
+    CLK_SetHCLK(CLK_CLKSEL0_HCLKSEL_HIRC, CLK_CLKDIV0_HCLK(1));
+
+    /*------------------------------------------------------------------------------------------------------*/
+    /* Enable Module Clock                                                                                  */
+    /*------------------------------------------------------------------------------------------------------*/
+    /* Enable peripheral clock */
+    CLK_EnableModuleClock(UART0_MODULE);
+    CLK_EnableModuleClock(TMR0_MODULE);
+    CLK_EnableModuleClock(TMR2_MODULE);
+    CLK_EnableModuleClock(TMR3_MODULE);
+    CLK_EnableModuleClock(PDMA_MODULE);
+
+    /* Peripheral clock source */
+    CLK_SetModuleClock(UART0_MODULE, CLK_CLKSEL1_UARTSEL_HIRC_DIV2, CLK_CLKDIV0_UART(1));
+    CLK_SetModuleClock(TMR0_MODULE, CLK_CLKSEL1_TMR0SEL_HIRC_DIV2, 0);
+    CLK_SetModuleClock(TMR2_MODULE, CLK_CLKSEL1_TMR2SEL_HIRC_DIV2, 0);
+    CLK_SetModuleClock(TMR3_MODULE, CLK_CLKSEL1_TMR3SEL_HIRC_DIV2, 0);
+
+    /* Update System Core Clock */
+    SystemCoreClockUpdate();
+
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Init I/O Multi-function                                                                                 */
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* PB.0 is UART0_RX */
+    SYS->GPB_MFPL &= ~SYS_GPB_MFPL_PB0MFP_Msk;
+    SYS->GPB_MFPL |= (1 << SYS_GPB_MFPL_PB0MFP_Pos);
+    /* PB.1 is UART0_TX */
+    SYS->GPB_MFPL &= ~SYS_GPB_MFPL_PB1MFP_Msk;
+    SYS->GPB_MFPL |= (1 << SYS_GPB_MFPL_PB1MFP_Pos);
+
+    /* set PA.11 as TM0 */
+    SYS->GPA_MFPH &= ~SYS_GPA_MFPH_PA11MFP_Msk;
+    SYS->GPA_MFPH |= (5 << SYS_GPA_MFPH_PA11MFP_Pos);
+
+    /* set PB.2 as TM2_EXT and PB.3 as TM3_EXT */
+    SYS->GPB_MFPL &= ~(SYS_GPB_MFPL_PB2MFP_Msk | SYS_GPB_MFPL_PB3MFP_Msk);
+    SYS->GPB_MFPL |= (SYS_GPB_MFPL_PB2MFP_TM2_EXT | SYS_GPB_MFPL_PB3MFP_TM3_EXT);
+}
+
+void UART0_Init(void)
+{
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Init UART                                                                                               */
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Reset UART module */
+    SYS_ResetModule(UART0_RST);
+
+    /* Configure UART0 and set UART0 Baudrate */
+    UART_Open(UART0, 115200);
+}
+
+int32_t CheckChannel(char *pcName, S_TIMER_CAP_T *psCap)
+{
+    uint32_t au32Stamp[8], u32Count, u32Avg;
+
+    /* Read a few timestamps to show them, then drain the rest only into the statistics */
+    u32Count = TIMER_CAP_Read(psCap, au32Stamp, 8);
+
+    if (u32Count > 1)
+        printf("  %s: stamp %u, next +%u counts\n", pcName, au32Stamp[0], au32Stamp[1] - au32Stamp[0]);
+
+    TIMER_CAP_Read(psCap, NULL, QUEUE_SIZE);
+
+    u32Avg = TIMER_CAP_GetAvgPeriod(psCap);
+
+    printf("  %s: %u periods, min %u, max %u, avg %u counts (%u us), %u mHz, %u RPM, dropped %u\n", pcName,
+           psCap->u32Periods, psCap->u32PeriodMin, psCap->u32PeriodMax, u32Avg, TIMER_CAP_COUNT_TO_US(psCap, u32Avg),
+           TIMER_CAP_GetFreq(psCap), TIMER_CAP_GetRPM(psCap, PULSE_PER_REV), psCap->u32Dropped);
+
+    if ((psCap->u32Periods == 0) || (psCap->u32PeriodMin < (EXPECT_PERIOD - 2)) || (psCap->u32PeriodMax > (EXPECT_PERIOD + 2)))
+        return -1;
+
+    return 0;
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/*  MAIN function                                                                                          */
+/*---------------------------------------------------------------------------------------------------------*/
+int main(void)
+{
+    uint32_t u32Round, u32Freq;
+    int32_t i32Err = 0;
+
+    /* Unlock protected registers */
+    SYS_UnlockReg();
+
+    /* Init System, peripheral clock and multi-function I/O */
+    SYS_Init();
+
+    /* Lock protected registers */
+    SYS_LockReg();
+
+    /* Init UART0 for printf */
+    UART0_Init();
+
+    printf("\n\nCPU @ %d Hz\n", SystemCoreClock);
+    printf("+------------------------------------------+\n");
+    printf("|   Timer Capture Timestamp Sample Code    |\n");
+    printf("+------------------------------------------+\n\n");
+    printf("# Timer0 toggles TM0(PA.11) at 500 Hz.\n");
+    printf("# Timer2 timestamps TM2_EXT(PB.2) falling edges by interrupt.\n");
+    printf("# Timer3 timestamps TM3_EXT(PB.3) falling edges by PDMA channel 0.\n");
+    printf("# Connect TM0(PA.11) to TM2_EXT(PB.2) and TM3_EXT(PB.3).\n\n");
+
+    /* Interrupt path */
+    u32Freq = TIMER_CAP_Open(&s_sCapIRQ, TIMER2, 1000000, TIMER_CAPTURE_FALLING_EDGE, s_au32QueueIRQ, QUEUE_SIZE);
+    NVIC_EnableIRQ(TMR2_IRQn);
+
+    /* PDMA path, no CPU load per edge */
+    TIMER_CAP_Open(&s_sCapPDMA, TIMER3, 1000000, TIMER_CAPTURE_FALLING_EDGE, s_au32QueuePDMA, QUEUE_SIZE);
+
+    if (TIMER_CAP_EnablePDMA(&s_sCapPDMA, 0) != 0)
+    {
+        printf("PDMA setting failed!\n");
+
+        while (1);
+    }
+
+    printf("# Counting frequency is %d Hz\n", u32Freq);
+
+    /* Open Timer0 in toggle-output mode and toggle-output frequency is 500 Hz */
+    TIMER_Open(TIMER0, TIMER_TOGGLE_MODE, 1000);
+
+    TIMER_CAP_Start(&s_sCapIRQ);
+    TIMER_CAP_Start(&s_sCapPDMA);
+    TIMER_Start(TIMER0);
+
+    for (u32Round = 0; u32Round < 5; u32Round++)
+    {
+        /* About 50 edges per round, the queues hold 64 */
+        CLK_SysTickDelay(100000);
+
+        printf("Round %d\n", u32Round);
+
+        if (CheckChannel("IRQ ", &s_sCapIRQ) != 0)
+            i32Err = -1;
+
+        if (CheckChannel("PDMA", &s_sCapPDMA) != 0)
+            i32Err = -1;
+    }
+
+    TIMER_Stop(TIMER0);
+    TIMER_CAP_Stop(&s_sCapIRQ);
+    TIMER_CAP_Stop(&s_sCapPDMA);
+
+    if (i32Err != 0)
+    {
+        printf("*** FAIL ***\n");
+
+        while (1);
+    }
+
+    printf("*** PASS ***\n");
+
+    while (1);
+}
+
+/*** (C) COPYRIGHT 2021 Nuvoton Technology Corp. ***/
@@ -0,0 +1,195 @@
+/**************************************************************************//**
+ * @file     main.c
+ * @version  V1.00
+ * @brief    Share one timer between many software timers by a timer wheel.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * @copyright (C) 2021 Nuvoton Technology Corp. All rights reserved.
+ ******************************************************************************/
+#include <stdio.h>
+#include "NuMicro.h"
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Macro, type and constant definitions                                                                    */
+/*---------------------------------------------------------------------------------------------------------*/
+#define TIMEOUT_NUM     100
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Global Interface Variables Declarations                                                                 */
+/*---------------------------------------------------------------------------------------------------------*/
+static S_SWTIMER_T s_sTick100ms, s_sTick1s, s_asTimeout[TIMEOUT_NUM];
+
+volatile uint32_t g_u32Count100ms = 0;
+volatile uint32_t g_u32Count1s = 0;
+volatile uint32_t g_u32TimeoutCount = 0;
+volatile uint32_t g_u32TimeoutOrderErr = 0;
+volatile int32_t  g_i32MaxDrift = 0;
+volatile uint32_t g_u32StartTime;
+
+static uint32_t s_u32LastTimeoutIdx = 0;
+
+
+/**
+ * @brief       Timer0 IRQ
+ *
+ * @param       None
+ *
+ * @return      None
+ *
+ * @details     The Timer0 default IRQ, declared in startup_NUC121.s.
+ */
+void TMR0_IRQHandler(void)
+{
+    SWTIMER_IRQHandler();
+}
+
+void Tick100ms(void *pvArg)
+{
+    (void)pvArg;
+    g_u32Count100ms++;
+}
+
+void Tick1s(void *pvArg)
+{
+    int32_t i32Drift;
+
+    (void)pvArg;
+    g_u32Count1s++;
+
+    /* Distance from the ideal expiry, which must not grow over time */
+    i32Drift = (int32_t)(SWTIMER_GetTime() - g_u32StartTime - (g_u32Count1s * SWTIMER_MS_TO_COUNT(1000)));
+
+    if (i32Drift > g_i32MaxDrift)
+        g_i32MaxDrift = i32Drift;
+}
+
+void Timeout(void *pvArg)
+{
+    uint32_t u32Idx = (uint32_t)pvArg;
+
+    /* Timeouts were started with increasing delays and must expire in the same order */
+    if (u32Idx < s_u32LastTimeoutIdx)
+        g_u32TimeoutOrderErr++;
+
+    s_u32LastTimeoutIdx = u32Idx;
+    g_u32TimeoutCount++;
+}
+
+void SYS_Init(void)
+{
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Init System Clock                                                                                       */
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Enable HIRC clock */
+    CLK_EnableXtalRC(CLK_PWRCTL_HIRCEN_Msk);
+
+    /* Waiting for HIRC clock ready */
+    CLK_WaitClockReady(CLK_STATUS_HIRCSTB_Msk);
+
+    /* Switch HCLK clock source to HIRC */
+    CLK_SetHCLK(CLK_CLKSEL0_HCLKSEL_HIRC, CLK_CLKDIV0_HCLK(1));
+
+    /*------------------------------------------------------------------------------------------------------*/
+    /* Enable Module Clock                                                                                  */
+    /*------------------------------------------------------------------------------------------------------*/
+
+    /* Set SysTick source to HCLK*/
+    CLK_SetSysTickClockSrc(CLK_CLKSEL0_STCLKSEL_HCLK);
+
+    /* Enable peripheral clock */
+    CLK_EnableModuleClock(UART0_MODULE);
+    CLK_EnableModuleClock(TMR0_MODULE);
+
+    /* Peripheral clock source. HIRC/2 is 24 MHz, a multiple of 1 MHz, so the timebase counts micro seconds. */
+    CLK_SetModuleClock(UART0_MODULE, CLK_CLKSEL1_UARTSEL_HIRC_DIV2, CLK_CLKDIV0_UART(1));
+    CLK_SetModuleClock(TMR0_MODULE, CLK_CLKSEL1_TMR0SEL_HIRC_DIV2, 0);
+
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Init I/O Multi-function                                                                                 */
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* PB.0 is UART0_RX */
+    SYS->GPB_MFPL &= ~SYS_GPB_MFPL_PB0MFP_Msk;
+    SYS->GPB_MFPL |= (1 << SYS_GPB_MFPL_PB0MFP_Pos);
+    /* PB.1 is UART0_TX */
+    SYS->GPB_MFPL &= ~SYS_GPB_MFPL_PB1MFP_Msk;
+    SYS->GPB_MFPL |= (1 << SYS_GPB_MFPL_PB1MFP_Pos);
+
+}
+
+void UART0_Init(void)
+{
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Init UART                                                                                               */
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Reset UART module */
+    SYS_ResetModule(UART0_RST);
+
+    /* Configure UART0 and set UART0 Baudrate */
+    UART_Open(UART0, 115200);
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/*  MAIN function                                                                                          */
+/*---------------------------------------------------------------------------------------------------------*/
+int main(void)
+{
+    uint32_t i, u32Freq, u32Count1s = 0;
+
+    /* Unlock protected registers */
+    SYS_UnlockReg();
+
+    /* Init System, peripheral clock and multi-function I/O */
+    SYS_Init();
+
+    /* Lock protected registers */
+    SYS_LockReg();
+
+    /* Init UART0 for printf */
+    UART0_Init();
+
+    printf("\n\nCPU @ %d Hz\n", SystemCoreClock);
+    printf("+--------------------------------------------+\n");
+    printf("|       Timer Software Timer Sample Code     |\n");
+    printf("+--------------------------------------------+\n\n");
+
+    /* All software timers share Timer0, which is only interrupted when one of them expires */
+    u32Freq = SWTIMER_Open(TIMER0);
+    NVIC_EnableIRQ(TMR0_IRQn);
+
+    printf("# Timebase frequency is %d Hz, wheel tick is %d counts\n", u32Freq, (1 << SWTIMER_TICK_SHIFT));
+    printf("# 100 ms and 1 s periodic timers and %d one-shot timeouts from 50 ms to %d ms\n", TIMEOUT_NUM, 50 + (TIMEOUT_NUM - 1) * 30);
+
+    g_u32StartTime = SWTIMER_GetTime();
+
+    SWTIMER_Start(&s_sTick100ms, SWTIMER_MS_TO_COUNT(100), SWTIMER_MS_TO_COUNT(100), Tick100ms, NULL);
+    SWTIMER_Start(&s_sTick1s, SWTIMER_MS_TO_COUNT(1000), SWTIMER_MS_TO_COUNT(1000), Tick1s, NULL);
+
+    /* Start in reverse order to show that expiry order does not depend on insertion order */
+    for (i = TIMEOUT_NUM; i > 0; i--)
+        SWTIMER_Start(&s_asTimeout[i - 1], SWTIMER_MS_TO_COUNT(50 + (i - 1) * 30), SWTIMER_ONESHOT, Timeout, (void *)(i - 1));
+
+    while (g_u32Count1s < 10)
+    {
+        if (g_u32Count1s != u32Count1s)
+        {
+            u32Count1s = g_u32Count1s;
+            printf("    1s:%3d    100ms:%4d    timeouts:%3d    max drift:%5d us\n",
+                   g_u32Count1s, g_u32Count100ms, g_u32TimeoutCount, g_i32MaxDrift);
+        }
+    }
+
+    if ((g_u32TimeoutCount != TIMEOUT_NUM) || (g_u32TimeoutOrderErr != 0) ||
+            (g_u32Count100ms < (g_u32Count1s * 10 - 1)) || (g_u32Count100ms > (g_u32Count1s * 10 + 1)) ||
+            (g_i32MaxDrift > (1 << SWTIMER_TICK_SHIFT) * 2))
+    {
+        printf("*** FAIL ***\n");
+
+        while (1);
+    }
+
+    printf("*** PASS ***\n");
+
+    while (1);
+}
+
+/*** (C) COPYRIGHT 2021 Nuvoton Technology Corp. ***/
@@ -0,0 +1,164 @@
+/**************************************************************************//**
+ * @file     main.c
+ * @version  V1.00
+ * @brief    Demonstrate the deferred binary log: a timer interrupt logs records that cost a few word stores,
+ *           the main loop prints them as text first and then drains them in binary form by PDMA.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * @copyright (C) 2021 Nuvoton Technology Corp. All rights reserved.
+*****************************************************************************/
+#include <stdio.h>
+#include "NuMicro.h"
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Macro, type and constant definitions                                                                    */
+/*---------------------------------------------------------------------------------------------------------*/
+#define LOG_DMA_CH          0
+#define TICK_FREQ           200
+#define TEXT_TICKS          (TICK_FREQ * 3)
+#define BINARY_TICKS        (TICK_FREQ * 3)
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Global variables                                                                                        */
+/*---------------------------------------------------------------------------------------------------------*/
+static volatile uint32_t s_u32Ticks = 0;
+static volatile uint32_t s_u32MaxCycles = 0;
+static uint32_t s_u32Overhead = 0;
+
+
+/*---------------------------------------------------------------------------------------------------------*/
+/*  Interrupt Handlers                                                                                     */
+/*---------------------------------------------------------------------------------------------------------*/
+void TMR0_IRQHandler(void)
+{
+    uint32_t u32Start, u32Cycles;
+
+    TIMER_ClearIntFlag(TIMER0);
+
+    s_u32Ticks++;
+
+    /* SysTick counts down, measure the log call only */
+    u32Start = SysTick->VAL;
+    DLOG2("tick %u, timer count %u\n", s_u32Ticks, TIMER_GetCounter(TIMER0));
+    u32Cycles = ((u32Start - SysTick->VAL) & SysTick_LOAD_RELOAD_Msk) - s_u32Overhead;
+
+    if (u32Cycles > s_u32MaxCycles)
+        s_u32MaxCycles = u32Cycles;
+
+    if ((s_u32Ticks % TICK_FREQ) == 0)
+        DLOG1("%u seconds\n", s_u32Ticks / TICK_FREQ);
+}
+
+void SYS_Init(void)
+{
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Init System Clock                                                                                       */
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Enable HIRC clock */
+    CLK_EnableXtalRC(CLK_PWRCTL_HIRCEN_Msk);
+
+    /* Waiting for HIRC clock ready */
+    CLK_WaitClockReady(CLK_STATUS_HIRCSTB_Msk);
+
+    /* Switch HCLK clock source to HIRC */
+    CLK_SetHCLK(CLK_CLKSEL0_HCLKSEL_HIRC, CLK_CLKDIV0_HCLK(1));
+
+    /* Select IP clock source */
+    CLK_SetModuleClock(UART0_MODULE, CLK_CLKSEL1_UARTSEL_HIRC_DIV2, CLK_CLKDIV0_UART(1));
+    CLK_SetModuleClock(TMR0_MODULE, CLK_CLKSEL1_TMR0SEL_HIRC_DIV2, 0);
+
+    /* Enable IP peripheral clock */
+    CLK_EnableModuleClock(UART0_MODULE);
+    CLK_EnableModuleClock(TMR0_MODULE);
+    CLK_EnableModuleClock(PDMA_MODULE);
+
+    /* Update System Core Clock */
+    SystemCoreClockUpdate();
+
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Init I/O Multi-function                                                                                 */
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Set GPB multi-function pins for UART0 RXD and TXD */
+    SYS->GPB_MFPL = (SYS->GPB_MFPL & ~(SYS_GPB_MFPL_PB0MFP_Msk | SYS_GPB_MFPL_PB1MFP_Msk)) |
+                    SYS_GPB_MFPL_PB0MFP_UART0_RXD | SYS_GPB_MFPL_PB1MFP_UART0_TXD;
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/*  Main Function                                                                                          */
+/*---------------------------------------------------------------------------------------------------------*/
+int main(void)
+{
+    uint32_t u32Start, u32Cycles;
+
+    /* Unlock protected registers */
+    SYS_UnlockReg();
+
+    /* Init system, peripheral clock and multi-function I/O */
+    SYS_Init();
+
+    /* Lock protected registers */
+    SYS_LockReg();
+
+    /* Init UART to 115200-8n1 for print message */
+    UART_Open(UART0, 115200);
+
+    printf("\n\n");
+    printf("+--------------------------------------------------------------+\n");
+    printf("|                 UART Deferred Log Sample Code                |\n");
+    printf("+--------------------------------------------------------------+\n");
+
+    /* Free running SysTick for cycle counts */
+    SysTick->LOAD = SysTick_LOAD_RELOAD_Msk;
+    SysTick->VAL = 0;
+    SysTick->CTRL = SysTick_CTRL_CLKSOURCE_Msk | SysTick_CTRL_ENABLE_Msk;
+
+    u32Start = SysTick->VAL;
+    s_u32Overhead = (u32Start - SysTick->VAL) & SysTick_LOAD_RELOAD_Msk;
+
+    /* Compare with one formatted line of the same content */
+    u32Start = SysTick->VAL;
+    printf("tick %u, timer count %u\n", 0, 0);
+    u32Cycles = ((u32Start - SysTick->VAL) & SysTick_LOAD_RELOAD_Msk) - s_u32Overhead;
+    printf("printf of that line takes %u cycles\n\n", u32Cycles);
+
+    TIMER_Open(TIMER0, TIMER_PERIODIC_MODE, TICK_FREQ);
+    TIMER_EnableInt(TIMER0);
+    NVIC_EnableIRQ(TMR0_IRQn);
+    TIMER_Start(TIMER0);
+
+    /* Text first, the records are formatted by the main loop and never in the interrupt */
+    printf("Records decoded on chip for %d seconds:\n", TEXT_TICKS / TICK_FREQ);
+
+    while (s_u32Ticks < TEXT_TICKS)
+        DLOG_Print();
+
+    DLOG_Print();
+
+    /* Then binary, the PDMA moves the raw records and the host decoder formats them */
+    printf("\nRaw records for %d seconds follow, decode them with the ELF file.\n", BINARY_TICKS / TICK_FREQ);
+    UART_WAIT_TX_EMPTY(UART0);
+
+    DLOG_Open(LOG_DMA_CH);
+
+    while (s_u32Ticks < (TEXT_TICKS + BINARY_TICKS))
+        DLOG_Poll();
+
+    TIMER_Stop(TIMER0);
+    DLOG_Flush();
+    DLOG_Close();
+
+    printf("\n\nDLOG2 in the interrupt takes at most %u cycles, %u records dropped\n", s_u32MaxCycles, DLOG_GetDropped());
+
+    if (DLOG_GetDropped() != 0)
+    {
+        printf("*** FAIL ***\n");
+
+        while (1);
+    }
+
+    printf("*** PASS ***\n");
+
+    while (1);
+}
+
+/*** (C) COPYRIGHT 2021 Nuvoton Technology Corp. ***/
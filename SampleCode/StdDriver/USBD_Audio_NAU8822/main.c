@@ -102,11 +102,14 @@ void UART0_Init(void)
 
 void I2C0_Init(void)
 {
-    /* Open I2C0 and set clock to 100k */
-    I2C_Open(I2C0, 100000);
+    /* Open I2C0 as a queued master at 100k, codec writes then never block the audio path */
+    printf("I2C clock %d Hz\n", I2C_XFER_Open(&g_sI2cBus, I2C0, 100000));
+    NVIC_EnableIRQ(I2C0_IRQn);
+}
 
-    /* Get I2C0 Bus Clock */
-    printf("I2C clock %d Hz\n", I2C_GetBusClockFreq(I2C0));
+void I2C0_IRQHandler(void)
+{
+    I2C_XFER_IRQHandler(&g_sI2cBus);
 }
 
 
@@ -275,7 +278,7 @@ int32_t main(void)
             ch = getchar();
             u32Data = u32Data * 16 + ((ch >= '0' && ch <= '9') ? ch - '0' : ch - 'a' + 10);
             printf("%03x\n", u32Data);
-            I2C_WriteWAU8822(u32Reg,  u32Data);
+            NAU8822_WriteReg(&g_sCodec, u32Reg, u32Data);
         }
 
     }
@@ -721,80 +721,41 @@ void UAC_SetInterface(void)
 
 
 
+S_I2C_XFER_BUS_T g_sI2cBus;
+S_NAU8822_T g_sCodec;
+
 /*---------------------------------------------------------------------------------------------------------*/
-/*  Write 9-bit data to 7-bit address register of WAU8822 with I2C0                                        */
+/*  Reset NAU8822 and queue its settings, only registers that differ from the reset value are sent         */
 /*---------------------------------------------------------------------------------------------------------*/
-void I2C_WriteWAU8822(uint8_t u8addr, uint16_t u16data)
-{
-    /* Send START */
-    I2C_START(I2C0);
-    I2C_WAIT_READY(I2C0);
-
-    /* Send device address */
-    I2C_SET_DATA(I2C0, 0x1A << 1);
-    I2C_SET_CONTROL_REG(I2C0, I2C_CTL_SI);
-    I2C_WAIT_READY(I2C0);
-
-    /* Send register number and MSB of data */
-    I2C_SET_DATA(I2C0, (uint8_t)((u8addr << 1) | (u16data >> 8)));
-    I2C_SET_CONTROL_REG(I2C0, I2C_CTL_SI);
-    I2C_WAIT_READY(I2C0);
-
-    /* Send data */
-    I2C_SET_DATA(I2C0, (uint8_t)(u16data & 0x00FF));
-    I2C_SET_CONTROL_REG(I2C0, I2C_CTL_SI);
-    I2C_WAIT_READY(I2C0);
-
-    /* Send STOP */
-    I2C_STOP(I2C0);
-}
-
-
 void WAU8822_Setup(void)
 {
+    if (NAU8822_Open(&g_sCodec, &g_sI2cBus) != I2C_XFER_OK)
+        printf("NAU8822 not found\n");
 
-    I2C_WriteWAU8822(0,  0x000);   /* Reset all registers */
-    CLK_SysTickDelay(10000);
-    I2C_WriteWAU8822(1,  0x0FF);
-    I2C_WriteWAU8822(2,  0x1BF);   /* Enable L/R Headphone, ADC Mix/Boost, ADC */
-    I2C_WriteWAU8822(3,  0x07F);   /* Enable L/R main mixer, DAC */
-    I2C_WriteWAU8822(4,  0x010);   /* 16-bit word length, I2S format, Stereo */
-    I2C_WriteWAU8822(5,  0x000);   /* Companding control and loop back mode (all disable) */
-
-#if(PLAY_RATE == 48000)
-    I2C_WriteWAU8822(6,  0x14D);   /* Divide by 2, 48K@16Bit */
-    I2C_WriteWAU8822(7,  0x000);   /* 48K for internal filter coefficients */
-#elif(PLAY_RATE == 32000)
-    I2C_WriteWAU8822(6,  0x16D);   /* Divide by 3, 32K@16Bit */
-    I2C_WriteWAU8822(7,  0x002);   /* 32K for internal filter coefficients */
-#elif(PLAY_RATE == 16000)
-    I2C_WriteWAU8822(6,  0x1AD);   /* Divide by 6, 16K@16Bit */
-    I2C_WriteWAU8822(7,  0x006);   /* 16K for internal filter coefficients */
-#else
-    I2C_WriteWAU8822(6,  0x1ED);   /* Divide by 12, 8K@16Bit */
-    I2C_WriteWAU8822(7,  0x00A);   /* 8K for internal filter coefficients */
-#endif
-
+    NAU8822_WriteReg(&g_sCodec, NAU8822_R_POWER1, 0x0FF);
+    NAU8822_WriteReg(&g_sCodec, NAU8822_R_POWER2, 0x1BF);      /* Enable L/R Headphone, ADC Mix/Boost, ADC */
+    NAU8822_WriteReg(&g_sCodec, NAU8822_R_POWER3, 0x07F);      /* Enable L/R main mixer, DAC */
+    NAU8822_WriteReg(&g_sCodec, NAU8822_R_COMPAND, 0x000);     /* Companding control and loop back mode (all disable) */
 
-    I2C_WriteWAU8822(10, 0x008);   /* DAC soft mute is disabled, DAC oversampling rate is 128x */
-    I2C_WriteWAU8822(14, 0x108);   /* ADC HP filter is disabled, ADC oversampling rate is 128x */
-    I2C_WriteWAU8822(15, 0x0FF);   /* ADC left digital volume control */
-    I2C_WriteWAU8822(16, 0x1FF);   /* ADC right digital volume control */
+    /* 16-bit I2S, codec is master with PLL clock from MCLK */
+    NAU8822_SetFormat(&g_sCodec, PLAY_RATE, 16);
 
-    I2C_WriteWAU8822(45, 0x0bf);   /* LAUXIN connected, and its Gain value is 0dB */
-    I2C_WriteWAU8822(46, 0x1bf);   /* RAUXIN connected, and its Gain value is 0dB */
-    I2C_WriteWAU8822(47, 0x175);   /* LAUXIN connected, and its Gain value is 0dB, MIC is +6dB */
-    I2C_WriteWAU8822(48, 0x175);   /* RAUXIN connected, and its Gain value is 0dB, MIC is +6dB */
+    NAU8822_WriteReg(&g_sCodec, NAU8822_R_DAC_CTL, 0x008);     /* DAC soft mute is disabled, DAC oversampling rate is 128x */
+    NAU8822_WriteReg(&g_sCodec, NAU8822_R_ADC_CTL, 0x108);     /* ADC HP filter is disabled, ADC oversampling rate is 128x */
+    NAU8822_WritePair(&g_sCodec, NAU8822_R_ADC_VOL_L, 0x0FF, 0x0FF);   /* ADC digital volume control */
 
-    I2C_WriteWAU8822(50, 0x001);   /* Left DAC connected to LMIX */
-    I2C_WriteWAU8822(51, 0x001);   /* Right DAC connected to RMIX */
+    NAU8822_WritePair(&g_sCodec, NAU8822_R_PGA_L, 0x0BF, 0x0BF);       /* L/RAUXIN connected, and its Gain value is 0dB */
+    NAU8822_WriteReg(&g_sCodec, NAU8822_R_BOOST_L, 0x175);     /* L/RAUXIN connected, and its Gain value is 0dB, MIC is +6dB */
+    NAU8822_WriteReg(&g_sCodec, NAU8822_R_BOOST_R, 0x175);
 
-    I2C_WriteWAU8822(52, 0x039);   /* HP Volume */
-    I2C_WriteWAU8822(53, 0x139);   /* HP Volume */
+    NAU8822_WriteReg(&g_sCodec, NAU8822_R_MIX_L, 0x001);       /* Left DAC connected to LMIX */
+    NAU8822_WriteReg(&g_sCodec, NAU8822_R_MIX_R, 0x001);       /* Right DAC connected to RMIX */
 
-    I2C_WriteWAU8822(54, 0x140);   /* LSPKOUT Volume */
-    I2C_WriteWAU8822(55, 0x140);   /* RSPKOUT Volume */
+    NAU8822_WritePair(&g_sCodec, NAU8822_R_HP_VOL_L, 0x039, 0x039);    /* HP Volume */
+    NAU8822_WritePair(&g_sCodec, NAU8822_R_SPK_VOL_L, 0x040, 0x040);   /* L/RSPKOUT Volume */
 
+    NAU8822_Sync(&g_sCodec);
+    printf("NAU8822 %d register writes, %d skipped\n", g_sCodec.u32Writes, g_sCodec.u32Skips);
 }
 
 void SPI0_IRQHandler(void)
@@ -974,35 +935,13 @@ void UAC_DeviceDisable(uint8_t u8Object)
 
 void AdjustCodecPll(RESAMPLE_STATE_T r)
 {
-    static uint16_t tb[3][3] = {{0x00C, 0x093, 0x0E9}, // 8.192
-        {0x00E, 0x1D2, 0x1E3},  // * 1.005 = 8.233
-        {0x009, 0x153, 0x1EF}
-    }; // * .995 = 8.151
-    static RESAMPLE_STATE_T current = E_RS_NONE;
-    int i, s;
-
-    if (r == current)
-        return;
+    /* PLL fractions come from the table of the play rate, a repeated state sends nothing */
+    if (r == E_RS_UP)
+        NAU8822_TrimPll(&g_sCodec, NAU8822_TRIM_UP);
+    else if (r == E_RS_DOWN)
+        NAU8822_TrimPll(&g_sCodec, NAU8822_TRIM_DOWN);
     else
-        current = r;
-
-    switch (r)
-    {
-        case E_RS_UP:
-            s = 1;
-            break;
-
-        case E_RS_DOWN:
-            s = 2;
-            break;
-
-        case E_RS_NONE:
-        default:
-            s = 0;
-    }
-
-    for (i = 0; i < 3; i++)
-        I2C_WriteWAU8822(37 + i, tb[s][i]);
+        NAU8822_TrimPll(&g_sCodec, NAU8822_TRIM_NONE);
 }
 
 
@@ -1065,15 +1004,7 @@ void AdjFreq(void)
 
 void VolumnControl(void)
 {
-    static uint8_t u8PrePlayMute = 0;
-    static uint8_t u8PreRecMute = 0;
-    static int16_t i16PrePlayVolumeL = 0;
-    static int16_t i16PrePlayVolumeR = 0;
-    static int16_t i16PreRecVolumeL = 0;
-    static int16_t i16PreRecVolumeR = 0;
-    uint8_t IsChange = 0;
-    uint32_t u32R52, u32R53;
-    uint32_t u32R15, u32R16;
+    uint32_t u32Mute = g_usbd_PlayMute ? NAU8822_MUTE : 0;
 
     /*
         g_usbd_PlayMute is used for MUTE control. 0 = not MUTE. 1 = MUTE.
@@ -1087,117 +1018,17 @@ void VolumnControl(void)
         NAU8822 LADCGAIN (R15) = MUTE, -127dB ~ 0dB. Code is 0x0, 0x1 ~ 0xFF.
         NAU8822 RADCGAIN (R16) = MUTE, -127dB ~ 0dB. Code is 0x0, 0x1 ~ 0xFF.
         Record volume mapping to code will be (Volume >> 8)+128
-    */
-
-    u32R52 = 0;
-    u32R53 = 0;
-
-    /* Update MUTE and volume to u32R52/53 when MUTE changed for play */
-    if (u8PrePlayMute != g_usbd_PlayMute)
-    {
-        u8PrePlayMute = g_usbd_PlayMute;
-        u32R52 = u32R52 | (g_usbd_PlayMute << 6);
-        u32R53 = u32R53 | (g_usbd_PlayMute << 6);
-        i16PrePlayVolumeL = g_usbd_PlayVolumeL;
-        u32R52 |= (g_usbd_PlayVolumeL >> 10) + 32;
-        i16PrePlayVolumeR = g_usbd_PlayVolumeR;
-        u32R53 |= (g_usbd_PlayVolumeL >> 10) + 32;
-        IsChange |= 3;
-    }
-
-    /* Update left volume to u32R52 when left volume changed for play */
-    if (i16PrePlayVolumeL != g_usbd_PlayVolumeL)
-    {
-        i16PrePlayVolumeL = g_usbd_PlayVolumeL;
-        u32R52 |= (g_usbd_PlayVolumeL >> 10) + 32;
-        IsChange |= 1;
-    }
-
-    /* Update right volume to u32R53 when left volume changed for play */
-    if (i16PrePlayVolumeR != g_usbd_PlayVolumeR)
-    {
-        i16PrePlayVolumeR = g_usbd_PlayVolumeR;
-        u32R53 |= (g_usbd_PlayVolumeR >> 10) + 32;
-        IsChange |= 2;
-    }
-
-    u32R15 = 0;
-    u32R16 = 0;
-
-    /* Update MUTE and volume to u32R15/16 when MUTE changed for record */
-    if (u8PreRecMute != g_usbd_RecMute)
-    {
-        u8PreRecMute = g_usbd_RecMute;
-
-        if (!g_usbd_RecMute)
-        {
-            i16PreRecVolumeL = g_usbd_RecVolumeL;
-            i16PreRecVolumeR = g_usbd_RecVolumeR;
-            u32R15 |= (g_usbd_RecVolumeL >> 8) + 128;
-            u32R16 |= (g_usbd_RecVolumeR >> 8) + 128;
-        }
-
-        IsChange |= 0xc;
-    }
-
-    /* Update left volume to u32R15 when left volume changed for record */
-    if (i16PreRecVolumeL != g_usbd_RecVolumeL)
-    {
-        i16PreRecVolumeL = g_usbd_RecVolumeL;
-        u32R15 |= (g_usbd_RecVolumeL >> 8) + 128;
-        IsChange |= 4;
-    }
 
-    /* Update right volume to u32R16 when left volume changed for record */
-    if (i16PreRecVolumeR != g_usbd_RecVolumeR)
-    {
-        i16PreRecVolumeR = g_usbd_RecVolumeR;
-        u32R16 |= (g_usbd_RecVolumeR >> 8) + 128;
-        IsChange |= 8;
-    }
-
-    /* Update R52, R53 when MUTE or volume changed */
-    if ((IsChange & 3) == 3)
-    {
-        /* Both channels need to be changed */
-        I2C_WriteWAU8822(52, u32R52);
-        I2C_WriteWAU8822(53, u32R53 | 0x100);
-        IsChange ^= 3;
-    }
-    else if (IsChange & 1)
-    {
-        /* Only change left channel */
-        I2C_WriteWAU8822(52, u32R52 | 0x100);
-        IsChange ^= 1;
-    }
-    else if (IsChange & 2)
-    {
-        /* Only change right channel */
-        I2C_WriteWAU8822(53, u32R53 | 0x100);
-        IsChange ^= 2;
-    }
-
-    /* Update R15, R16 when MUTE or volume changed */
-    if ((IsChange & 0xc) == 0xc)
-    {
-        /* Both channels need to be changed */
-        I2C_WriteWAU8822(15, u32R15);
-        I2C_WriteWAU8822(16, u32R16 | 0x100);
-        IsChange ^= 0xc;
-    }
-    else if (IsChange & 4)
-    {
-        /* Only change left channel */
-        I2C_WriteWAU8822(15, u32R15 | 0x100);
-        IsChange ^= 4;
-    }
-    else if (IsChange & 8)
-    {
-        /* Only change right channel */
-        I2C_WriteWAU8822(16, u32R16 | 0x100);
-        IsChange ^= 8;
-    }
+        The codec driver compares with its register shadow, so nothing is sent until a setting changes.
+    */
+    NAU8822_WritePair(&g_sCodec, NAU8822_R_HP_VOL_L, u32Mute | (uint32_t)((g_usbd_PlayVolumeL >> 10) + 32),
+                      u32Mute | (uint32_t)((g_usbd_PlayVolumeR >> 10) + 32));
 
+    if (g_usbd_RecMute)
+        NAU8822_WritePair(&g_sCodec, NAU8822_R_ADC_VOL_L, 0, 0);
+    else
+        NAU8822_WritePair(&g_sCodec, NAU8822_R_ADC_VOL_L, (uint32_t)((g_usbd_RecVolumeL >> 8) + 128),
+                          (uint32_t)((g_usbd_RecVolumeR >> 8) + 128));
 }
 
 
@@ -129,7 +129,9 @@ void EP3_Handler(void);
 void WAU8822_Setup(void);
 void AdjFreq(void);
 void VolumnControl(void);
-void I2C_WriteWAU8822(uint8_t u8addr, uint16_t u16data);
+
+extern S_I2C_XFER_BUS_T g_sI2cBus;
+extern S_NAU8822_T g_sCodec;
 
 #endif  /* __USBD_UAC_H_ */
 
@@ -0,0 +1,64 @@
+/**************************************************************************//**
+ * @file     DataFlashProg.c
+ * @version  V1.00
+ * @brief    SPI NOR flash storage of the USB mass storage sample
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * @copyright (C) 2021 Nuvoton Technology Corp. All rights reserved.
+ ******************************************************************************/
+
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Includes of system headers                                                                              */
+/*---------------------------------------------------------------------------------------------------------*/
+#include <stdio.h>
+#include <string.h>
+#include "NuMicro.h"
+#include "massstorage.h"
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Global variables                                                                                        */
+/*---------------------------------------------------------------------------------------------------------*/
+S_SPI_NOR_T g_sSpiFlash;
+S_BLKDEV_T g_sSpiFlashBlk;
+
+/* Write-behind sector of the block device */
+static uint8_t s_au8SectorBuf[SPI_NOR_SECTOR_SIZE];
+
+
+int32_t SpiFlashInit(void)
+{
+    int32_t i32Ret;
+
+    /* Master, mode 0, 8-bit frames, SPI0_SS is driven by the flash driver */
+    SPI_Open(SPI0, SPI_MASTER, SPI_MODE_0, 8, SPI_FLASH_CLOCK);
+
+    i32Ret = SPI_NOR_Open(&g_sSpiFlash, SPI0, SPI_FLASH_TX_DMA_CH, SPI_FLASH_RX_DMA_CH);
+
+    if (i32Ret != 0)
+        return i32Ret;
+
+    SPI_NOR_GetBlockDev(&g_sSpiFlash, &g_sSpiFlashBlk, s_au8SectorBuf);
+
+    return 0;
+}
+
+void SpiFlashSync(void)
+{
+    BLKDEV_SYNC(&g_sSpiFlashBlk);
+}
+
+void DataFlashRead(uint32_t addr, uint32_t size, uint32_t buffer)
+{
+    /* This is low level read function of USB Mass Storage, sizes are whole sectors */
+    BLKDEV_READ(&g_sSpiFlashBlk, addr / UDC_SECTOR_SIZE, (uint8_t *)buffer, size / UDC_SECTOR_SIZE);
+}
+
+void DataFlashWrite(uint32_t addr, uint32_t size, uint32_t buffer)
+{
+    /* This is low level write function of USB Mass Storage, the block device collects the sectors of
+       one flash sector and erases it once */
+    BLKDEV_WRITE(&g_sSpiFlashBlk, addr / UDC_SECTOR_SIZE, (const uint8_t *)buffer, size / UDC_SECTOR_SIZE);
+}
+
+/*** (C) COPYRIGHT 2021 Nuvoton Technology Corp. ***/
@@ -0,0 +1,24 @@
+/****************************************************************************//**
+ * @file     DataFlashProg.h
+ * @version  V1.00
+ * @brief    SPI NOR flash storage of the USB mass storage sample
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * @copyright (C) 2021 Nuvoton Technology Corp. All rights reserved.
+ ******************************************************************************/
+#ifndef __DATA_FLASH_PROG_H__
+#define __DATA_FLASH_PROG_H__
+
+#define SPI_FLASH_CLOCK           24000000  /* SPI0 bus clock */
+#define SPI_FLASH_TX_DMA_CH       0
+#define SPI_FLASH_RX_DMA_CH       1
+
+extern S_SPI_NOR_T g_sSpiFlash;
+extern S_BLKDEV_T g_sSpiFlashBlk;
+
+int32_t SpiFlashInit(void);
+void SpiFlashSync(void);
+
+#endif  /* __DATA_FLASH_PROG_H__ */
+
+/*** (C) COPYRIGHT 2021 Nuvoton Technology Corp. ***/
@@ -0,0 +1,204 @@
+/****************************************************************************//**
+ * @file     main.c
+ * @version  V1.00
+ * @brief
+ *           Demonstrate how to implement a USB Mass-Storage.
+ *           It uses a SPI NOR flash on SPI0 as storage through the block device interface.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * @copyright (C) 2021 Nuvoton Technology Corp. All rights reserved.
+ ******************************************************************************/
+#include <stdio.h>
+#include "NuMicro.h"
+#include "massstorage.h"
+
+#define CRYSTAL_LESS    1
+#define HIRC_AUTO_TRIM  (SYS_IRCTCTL_REFCKSEL_Msk | 0x2);   /* Use USB signal to fine tune HIRC 48MHz */
+#define TRIM_INIT       (SYS_BASE+0x110)
+#define TRIM_THRESHOLD  16      /* Each value is 0.125%, max 2% */
+
+#if CRYSTAL_LESS
+static volatile uint32_t s_u32DefaultTrim, s_u32LastTrim;
+#endif
+
+/*--------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Global variables                                                                                        */
+/*---------------------------------------------------------------------------------------------------------*/
+
+/*--------------------------------------------------------------------------*/
+void SYS_Init(void)
+{
+
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Init System Clock                                                                                       */
+    /*---------------------------------------------------------------------------------------------------------*/
+
+    /* Enable Internal HIRC 48 MHz clock */
+    CLK_EnableXtalRC(CLK_PWRCTL_HIRCEN);
+
+    /* Waiting for Internal RC clock ready */
+    CLK_WaitClockReady(CLK_STATUS_HIRCSTB_Msk);
+
+#if (CRYSTAL_LESS)
+    /* Switch HCLK clock source to Internal HIRC and HCLK source divide 1 */
+    CLK_SetHCLK(CLK_CLKSEL0_HCLKSEL_HIRC, CLK_CLKDIV0_HCLK(1));
+
+    /* Select module clock source */
+    CLK_SetModuleClock(USBD_MODULE, CLK_CLKSEL3_USBDSEL_HIRC, CLK_CLKDIV0_USB(1));
+#else
+    /* Enable External XTAL (4~24 MHz) */
+    CLK_EnableXtalRC(CLK_PWRCTL_HXTEN);
+
+    /* Waiting for 12MHz clock ready */
+    CLK_WaitClockReady(CLK_STATUS_HXTSTB_Msk);
+
+    /* Set core clock as PLL_CLOCK from PLL */
+    CLK_SetCoreClock(FREQ_48MHZ);
+
+    /* Select module clock source */
+    CLK_SetModuleClock(USBD_MODULE, CLK_CLKSEL3_USBDSEL_PLL, CLK_CLKDIV0_USB(2));
+#endif
+
+    SystemCoreClockUpdate();
+    /* Enable module clock */
+    CLK_EnableModuleClock(UART0_MODULE);
+    CLK_EnableModuleClock(USBD_MODULE);
+    CLK_EnableModuleClock(SPI0_MODULE);
+    CLK_EnableModuleClock(PDMA_MODULE);
+
+    /* Select module clock source */
+    CLK_SetModuleClock(UART0_MODULE, CLK_CLKSEL1_UARTSEL_HIRC_DIV2, CLK_CLKDIV0_UART(1));
+    CLK_SetModuleClock(SPI0_MODULE, CLK_CLKSEL2_SPI0SEL_PCLK0, MODULE_NoMsk);
+
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Init I/O Multi-function                                                                                 */
+    /*---------------------------------------------------------------------------------------------------------*/
+
+    /* Set PB multi-function pins for UART0 RXD and TXD */
+    SYS->GPB_MFPL &= ~(SYS_GPB_MFPL_PB0MFP_Msk | SYS_GPB_MFPL_PB1MFP_Msk);
+    SYS->GPB_MFPL = SYS_GPB_MFPL_PB0MFP_UART0_RXD | SYS_GPB_MFPL_PB1MFP_UART0_TXD;
+
+    /* Set PC multi-function pins for SPI0 SS, CLK, MISO and MOSI */
+    SYS->GPC_MFPL &= ~(SYS_GPC_MFPL_PC0MFP_Msk | SYS_GPC_MFPL_PC1MFP_Msk | SYS_GPC_MFPL_PC2MFP_Msk | SYS_GPC_MFPL_PC3MFP_Msk);
+    SYS->GPC_MFPL |= SYS_GPC_MFPL_PC0MFP_SPI0_SS | SYS_GPC_MFPL_PC1MFP_SPI0_CLK | SYS_GPC_MFPL_PC2MFP_SPI0_MISO | SYS_GPC_MFPL_PC3MFP_SPI0_MOSI;
+
+}
+
+
+void UART0_Init(void)
+{
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Init UART                                                                                               */
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Reset IP */
+    SYS->IPRST1 |=  SYS_IPRST1_UART0RST_Msk;
+    SYS->IPRST1 &= ~SYS_IPRST1_UART0RST_Msk;
+
+    /* Configure UART0 and set UART0 Baudrate */
+    UART0->BAUD = UART_BAUD_MODE2 | UART_BAUD_MODE2_DIVIDER(__HIRC_DIV2, 115200);
+    UART0->LINE = UART_WORD_LEN_8 | UART_PARITY_NONE | UART_STOP_BIT_1;
+}
+
+
+/*---------------------------------------------------------------------------------------------------------*/
+/*  Main Function                                                                                          */
+/*---------------------------------------------------------------------------------------------------------*/
+int32_t main(void)
+{
+    /* Unlock protected registers */
+    SYS_UnlockReg();
+
+    SYS_Init();
+    UART0_Init();
+
+    printf("+-------------------------------------------------------+\n");
+    printf("|          NuMicro USB MassStorage Sample Code          |\n");
+    printf("+-------------------------------------------------------+\n");
+
+    if (SpiFlashInit() != 0)
+    {
+        printf("No SPI NOR flash found on SPI0.\n");
+        return -1;
+    }
+
+    printf("JEDEC ID %02X %02X %02X, %d KB\n", g_sSpiFlash.au8Id[0], g_sSpiFlash.au8Id[1], g_sSpiFlash.au8Id[2],
+           g_sSpiFlash.u32Size / 1024);
+
+    printf("NuMicro USB MassStorage Start!\n");
+
+    USBD_Open(&gsInfo, MSC_ClassRequest, NULL);
+
+    USBD_SetConfigCallback(MSC_SetConfig);
+
+    /* Endpoint configuration */
+    MSC_Init();
+    USBD_Start();
+
+    NVIC_EnableIRQ(USBD_IRQn);
+
+#if CRYSTAL_LESS
+    /* Backup default trim value */
+    s_u32DefaultTrim = M32(TRIM_INIT);
+    s_u32LastTrim = s_u32DefaultTrim;
+
+    /* Clear SOF */
+    USBD_CLR_INT_FLAG(USBD_INTSTS_SOFIF_Msk);
+#endif
+
+    while (1)
+    {
+#if CRYSTAL_LESS
+
+        /* Start USB trim function if it is not enabled. */
+        if ((SYS->IRCTCTL & SYS_IRCTCTL_FREQSEL_Msk) != 0x2)
+        {
+            /* Start USB trim only when USB signal arrived */
+            if (USBD->INTSTS & USBD_INTSTS_SOFIF_Msk)
+            {
+                /* Clear SOF */
+                USBD_CLR_INT_FLAG(USBD_INTSTS_SOFIF_Msk);
+
+                /* Enable USB clock trim function */
+                SYS->IRCTCTL = HIRC_AUTO_TRIM;
+            }
+        }
+
+        /* Disable USB Trim when any error found */
+        if (SYS->IRCTISTS & (SYS_IRCTISTS_CLKERRIF_Msk | SYS_IRCTISTS_TFAILIF_Msk))
+        {
+            /* Last TRIM */
+            M32(TRIM_INIT) = s_u32LastTrim;
+
+            /* Disable USB clock trim function */
+            SYS->IRCTCTL = 0;
+
+            /* Clear trim error flags */
+            SYS->IRCTISTS = SYS_IRCTISTS_CLKERRIF_Msk | SYS_IRCTISTS_TFAILIF_Msk;
+
+            /* Clear SOF */
+            USBD_CLR_INT_FLAG(USBD_INTSTS_SOFIF_Msk);
+
+        }
+
+        /* Check trim value whether it is over the threshold */
+        if((M32(TRIM_INIT) > (s_u32DefaultTrim + TRIM_THRESHOLD)) || (M32(TRIM_INIT) < (s_u32DefaultTrim - TRIM_THRESHOLD)))
+        {
+            /* Write updated value */
+            M32(TRIM_INIT) = s_u32LastTrim;
+        }
+        else
+        {
+            /* Backup trim value */
+            s_u32LastTrim =  M32(TRIM_INIT);
+        }
+#endif
+        MSC_ProcessCmd();
+    }
+}
+
+
+
+/*** (C) COPYRIGHT 2016 Nuvoton Technology Corp. ***/
+
@@ -0,0 +1,353 @@
+/****************************************************************************//**
+ * @file     main.c
+ * @version  V1.00
+ * @brief    Monitor an I2C bus with USCI_I2C, stream the event records over USB VCOM
+ *           and print per address statistics on UART0.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * @copyright (C) 2021 Nuvoton Technology Corp. All rights reserved.
+ ******************************************************************************/
+#include <stdio.h>
+#include "NuMicro.h"
+#include "cdc_serial.h"
+
+#define CRYSTAL_LESS    1
+#define HIRC_AUTO_TRIM  (SYS_IRCTCTL_REFCKSEL_Msk | 0x2);   /* Use USB signal to fine tune HIRC 48MHz */
+#define TRIM_INIT       (SYS_BASE+0x110)
+#define TRIM_THRESHOLD  16      /* Each value is 0.125%, max 2% */
+
+#if CRYSTAL_LESS
+static volatile uint32_t s_u32DefaultTrim, s_u32LastTrim;
+#endif
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Macro, type and constant definitions                                                                    */
+/*---------------------------------------------------------------------------------------------------------*/
+#define RING_SIZE           256                     /* Records, 1 KB */
+#define PKT_RECORDS         (EP2_MAX_PKT_SIZE / 4)
+#define TRAFFIC_MS          20
+#define REPORT_MS           1000
+#define DEMO_SLAVE_ADDR     0x16
+#define ABSENT_ADDR         0x50
+
+/*--------------------------------------------------------------------------*/
+STR_VCOM_LINE_CODING g_sLineCoding = {115200, 0, 0, 8};   /* Baud rate: 115200     */
+/* Stop bit : 1 Stops Bit*/
+/* parity   : None       */
+/* data bits: 8 Bits     */
+uint16_t g_u16CtrlSignal = 0;     /* BIT0: DTR(Data Terminal Ready) , BIT1: RTS(Request To Send) */
+
+volatile uint8_t *g_pu8RxBuf = 0;
+volatile uint32_t g_u32RxSize = 0;
+volatile uint32_t g_u32TxSize = 0;
+
+volatile int8_t g_i8BulkOutReady = 0;
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Global variables                                                                                        */
+/*---------------------------------------------------------------------------------------------------------*/
+static S_UI2C_MON_T s_sMon;
+static S_UI2C_MON_STAT_T s_sStat;
+static uint32_t s_au32Ring[RING_SIZE];
+static uint32_t s_au32Pkt[PKT_RECORDS];
+
+/* Demo slave on the monitored bus */
+static S_I2C_REGMAP_T s_sMap;
+static uint8_t s_au8SlvRegs[64];
+
+
+/*---------------------------------------------------------------------------------------------------------*/
+/*  USCI IRQ Handler                                                                                       */
+/*---------------------------------------------------------------------------------------------------------*/
+void USCI_IRQHandler(void)
+{
+    UI2C_MON_IRQHandler(&s_sMon);
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/*  I2C1 IRQ Handler                                                                                       */
+/*---------------------------------------------------------------------------------------------------------*/
+void I2C1_IRQHandler(void)
+{
+    I2C_REGMAP_IRQHandler(&s_sMap);
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/*  TMR0 IRQ Handler                                                                                       */
+/*---------------------------------------------------------------------------------------------------------*/
+void TMR0_IRQHandler(void)
+{
+    SWTIMER_IRQHandler();
+}
+
+void SYS_Init(void)
+{
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Init System Clock                                                                                       */
+    /*---------------------------------------------------------------------------------------------------------*/
+
+    /* Enable Internal HIRC 48 MHz clock */
+    CLK_EnableXtalRC(CLK_PWRCTL_HIRCEN);
+
+    /* Waiting for Internal RC clock ready */
+    CLK_WaitClockReady(CLK_STATUS_HIRCSTB_Msk);
+
+#if (CRYSTAL_LESS)
+    /* Switch HCLK clock source to Internal HIRC and HCLK source divide 1 */
+    CLK_SetHCLK(CLK_CLKSEL0_HCLKSEL_HIRC, CLK_CLKDIV0_HCLK(1));
+
+    /* Select module clock source */
+    CLK_SetModuleClock(USBD_MODULE, CLK_CLKSEL3_USBDSEL_HIRC, CLK_CLKDIV0_USB(1));
+#else
+    /* Enable External XTAL (4~24 MHz) */
+    CLK_EnableXtalRC(CLK_PWRCTL_HXTEN);
+
+    /* Waiting for 12MHz clock ready */
+    CLK_WaitClockReady(CLK_STATUS_HXTSTB_Msk);
+
+    /* Set core clock as PLL_CLOCK from PLL */
+    CLK_SetCoreClock(FREQ_48MHZ);
+
+    /* Select module clock source */
+    CLK_SetModuleClock(USBD_MODULE, CLK_CLKSEL3_USBDSEL_PLL, CLK_CLKDIV0_USB(2));
+#endif
+
+    SystemCoreClockUpdate();
+
+    /* Enable module clock */
+    CLK_EnableModuleClock(UART0_MODULE);
+    CLK_EnableModuleClock(USBD_MODULE);
+    CLK_EnableModuleClock(USCI0_MODULE);
+    CLK_EnableModuleClock(I2C0_MODULE);
+    CLK_EnableModuleClock(I2C1_MODULE);
+    CLK_EnableModuleClock(TMR0_MODULE);
+
+    /* Select module clock source */
+    CLK_SetModuleClock(UART0_MODULE, CLK_CLKSEL1_UARTSEL_HIRC_DIV2, CLK_CLKDIV0_UART(1));
+    CLK_SetModuleClock(TMR0_MODULE, CLK_CLKSEL1_TMR0SEL_HIRC_DIV2, 0);
+
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Init I/O Multi-function                                                                                 */
+    /*---------------------------------------------------------------------------------------------------------*/
+
+    /* Set PB multi-function pins for UART0 RXD and TXD */
+    SYS->GPB_MFPL &= ~(SYS_GPB_MFPL_PB0MFP_Msk | SYS_GPB_MFPL_PB1MFP_Msk);
+    SYS->GPB_MFPL = SYS_GPB_MFPL_PB0MFP_UART0_RXD | SYS_GPB_MFPL_PB1MFP_UART0_TXD;
+
+    /* Set PC multi-function pins for UI2C SDA and SCL */
+    SYS->GPC_MFPL &= ~(SYS_GPC_MFPL_PC3MFP_Msk | SYS_GPC_MFPL_PC0MFP_Msk);
+    SYS->GPC_MFPL |= (SYS_GPC_MFPL_PC3MFP_USCI0_DAT0 | SYS_GPC_MFPL_PC0MFP_USCI0_CLK);
+
+    /* Set PC multi-function pins for I2C0 SDA and SCL */
+    SYS->GPC_MFPH &= ~(SYS_GPC_MFPH_PC11MFP_Msk | SYS_GPC_MFPH_PC12MFP_Msk);
+    SYS->GPC_MFPH |= (SYS_GPC_MFPH_PC11MFP_I2C0_SDA | SYS_GPC_MFPH_PC12MFP_I2C0_SCL);
+
+    /* Set PA multi-function pins for I2C1 SDA and SCL */
+    SYS->GPA_MFPH &= ~(SYS_GPA_MFPH_PA10MFP_Msk | SYS_GPA_MFPH_PA11MFP_Msk);
+    SYS->GPA_MFPH |= (SYS_GPA_MFPH_PA10MFP_I2C1_SDA | SYS_GPA_MFPH_PA11MFP_I2C1_SCL);
+
+    /* I2C pins enable schmitt trigger */
+    PA->SMTEN |= GPIO_SMTEN_SMTEN10_Msk | GPIO_SMTEN_SMTEN11_Msk;
+    PC->SMTEN |= GPIO_SMTEN_SMTEN0_Msk  | GPIO_SMTEN_SMTEN3_Msk;
+    PC->SMTEN |= GPIO_SMTEN_SMTEN11_Msk | GPIO_SMTEN_SMTEN12_Msk;
+}
+
+void UART0_Init(void)
+{
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Init UART                                                                                               */
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Reset IP */
+    SYS_ResetModule(UART0_RST);
+
+    /* Configure UART0 and set UART0 Baudrate */
+    UART_Open(UART0, 115200);
+}
+
+/* Some bus traffic for the monitor: register writes and reads, and a probe of an absent device */
+void Traffic(void)
+{
+    static uint8_t s_u8Seq = 0;
+    uint8_t au8Data[4];
+
+    au8Data[0] = s_u8Seq++;
+    au8Data[1] = 0x11;
+    au8Data[2] = 0x22;
+    au8Data[3] = 0x33;
+
+    I2C_WriteMultiBytesOneReg(I2C0, DEMO_SLAVE_ADDR, 0x00, au8Data, sizeof(au8Data));
+    I2C_ReadMultiBytesOneReg(I2C0, DEMO_SLAVE_ADDR, 0x00, au8Data, sizeof(au8Data));
+    I2C_ReadByte(I2C0, ABSENT_ADDR);
+}
+
+/* Records go to the statistics and, while the host holds DTR, to the bulk IN endpoint */
+void MonitorTransfer(void)
+{
+    uint32_t u32Num;
+
+    if (g_u32TxSize != 0)
+        return;
+
+    u32Num = UI2C_MON_Read(&s_sMon, s_au32Pkt, PKT_RECORDS);
+
+    if (u32Num == 0)
+        return;
+
+    UI2C_MON_StatFeed(&s_sStat, s_au32Pkt, u32Num);
+
+    if (g_u16CtrlSignal & 0x1)
+    {
+        g_u32TxSize = u32Num * 4;
+        USBD_MemCopy((uint8_t *)(USBD_BUF_BASE + USBD_GET_EP_BUF_ADDR(EP2)), (uint8_t *)s_au32Pkt, g_u32TxSize);
+        USBD_SET_PAYLOAD_LEN(EP2, g_u32TxSize);
+    }
+
+    /* Nothing is received from the host */
+    if (g_i8BulkOutReady)
+    {
+        g_i8BulkOutReady = 0;
+        USBD_SET_PAYLOAD_LEN(EP3, EP3_MAX_PKT_SIZE);
+    }
+}
+
+void MonitorReport(void)
+{
+    uint32_t i, u32Util = UI2C_MON_StatUtilization(&s_sStat);
+    S_UI2C_MON_ADDR_STAT_T *psAddr;
+
+    printf("\nBus utilization %d.%d %%, %d events, %d lost, %d transactions to other slaves\n",
+           u32Util / 10, u32Util % 10, s_sStat.u32Events, s_sStat.u32Lost, s_sStat.u32OtherXfers);
+    printf("Addr   Xfers   Bytes   NACKs  Avg(us)  Max(us)\n");
+
+    for (i = 0; i < s_sStat.u32AddrNum; i++)
+    {
+        psAddr = &s_sStat.asAddr[i];
+        printf("0x%02X %7d %7d %7d %8d %8d\n", psAddr->u8Addr, psAddr->u32Xfers, psAddr->u32Bytes, psAddr->u32Nacks,
+               psAddr->u32Xfers ? (psAddr->u32TotalTime / psAddr->u32Xfers) : 0, psAddr->u32MaxTime);
+    }
+
+    UI2C_MON_StatInit(&s_sStat);
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/*  Main Function                                                                                          */
+/*---------------------------------------------------------------------------------------------------------*/
+int32_t main(void)
+{
+    uint32_t u32Traffic, u32Report;
+
+    /* Unlock protected registers */
+    SYS_UnlockReg();
+
+    SYS_Init();
+    UART0_Init();
+
+    printf("\n\n");
+    printf("+------------------------------------------------------------+\n");
+    printf("|          USCI_I2C Bus Monitor Sample Code                  |\n");
+    printf("+------------------------------------------------------------+\n");
+    printf("Monitor UI2C0_SDA(PC.3), UI2C0_SCL(PC.0).\n");
+    printf("Demo traffic from I2C0_SDA(PC.11), I2C0_SCL(PC.12) to I2C1_SDA(PA.10), I2C1_SCL(PA.11).\n");
+    printf("Connect all SDA pins together and all SCL pins together.\n");
+    printf("Open the VCOM port with DTR set to receive the 32-bit records described in usci_i2c_mon.h.\n");
+
+    SWTIMER_Open(TIMER0);
+    NVIC_EnableIRQ(TMR0_IRQn);
+
+    /* Never drive the bus, a full ring is reported by a LOST record */
+    UI2C_MON_StatInit(&s_sStat);
+    UI2C_MON_Open(&s_sMon, UI2C0, s_au32Ring, RING_SIZE, UI2C_MON_PASSIVE);
+    NVIC_EnableIRQ(USCI_IRQn);
+
+    I2C_REGMAP_Open(&s_sMap, I2C1, 400000, 1);
+    I2C_REGMAP_AddWindow(&s_sMap, DEMO_SLAVE_ADDR, 0, s_au8SlvRegs, sizeof(s_au8SlvRegs), I2C_REGMAP_RW);
+    NVIC_EnableIRQ(I2C1_IRQn);
+
+    I2C_Open(I2C0, 400000);
+
+    /* Open USB controller */
+    USBD_Open(&gsInfo, VCOM_ClassRequest, NULL);
+
+    /* Endpoint configuration */
+    VCOM_Init();
+    /* Start USB device */
+    USBD_Start();
+
+#if CRYSTAL_LESS
+    /* Backup default trim value */
+    s_u32DefaultTrim = M32(TRIM_INIT);
+    s_u32LastTrim = s_u32DefaultTrim;
+
+    /* Clear SOF */
+    USBD_CLR_INT_FLAG(USBD_INTSTS_SOFIF_Msk);
+#endif
+
+    NVIC_EnableIRQ(USBD_IRQn);
+
+    u32Traffic = u32Report = SWTIMER_GetTime();
+
+    while (1)
+    {
+#if CRYSTAL_LESS
+
+        /* Start USB trim function if it is not enabled. */
+        if ((SYS->IRCTCTL & SYS_IRCTCTL_FREQSEL_Msk) != 0x2)
+        {
+            /* Start USB trim only when USB signal arrived */
+            if (USBD->INTSTS & USBD_INTSTS_SOFIF_Msk)
+            {
+                /* Clear SOF */
+                USBD_CLR_INT_FLAG(USBD_INTSTS_SOFIF_Msk);
+
+                /* Enable USB clock trim function */
+                SYS->IRCTCTL = HIRC_AUTO_TRIM;
+            }
+        }
+
+        /* Disable USB Trim when any error found */
+        if (SYS->IRCTISTS & (SYS_IRCTISTS_CLKERRIF_Msk | SYS_IRCTISTS_TFAILIF_Msk))
+        {
+            /* Last TRIM */
+            M32(TRIM_INIT) = s_u32LastTrim;
+
+            /* Disable USB clock trim function */
+            SYS->IRCTCTL = 0;
+
+            /* Clear trim error flags */
+            SYS->IRCTISTS = SYS_IRCTISTS_CLKERRIF_Msk | SYS_IRCTISTS_TFAILIF_Msk;
+
+            /* Clear SOF */
+            USBD_CLR_INT_FLAG(USBD_INTSTS_SOFIF_Msk);
+        }
+
+        /* Check trim value whether it is over the threshold */
+        if ((M32(TRIM_INIT) > (s_u32DefaultTrim + TRIM_THRESHOLD)) || (M32(TRIM_INIT) < (s_u32DefaultTrim - TRIM_THRESHOLD)))
+        {
+            /* Write updated value */
+            M32(TRIM_INIT) = s_u32LastTrim;
+        }
+        else
+        {
+            /* Backup trim value */
+            s_u32LastTrim =  M32(TRIM_INIT);
+        }
+
+#endif
+
+        MonitorTransfer();
+
+        if ((SWTIMER_GetTime() - u32Traffic) >= SWTIMER_MS_TO_COUNT(TRAFFIC_MS))
+        {
+            u32Traffic += SWTIMER_MS_TO_COUNT(TRAFFIC_MS);
+            Traffic();
+        }
+
+        if ((SWTIMER_GetTime() - u32Report) >= SWTIMER_MS_TO_COUNT(REPORT_MS))
+        {
+            u32Report += SWTIMER_MS_TO_COUNT(REPORT_MS);
+            MonitorReport();
+        }
+    }
+}
+
+/*** (C) COPYRIGHT 2021 Nuvoton Technology Corp. ***/
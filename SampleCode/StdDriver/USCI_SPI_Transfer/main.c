@@ -0,0 +1,246 @@
+/**************************************************************************//**
+ * @file     main.c
+ * @version  V1.00
+ * @brief    Demonstrate the USCI_SPI transfer API: CPU batched and PDMA transfers, background
+ *           transfers and chip select hold across segments. MOSI is looped back to MISO.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * @copyright (C) 2021 Nuvoton Technology Corp. All rights reserved.
+*****************************************************************************/
+#include <stdio.h>
+#include <string.h>
+#include "NuMicro.h"
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Macro, type and constant definitions                                                                    */
+/*---------------------------------------------------------------------------------------------------------*/
+#define BUS_CLOCK           12000000
+#define SPI_TX_DMA_CH       0
+#define SPI_RX_DMA_CH       1
+#define PDMA_MIN_LEN        32
+#define BYTE_LEN            512
+#define WORD_LEN            256
+#define CMD_LEN             4
+#define LONG_LEN            20000
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Global variables                                                                                        */
+/*---------------------------------------------------------------------------------------------------------*/
+static S_USPI_XFER_T s_sXfer;
+
+static uint8_t s_au8Tx[BYTE_LEN], s_au8Rx[BYTE_LEN];
+static uint16_t s_au16Tx[WORD_LEN], s_au16Rx[WORD_LEN];
+
+volatile uint32_t g_u32Done = 0;
+
+
+/*---------------------------------------------------------------------------------------------------------*/
+/*  USCI IRQ Handler                                                                                       */
+/*---------------------------------------------------------------------------------------------------------*/
+void USCI_IRQHandler(void)
+{
+    USPI_XferIRQHandler(&s_sXfer);
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/*  PDMA IRQ Handler                                                                                       */
+/*---------------------------------------------------------------------------------------------------------*/
+void PDMA_IRQHandler(void)
+{
+    USPI_XferPDMAHandler(&s_sXfer);
+}
+
+void XferDone(S_USPI_XFER_T *psXfer)
+{
+    (void)psXfer;
+    g_u32Done++;
+}
+
+void SYS_Init(void)
+{
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Init System Clock                                                                                       */
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Enable HIRC clock (Internal RC 48MHz) */
+    CLK_EnableXtalRC(CLK_PWRCTL_HIRCEN_Msk);
+
+    /* Wait for HIRC clock ready */
+    CLK_WaitClockReady(CLK_STATUS_HIRCSTB_Msk);
+
+    /* Select HCLK clock source as HIRC and HCLK source divider as 1 */
+    CLK_SetHCLK(CLK_CLKSEL0_HCLKSEL_HIRC, CLK_CLKDIV0_HCLK(1));
+
+    /* Enable module clock */
+    CLK_EnableModuleClock(UART0_MODULE);
+    CLK_EnableModuleClock(USCI0_MODULE);
+    CLK_EnableModuleClock(PDMA_MODULE);
+
+    /* Select UART module clock source as HIRC/2 and UART module clock divider as 1 */
+    CLK_SetModuleClock(UART0_MODULE, CLK_CLKSEL1_UARTSEL_HIRC_DIV2, CLK_CLKDIV0_UART(1));
+
+    /* Update System Core Clock */
+    SystemCoreClockUpdate();
+
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Initiate I/O Multi-function                                                                             */
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Set GPB multi-function pins for UART0 RXD and TXD */
+    SYS->GPB_MFPL = SYS_GPB_MFPL_PB0MFP_UART0_RXD | SYS_GPB_MFPL_PB1MFP_UART0_TXD;
+
+    /* Set USCI_SPI0 multi-function pins */
+    SYS->GPC_MFPL = (SYS->GPC_MFPL & (~SYS_GPC_MFPL_PC1MFP_Msk))  | (SYS_GPC_MFPL_PC1MFP_USCI0_CTL0);   /* PC.1  */
+    SYS->GPC_MFPL = (SYS->GPC_MFPL & (~SYS_GPC_MFPL_PC0MFP_Msk))  | (SYS_GPC_MFPL_PC0MFP_USCI0_CLK);    /* PC.0  */
+    SYS->GPC_MFPL = (SYS->GPC_MFPL & (~SYS_GPC_MFPL_PC3MFP_Msk))  | (SYS_GPC_MFPL_PC3MFP_USCI0_DAT0);   /* PC.3  */
+    SYS->GPC_MFPL = (SYS->GPC_MFPL & (~SYS_GPC_MFPL_PC2MFP_Msk))  | (SYS_GPC_MFPL_PC2MFP_USCI0_DAT1);   /* PC.2  */
+}
+
+void UART0_Init(void)
+{
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Init UART                                                                                               */
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Reset UART0 */
+    SYS_ResetModule(UART0_RST);
+
+    /* Configure UART0 and set UART0 baud rate */
+    UART_Open(UART0, 115200);
+}
+
+/* SysTick runs free at HCLK to time the transfers */
+uint32_t CycleStart(void)
+{
+    SysTick->LOAD = SysTick_LOAD_RELOAD_Msk;
+    SysTick->VAL = 0;
+    SysTick->CTRL = SysTick_CTRL_CLKSOURCE_Msk | SysTick_CTRL_ENABLE_Msk;
+
+    return SysTick->VAL;
+}
+
+uint32_t CycleElapsed(uint32_t u32Start)
+{
+    return (u32Start - SysTick->VAL) & SysTick_LOAD_RELOAD_Msk;
+}
+
+/* Efficiency is the bus time of the bits divided by the measured time */
+void Report(const char *pcName, uint32_t u32Bits, uint32_t u32Cycles)
+{
+    uint32_t u32BusUs = (uint32_t)(((uint64_t)u32Bits * 1000000) / BUS_CLOCK);
+    uint32_t u32Us = u32Cycles / (SystemCoreClock / 1000000);
+
+    printf("%-28s %6d us, bus time %6d us, %3d %%\n", pcName, u32Us, u32BusUs, u32Us ? (u32BusUs * 100 / u32Us) : 0);
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/*  Main Function                                                                                          */
+/*---------------------------------------------------------------------------------------------------------*/
+int main(void)
+{
+    uint32_t i, u32Start, u32Cycles, u32SsHeld;
+    int32_t i32Err = 0;
+
+    /* Unlock protected registers */
+    SYS_UnlockReg();
+
+    /* Initial clocks and multi-functions */
+    SYS_Init();
+
+    /* Lock protected registers */
+    SYS_LockReg();
+
+    /* Initiate UART0 to 115200-8n1 for print message */
+    UART0_Init();
+
+    printf("\n\n");
+    printf("+--------------------------------------------------------------+\n");
+    printf("|                USCI_SPI Transfer Sample Code                 |\n");
+    printf("+--------------------------------------------------------------+\n");
+    printf("Configure USCI_SPI0 as a master at %d Hz.\n", BUS_CLOCK);
+    printf("The I/O connection for USCI_SPI0 loop back:\n");
+    printf("    USCI_SPI0_SS (PC.1) <--> NULL\n    USCI_SPI0_CLK (PC.0) <--> NULL\n");
+    printf("    USCI_SPI0_MISO (PC.2) <--> USCI_SPI0_MOSI (PC.3)\n\n");
+
+    printf("Bus clock %d Hz\n", USPI_Open(USPI0, USPI_MASTER, USPI_MODE_0, 8, BUS_CLOCK));
+    USPI_XferInit(&s_sXfer, USPI0);
+    USPI_XferEnablePDMA(&s_sXfer, SPI_TX_DMA_CH, SPI_RX_DMA_CH, PDMA_MIN_LEN);
+    NVIC_EnableIRQ(USCI_IRQn);
+    NVIC_EnableIRQ(PDMA_IRQn);
+
+    for (i = 0; i < BYTE_LEN; i++)
+        s_au8Tx[i] = (uint8_t)(i * 7 + 3);
+
+    for (i = 0; i < WORD_LEN; i++)
+        s_au16Tx[i] = (uint16_t)(0xA5A5 ^ (i * 0x0101));
+
+    /* Short transfer, the CPU keeps both buffer levels loaded */
+    u32Start = CycleStart();
+    USPI_Transfer(&s_sXfer, s_au8Tx, s_au8Rx, PDMA_MIN_LEN - 1, 0);
+    u32Cycles = CycleElapsed(u32Start);
+    Report("8-bit CPU, 31 frames", (PDMA_MIN_LEN - 1) * 8, u32Cycles);
+
+    if (memcmp(s_au8Rx, s_au8Tx, PDMA_MIN_LEN - 1) != 0)
+        i32Err = -1;
+
+    /* Command and data segments with chip select held in between */
+    memset(s_au8Rx, 0, sizeof(s_au8Rx));
+    USPI_Transfer(&s_sXfer, s_au8Tx, s_au8Rx, CMD_LEN, USPI_XFER_CS_HOLD);
+    u32SsHeld = (PC1 == 0);
+    USPI_Transfer(&s_sXfer, &s_au8Tx[CMD_LEN], &s_au8Rx[CMD_LEN], BYTE_LEN - CMD_LEN, 0);
+
+    if ((memcmp(s_au8Rx, s_au8Tx, BYTE_LEN) != 0) || !u32SsHeld || (PC1 == 0))
+        i32Err = -1;
+
+    printf("Command + data segments: SS %s between segments\n", u32SsHeld ? "held" : "released");
+
+    /* PDMA transfer */
+    memset(s_au8Rx, 0, sizeof(s_au8Rx));
+    u32Start = CycleStart();
+    USPI_Transfer(&s_sXfer, s_au8Tx, s_au8Rx, BYTE_LEN, 0);
+    u32Cycles = CycleElapsed(u32Start);
+    Report("8-bit PDMA, 512 frames", BYTE_LEN * 8, u32Cycles);
+
+    if (memcmp(s_au8Rx, s_au8Tx, BYTE_LEN) != 0)
+        i32Err = -1;
+
+    /* Read only transfer longer than one PDMA block */
+    u32Start = CycleStart();
+    USPI_Transfer(&s_sXfer, NULL, NULL, LONG_LEN, 0);
+    u32Cycles = CycleElapsed(u32Start);
+    Report("8-bit PDMA, 20000 frames", LONG_LEN * 8, u32Cycles);
+
+    /* 16-bit background transfers, by interrupt and by PDMA */
+    USPI_SET_DATA_WIDTH(USPI0, 16);
+
+    USPI_TransferAsync(&s_sXfer, s_au16Tx, s_au16Rx, PDMA_MIN_LEN - 1, 0, XferDone, NULL);
+
+    while (USPI_XFER_IS_BUSY(&s_sXfer));
+
+    if (memcmp(s_au16Rx, s_au16Tx, (PDMA_MIN_LEN - 1) * 2) != 0)
+        i32Err = -1;
+
+    memset(s_au16Rx, 0, sizeof(s_au16Rx));
+    u32Start = CycleStart();
+    USPI_TransferAsync(&s_sXfer, s_au16Tx, s_au16Rx, WORD_LEN, 0, XferDone, NULL);
+
+    while (USPI_XFER_IS_BUSY(&s_sXfer));
+
+    u32Cycles = CycleElapsed(u32Start);
+    Report("16-bit PDMA async, 256 frames", WORD_LEN * 16, u32Cycles);
+
+    if ((memcmp(s_au16Rx, s_au16Tx, sizeof(s_au16Tx)) != 0) || (g_u32Done != 2))
+        i32Err = -1;
+
+    USPI_Close(USPI0);
+
+    if (i32Err != 0)
+    {
+        printf("*** FAIL ***\n");
+
+        while (1);
+    }
+
+    printf("*** PASS ***\n");
+
+    while (1);
+}
+
+/*** (C) COPYRIGHT 2021 Nuvoton Technology Corp. ***/